@@ -37,6 +37,11 @@
 #include "Model/WorldNode.h"
 
 #include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <random>
+#include <vector>
 
 namespace TrenchBroom {
     using AABB = AABBTree<double, 3, Model::Node*>;
@@ -63,8 +68,19 @@ namespace TrenchBroom {
         }
     };
 
-    TEST_CASE("AABBTreeBenchmark.benchBuildTree", "[AABBTreeBenchmark]") {
-        const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
+    class CollectTreeNodes : public Model::NodeVisitor {
+    public:
+        std::vector<Model::Node*> nodes;
+    private:
+        void doVisit(Model::WorldNode*) override {}
+        void doVisit(Model::LayerNode*) override {}
+        void doVisit(Model::GroupNode*) override {}
+        void doVisit(Model::EntityNode* entity) override { nodes.push_back(entity); }
+        void doVisit(Model::BrushNode* brush) override   { nodes.push_back(brush); }
+    };
+
+    static std::unique_ptr<Model::WorldNode> loadMap(const IO::Path& path) {
+        const auto mapPath = IO::Disk::getCurrentWorkingDir() + path;
         const auto file = IO::Disk::openFile(mapPath);
         auto fileReader = file->reader().buffer();
 
@@ -72,7 +88,35 @@ namespace TrenchBroom {
         IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
 
         const vm::bbox3 worldBounds(8192.0);
-        auto world = worldReader.read(Model::MapFormat::Standard, worldBounds, status);
+        return worldReader.read(Model::MapFormat::Standard, worldBounds, status);
+    }
+
+    /**
+     * Returns random rays that start inside the given bounds. The rays are always the same for a given count.
+     */
+    static std::vector<vm::ray3> makeRays(const vm::bbox3& bounds, const size_t count) {
+        std::mt19937 rng(0u);
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+        const auto randomPoint = [&]() {
+            return vm::vec3(
+                bounds.min.x() + dist(rng) * bounds.size().x(),
+                bounds.min.y() + dist(rng) * bounds.size().y(),
+                bounds.min.z() + dist(rng) * bounds.size().z());
+        };
+
+        std::vector<vm::ray3> rays;
+        rays.reserve(count);
+        for (size_t i = 0u; i < count; ++i) {
+            const auto origin = randomPoint();
+            const auto target = randomPoint();
+            rays.emplace_back(origin, vm::normalize(target - origin));
+        }
+        return rays;
+    }
+
+    TEST_CASE("AABBTreeBenchmark.benchBuildTree", "[AABBTreeBenchmark]") {
+        auto world = loadMap(IO::Path("fixture/benchmark/AABBTree/ne_ruins.map"));
 
         std::vector<AABB> trees(100);
         timeLambda([&world, &trees]() {
@@ -82,4 +126,45 @@ namespace TrenchBroom {
             }
         }, "Add objects to AABB tree");
     }
+
+    TEST_CASE("AABBTreeBenchmark.benchBulkBuildTree", "[AABBTreeBenchmark]") {
+        auto world = loadMap(IO::Path("fixture/benchmark/AABBTree/ne_ruins.map"));
+
+        CollectTreeNodes collect;
+        world->acceptAndRecurse(collect);
+
+        const auto getBounds = [](const Model::Node* node) { return node->physicalBounds(); };
+
+        std::vector<AABB> trees(100);
+        timeLambda([&]() {
+            for (auto& tree : trees) {
+                tree.clearAndBuild(collect.nodes, getBounds);
+            }
+        }, "Bulk build AABB tree");
+
+        AABB incrementalTree;
+        TreeBuilder builder(incrementalTree);
+        world->acceptAndRecurse(builder);
+
+        const auto& bulkTree = trees.front();
+        printf("Tree height: incremental %zu, bulk %zu\n", incrementalTree.height(), bulkTree.height());
+
+        const auto rays = makeRays(bulkTree.bounds(), 100000u);
+        size_t incrementalHits = 0u;
+        size_t bulkHits = 0u;
+
+        timeLambda([&]() {
+            for (const auto& ray : rays) {
+                incrementalHits += incrementalTree.findIntersectors(ray).size();
+            }
+        }, "Ray queries against incrementally built AABB tree");
+
+        timeLambda([&]() {
+            for (const auto& ray : rays) {
+                bulkHits += bulkTree.findIntersectors(ray).size();
+            }
+        }, "Ray queries against flat snapshot of bulk built AABB tree");
+
+        ASSERT_EQ(incrementalHits, bulkHits);
+    }
 }
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "Assets/ModelDefinition.h"
+#include "EL/CompiledExpression.h"
+#include "EL/EvaluationContext.h"
+#include "EL/Expression.h"
+#include "EL/Value.h"
+#include "IO/ELParser.h"
+#include "Model/EntityAttributes.h"
+#include "Model/EntityAttributesVariableStore.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace EL {
+        static const std::string ModelExpression = R"({{
+            spawnflags == 1 -> { "path": "progs/armor.mdl", "skin": 0 },
+            spawnflags == 2 -> { "path": "progs/armor.mdl", "skin": 1 },
+            spawnflags == 4 -> { "path": "progs/armor.mdl", "skin": 2 },
+            { "path": "progs/" + classname + ".mdl", "skin": skin, "frame": frame }
+        }})";
+
+        static std::vector<Model::EntityAttributes> makeEntities(const size_t count) {
+            std::vector<Model::EntityAttributes> entities(count);
+            for (size_t i = 0u; i < count; ++i) {
+                entities[i].addOrUpdateAttribute("classname", "item_armor" + std::to_string(i % 3u), nullptr);
+                entities[i].addOrUpdateAttribute("spawnflags", std::to_string(i % 8u), nullptr);
+                entities[i].addOrUpdateAttribute("skin", std::to_string(i % 4u), nullptr);
+                entities[i].addOrUpdateAttribute("frame", std::to_string(i % 10u), nullptr);
+                entities[i].addOrUpdateAttribute("origin", "0 0 0", nullptr);
+            }
+            return entities;
+        }
+
+        TEST_CASE("ExpressionBenchmark.benchEvaluateModelExpression", "[ExpressionBenchmark]") {
+            const auto entities = makeEntities(10000u);
+            const auto expression = IO::ELParser::parseStrict(ModelExpression);
+            const auto compiled = CompiledExpression(expression);
+
+            std::vector<Value> treeResults;
+            treeResults.reserve(entities.size());
+            timeLambda([&]() {
+                for (const auto& attributes : entities) {
+                    const Model::EntityAttributesVariableStore store(attributes);
+                    treeResults.push_back(expression.evaluate(EvaluationContext(store)));
+                }
+            }, "Evaluate model expression tree for 10000 entities");
+
+            std::vector<Value> compiledResults;
+            compiledResults.reserve(entities.size());
+            timeLambda([&]() {
+                for (const auto& attributes : entities) {
+                    const Model::EntityAttributesVariableStore store(attributes);
+                    compiledResults.push_back(compiled.evaluate(store));
+                }
+            }, "Evaluate compiled model expression for 10000 entities");
+
+            ASSERT_EQ(treeResults, compiledResults);
+        }
+
+        TEST_CASE("ExpressionBenchmark.benchModelSpecification", "[ExpressionBenchmark]") {
+            const auto entities = makeEntities(10000u);
+            const auto definition = Assets::ModelDefinition(IO::ELParser::parseStrict(ModelExpression));
+
+            size_t skins = 0u;
+            timeLambda([&]() {
+                for (const auto& attributes : entities) {
+                    skins += definition.modelSpecification(attributes).skinIndex;
+                }
+            }, "Get model specifications for 10000 entities");
+            printf("Skins: %zu\n", skins);
+        }
+    }
+}
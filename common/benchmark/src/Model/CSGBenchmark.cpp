@@ -0,0 +1,111 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushBuilder.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/NodeVisitor.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class CollectBrushes : public NodeVisitor {
+        public:
+            std::vector<const Brush*> brushes;
+        private:
+            void doVisit(WorldNode*) override {}
+            void doVisit(LayerNode*) override {}
+            void doVisit(GroupNode*) override {}
+            void doVisit(EntityNode*) override {}
+            void doVisit(BrushNode* brush) override { brushes.push_back(&brush->brush()); }
+        };
+
+        static std::unique_ptr<WorldNode> loadMap(const IO::Path& path, const vm::bbox3& worldBounds) {
+            const auto mapPath = IO::Disk::getCurrentWorkingDir() + path;
+            const auto file = IO::Disk::openFile(mapPath);
+            auto fileReader = file->reader().buffer();
+
+            IO::TestParserStatus status;
+            IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+
+            return worldReader.read(MapFormat::Standard, worldBounds, status);
+        }
+
+        TEST_CASE("CSGBenchmark.benchSubtract", "[CSGBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+            auto world = loadMap(IO::Path("fixture/benchmark/AABBTree/ne_ruins.map"), worldBounds);
+
+            CollectBrushes collect;
+            world->acceptAndRecurse(collect);
+
+            // subtract random cubes which are scattered over the map
+            const auto bounds = world->logicalBounds();
+            std::mt19937 rng(0u);
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+            const BrushBuilder builder(world.get(), worldBounds);
+            std::vector<Brush> subtrahendBrushes;
+            for (size_t i = 0u; i < 200u; ++i) {
+                const auto center = vm::round(bounds.min + vm::vec3(dist(rng), dist(rng), dist(rng)) * bounds.size());
+                subtrahendBrushes.push_back(builder.createCuboid(vm::bbox3(center - vm::vec3::fill(64.0), center + vm::vec3::fill(64.0)), "subtrahend"));
+            }
+
+            std::vector<const Brush*> subtrahends;
+            for (const auto& subtrahend : subtrahendBrushes) {
+                subtrahends.push_back(&subtrahend);
+            }
+
+            size_t count = 0u;
+            timeLambda([&]() {
+                for (const auto* minuend : collect.brushes) {
+                    count += minuend->subtract(*world, worldBounds, "default", subtrahends).size();
+                }
+            }, "Subtract cubes from every brush one by one");
+            printf("Brushes: %zu\n", count);
+
+            count = 0u;
+            timeLambda([&]() {
+                for (const auto& result : Brush::subtractAll(*world, worldBounds, "default", collect.brushes, subtrahends)) {
+                    count += result.size();
+                }
+            }, "Subtract cubes from all brushes at once");
+            printf("Brushes: %zu\n", count);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/NodeVisitor.h"
+#include "Model/PickResult.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class CollectBrushNodes : public NodeVisitor {
+        public:
+            std::vector<BrushNode*> brushes;
+        private:
+            void doVisit(WorldNode*) override {}
+            void doVisit(LayerNode*) override {}
+            void doVisit(GroupNode*) override {}
+            void doVisit(EntityNode*) override {}
+            void doVisit(BrushNode* brush) override { brushes.push_back(brush); }
+        };
+
+        static std::unique_ptr<WorldNode> loadMap(const IO::Path& path) {
+            const auto mapPath = IO::Disk::getCurrentWorkingDir() + path;
+            const auto file = IO::Disk::openFile(mapPath);
+            auto fileReader = file->reader().buffer();
+
+            IO::TestParserStatus status;
+            IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+
+            const vm::bbox3 worldBounds(8192.0);
+            return worldReader.read(MapFormat::Standard, worldBounds, status);
+        }
+
+        TEST_CASE("PickBenchmark.benchPickWorld", "[PickBenchmark]") {
+            auto world = loadMap(IO::Path("fixture/benchmark/AABBTree/ne_ruins.map"));
+            const auto bounds = world->logicalBounds();
+
+            std::mt19937 rng(0u);
+            std::uniform_real_distribution<double> dist(0.0, 1.0);
+            const auto randomPoint = [&]() {
+                return vm::vec3(
+                    bounds.min.x() + dist(rng) * bounds.size().x(),
+                    bounds.min.y() + dist(rng) * bounds.size().y(),
+                    bounds.min.z() + dist(rng) * bounds.size().z());
+            };
+
+            std::vector<vm::ray3> rays;
+            for (size_t i = 0u; i < 100000u; ++i) {
+                const auto origin = randomPoint();
+                rays.emplace_back(origin, vm::normalize(randomPoint() - origin));
+            }
+
+            size_t hits = 0u;
+            timeLambda([&]() {
+                for (const auto& ray : rays) {
+                    PickResult pickResult;
+                    world->pick(ray, pickResult);
+                    hits += pickResult.size();
+                }
+            }, "Pick world with random rays");
+            printf("Hits: %zu\n", hits);
+        }
+
+        TEST_CASE("PickBenchmark.benchPickBrushes", "[PickBenchmark]") {
+            auto world = loadMap(IO::Path("fixture/benchmark/AABBTree/ne_ruins.map"));
+
+            CollectBrushNodes collect;
+            world->acceptAndRecurse(collect);
+
+            // aim at each brush's center from several directions, so that every ray hits the brush bounds
+            const auto directions = std::vector<vm::vec3>{
+                vm::vec3::pos_x(), vm::vec3::neg_y(), vm::vec3::pos_z(),
+                vm::normalize(vm::vec3(1.0, 1.0, 1.0)), vm::normalize(vm::vec3(-1.0, 2.0, -3.0))
+            };
+
+            size_t hits = 0u;
+            timeLambda([&]() {
+                for (size_t i = 0u; i < 20u; ++i) {
+                    for (auto* brush : collect.brushes) {
+                        const auto center = brush->logicalBounds().center();
+                        for (const auto& direction : directions) {
+                            PickResult pickResult;
+                            brush->pick(vm::ray3(center - direction * 1024.0, direction), pickResult);
+                            hits += pickResult.size();
+                        }
+                    }
+                }
+            }, "Pick brush faces");
+
+            ASSERT_EQ(20u * directions.size() * collect.brushes.size(), hits);
+        }
+    }
+}
@@ -0,0 +1,163 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "../../test/src/GTestCompat.h"
+
+#include "BenchmarkUtils.h"
+
+#include "FloatType.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
+#include "Model/NodeVisitor.h"
+#include "Model/Polyhedron.h"
+#include "Model/Polyhedron_DefaultPayload.h"
+#include "Model/Polyhedron_Instantiation.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+#include <vecmath/vec.h>
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        using ArenaPolyhedron = Polyhedron<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_ArenaAllocator>;
+        using PoolPolyhedron = Polyhedron<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
+
+        static std::vector<std::vector<vm::vec3>> randomPointClouds(const size_t cloudCount, const size_t pointCount) {
+            std::mt19937 rng(0u);
+            std::uniform_real_distribution<FloatType> dist(-64.0, 64.0);
+
+            std::vector<std::vector<vm::vec3>> result(cloudCount);
+            for (auto& points : result) {
+                for (size_t i = 0u; i < pointCount; ++i) {
+                    points.emplace_back(dist(rng), dist(rng), dist(rng));
+                }
+            }
+            return result;
+        }
+
+        template <typename P>
+        static size_t elementBytes(const P& polyhedron) {
+            return polyhedron.vertexCount() * sizeof(typename P::Vertex)
+                + polyhedron.edgeCount() * (sizeof(typename P::Edge) + 2u * sizeof(typename P::HalfEdge))
+                + polyhedron.faceCount() * sizeof(typename P::Face);
+        }
+
+        template <typename P>
+        static void benchConvexHullAndCopy(const std::vector<std::vector<vm::vec3>>& pointClouds, const std::string& policy) {
+            std::vector<P> hulls;
+            hulls.reserve(pointClouds.size());
+            timeLambda([&]() {
+                for (const auto& points : pointClouds) {
+                    hulls.emplace_back(points);
+                }
+            }, "Build convex hulls using " + policy);
+
+            std::vector<P> copies;
+            copies.reserve(hulls.size());
+            timeLambda([&]() {
+                for (const auto& hull : hulls) {
+                    copies.push_back(hull);
+                }
+            }, "Copy convex hulls using " + policy);
+
+            timeLambda([&]() {
+                copies.clear();
+                hulls.clear();
+            }, "Destroy convex hulls using " + policy);
+        }
+
+        TEST_CASE("PolyhedronBenchmark.benchConvexHull", "[PolyhedronBenchmark]") {
+            const auto pointClouds = randomPointClouds(20000u, 16u);
+
+            benchConvexHullAndCopy<PoolPolyhedron>(pointClouds, "pool allocator");
+            benchConvexHullAndCopy<ArenaPolyhedron>(pointClouds, "arena allocator");
+
+            size_t elementTotal = 0u;
+            size_t arenaTotal = 0u;
+            for (const auto& points : pointClouds) {
+                const auto hull = ArenaPolyhedron(points);
+                elementTotal += elementBytes(hull);
+                arenaTotal += hull.allocator().allocatedBytes();
+            }
+            printf("Element bytes per hull: %zu, arena bytes per hull: %zu\n", elementTotal / pointClouds.size(), arenaTotal / pointClouds.size());
+
+            size_t cubeElementTotal = 0u;
+            size_t cubeArenaTotal = 0u;
+            for (const auto& points : pointClouds) {
+                const auto cube = ArenaPolyhedron(vm::bbox3(points.front(), points.front() + vm::vec3::fill(16.0)));
+                cubeElementTotal += elementBytes(cube);
+                cubeArenaTotal += cube.allocator().allocatedBytes();
+            }
+            printf("Element bytes per cube: %zu, arena bytes per cube: %zu\n", cubeElementTotal / pointClouds.size(), cubeArenaTotal / pointClouds.size());
+        }
+
+        class CollectBrushCopies : public NodeVisitor {
+        public:
+            std::vector<Brush> brushes;
+        private:
+            void doVisit(WorldNode*) override {}
+            void doVisit(LayerNode*) override {}
+            void doVisit(GroupNode*) override {}
+            void doVisit(EntityNode*) override {}
+            void doVisit(BrushNode* brush) override { brushes.push_back(brush->brush()); }
+        };
+
+        TEST_CASE("PolyhedronBenchmark.benchBrushCopy", "[PolyhedronBenchmark]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            const auto mapPath = IO::Disk::getCurrentWorkingDir() + IO::Path("fixture/benchmark/AABBTree/ne_ruins.map");
+            const auto file = IO::Disk::openFile(mapPath);
+            auto fileReader = file->reader().buffer();
+
+            IO::TestParserStatus status;
+            IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
+            auto world = worldReader.read(MapFormat::Standard, worldBounds, status);
+
+            CollectBrushCopies collect;
+            world->acceptAndRecurse(collect);
+
+            std::vector<Brush> copies;
+            copies.reserve(collect.brushes.size() * 10u);
+            timeLambda([&]() {
+                for (size_t i = 0u; i < 10u; ++i) {
+                    for (const auto& brush : collect.brushes) {
+                        copies.push_back(brush);
+                    }
+                }
+            }, "Copy all brushes 10 times");
+
+            timeLambda([&]() {
+                copies.clear();
+            }, "Destroy brush copies");
+        }
+    }
+}
@@ -21,15 +21,25 @@
 #define TRENCHBROOM_AABBTREE_H
 
 #include "Exceptions.h"
+#include "SimdIntersection.h"
+
+#include <kdl/parallel.h>
 
 #include <vecmath/scalar.h>
 #include <vecmath/bbox.h>
 #include <vecmath/bbox_io.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include <vecmath/intersection.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <iosfwd>
+#include <iterator>
+#include <limits>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -229,6 +239,40 @@ namespace TrenchBroom {
 
                 return updateAndReturnRoot();
             }
+        public:
+            /**
+             * Returns the left child of this node.
+             */
+            const Node* left() const {
+                return m_left;
+            }
+
+            /**
+             * Returns the right child of this node.
+             */
+            const Node* right() const {
+                return m_right;
+            }
+
+            /**
+             * Inserts the given subtree into the subtree rooted at this node. Descends into the child that is increased
+             * the least by the bounds of the given subtree until the child is at most one level higher than the given
+             * subtree, and then replaces that child with a new inner node that has the child and the given subtree as its
+             * children. This keeps the tree balanced if the given subtree is balanced.
+             *
+             * @param subtree the subtree to insert, must not be higher than this node
+             * @return the new root of the tree
+             */
+            Node* insertSubtree(Node* subtree) {
+                auto*& child = selectLeastIncreaser(m_left, m_right, subtree->bounds());
+                if (child->height() > subtree->height() + 1u) {
+                    // only leaves have a height of 1
+                    return static_cast<InnerNode*>(child)->insertSubtree(subtree);
+                }
+
+                Node* oldChild = child;
+                return replaceChild(oldChild, new InnerNode(oldChild, subtree));
+            }
         public: // Node removal public
             /**
              * One of our direct children is being deleted. `this` will turn into a LeafNode.
@@ -462,11 +506,72 @@ namespace TrenchBroom {
                 assert(this->m_parent == expectedParent);
             }
         };
+        /**
+         * A read only snapshot of the tree in a flat, cache friendly layout. The nodes are stored in depth first order, so
+         * the left child of an inner node immediately follows it, and the node bounds are stored per component. For each
+         * node, we store the index of the first node following its subtree. This allows for queries that need neither a
+         * stack nor virtual function calls: if a node is hit, we continue with the next node, otherwise we skip its
+         * subtree. A node is a leaf if and only if its subtree ends right after it.
+         */
+        struct FlatTree {
+            std::array<std::vector<T>, S> min;
+            std::array<std::vector<T>, S> max;
+            std::vector<size_t> next;
+            std::vector<U> data; // only valid for leaves
+
+            bool empty() const {
+                return next.empty();
+            }
+
+            size_t size() const {
+                return next.size();
+            }
+
+            bool isLeaf(const size_t index) const {
+                return next[index] == index + 1u;
+            }
+
+            std::array<const T*, S> minFrom(const size_t index) const {
+                std::array<const T*, S> result;
+                for (size_t i = 0u; i < S; ++i) {
+                    result[i] = min[i].data() + index;
+                }
+                return result;
+            }
+
+            std::array<const T*, S> maxFrom(const size_t index) const {
+                std::array<const T*, S> result;
+                for (size_t i = 0u; i < S; ++i) {
+                    result[i] = max[i].data() + index;
+                }
+                return result;
+            }
+
+            void clear() {
+                for (size_t i = 0u; i < S; ++i) {
+                    min[i].clear();
+                    max[i].clear();
+                }
+                next.clear();
+                data.clear();
+            }
+        };
     private:
         Node* m_root;
         std::unordered_map<U, LeafNode*> m_leafForData;
+
+        /**
+         * The flat snapshot is rebuilt lazily by queries after the tree was modified, see useFlatTree().
+         */
+        mutable FlatTree m_flatTree;
+        mutable std::atomic<bool> m_flatTreeValid;
+        mutable std::atomic<size_t> m_staleQueryCount;
+        mutable std::mutex m_flattenMutex;
     public:
-        AABBTree() : m_root(nullptr) {}
+        AABBTree() :
+        m_root(nullptr),
+        m_flatTreeValid(true),
+        m_staleQueryCount(0u) {}
 
         ~AABBTree() {
             clear();
@@ -484,16 +589,54 @@ namespace TrenchBroom {
         }
 
         /**
-         * Clears this tree and rebuilds it by inserting given objects.
+         * Clears this tree and rebuilds it from the given objects.
+         *
+         * Unlike inserting the objects one by one, this builds the tree top-down by recursively splitting the objects
+         * using the surface area heuristic (SAH), which yields a much better balanced tree. The top levels of large trees
+         * are built in parallel.
+         *
+         * Afterwards, a flat snapshot of the tree is created and used for queries. It is rebuilt lazily after the tree is
+         * modified.
          *
          * @param objects the objects to insert, a list of DataType
          * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates or if any bounds contains NaN
          */
         template <typename DataList, typename GetBounds>
         void clearAndBuild(const DataList& objects, GetBounds&& getBounds) {
             clear();
-            for (const U& object : objects) {
-                insert(getBounds(object), object);
+
+            std::vector<U> data;
+            std::vector<BuildItem> items;
+
+            try {
+                for (const U& object : objects) {
+                    const Box bounds = getBounds(object);
+                    check(bounds);
+
+                    if (!m_leafForData.emplace(object, nullptr).second) {
+                        throw NodeTreeException("Data already in tree");
+                    }
+
+                    items.push_back(BuildItem{ bounds, bounds.center(), data.size() });
+                    data.push_back(object);
+                }
+            } catch (const NodeTreeException&) {
+                clear();
+                throw;
+            }
+
+            if (!items.empty()) {
+                std::vector<LeafNode*> leaves(items.size());
+                m_root = build(data, leaves, std::begin(items), std::end(items), 0u);
+
+                for (size_t i = 0u; i < data.size(); ++i) {
+                    m_leafForData[data[i]] = leaves[i];
+                }
+
+                flatten();
+                m_flatTreeValid = true;
             }
         }
 
@@ -513,6 +656,8 @@ namespace TrenchBroom {
                 throw NodeTreeException("Data already in tree");
             }
 
+            invalidateFlatTree();
+
             if (empty()) {
                 auto* insertedLeafNode = new LeafNode(bounds, data);
 
@@ -526,6 +671,65 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Inserts the given objects into this tree at once.
+         *
+         * Unlike inserting the objects one by one, this builds a subtree from the given objects top-down using the
+         * surface area heuristic (SAH) like clearAndBuild does, and then inserts that subtree into the tree.
+         *
+         * @param objects the objects to insert, a list of DataType
+         * @param getBounds a function from DataType -> Box to compute the bounds of each object
+         *
+         * @throws NodeTreeException if the given objects contain duplicates or objects that already exist in this tree,
+         * or if any bounds contains NaN; the tree is not modified in that case
+         */
+        template <typename DataList, typename GetBounds>
+        void insertAll(const DataList& objects, GetBounds&& getBounds) {
+            std::vector<U> data;
+            std::vector<BuildItem> items;
+
+            try {
+                for (const U& object : objects) {
+                    const Box bounds = getBounds(object);
+                    check(bounds);
+
+                    if (!m_leafForData.emplace(object, nullptr).second) {
+                        throw NodeTreeException("Data already in tree");
+                    }
+
+                    items.push_back(BuildItem{ bounds, bounds.center(), data.size() });
+                    data.push_back(object);
+                }
+            } catch (const NodeTreeException&) {
+                for (const U& object : data) {
+                    m_leafForData.erase(object);
+                }
+                throw;
+            }
+
+            if (items.empty()) {
+                return;
+            }
+
+            std::vector<LeafNode*> leaves(items.size());
+            Node* subtree = build(data, leaves, std::begin(items), std::end(items), 0u);
+
+            for (size_t i = 0u; i < data.size(); ++i) {
+                m_leafForData[data[i]] = leaves[i];
+            }
+
+            invalidateFlatTree();
+
+            if (empty()) {
+                m_root = subtree;
+            } else if (m_root->height() <= subtree->height() + 1u) {
+                m_root = new InnerNode(m_root, subtree);
+            } else {
+                // only leaves have a height of 1
+                m_root = static_cast<InnerNode*>(m_root)->insertSubtree(subtree);
+            }
+        }
+
         /**
          * Removes the node with the given data from this tree.
          *
@@ -541,6 +745,7 @@ namespace TrenchBroom {
             LeafNode* leaf = it->second;
             assert(leaf->data() == data);
             m_leafForData.erase(it);
+            invalidateFlatTree();
 
             m_root = leaf->deleteThis();
 
@@ -569,6 +774,339 @@ namespace TrenchBroom {
                 throw NodeTreeException("Cannot add node to AABB tree with invalid bounds");
             }
         }
+    private: // bulk building
+        /**
+         * An object to be added to the tree when building it top-down.
+         */
+        struct BuildItem {
+            Box bounds;
+            vm::vec<T,S> center;
+            size_t index;
+        };
+
+        using BuildIterator = typename std::vector<BuildItem>::iterator;
+
+        /**
+         * The number of bins to sort the objects into when searching for the best split.
+         */
+        static constexpr size_t BuildBinCount = 16u;
+
+        /**
+         * Subtrees with fewer objects than this are never built in parallel.
+         */
+        static constexpr size_t ParallelBuildMinCount = 4096u;
+
+        /**
+         * Subtrees below this depth are never built in parallel. At this depth, up to 2^ParallelBuildMaxDepth subtrees
+         * are built at once.
+         */
+        static constexpr size_t ParallelBuildMaxDepth = 3u;
+
+        /**
+         * Below this depth, the objects are always split at the median to bound the height of the tree.
+         */
+        static constexpr size_t MaxSAHDepth = 48u;
+
+        /**
+         * Builds a subtree containing the objects in the given range. Each created leaf is stored in the given leaves
+         * vector at the index of its object.
+         */
+        static Node* build(const std::vector<U>& data, std::vector<LeafNode*>& leaves, BuildIterator begin, BuildIterator end, const size_t depth) {
+            assert(begin != end);
+
+            const auto count = static_cast<size_t>(std::distance(begin, end));
+            if (count == 1u) {
+                auto* leaf = new LeafNode(begin->bounds, data[begin->index]);
+                leaves[begin->index] = leaf;
+                return leaf;
+            }
+
+            const auto mid = split(begin, end, depth);
+            assert(mid != begin && mid != end);
+
+            if (count >= ParallelBuildMinCount && depth < ParallelBuildMaxDepth && kdl::default_thread_count() > 1u) {
+                std::array<Node*, 2u> children;
+                kdl::parallel_for(2u, [&](const size_t i) {
+                    children[i] = i == 0u ? build(data, leaves, begin, mid, depth + 1u) : build(data, leaves, mid, end, depth + 1u);
+                });
+                return new InnerNode(children[0], children[1]);
+            } else {
+                auto* left = build(data, leaves, begin, mid, depth + 1u);
+                auto* right = build(data, leaves, mid, end, depth + 1u);
+                return new InnerNode(left, right);
+            }
+        }
+
+        /**
+         * Partitions the given range of objects into two non-empty ranges and returns the start of the second range.
+         *
+         * The objects are sorted into bins along the axis on which their centers are spread the most, and the range is
+         * split at the bin boundary with the lowest SAH cost. If no such split exists, the range is split at the median.
+         */
+        static BuildIterator split(BuildIterator begin, BuildIterator end, const size_t depth) {
+            const auto count = static_cast<size_t>(std::distance(begin, end));
+
+            auto centerBounds = Box(begin->center, begin->center);
+            for (auto it = std::next(begin); it != end; ++it) {
+                centerBounds = vm::merge(centerBounds, it->center);
+            }
+
+            const auto centerSize = centerBounds.size();
+            size_t axis = 0u;
+            for (size_t i = 1u; i < S; ++i) {
+                if (centerSize[i] > centerSize[axis]) {
+                    axis = i;
+                }
+            }
+
+            if (depth >= MaxSAHDepth || count <= 2u || centerSize[axis] <= static_cast<T>(0)) {
+                return splitAtMedian(begin, end, axis);
+            }
+
+            const auto binMin = centerBounds.min[axis];
+            const auto binScale = static_cast<T>(BuildBinCount) / centerSize[axis];
+            const auto binIndex = [&](const BuildItem& item) {
+                const auto bin = static_cast<size_t>((item.center[axis] - binMin) * binScale);
+                return std::min(bin, BuildBinCount - 1u);
+            };
+
+            std::array<Box, BuildBinCount> binBounds;
+            std::array<size_t, BuildBinCount> binCounts;
+            binCounts.fill(0u);
+
+            for (auto it = begin; it != end; ++it) {
+                const auto bin = binIndex(*it);
+                binBounds[bin] = binCounts[bin] == 0u ? it->bounds : vm::merge(binBounds[bin], it->bounds);
+                ++binCounts[bin];
+            }
+
+            // sweep from the right to compute the cost of the right side of each possible split
+            std::array<T, BuildBinCount> rightCosts;
+            Box rightBounds;
+            size_t rightCount = 0u;
+            for (size_t i = BuildBinCount - 1u; i > 0u; --i) {
+                if (binCounts[i] > 0u) {
+                    rightBounds = rightCount == 0u ? binBounds[i] : vm::merge(rightBounds, binBounds[i]);
+                    rightCount += binCounts[i];
+                }
+                rightCosts[i] = rightCount == 0u ? static_cast<T>(0) : static_cast<T>(rightCount) * surfaceArea(rightBounds);
+            }
+
+            // sweep from the left, a split at i puts bins [0, i) on the left and bins [i, BuildBinCount) on the right
+            size_t bestSplit = 0u;
+            auto bestCost = std::numeric_limits<T>::max();
+            Box leftBounds;
+            size_t leftCount = 0u;
+            for (size_t i = 1u; i < BuildBinCount; ++i) {
+                if (binCounts[i - 1u] > 0u) {
+                    leftBounds = leftCount == 0u ? binBounds[i - 1u] : vm::merge(leftBounds, binBounds[i - 1u]);
+                    leftCount += binCounts[i - 1u];
+                }
+
+                if (leftCount > 0u && leftCount < count) {
+                    const auto cost = static_cast<T>(leftCount) * surfaceArea(leftBounds) + rightCosts[i];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestSplit = i;
+                    }
+                }
+            }
+
+            if (bestSplit == 0u) {
+                return splitAtMedian(begin, end, axis);
+            }
+
+            return std::partition(begin, end, [&](const BuildItem& item) {
+                return binIndex(item) < bestSplit;
+            });
+        }
+
+        static BuildIterator splitAtMedian(BuildIterator begin, BuildIterator end, const size_t axis) {
+            const auto mid = std::next(begin, std::distance(begin, end) / 2);
+            std::nth_element(begin, mid, end, [&](const BuildItem& lhs, const BuildItem& rhs) {
+                return lhs.center[axis] < rhs.center[axis];
+            });
+            return mid;
+        }
+
+        /**
+         * Returns half of the surface area of the given box, which is sufficient to compare SAH costs.
+         */
+        static T surfaceArea(const Box& box) {
+            const auto size = box.size();
+            auto result = static_cast<T>(0);
+            for (size_t i = 0u; i < S; ++i) {
+                auto product = static_cast<T>(1);
+                for (size_t j = 0u; j < S; ++j) {
+                    if (j != i) {
+                        product *= size[j];
+                    }
+                }
+                result += product;
+            }
+            return result;
+        }
+    private: // flat snapshot
+        /**
+         * Marks the flat snapshot as stale after the tree was modified.
+         */
+        void invalidateFlatTree() {
+            m_flatTreeValid = false;
+            m_staleQueryCount = 0u;
+        }
+
+        /**
+         * Indicates whether a query should use the flat snapshot, rebuilding it if it is stale.
+         *
+         * Rebuilding the snapshot takes linear time, so rebuilding it on every query that follows a modification would
+         * make interactive edits (where the tree is modified and queried in turns) slow. Therefore, the first query after
+         * a modification traverses the tree itself, and the snapshot is rebuilt by the next query if the tree was not
+         * modified in between.
+         *
+         * Queries may run concurrently, but not concurrently with modifications of the tree.
+         */
+        bool useFlatTree() const {
+            if (!m_flatTreeValid) {
+                if (m_staleQueryCount++ == 0u) {
+                    return false;
+                }
+
+                std::lock_guard<std::mutex> lock(m_flattenMutex);
+                if (!m_flatTreeValid) {
+                    flatten();
+                    m_flatTreeValid = true;
+                }
+            }
+            return !m_flatTree.empty();
+        }
+
+        /**
+         * Creates a flat snapshot of the current tree.
+         */
+        void flatten() const {
+            m_flatTree.clear();
+            if (empty()) {
+                return;
+            }
+
+            const auto nodeCount = 2u * m_leafForData.size() - 1u;
+            for (size_t i = 0u; i < S; ++i) {
+                m_flatTree.min[i].reserve(nodeCount);
+                m_flatTree.max[i].reserve(nodeCount);
+            }
+            m_flatTree.next.reserve(nodeCount);
+            m_flatTree.data.reserve(nodeCount);
+
+            flatten(m_root);
+            assert(m_flatTree.size() == nodeCount);
+        }
+
+        void flatten(const Node* node) const {
+            const auto index = m_flatTree.size();
+            const auto& bounds = node->bounds();
+            for (size_t i = 0u; i < S; ++i) {
+                m_flatTree.min[i].push_back(bounds.min[i]);
+                m_flatTree.max[i].push_back(bounds.max[i]);
+            }
+            m_flatTree.next.push_back(index + 1u);
+
+            // only leaves have a height of 1
+            if (node->height() == 1u) {
+                m_flatTree.data.push_back(static_cast<const LeafNode*>(node)->data());
+            } else {
+                m_flatTree.data.push_back(U());
+
+                const auto* innerNode = static_cast<const InnerNode*>(node);
+                flatten(innerNode->left());
+                flatten(innerNode->right());
+                m_flatTree.next[index] = m_flatTree.size();
+            }
+        }
+
+        /**
+         * Traverses the flat snapshot and appends the data of every leaf that is hit to the given output iterator.
+         * Subtrees of inner nodes that are not hit are skipped.
+         *
+         * The nodes are tested in batches of consecutive nodes: the given function is called with the index of the first
+         * node and the number of nodes of a batch, and it must return a bit mask where bit i is set if and only if the
+         * i-th node of the batch is hit. Since the left child of an inner node follows it immediately, descending into
+         * a subtree that is hit mostly consumes nodes that were already tested in the current batch.
+         */
+        template <typename H, typename O>
+        void findInFlatTree(const H& hitBatch, O& out) const {
+            const auto count = m_flatTree.size();
+            size_t batchStart = 0u;
+            size_t batchEnd = 0u;
+            unsigned batchHits = 0u;
+
+            size_t index = 0u;
+            while (index < count) {
+                if (index >= batchEnd) {
+                    batchStart = index;
+                    batchEnd = std::min(index + RayBatchSize, count);
+                    batchHits = hitBatch(batchStart, batchEnd - batchStart);
+                }
+
+                if (batchHits & (1u << (index - batchStart))) {
+                    if (m_flatTree.isLeaf(index)) {
+                        out = m_flatTree.data[index];
+                        ++out;
+                    }
+                    ++index;
+                } else {
+                    index = m_flatTree.next[index];
+                }
+            }
+        }
+
+        bool containsInFlatNode(const size_t index, const vm::vec<T,S>& point) const {
+            for (size_t i = 0u; i < S; ++i) {
+                if (point[i] < m_flatTree.min[i][index] || point[i] > m_flatTree.max[i][index]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool intersectsFlatNode(const size_t index, const Box& box) const {
+            for (size_t i = 0u; i < S; ++i) {
+                if (box.max[i] < m_flatTree.min[i][index] || box.min[i] > m_flatTree.max[i][index]) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool flatNodeAbovePlanes(const size_t index, const std::vector<vm::plane<T,S>>& planes) const {
+            const Box bounds = flatNodeBounds(index);
+            return boxAbovePlanes(bounds.min, bounds.max, planes);
+        }
+
+        Box flatNodeBounds(const size_t index) const {
+            Box bounds;
+            for (size_t i = 0u; i < S; ++i) {
+                bounds.min[i] = m_flatTree.min[i][index];
+                bounds.max[i] = m_flatTree.max[i][index];
+            }
+            return bounds;
+        }
+
+        /**
+         * Indicates whether the box with the given corners lies entirely above at least one of the given planes. The
+         * corner of the box that is closest to each plane along its normal is tested.
+         */
+        static bool boxAbovePlanes(const vm::vec<T,S>& min, const vm::vec<T,S>& max, const std::vector<vm::plane<T,S>>& planes) {
+            for (const auto& plane : planes) {
+                T distance = -plane.distance;
+                for (size_t i = 0u; i < S; ++i) {
+                    distance += plane.normal[i] * (plane.normal[i] > T(0) ? min[i] : max[i]);
+                }
+                if (distance > T(0)) {
+                    return true;
+                }
+            }
+            return false;
+        }
     public:
         /**
          * Clears this node tree.
@@ -578,6 +1116,8 @@ namespace TrenchBroom {
                 delete m_root;
                 m_root = nullptr;
             }
+            m_leafForData.clear();
+            invalidateFlatTree();
         }
 
         /**
@@ -636,7 +1176,12 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findIntersectors(const vm::ray<T,S>& ray, O out) const {
-            if (!empty()) {
+            if (useFlatTree()) {
+                const RayBoxTest<T,S> test(ray);
+                findInFlatTree([&](const size_t first, const size_t count) {
+                    return test(m_flatTree.minFrom(first), m_flatTree.maxFrom(first), count);
+                }, out);
+            } else if (!empty()) {
                 LambdaVisitor visitor(
                     [&](const InnerNode* innerNode) {
                         return innerNode->bounds().contains(ray.origin) || !vm::is_nan(
@@ -675,7 +1220,17 @@ namespace TrenchBroom {
          */
         template <typename O>
         void findContainers(const vm::vec<T,S>& point, O out) const {
-            if (!empty()) {
+            if (useFlatTree()) {
+                findInFlatTree([&](const size_t first, const size_t count) {
+                    unsigned result = 0u;
+                    for (size_t i = 0u; i < count; ++i) {
+                        if (containsInFlatNode(first + i, point)) {
+                            result |= 1u << i;
+                        }
+                    }
+                    return result;
+                }, out);
+            } else if (!empty()) {
                 LambdaVisitor visitor(
                     [&](const InnerNode* innerNode) {
                         return innerNode->bounds().contains(point);
@@ -691,6 +1246,147 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and returns a list of
+         * those items. Boxes that only touch the given box are found, too.
+         *
+         * @param box the box to test
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const Box& box) const {
+            List result;
+            findIntersectors(box, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the given box and appends it to the
+         * given output iterator.
+         *
+         * @tparam O the output iterator type
+         * @param box the box to test
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const Box& box, O out) const {
+            if (useFlatTree()) {
+                findInFlatTree([&](const size_t first, const size_t count) {
+                    unsigned result = 0u;
+                    for (size_t i = 0u; i < count; ++i) {
+                        if (intersectsFlatNode(first + i, box)) {
+                            result |= 1u << i;
+                        }
+                    }
+                    return result;
+                }, out);
+            } else if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return innerNode->bounds().intersects(box);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (leaf->bounds().intersects(box)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the convex volume bounded by the given
+         * planes and returns a list of those items. The normals of the planes must point out of the volume.
+         *
+         * The test is conservative: a bounding box is only rejected if it lies entirely above one of the planes, so a
+         * few boxes near the edges of the volume may be found even though they do not intersect it.
+         *
+         * @param planes the planes bounding the volume
+         * @return a list containing all found data items
+         */
+        List findIntersectors(const std::vector<vm::plane<T,S>>& planes) const {
+            List result;
+            findIntersectors(planes, std::back_inserter(result));
+            return result;
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box intersects with the convex volume bounded by the given
+         * planes and appends it to the given output iterator. See above for the details of the test.
+         *
+         * @tparam O the output iterator type
+         * @param planes the planes bounding the volume
+         * @param out the output iterator to append to
+         */
+        template <typename O>
+        void findIntersectors(const std::vector<vm::plane<T,S>>& planes, O out) const {
+            if (useFlatTree()) {
+                findInFlatTree([&](const size_t first, const size_t count) {
+                    unsigned result = 0u;
+                    for (size_t i = 0u; i < count; ++i) {
+                        if (!flatNodeAbovePlanes(first + i, planes)) {
+                            result |= 1u << i;
+                        }
+                    }
+                    return result;
+                }, out);
+            } else if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return !boxAbovePlanes(innerNode->bounds().min, innerNode->bounds().max, planes);
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (!boxAbovePlanes(leaf->bounds().min, leaf->bounds().max, planes)) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
+        /**
+         * Finds every data item in this tree whose bounding box satisfies the given predicate and appends it to the
+         * given output iterator.
+         *
+         * The predicate is applied to the bounds of the inner nodes, too, and their subtrees are skipped if it returns
+         * false. Therefore, the predicate must accept every box that contains a box which it accepts.
+         *
+         * @tparam P the predicate type, a function from Box -> bool
+         * @tparam O the output iterator type
+         * @param test the predicate to apply
+         * @param out the output iterator to append to
+         */
+        template <typename P, typename O>
+        void findMatching(const P& test, O out) const {
+            if (useFlatTree()) {
+                findInFlatTree([&](const size_t first, const size_t count) {
+                    unsigned result = 0u;
+                    for (size_t i = 0u; i < count; ++i) {
+                        if (test(flatNodeBounds(first + i))) {
+                            result |= 1u << i;
+                        }
+                    }
+                    return result;
+                }, out);
+            } else if (!empty()) {
+                LambdaVisitor visitor(
+                    [&](const InnerNode* innerNode) {
+                        return test(innerNode->bounds());
+                    },
+                    [&](const LeafNode* leaf) {
+                        if (test(leaf->bounds())) {
+                            out = leaf->data();
+                            ++out;
+                        }
+                    }
+                );
+                m_root->accept(visitor);
+            }
+        }
+
         /**
          * Prints a textual representation of this tree to the given output stream.
          *
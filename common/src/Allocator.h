@@ -21,7 +21,7 @@
 #define TrenchBroom_Allocator_h
 
 #include <cassert>
-#include <stack>
+#include <mutex>
 #include <vector>
 
 // Undefine this to prevent false positives when looking for memory leaks.
@@ -89,10 +89,53 @@ namespace TrenchBroom {
         };
 
         using ChunkList = std::vector<Chunk*>;
-        using Pool = std::stack<T*>;
+
+        /**
+         * Keeps the free blocks of a thread so that most allocations and deallocations do not need to take the lock
+         * that guards the chunk lists. A block that is deleted on another thread than the one that allocated it is
+         * simply added to the free list of the deleting thread. The free list is refilled from and drained to the
+         * chunks in batches, and its remaining blocks are returned to the chunks when the thread exits.
+         */
+        class Pool {
+        private:
+            std::vector<T*> m_blocks;
+        public:
+            ~Pool() {
+                std::lock_guard<std::mutex> lock(mutex());
+                for (T* t : m_blocks) {
+                    deallocateBlock(t);
+                }
+            }
+
+            T* allocate() {
+                if (m_blocks.empty()) {
+                    std::lock_guard<std::mutex> lock(mutex());
+                    for (size_t i = 0; i < BatchSize; ++i) {
+                        m_blocks.push_back(allocateBlock());
+                    }
+                }
+
+                T* t = m_blocks.back();
+                m_blocks.pop_back();
+                return t;
+            }
+
+            void deallocate(T* t) {
+                if (m_blocks.size() >= PoolSize) {
+                    std::lock_guard<std::mutex> lock(mutex());
+                    while (m_blocks.size() > PoolSize - BatchSize) {
+                        deallocateBlock(m_blocks.back());
+                        m_blocks.pop_back();
+                    }
+                }
+                m_blocks.push_back(t);
+            }
+        };
+
+        static constexpr size_t BatchSize = PoolSize / 2 > 0 ? PoolSize / 2 : 1;
 
         static Pool& pool() {
-            static Pool p;
+            thread_local Pool p;
             return p;
         }
 
@@ -106,21 +149,23 @@ namespace TrenchBroom {
             return chunks;
         }
 
-        static ChunkList emptyChunks() {
+        static ChunkList& emptyChunks() {
             static ChunkList chunks;
             return chunks;
         }
-    public:
-#ifdef TB_ENABLE_ALLOCATOR
-        void* operator new([[maybe_unused]] size_t size) {
-            assert(size == sizeof(T));
 
-            if (!pool().empty()) {
-                T* t = pool().top();
-                pool().pop();
-                return t;
-            }
+        /**
+         * Guards the chunk lists, which are shared by all threads.
+         */
+        static std::mutex& mutex() {
+            static std::mutex m;
+            return m;
+        }
 
+        /**
+         * Takes a block from the chunks. The caller must hold the lock.
+         */
+        static T* allocateBlock() {
             Chunk* chunk = nullptr;
             if (mixedChunks().empty()) {
                 if (!emptyChunks().empty()) {
@@ -145,14 +190,10 @@ namespace TrenchBroom {
             return block;
         }
 
-        void operator delete(void* block) {
-            T* t = reinterpret_cast<T*>(block);
-
-            if (PoolSize > 0 && pool().size() < PoolSize) {
-                pool().push(t);
-                return;
-            }
-
+        /**
+         * Returns a block to the chunk that contains it. The caller must hold the lock.
+         */
+        static void deallocateBlock(T* t) {
             typename ChunkList::reverse_iterator fullIt, fullEnd, mixedIt, mixedEnd;
             fullIt = fullChunks().rbegin();
             fullEnd = fullChunks().rend();
@@ -184,6 +225,7 @@ namespace TrenchBroom {
             if (chunk->full()) {
                 fullChunks().erase((fullIt + 1).base());
                 mixedChunks().push_back(chunk);
+                mixedIt = mixedChunks().rbegin();
             }
 
             chunk->deallocate(t);
@@ -196,6 +238,28 @@ namespace TrenchBroom {
                     delete chunk;
             }
         }
+    public:
+#ifdef TB_ENABLE_ALLOCATOR
+        void* operator new([[maybe_unused]] size_t size) {
+            assert(size == sizeof(T));
+
+            if constexpr (PoolSize == 0) {
+                std::lock_guard<std::mutex> lock(mutex());
+                return allocateBlock();
+            }
+            return pool().allocate();
+        }
+
+        void operator delete(void* block) {
+            T* t = reinterpret_cast<T*>(block);
+
+            if constexpr (PoolSize == 0) {
+                std::lock_guard<std::mutex> lock(mutex());
+                deallocateBlock(t);
+                return;
+            }
+            pool().deallocate(t);
+        }
 #endif
     };
 }
@@ -19,6 +19,7 @@
 
 #include "EntityModelManager.h"
 
+#include "DeferredLogger.h"
 #include "Exceptions.h"
 #include "Logger.h"
 #include "Macros.h"
@@ -28,6 +29,12 @@
 #include "Model/EntityNode.h"
 #include "Renderer/TexturedIndexRangeRenderer.h"
 
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <chrono>
+#include <functional>
+
 namespace TrenchBroom {
     namespace Assets {
         EntityModelManager::EntityModelManager(const int magFilter, const int minFilter, Logger& logger) :
@@ -35,13 +42,18 @@ namespace TrenchBroom {
         m_loader(nullptr),
         m_minFilter(minFilter),
         m_magFilter(magFilter),
-        m_resetTextureMode(false) {}
+        m_resetTextureMode(false),
+        m_loadInBackground(false),
+        m_backgroundLogger(std::make_unique<DeferredLogger>()) {}
 
         EntityModelManager::~EntityModelManager() {
             clear();
         }
 
         void EntityModelManager::clear() {
+            waitForBackgroundLoad();
+            m_queuedModels.clear();
+
             m_renderers.clear();
             m_models.clear();
             m_rendererMismatches.clear();
@@ -64,8 +76,12 @@ namespace TrenchBroom {
             m_loader = loader;
         }
 
+        void EntityModelManager::setLoadInBackground(const bool loadInBackground) {
+            m_loadInBackground = loadInBackground;
+        }
+
         Renderer::TexturedRenderer* EntityModelManager::renderer(const Assets::ModelSpecification& spec) const {
-            auto* entityModel = safeGetModel(spec.path);
+            auto* entityModel = safeGetModel(spec);
 
             if (entityModel == nullptr) {
                 return nullptr;
@@ -97,7 +113,7 @@ namespace TrenchBroom {
         }
 
         const EntityModelFrame* EntityModelManager::frame(const Assets::ModelSpecification& spec) const {
-            auto* model = this->safeGetModel(spec.path);
+            auto* model = this->safeGetModel(spec);
             if (model == nullptr) {
                 return nullptr;
             } else if (spec.frameIndex >= model->frameCount()) {
@@ -124,6 +140,11 @@ namespace TrenchBroom {
                 return nullptr;
             }
 
+            if (m_loadInBackground) {
+                // the model is queued for loading by the caller
+                return nullptr;
+            }
+
             try {
                 const auto [pos, success] = m_models.insert({ path, loadModel(path) });
                 assert(success); unused(success);
@@ -149,6 +170,14 @@ namespace TrenchBroom {
             }
         }
 
+        EntityModel* EntityModelManager::safeGetModel(const Assets::ModelSpecification& spec) const {
+            auto* result = safeGetModel(spec.path);
+            if (result == nullptr && m_loadInBackground) {
+                queueModel(spec.path, spec.frameIndex);
+            }
+            return result;
+        }
+
         std::unique_ptr<EntityModel> EntityModelManager::loadModel(const IO::Path& path) const {
             ensure(m_loader != nullptr, "loader is null");
             return m_loader->initializeModel(path, m_logger);
@@ -164,6 +193,109 @@ namespace TrenchBroom {
             }
         }
 
+        void EntityModelManager::loadPendingModels() {
+            const auto loadedPaths = finishBackgroundLoad();
+            startBackgroundLoad();
+
+            if (!loadedPaths.empty()) {
+                modelsWereLoadedNotifier(loadedPaths);
+            }
+        }
+
+        bool EntityModelManager::hasPendingModels() const {
+            return !m_queuedModels.empty() || m_backgroundLoad.valid();
+        }
+
+        void EntityModelManager::queueModel(const IO::Path& path, const size_t frameIndex) const {
+            if (path.isEmpty() || m_modelMismatches.count(path) > 0 || m_loadingModels.count(path) > 0) {
+                return;
+            }
+            m_queuedModels[path].push_back(frameIndex);
+        }
+
+        void EntityModelManager::startBackgroundLoad() {
+            if (m_backgroundLoad.valid() || m_queuedModels.empty()) {
+                return;
+            }
+
+            if (m_loader == nullptr) {
+                m_queuedModels.clear();
+                return;
+            }
+
+            auto loads = BackgroundLoadList();
+            loads.reserve(m_queuedModels.size());
+            for (auto& [path, frameIndices] : m_queuedModels) {
+                kdl::vec_sort_and_remove_duplicates(frameIndices);
+                m_loadingModels.insert(path);
+                loads.push_back(BackgroundLoad{path, std::move(frameIndices), nullptr});
+            }
+            m_queuedModels.clear();
+
+            m_backgroundLoad = std::async(std::launch::async, &EntityModelManager::loadModelsInBackground,
+                                          std::move(loads), std::cref(*m_loader), std::ref(*m_backgroundLogger));
+        }
+
+        std::vector<IO::Path> EntityModelManager::finishBackgroundLoad() {
+            auto result = std::vector<IO::Path>();
+            if (!m_backgroundLoad.valid() || m_backgroundLoad.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                return result;
+            }
+
+            auto loads = m_backgroundLoad.get();
+            m_loadingModels.clear();
+            m_backgroundLogger->flush(m_logger);
+
+            result.reserve(loads.size());
+            for (auto& load : loads) {
+                if (load.model != nullptr) {
+                    auto* model = load.model.get();
+                    if (m_models.insert({ load.path, std::move(load.model) }).second) {
+                        m_unpreparedModels.push_back(model);
+                        m_logger.debug() << "Loaded entity model " << load.path;
+                    }
+                } else {
+                    m_modelMismatches.insert(load.path);
+                }
+                result.push_back(load.path);
+            }
+
+            return result;
+        }
+
+        void EntityModelManager::waitForBackgroundLoad() {
+            if (m_backgroundLoad.valid()) {
+                // the loader must not be used anymore once this manager is cleared, the loaded models are discarded
+                m_backgroundLoad.wait();
+                m_backgroundLoad = std::future<BackgroundLoadList>();
+                m_loadingModels.clear();
+                m_backgroundLogger->flush(m_logger);
+            }
+        }
+
+        EntityModelManager::BackgroundLoadList EntityModelManager::loadModelsInBackground(BackgroundLoadList loads, const IO::EntityModelLoader& loader, Logger& logger) {
+            kdl::parallel_for(loads.size(), [&](const size_t i) {
+                auto& load = loads[i];
+                try {
+                    load.model = loader.initializeModel(load.path, logger);
+                } catch (const Exception& e) {
+                    logger.error() << e.what();
+                    return;
+                }
+
+                for (const auto frameIndex : load.frameIndices) {
+                    if (frameIndex < load.model->frameCount() && !load.model->frame(frameIndex)->loaded()) {
+                        try {
+                            loader.loadFrame(load.path, frameIndex, *load.model, logger);
+                        } catch (const Exception& e) {
+                            logger.error() << "Could not load entity model frame " << frameIndex << " of " << load.path << ": " << e.what();
+                        }
+                    }
+                }
+            });
+            return loads;
+        }
+
         void EntityModelManager::prepare(Renderer::VboManager& vboManager) {
             resetTextureMode();
             prepareModels();
@@ -20,15 +20,18 @@
 #ifndef TrenchBroom_EntityModelManager
 #define TrenchBroom_EntityModelManager
 
+#include "Notifier.h"
 #include "IO/Path.h"
 
 #include <kdl/vector_set.h>
 
+#include <future>
 #include <map>
 #include <memory>
 #include <vector>
 
 namespace TrenchBroom {
+    class DeferredLogger;
     class Logger;
 
     namespace IO {
@@ -73,6 +76,30 @@ namespace TrenchBroom {
 
             mutable ModelList m_unpreparedModels;
             mutable RendererList m_unpreparedRenderers;
+
+            struct BackgroundLoad {
+                IO::Path path;
+                std::vector<size_t> frameIndices;
+                std::unique_ptr<EntityModel> model;
+            };
+            using BackgroundLoadList = std::vector<BackgroundLoad>;
+
+            bool m_loadInBackground;
+            std::unique_ptr<DeferredLogger> m_backgroundLogger;
+
+            /**
+             * Models which were requested while background loading is enabled, along with the requested frames. These
+             * are loaded by the next background load started in loadPendingModels().
+             */
+            mutable std::map<IO::Path, std::vector<size_t>> m_queuedModels;
+            kdl::vector_set<IO::Path> m_loadingModels;
+            std::future<BackgroundLoadList> m_backgroundLoad;
+        public:
+            /**
+             * Notifies observers when models that were loaded in the background become available. The paths of all
+             * models that were attempted to load are passed, including those that failed to load.
+             */
+            Notifier<const std::vector<IO::Path>&> modelsWereLoadedNotifier;
         public:
             EntityModelManager(int magFilter, int minFilter, Logger& logger);
             ~EntityModelManager();
@@ -81,14 +108,43 @@ namespace TrenchBroom {
 
             void setTextureMode(int minFilter, int magFilter);
             void setLoader(const IO::EntityModelLoader* loader);
+
+            /**
+             * Controls whether models are loaded on a background thread. If enabled, renderer() and frame() return
+             * null for models that are not loaded yet and queue them for loading instead. Callers can use the
+             * bounds of the entity definition as a placeholder until modelsWereLoadedNotifier is triggered.
+             *
+             * Background loading is disabled by default.
+             */
+            void setLoadInBackground(bool loadInBackground);
+
             Renderer::TexturedRenderer* renderer(const ModelSpecification& spec) const;
 
             const EntityModelFrame* frame(const ModelSpecification& spec) const;
+
+            /**
+             * Integrates the models whose background load has finished and starts loading the queued models. Must be
+             * called regularly from the main thread (e.g. before rendering) as long as hasPendingModels() returns
+             * true. Triggers modelsWereLoadedNotifier if any models were integrated.
+             */
+            void loadPendingModels();
+
+            /**
+             * Indicates whether any models are queued for or currently being loaded in the background.
+             */
+            bool hasPendingModels() const;
         private:
             EntityModel* model(const IO::Path& path) const;
             EntityModel* safeGetModel(const IO::Path& path) const;
+            EntityModel* safeGetModel(const ModelSpecification& spec) const;
             std::unique_ptr<EntityModel> loadModel(const IO::Path& path) const;
             void loadFrame(const ModelSpecification& spec, EntityModel& model) const;
+
+            void queueModel(const IO::Path& path, size_t frameIndex) const;
+            void startBackgroundLoad();
+            std::vector<IO::Path> finishBackgroundLoad();
+            void waitForBackgroundLoad();
+            static BackgroundLoadList loadModelsInBackground(BackgroundLoadList loads, const IO::EntityModelLoader& loader, Logger& logger);
         public:
             void prepare(Renderer::VboManager& vboManager);
         private:
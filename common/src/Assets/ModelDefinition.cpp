@@ -19,9 +19,10 @@
 
 #include "ModelDefinition.h"
 
-#include "EL/EvaluationContext.h"
+#include "EL/CompiledExpression.h"
 #include "EL/Types.h"
 #include "EL/Value.h"
+#include "EL/VariableStore.h"
 #include "Model/EntityAttributesVariableStore.h"
 
 #include <kdl/string_compare.h>
@@ -83,13 +84,16 @@ namespace TrenchBroom {
         }
 
         ModelDefinition::ModelDefinition() :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, 0, 0)),
+        m_compiledExpression(std::make_shared<EL::CompiledExpression>(m_expression)) {}
 
         ModelDefinition::ModelDefinition(const size_t line, const size_t column) :
-        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)) {}
+        m_expression(EL::LiteralExpression::create(EL::Value::Undefined, line, column)),
+        m_compiledExpression(std::make_shared<EL::CompiledExpression>(m_expression)) {}
 
         ModelDefinition::ModelDefinition(const EL::Expression& expression) :
-        m_expression(expression) {}
+        m_expression(expression),
+        m_compiledExpression(std::make_shared<EL::CompiledExpression>(m_expression)) {}
 
         void ModelDefinition::append(const ModelDefinition& other) {
             EL::ExpressionBase::List cases;
@@ -99,18 +103,17 @@ namespace TrenchBroom {
             const size_t line = m_expression.line();
             const size_t column = m_expression.column();
             m_expression = EL::SwitchOperator::create(std::move(cases), line, column);
+            m_compiledExpression = std::make_shared<EL::CompiledExpression>(m_expression);
         }
 
         ModelSpecification ModelDefinition::modelSpecification(const Model::EntityAttributes& attributes) const {
             const Model::EntityAttributesVariableStore store(attributes);
-            const EL::EvaluationContext context(store);
-            return convertToModel(m_expression.evaluate(context));
+            return convertToModel(m_compiledExpression->evaluate(store));
         }
 
         ModelSpecification ModelDefinition::defaultModelSpecification() const {
             const EL::NullVariableStore store;
-            const EL::EvaluationContext context(store);
-            return convertToModel(m_expression.evaluate(context));
+            return convertToModel(m_compiledExpression->evaluate(store));
         }
 
         ModelSpecification ModelDefinition::convertToModel(const EL::Value& value) const {
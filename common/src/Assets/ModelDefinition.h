@@ -24,8 +24,13 @@
 #include "IO/Path.h"
 
 #include <iosfwd>
+#include <memory>
 
 namespace TrenchBroom {
+    namespace EL {
+        class CompiledExpression;
+    }
+
     namespace Model {
         class EntityAttributes;
     }
@@ -53,6 +58,7 @@ namespace TrenchBroom {
         class ModelDefinition {
         private:
             EL::Expression m_expression;
+            std::shared_ptr<const EL::CompiledExpression> m_compiledExpression;
         public:
             ModelDefinition();
             ModelDefinition(size_t line, size_t column);
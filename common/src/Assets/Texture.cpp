@@ -39,6 +39,8 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
+        m_tagMask(Model::TagType::NoType),
+        m_tagMaskGeneration(0),
         m_textureId(0) {
             assert(m_width > 0);
             assert(m_height > 0);
@@ -58,6 +60,8 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
+        m_tagMask(Model::TagType::NoType),
+        m_tagMaskGeneration(0),
         m_textureId(0),
         m_buffers(std::move(buffers)) {
             assert(m_width > 0);
@@ -84,6 +88,8 @@ namespace TrenchBroom {
         m_type(type),
         m_culling(TextureCulling::CullDefault),
         m_blendFunc{TextureBlendFunc::Enable::UseDefault, GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA},
+        m_tagMask(Model::TagType::NoType),
+        m_tagMaskGeneration(0),
         m_textureId(0) {}
 
         Texture::~Texture() {
@@ -135,6 +141,7 @@ namespace TrenchBroom {
 
         void Texture::setSurfaceParms(const std::set<std::string>& surfaceParms) {
             m_surfaceParms = surfaceParms;
+            m_tagMaskGeneration = 0;
         }
 
         TextureCulling Texture::culling() const {
@@ -155,6 +162,21 @@ namespace TrenchBroom {
             m_blendFunc.enable = TextureBlendFunc::Enable::DisableBlend;
         }
 
+        bool Texture::hasTagMask(const size_t generation) const {
+            assert(generation != 0u);
+            return m_tagMaskGeneration == generation;
+        }
+
+        Model::TagType::Type Texture::tagMask() const {
+            return m_tagMask;
+        }
+
+        void Texture::setTagMask(const size_t generation, const Model::TagType::Type tagMask) {
+            assert(generation != 0u);
+            m_tagMaskGeneration = generation;
+            m_tagMask = tagMask;
+        }
+
         size_t Texture::usageCount() const {
             return m_usageCount;
         }
@@ -21,6 +21,7 @@
 #define TrenchBroom_Texture
 
 #include "Color.h"
+#include "Model/TagType.h"
 #include "Renderer/GL.h"
 
 #include <vecmath/forward.h>
@@ -97,6 +98,10 @@ namespace TrenchBroom {
             // Quake 3 blend function, move to materials
             TextureBlendFunc m_blendFunc;
 
+            // the smart tags whose matchers only depend on the texture and match it, see Model::TagManager
+            Model::TagType::Type m_tagMask;
+            size_t m_tagMaskGeneration;
+
             mutable GLuint m_textureId;
             mutable BufferList m_buffers;
         public:
@@ -127,6 +132,29 @@ namespace TrenchBroom {
             void setBlendFunc(GLenum srcFactor, GLenum destFactor);
             void disableBlend();
 
+            /**
+             * Indicates whether this texture holds a tag mask that was computed for the smart tags registered in the
+             * given generation. Changing the surface parameters of this texture invalidates the tag mask.
+             *
+             * @param generation the generation of the registered smart tags, must not be 0
+             * @return true if the tag mask is valid for the given generation and false otherwise
+             */
+            bool hasTagMask(size_t generation) const;
+
+            /**
+             * Returns the tag mask of this texture. Only meaningful if hasTagMask returns true for the current
+             * generation of smart tags.
+             */
+            Model::TagType::Type tagMask() const;
+
+            /**
+             * Sets the tag mask of this texture and the generation of smart tags it was computed for.
+             *
+             * @param generation the generation of the registered smart tags, must not be 0
+             * @param tagMask the tag mask
+             */
+            void setTagMask(size_t generation, Model::TagType::Type tagMask);
+
             size_t usageCount() const;
             void incUsageCount();
             void decUsageCount();
@@ -24,6 +24,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -31,23 +32,27 @@ namespace TrenchBroom {
     namespace Assets {
         TextureCollection::TextureCollection() :
         m_loaded(false),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_preparedCount(0) {}
 
         TextureCollection::TextureCollection(const std::vector<Texture*>& textures) :
         m_loaded(false),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_preparedCount(0) {
             addTextures(textures);
         }
 
         TextureCollection::TextureCollection(const IO::Path& path) :
         m_loaded(false),
         m_path(path),
-        m_usageCount(0) {}
+        m_usageCount(0),
+        m_preparedCount(0) {}
 
         TextureCollection::TextureCollection(const IO::Path& path, const std::vector<Texture*>& textures) :
         m_loaded(true),
         m_path(path),
-        m_usageCount(0) {
+        m_usageCount(0),
+        m_preparedCount(0) {
             addTextures(textures);
         }
 
@@ -116,20 +121,37 @@ namespace TrenchBroom {
         }
 
         bool TextureCollection::prepared() const {
-            return !m_textureIds.empty();
+            return !m_textureIds.empty() && m_preparedCount == m_textureIds.size();
         }
 
         void TextureCollection::prepare(const int minFilter, const int magFilter) {
+            prepare(minFilter, magFilter, std::chrono::steady_clock::time_point::max());
+        }
+
+        bool TextureCollection::prepare(const int minFilter, const int magFilter, const std::chrono::steady_clock::time_point deadline) {
             assert(!prepared());
 
-            m_textureIds.resize(textureCount());
-            glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
-                                   static_cast<GLuint*>(&m_textureIds.front())));
+            if (textureCount() == 0) {
+                return true;
+            }
+
+            if (m_textureIds.empty()) {
+                m_textureIds.resize(textureCount());
+                glAssert(glGenTextures(static_cast<GLsizei>(textureCount()),
+                                       static_cast<GLuint*>(&m_textureIds.front())));
+            }
+
+            while (m_preparedCount < textureCount()) {
+                Texture* texture = m_textures[m_preparedCount];
+                texture->prepare(m_textureIds[m_preparedCount], minFilter, magFilter);
+                ++m_preparedCount;
 
-            for (size_t i = 0; i < textureCount(); ++i) {
-                Texture* texture = m_textures[i];
-                texture->prepare(m_textureIds[i], minFilter, magFilter);
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
             }
+
+            return prepared();
         }
 
         void TextureCollection::setTextureMode(const int minFilter, const int magFilter) {
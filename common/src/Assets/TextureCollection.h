@@ -24,6 +24,7 @@
 #include "IO/Path.h"
 #include "Renderer/GL.h"
 
+#include <chrono>
 #include <string>
 #include <vector>
 
@@ -42,6 +43,7 @@ namespace TrenchBroom {
             size_t m_usageCount;
 
             TextureIdList m_textureIds;
+            size_t m_preparedCount;
 
             friend class Texture;
         public:
@@ -68,6 +70,14 @@ namespace TrenchBroom {
 
             bool prepared() const;
             void prepare(int minFilter, int magFilter);
+
+            /**
+             * Uploads the textures of this collection one by one until all textures are uploaded or the given
+             * deadline has passed. At least one texture is uploaded per call.
+             *
+             * @return true if all textures of this collection are uploaded
+             */
+            bool prepare(int minFilter, int magFilter, std::chrono::steady_clock::time_point deadline);
             void setTextureMode(int minFilter, int magFilter);
         private:
             void incUsageCount();
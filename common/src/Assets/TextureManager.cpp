@@ -30,12 +30,15 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <chrono>
 #include <iterator>
 #include <string>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
+        static constexpr auto UploadTimeBudget = std::chrono::milliseconds(8);
+
         class CompareByName {
         public:
             CompareByName() {}
@@ -145,6 +148,10 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(m_toRemove);
         }
 
+        bool TextureManager::hasPendingChanges() const {
+            return !m_toPrepare.empty();
+        }
+
         Texture* TextureManager::texture(const std::string& name) const {
             auto it = m_texturesByName.find(kdl::str_to_lower(name));
             if (it == std::end(m_texturesByName)) {
@@ -179,9 +186,19 @@ namespace TrenchBroom {
         }
 
         void TextureManager::prepare() {
-            std::for_each(std::begin(m_toPrepare), std::end(m_toPrepare),
-                          [this](auto collection) { collection->prepare(m_minFilter, m_magFilter); });
-            m_toPrepare.clear();
+            const auto deadline = std::chrono::steady_clock::now() + UploadTimeBudget;
+            while (!m_toPrepare.empty()) {
+                auto* collection = m_toPrepare.front();
+                if (!collection->prepare(m_minFilter, m_magFilter, deadline)) {
+                    // out of time, continue with this collection on the next call
+                    break;
+                }
+                m_toPrepare.erase(std::begin(m_toPrepare));
+
+                if (std::chrono::steady_clock::now() >= deadline) {
+                    break;
+                }
+            }
         }
 
         void TextureManager::updateTextures() {
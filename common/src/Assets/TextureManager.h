@@ -72,8 +72,20 @@ namespace TrenchBroom {
             void clear();
 
             void setTextureMode(int minFilter, int magFilter);
+
+            /**
+             * Applies pending texture mode changes and uploads pending textures. To keep the UI responsive, the uploads
+             * are limited to a small time budget per call, so this must be called repeatedly (i.e., once per frame)
+             * until hasPendingChanges() returns false. Textures that are not uploaded yet can be rendered using their
+             * average color.
+             */
             void commitChanges();
 
+            /**
+             * Indicates whether some textures have not been uploaded yet.
+             */
+            bool hasPendingChanges() const;
+
             Texture* texture(const std::string& name) const;
             const std::vector<Texture*>& textures() const;
             const std::vector<TextureCollection*>& collections() const;
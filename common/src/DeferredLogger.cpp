@@ -0,0 +1,50 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DeferredLogger.h"
+
+#include <string>
+#include <vector>
+
+#include <QString>
+
+namespace TrenchBroom {
+    DeferredLogger::DeferredLogger() = default;
+
+    void DeferredLogger::flush(Logger& logger) {
+        auto messages = std::vector<Message>();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            swap(messages, m_messages);
+        }
+
+        for (const auto& [level, message] : messages) {
+            logger.log(level, message);
+        }
+    }
+
+    void DeferredLogger::doLog(const LogLevel level, const std::string& message) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_messages.emplace_back(level, message);
+    }
+
+    void DeferredLogger::doLog(const LogLevel level, const QString& message) {
+        doLog(level, message.toStdString());
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_DeferredLogger
+#define TrenchBroom_DeferredLogger
+
+#include "Macros.h"
+#include "Logger.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class QString;
+
+namespace TrenchBroom {
+    /**
+     * A logger that may be used from several threads at once. The messages are queued until flush() is called,
+     * which forwards them to a target logger on the calling thread.
+     *
+     * This is used for code that runs on worker threads while the actual logger (e.g. the console) must only be
+     * used from the main thread.
+     */
+    class DeferredLogger : public Logger {
+    private:
+        using Message = std::pair<LogLevel, std::string>;
+
+        std::mutex m_mutex;
+        std::vector<Message> m_messages;
+    public:
+        DeferredLogger();
+
+        /**
+         * Forwards all queued messages to the given logger in the order in which they were logged and clears the
+         * queue.
+         */
+        void flush(Logger& logger);
+    private:
+        void doLog(LogLevel level, const std::string& message) override;
+        void doLog(LogLevel level, const QString& message) override;
+
+        deleteCopyAndMove(DeferredLogger)
+    };
+}
+
+#endif /* TrenchBroom_DeferredLogger */
@@ -0,0 +1,98 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CompiledExpression.h"
+
+#include "EL/ELExceptions.h"
+#include "EL/Value.h"
+#include "EL/VariableStore.h"
+
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace EL {
+        ExpressionCompiler::ExpressionCompiler() :
+        m_slotCount(0u) {}
+
+        size_t ExpressionCompiler::variableSlot(const std::string& name) {
+            for (auto it = std::rbegin(m_declarations), end = std::rend(m_declarations); it != end; ++it) {
+                if (it->first == name) {
+                    return it->second;
+                }
+            }
+
+            for (const auto& [variableName, slot] : m_variables) {
+                if (variableName == name) {
+                    return slot;
+                }
+            }
+
+            m_variables.emplace_back(name, m_slotCount);
+            return m_slotCount++;
+        }
+
+        size_t ExpressionCompiler::pushDeclaration(const std::string& name) {
+            m_declarations.emplace_back(name, m_slotCount);
+            return m_slotCount++;
+        }
+
+        void ExpressionCompiler::popDeclaration() {
+            assert(!m_declarations.empty());
+            m_declarations.pop_back();
+        }
+
+        const std::vector<std::pair<std::string, size_t>>& ExpressionCompiler::variables() const {
+            return m_variables;
+        }
+
+        size_t ExpressionCompiler::slotCount() const {
+            return m_slotCount;
+        }
+
+        CompiledExpression::CompiledExpression(const Expression& expression) :
+        m_slotCount(0u) {
+            std::unique_ptr<ExpressionBase> root(expression.clone());
+            try {
+                ExpressionBase* optimized = root->optimize();
+                if (optimized != nullptr && optimized != root.get()) {
+                    root.reset(optimized);
+                }
+            } catch (const Exception&) {
+                // a constant subexpression cannot be evaluated, the error is reported when this expression is evaluated
+            }
+
+            ExpressionCompiler compiler;
+            m_evaluator = root->compile(compiler);
+            m_variables = compiler.variables();
+            m_slotCount = compiler.slotCount();
+        }
+
+        Value CompiledExpression::evaluate(const VariableStore& store) const {
+            std::vector<Value> slots(m_slotCount);
+            for (const auto& [name, slot] : m_variables) {
+                slots[slot] = store.value(name);
+            }
+            return m_evaluator(slots);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CompiledExpression_h
+#define CompiledExpression_h
+
+#include "EL/EL_Forward.h"
+#include "EL/Expression.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace EL {
+        /**
+         * Assigns slots to the variables of an expression while it is being compiled.
+         *
+         * Every variable that is read from the variable store gets one slot, no matter how often it is referenced.
+         * Variables that are declared while the expression is evaluated, such as the auto range parameter of a
+         * subscript, get a slot for every declaration.
+         */
+        class ExpressionCompiler {
+        private:
+            std::vector<std::pair<std::string, size_t>> m_variables;
+            std::vector<std::pair<std::string, size_t>> m_declarations;
+            size_t m_slotCount;
+        public:
+            ExpressionCompiler();
+
+            /**
+             * Returns the slot of the given variable, which is the slot of its innermost declaration if there is one.
+             */
+            size_t variableSlot(const std::string& name);
+
+            /**
+             * Declares the given variable and returns its slot. The declaration shadows any previous declaration of a
+             * variable with the same name until it is removed with popDeclaration().
+             */
+            size_t pushDeclaration(const std::string& name);
+            void popDeclaration();
+
+            /**
+             * Returns the variables that must be read from the variable store, and their slots.
+             */
+            const std::vector<std::pair<std::string, size_t>>& variables() const;
+            size_t slotCount() const;
+        };
+
+        /**
+         * An expression that has been compiled into a tree of closures.
+         *
+         * Compiling folds constant subexpressions and resolves each variable to a slot. When the compiled expression is
+         * evaluated, every variable is read from the variable store once, and the closures access the variables by
+         * their slots. This avoids copying the variable store and looking up variables by name repeatedly.
+         *
+         * Evaluating a compiled expression has the same result as evaluating the original expression.
+         */
+        class CompiledExpression {
+        private:
+            std::vector<std::pair<std::string, size_t>> m_variables;
+            size_t m_slotCount;
+            CompiledEvaluator m_evaluator;
+        public:
+            explicit CompiledExpression(const Expression& expression);
+
+            /**
+             * Evaluates this expression, reading the values of its variables from the given store.
+             *
+             * @throws EL::Exception if the expression could not be evaluated
+             */
+            Value evaluate(const VariableStore& store) const;
+        };
+    }
+}
+
+#endif /* CompiledExpression_h */
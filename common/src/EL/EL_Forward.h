@@ -27,6 +27,8 @@ namespace TrenchBroom {
 
         class ExpressionBase;
         class Expression;
+        class ExpressionCompiler;
+        class CompiledExpression;
 
         class EvaluationContext;
 
@@ -20,14 +20,35 @@
 #include "Expression.h"
 
 #include "Ensure.h"
+#include "EL/CompiledExpression.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Value.h"
 
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TrenchBroom {
     namespace EL {
+        using Slots = std::vector<Value>;
+
+        template <typename F>
+        static CompiledEvaluator compileUnaryOperator(CompiledEvaluator operand, const size_t line, const size_t column, F op) {
+            return [operand = std::move(operand), line, column, op](Slots& slots) {
+                return Value(op(operand(slots)), line, column);
+            };
+        }
+
+        template <typename F>
+        static CompiledEvaluator compileBinaryOperator(CompiledEvaluator leftOperand, CompiledEvaluator rightOperand, const size_t line, const size_t column, F op) {
+            return [leftOperand = std::move(leftOperand), rightOperand = std::move(rightOperand), line, column, op](Slots& slots) {
+                const Value leftValue = leftOperand(slots);
+                const Value rightValue = rightOperand(slots);
+                return Value(op(leftValue, rightValue), line, column);
+            };
+        }
+
         Expression::Expression(ExpressionBase* expression) :
         m_expression(expression) {
             ensure(m_expression.get() != nullptr, "expression is null");
@@ -97,6 +118,10 @@ namespace TrenchBroom {
             return doEvaluate(context);
         }
 
+        CompiledEvaluator ExpressionBase::compile(ExpressionCompiler& compiler) const {
+            return doCompile(compiler);
+        }
+
         std::string ExpressionBase::asString() const {
             std::stringstream result;
             appendToStream(result);
@@ -140,6 +165,12 @@ namespace TrenchBroom {
             return *m_value;
         }
 
+        CompiledEvaluator LiteralExpression::doCompile(ExpressionCompiler& /* compiler */) const {
+            return [value = *m_value](Slots& /* slots */) {
+                return value;
+            };
+        }
+
         void LiteralExpression::doAppendToStream(std::ostream& str) const {
             m_value->appendToStream(str, false);
         }
@@ -164,6 +195,12 @@ namespace TrenchBroom {
             return context.variableValue(m_variableName);
         }
 
+        CompiledEvaluator VariableExpression::doCompile(ExpressionCompiler& compiler) const {
+            return [slot = compiler.variableSlot(m_variableName)](Slots& slots) {
+                return slots[slot];
+            };
+        }
+
         void VariableExpression::doAppendToStream(std::ostream& str) const {
             str << m_variableName;
         }
@@ -201,23 +238,47 @@ namespace TrenchBroom {
             return nullptr;
         }
 
+        /**
+         * Appends the given value to the given array, or its elements if it is a range.
+         */
+        static void appendArrayElement(ArrayType& array, const Value& value) {
+            if (value.type() == ValueType::Range) {
+                const RangeType& range = value.rangeValue();
+                array.reserve(array.size() + range.size());
+                for (size_t i = 0; i < range.size(); ++i)
+                    array.push_back(Value(range[i], value.line(), value.column()));
+            } else {
+                array.push_back(value);
+            }
+        }
+
         Value ArrayExpression::doEvaluate(const EvaluationContext& context) const {
             ArrayType array;
             for (const auto& element : m_elements) {
-                const Value value = element->evaluate(context);
-                if (value.type() == ValueType::Range) {
-                    const RangeType& range = value.rangeValue();
-                    array.reserve(array.size() + range.size());
-                    for (size_t i = 0; i < range.size(); ++i)
-                        array.push_back(Value(range[i], value.line(), value.column()));
-                } else {
-                    array.push_back(value);
-                }
+                appendArrayElement(array, element->evaluate(context));
             }
 
             return Value(array, m_line, m_column);
         }
 
+        CompiledEvaluator ArrayExpression::doCompile(ExpressionCompiler& compiler) const {
+            std::vector<CompiledEvaluator> elements;
+            elements.reserve(m_elements.size());
+            for (const auto& element : m_elements) {
+                elements.push_back(element->compile(compiler));
+            }
+
+            return [elements = std::move(elements), line = m_line, column = m_column](Slots& slots) {
+                ArrayType array;
+                array.reserve(elements.size());
+                for (const auto& element : elements) {
+                    appendArrayElement(array, element(slots));
+                }
+
+                return Value(array, line, column);
+            };
+        }
+
         void ArrayExpression::doAppendToStream(std::ostream& str) const {
             str << "[ ";
 
@@ -280,6 +341,23 @@ namespace TrenchBroom {
             return Value(map, m_line, m_column);
         }
 
+        CompiledEvaluator MapExpression::doCompile(ExpressionCompiler& compiler) const {
+            std::vector<std::pair<std::string, CompiledEvaluator>> elements;
+            elements.reserve(m_elements.size());
+            for (const auto& [key, expression] : m_elements) {
+                elements.emplace_back(key, expression->compile(compiler));
+            }
+
+            return [elements = std::move(elements), line = m_line, column = m_column](Slots& slots) {
+                MapType map;
+                for (const auto& [key, element] : elements) {
+                    map.insert(std::make_pair(key, element(slots)));
+                }
+
+                return Value(map, line, column);
+            };
+        }
+
         void MapExpression::doAppendToStream(std::ostream& str) const {
             str << "{ ";
             size_t i = 0;
@@ -326,6 +404,10 @@ namespace TrenchBroom {
             return Value(+m_operand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator UnaryPlusOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileUnaryOperator(m_operand->compile(compiler), m_line, m_column, [](const Value& value) { return +value; });
+        }
+
         void UnaryPlusOperator::doAppendToStream(std::ostream& str) const {
             str << "+" << *m_operand;
         }
@@ -345,6 +427,10 @@ namespace TrenchBroom {
             return Value(-m_operand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator UnaryMinusOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileUnaryOperator(m_operand->compile(compiler), m_line, m_column, [](const Value& value) { return -value; });
+        }
+
         void UnaryMinusOperator::doAppendToStream(std::ostream& str) const {
             str << "-" << *m_operand;
         }
@@ -364,6 +450,10 @@ namespace TrenchBroom {
             return Value(!m_operand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator LogicalNegationOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileUnaryOperator(m_operand->compile(compiler), m_line, m_column, [](const Value& value) { return !value; });
+        }
+
         void LogicalNegationOperator::doAppendToStream(std::ostream& str) const {
             str << "!" << *m_operand;
         }
@@ -383,6 +473,10 @@ namespace TrenchBroom {
             return Value(~m_operand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseNegationOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileUnaryOperator(m_operand->compile(compiler), m_line, m_column, [](const Value& value) { return ~value; });
+        }
+
         void BitwiseNegationOperator::doAppendToStream(std::ostream& str) const {
             str << "~" << *m_operand;
         }
@@ -402,6 +496,10 @@ namespace TrenchBroom {
             return Value(m_operand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator GroupingOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileUnaryOperator(m_operand->compile(compiler), m_line, m_column, [](const Value& value) { return value; });
+        }
+
         void GroupingOperator::doAppendToStream(std::ostream& str) const {
             str << "( " << *m_operand << " )";
         }
@@ -447,6 +545,23 @@ namespace TrenchBroom {
             return indexableValue[indexValue];
         }
 
+        CompiledEvaluator SubscriptOperator::doCompile(ExpressionCompiler& compiler) const {
+            auto indexableOperand = m_indexableOperand->compile(compiler);
+
+            const auto autoRangeSlot = compiler.pushDeclaration(RangeOperator::AutoRangeParameterName());
+            auto indexOperand = m_indexOperand->compile(compiler);
+            compiler.popDeclaration();
+
+            return [indexableOperand = std::move(indexableOperand), indexOperand = std::move(indexOperand), autoRangeSlot, line = m_line, column = m_column](Slots& slots) {
+                const Value indexableValue = indexableOperand(slots);
+
+                slots[autoRangeSlot] = Value(indexableValue.length()-1, line, column);
+                const Value indexValue = indexOperand(slots);
+
+                return indexableValue[indexValue];
+            };
+        }
+
         void SubscriptOperator::doAppendToStream(std::ostream& str) const {
             str << *m_indexableOperand << "[" << *m_indexOperand << "]";
         }
@@ -558,6 +673,10 @@ namespace TrenchBroom {
             return Value(leftValue + rightValue, m_line, m_column);
         }
 
+        CompiledEvaluator AdditionOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs + rhs; });
+        }
+
         void AdditionOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " + " << *m_rightOperand;
         }
@@ -583,6 +702,10 @@ namespace TrenchBroom {
             return Value(leftValue - rightValue, m_line, m_column);
         }
 
+        CompiledEvaluator SubtractionOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs - rhs; });
+        }
+
         void SubtractionOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " - " << *m_rightOperand;
         }
@@ -608,6 +731,10 @@ namespace TrenchBroom {
             return Value(leftValue * rightValue, m_line, m_column);
         }
 
+        CompiledEvaluator MultiplicationOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs * rhs; });
+        }
+
         void MultiplicationOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " * " << *m_rightOperand;
         }
@@ -633,6 +760,10 @@ namespace TrenchBroom {
             return Value(leftValue / rightValue, m_line, m_column);
         }
 
+        CompiledEvaluator DivisionOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs / rhs; });
+        }
+
         void DivisionOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " / " << *m_rightOperand;
         }
@@ -658,6 +789,10 @@ namespace TrenchBroom {
             return Value(leftValue % rightValue, m_line, m_column);
         }
 
+        CompiledEvaluator ModulusOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs % rhs; });
+        }
+
         void ModulusOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " % " << *m_rightOperand;
         }
@@ -686,6 +821,13 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) && m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator LogicalAndOperator::doCompile(ExpressionCompiler& compiler) const {
+            // the right operand is only evaluated if necessary
+            return [leftOperand = m_leftOperand->compile(compiler), rightOperand = m_rightOperand->compile(compiler), line = m_line, column = m_column](Slots& slots) {
+                return Value(leftOperand(slots) && rightOperand(slots), line, column);
+            };
+        }
+
         void LogicalAndOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " && " << *m_rightOperand;
         }
@@ -709,6 +851,13 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) || m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator LogicalOrOperator::doCompile(ExpressionCompiler& compiler) const {
+            // the right operand is only evaluated if necessary
+            return [leftOperand = m_leftOperand->compile(compiler), rightOperand = m_rightOperand->compile(compiler), line = m_line, column = m_column](Slots& slots) {
+                return Value(leftOperand(slots) || rightOperand(slots), line, column);
+            };
+        }
+
         void LogicalOrOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " || " << *m_rightOperand;
         }
@@ -732,6 +881,10 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) & m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseAndOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs & rhs; });
+        }
+
         void BitwiseAndOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " & " << *m_rightOperand;
         }
@@ -755,6 +908,10 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) ^ m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseXorOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs ^ rhs; });
+        }
+
         void BitwiseXorOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " ^ " << *m_rightOperand;
         }
@@ -778,6 +935,10 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) | m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseOrOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs | rhs; });
+        }
+
         void BitwiseOrOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " | " << *m_rightOperand;
         }
@@ -801,6 +962,10 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) << m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseShiftLeftOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs << rhs; });
+        }
+
         void BitwiseShiftLeftOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " << " << *m_rightOperand;
         }
@@ -824,6 +989,10 @@ namespace TrenchBroom {
             return Value(m_leftOperand->evaluate(context) >> m_rightOperand->evaluate(context), m_line, m_column);
         }
 
+        CompiledEvaluator BitwiseShiftRightOperator::doCompile(ExpressionCompiler& compiler) const {
+            return compileBinaryOperator(m_leftOperand->compile(compiler), m_rightOperand->compile(compiler), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs >> rhs; });
+        }
+
         void BitwiseShiftRightOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " >> " << *m_rightOperand;
         }
@@ -882,6 +1051,27 @@ namespace TrenchBroom {
             }
         }
 
+        CompiledEvaluator ComparisonOperator::doCompile(ExpressionCompiler& compiler) const {
+            auto leftOperand = m_leftOperand->compile(compiler);
+            auto rightOperand = m_rightOperand->compile(compiler);
+
+            switch (m_op) {
+                case Op_Less:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs < rhs; });
+                case Op_LessOrEqual:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs <= rhs; });
+                case Op_Equal:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs == rhs; });
+                case Op_Inequal:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs != rhs; });
+                case Op_GreaterOrEqual:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs >= rhs; });
+                case Op_Greater:
+                    return compileBinaryOperator(std::move(leftOperand), std::move(rightOperand), m_line, m_column, [](const Value& lhs, const Value& rhs) { return lhs > rhs; });
+                    switchDefault()
+            }
+        }
+
         void ComparisonOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand;
             switch (m_op) {
@@ -941,10 +1131,7 @@ namespace TrenchBroom {
             return new RangeOperator(m_leftOperand->clone(), m_rightOperand->clone(), m_line, m_column);
         }
 
-        Value RangeOperator::doEvaluate(const EvaluationContext& context) const {
-            const Value leftValue = m_leftOperand->evaluate(context);
-            const Value rightValue = m_rightOperand->evaluate(context);
-
+        static Value makeRange(const Value& leftValue, const Value& rightValue, const size_t line, const size_t column) {
             const long from = static_cast<long>(leftValue.convertTo(ValueType::Number).numberValue());
             const long to = static_cast<long>(rightValue.convertTo(ValueType::Number).numberValue());
 
@@ -964,7 +1151,21 @@ namespace TrenchBroom {
             }
             assert(range.capacity() == range.size());
 
-            return Value(range, m_line, m_column);
+            return Value(range, line, column);
+        }
+
+        Value RangeOperator::doEvaluate(const EvaluationContext& context) const {
+            const Value leftValue = m_leftOperand->evaluate(context);
+            const Value rightValue = m_rightOperand->evaluate(context);
+            return makeRange(leftValue, rightValue, m_line, m_column);
+        }
+
+        CompiledEvaluator RangeOperator::doCompile(ExpressionCompiler& compiler) const {
+            return [leftOperand = m_leftOperand->compile(compiler), rightOperand = m_rightOperand->compile(compiler), line = m_line, column = m_column](Slots& slots) {
+                const Value leftValue = leftOperand(slots);
+                const Value rightValue = rightOperand(slots);
+                return makeRange(leftValue, rightValue, line, column);
+            };
         }
 
         void RangeOperator::doAppendToStream(std::ostream& str) const {
@@ -993,6 +1194,14 @@ namespace TrenchBroom {
             return Value::Undefined;
         }
 
+        CompiledEvaluator CaseOperator::doCompile(ExpressionCompiler& compiler) const {
+            return [premise = m_leftOperand->compile(compiler), conclusion = m_rightOperand->compile(compiler)](Slots& slots) {
+                if (premise(slots).convertTo(ValueType::Boolean))
+                    return conclusion(slots);
+                return Value::Undefined;
+            };
+        }
+
         void CaseOperator::doAppendToStream(std::ostream& str) const {
             str << *m_leftOperand << " -> " << *m_rightOperand;
         }
@@ -1045,6 +1254,23 @@ namespace TrenchBroom {
             return Value::Undefined;
         }
 
+        CompiledEvaluator SwitchOperator::doCompile(ExpressionCompiler& compiler) const {
+            std::vector<CompiledEvaluator> cases;
+            cases.reserve(m_cases.size());
+            for (const auto& case_ : m_cases) {
+                cases.push_back(case_->compile(compiler));
+            }
+
+            return [cases = std::move(cases)](Slots& slots) {
+                for (const auto& case_ : cases) {
+                    Value result = case_(slots);
+                    if (!result.undefined())
+                        return result;
+                }
+                return Value::Undefined;
+            };
+        }
+
         void SwitchOperator::doAppendToStream(std::ostream& str) const {
             str << "{{ ";
             size_t i = 0;
@@ -23,6 +23,7 @@
 #include "Macros.h"
 #include "EL/EL_Forward.h"
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -31,8 +32,16 @@
 
 namespace TrenchBroom {
     namespace EL {
+        /**
+         * Evaluates a compiled expression, see CompiledExpression. The given vector holds the values of the variables,
+         * indexed by the slots that the compiler assigned to them.
+         */
+        using CompiledEvaluator = std::function<Value(std::vector<Value>& slots)>;
+
         class Expression {
         private:
+            friend class CompiledExpression;
+
             std::shared_ptr<ExpressionBase> m_expression;
         public:
             // intentionally allows implicit conversions
@@ -72,6 +81,7 @@ namespace TrenchBroom {
             ExpressionBase* clone() const;
             ExpressionBase* optimize();
             Value evaluate(const EvaluationContext& context) const;
+            CompiledEvaluator compile(ExpressionCompiler& compiler) const;
 
             std::string asString() const;
             void appendToStream(std::ostream& str) const;
@@ -82,6 +92,7 @@ namespace TrenchBroom {
             virtual ExpressionBase* doClone() const = 0;
             virtual ExpressionBase* doOptimize() = 0;
             virtual Value doEvaluate(const EvaluationContext& context) const = 0;
+            virtual CompiledEvaluator doCompile(ExpressionCompiler& compiler) const = 0;
             virtual void doAppendToStream(std::ostream& str) const = 0;
 
             deleteCopyAndMove(ExpressionBase)
@@ -98,6 +109,7 @@ namespace TrenchBroom {
             ExpressionBase* doClone() const override;
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(LiteralExpression)
@@ -114,6 +126,7 @@ namespace TrenchBroom {
             ExpressionBase* doClone() const override;
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(VariableExpression)
@@ -131,6 +144,7 @@ namespace TrenchBroom {
             ExpressionBase* doClone() const override;
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(ArrayExpression)
@@ -148,6 +162,7 @@ namespace TrenchBroom {
             ExpressionBase* doClone() const override;
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(MapExpression)
@@ -173,6 +188,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(UnaryPlusOperator)
@@ -186,6 +202,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(UnaryMinusOperator)
@@ -199,6 +216,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(LogicalNegationOperator)
@@ -212,6 +230,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(BitwiseNegationOperator)
@@ -225,6 +244,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(GroupingOperator)
@@ -244,6 +264,7 @@ namespace TrenchBroom {
             ExpressionBase* doClone() const override;
             ExpressionBase* doOptimize() override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
 
             deleteCopyAndMove(SubscriptOperator)
@@ -286,6 +307,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -300,6 +322,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -314,6 +337,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -328,6 +352,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -342,6 +367,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -356,6 +382,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -370,6 +397,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -384,6 +412,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -398,6 +427,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -412,6 +442,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -426,6 +457,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -440,6 +472,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -469,6 +502,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -487,6 +521,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -501,6 +536,7 @@ namespace TrenchBroom {
         private:
             ExpressionBase* doClone() const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
             void doAppendToStream(std::ostream& str) const override;
             Traits doGetTraits() const override;
 
@@ -521,6 +557,7 @@ namespace TrenchBroom {
             ExpressionBase* doOptimize() override;
             void doAppendToStream(std::ostream& str) const override;
             Value doEvaluate(const EvaluationContext& context) const override;
+            CompiledEvaluator doCompile(ExpressionCompiler& compiler) const override;
 
             deleteCopyAndMove(SwitchOperator)
         };
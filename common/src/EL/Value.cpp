@@ -33,6 +33,8 @@
 #include <iterator>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace TrenchBroom {
     namespace EL {
@@ -167,9 +169,9 @@ namespace TrenchBroom {
 
 
 
-        StringReferenceHolder::StringReferenceHolder(const StringType& value) : m_value(value) {}
-        ValueHolder* StringReferenceHolder::clone() const { return new StringReferenceHolder(m_value); }
-        const StringType& StringReferenceHolder::doGetValue() const { return m_value; }
+        StringReferenceHolder::StringReferenceHolder(const StringType& value) : m_value(&value) {}
+        ValueHolder* StringReferenceHolder::clone() const { return new StringReferenceHolder(*m_value); }
+        const StringType& StringReferenceHolder::doGetValue() const { return *m_value; }
 
 
 
@@ -484,47 +486,89 @@ namespace TrenchBroom {
         void UndefinedValueHolder::appendToStream(std::ostream& str, const bool /* multiline */, const std::string& /* indent */) const { str << "undefined"; }
 
 
-        const Value Value::Null = Value(new NullValueHolder(), 0, 0);
-        const Value Value::Undefined = Value(new UndefinedValueHolder(), 0, 0);
+        const Value Value::Null = Value(Holder(std::in_place_type<NullValueHolder>), 0, 0);
+        const Value Value::Undefined = Value(Holder(std::in_place_type<UndefinedValueHolder>), 0, 0);
 
-        Value::Value(ValueHolder* holder, const size_t line, const size_t column)      : m_value(holder), m_line(line), m_column(column) {}
+        Value::Value(Holder holder, const size_t line, const size_t column) : m_value(std::move(holder)), m_line(line), m_column(column) {}
 
-        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(new BooleanValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const BooleanType& value)                                         : m_value(new BooleanValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(std::unique_ptr<ValueHolder> holder, const size_t line, const size_t column) :
+        m_value(std::in_place_type<NullValueHolder>),
+        m_line(line),
+        m_column(column) {
+            switch (holder->type()) {
+                case ValueType::Boolean:
+                    m_value.emplace<BooleanValueHolder>(holder->booleanValue());
+                    break;
+                case ValueType::Number:
+                    m_value.emplace<NumberValueHolder>(holder->numberValue());
+                    break;
+                case ValueType::Null:
+                    break;
+                case ValueType::Undefined:
+                    m_value.emplace<UndefinedValueHolder>();
+                    break;
+                case ValueType::String:
+                case ValueType::Array:
+                case ValueType::Map:
+                case ValueType::Range:
+                    m_value.emplace<ValuePtr>(std::move(holder));
+                    break;
+            }
+        }
+
+        Value::Holder Value::makeString(const StringType& value) {
+            // strings are always shared, so that the references returned by stringValue() remain valid for as long as
+            // any copy of this value exists
+            return Holder(std::in_place_type<ValuePtr>, std::make_shared<StringValueHolder>(value));
+        }
+
+        const ValueHolder& Value::holder() const {
+            return std::visit([](const auto& h) -> const ValueHolder& {
+                using H = std::decay_t<decltype(h)>;
+                if constexpr (std::is_same_v<H, ValuePtr>) {
+                    return *h;
+                } else {
+                    return h;
+                }
+            }, m_value);
+        }
+
+        Value::Value(const BooleanType& value, const size_t line, const size_t column) : m_value(std::in_place_type<BooleanValueHolder>, value), m_line(line), m_column(column) {}
+        Value::Value(const BooleanType& value)                                         : m_value(std::in_place_type<BooleanValueHolder>, value), m_line(0), m_column(0) {}
 
-        Value::Value(const StringType& value, const size_t line, const size_t column)  : m_value(new StringValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const StringType& value)                                          : m_value(new StringValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const StringType& value, const size_t line, const size_t column)  : m_value(makeString(value)), m_line(line), m_column(column) {}
+        Value::Value(const StringType& value)                                          : m_value(makeString(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const char* value, const size_t line, const size_t column)        : m_value(new StringValueHolder(std::string(value))), m_line(line), m_column(column) {}
-        Value::Value(const char* value)                                                : m_value(new StringValueHolder(std::string(value))), m_line(0), m_column(0) {}
+        Value::Value(const char* value, const size_t line, const size_t column)        : m_value(makeString(std::string(value))), m_line(line), m_column(column) {}
+        Value::Value(const char* value)                                                : m_value(makeString(std::string(value))), m_line(0), m_column(0) {}
 
-        Value::Value(const NumberType& value, const size_t line, const size_t column)  : m_value(new NumberValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const NumberType& value)                                          : m_value(new NumberValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const NumberType& value, const size_t line, const size_t column)  : m_value(std::in_place_type<NumberValueHolder>, value), m_line(line), m_column(column) {}
+        Value::Value(const NumberType& value)                                          : m_value(std::in_place_type<NumberValueHolder>, value), m_line(0), m_column(0) {}
 
-        Value::Value(const int value, const size_t line, const size_t column)          : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const int value)                                                  : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const int value, const size_t line, const size_t column)          : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(line), m_column(column) {}
+        Value::Value(const int value)                                                  : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const long value, const size_t line, const size_t column)         : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const long value)                                                 : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const long value, const size_t line, const size_t column)         : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(line), m_column(column) {}
+        Value::Value(const long value)                                                 : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const size_t value, const size_t line, const size_t column)       : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(line), m_column(column) {}
-        Value::Value(const size_t value)                                               : m_value(new NumberValueHolder(static_cast<NumberType>(value))), m_line(0), m_column(0) {}
+        Value::Value(const size_t value, const size_t line, const size_t column)       : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(line), m_column(column) {}
+        Value::Value(const size_t value)                                               : m_value(std::in_place_type<NumberValueHolder>, static_cast<NumberType>(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const ArrayType& value, const size_t line, const size_t column)   : m_value(new ArrayValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const ArrayType& value)                                           : m_value(new ArrayValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const ArrayType& value, const size_t line, const size_t column)   : m_value(std::in_place_type<ValuePtr>, std::make_shared<ArrayValueHolder>(value)), m_line(line), m_column(column) {}
+        Value::Value(const ArrayType& value)                                           : m_value(std::in_place_type<ValuePtr>, std::make_shared<ArrayValueHolder>(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const MapType& value, const size_t line, const size_t column)     : m_value(new MapValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const MapType& value)                                             : m_value(new MapValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const MapType& value, const size_t line, const size_t column)     : m_value(std::in_place_type<ValuePtr>, std::make_shared<MapValueHolder>(value)), m_line(line), m_column(column) {}
+        Value::Value(const MapType& value)                                             : m_value(std::in_place_type<ValuePtr>, std::make_shared<MapValueHolder>(value)), m_line(0), m_column(0) {}
 
-        Value::Value(const RangeType& value, const size_t line, const size_t column)   : m_value(new RangeValueHolder(value)), m_line(line), m_column(column) {}
-        Value::Value(const RangeType& value)                                           : m_value(new RangeValueHolder(value)), m_line(0), m_column(0) {}
+        Value::Value(const RangeType& value, const size_t line, const size_t column)   : m_value(std::in_place_type<ValuePtr>, std::make_shared<RangeValueHolder>(value)), m_line(line), m_column(column) {}
+        Value::Value(const RangeType& value)                                           : m_value(std::in_place_type<ValuePtr>, std::make_shared<RangeValueHolder>(value)), m_line(0), m_column(0) {}
 
         Value::Value(const Value& other, const size_t line, const size_t column)       : m_value(other.m_value), m_line(line), m_column(column) {}
 
-        Value::Value()                                                                 : m_value(new NullValueHolder()), m_line(0), m_column(0) {}
+        Value::Value()                                                                 : m_value(std::in_place_type<NullValueHolder>), m_line(0), m_column(0) {}
 
         Value Value::ref(const StringType& value, const size_t line, const size_t column) {
-            return Value(new StringReferenceHolder(value), line, column);
+            return Value(Holder(std::in_place_type<StringReferenceHolder>, value), line, column);
         }
 
         Value Value::ref(const StringType& value) {
@@ -532,7 +576,7 @@ namespace TrenchBroom {
         }
 
         ValueType Value::type() const {
-            return m_value->type();
+            return holder().type();
         }
 
         std::string Value::typeName() const {
@@ -540,7 +584,7 @@ namespace TrenchBroom {
         }
 
         std::string Value::describe() const {
-            return m_value->describe();
+            return holder().describe();
         }
 
         size_t Value::line() const {
@@ -553,31 +597,31 @@ namespace TrenchBroom {
 
 
         const StringType& Value::stringValue() const {
-            return m_value->stringValue();
+            return holder().stringValue();
         }
 
         const BooleanType& Value::booleanValue() const {
-            return m_value->booleanValue();
+            return holder().booleanValue();
         }
 
         const NumberType& Value::numberValue() const {
-            return m_value->numberValue();
+            return holder().numberValue();
         }
 
         IntegerType Value::integerValue() const {
-            return m_value->integerValue();
+            return holder().integerValue();
         }
 
         const ArrayType& Value::arrayValue() const {
-            return m_value->arrayValue();
+            return holder().arrayValue();
         }
 
         const MapType& Value::mapValue() const {
-            return m_value->mapValue();
+            return holder().mapValue();
         }
 
         const RangeType& Value::rangeValue() const {
-            return m_value->rangeValue();
+            return holder().rangeValue();
         }
 
         bool Value::null() const {
@@ -612,19 +656,19 @@ namespace TrenchBroom {
         }
 
         size_t Value::length() const {
-            return m_value->length();
+            return holder().length();
         }
 
         bool Value::convertibleTo(const ValueType toType) const {
             if (type() == toType)
                 return true;
-            return m_value->convertibleTo(toType);
+            return holder().convertibleTo(toType);
         }
 
         Value Value::convertTo(const ValueType toType) const {
             if (type() == toType)
                 return *this;
-            return Value(m_value->convertTo(toType), m_line, m_column);
+            return Value(std::unique_ptr<ValueHolder>(holder().convertTo(toType)), m_line, m_column);
         }
 
         std::string Value::asString(const bool multiline) const {
@@ -634,7 +678,7 @@ namespace TrenchBroom {
         }
 
         void Value::appendToStream(std::ostream& str, const bool multiline, const std::string& indent) const {
-            m_value->appendToStream(str, multiline, indent);
+            holder().appendToStream(str, multiline, indent);
         }
 
         std::ostream& operator<<(std::ostream& stream, const Value& value) {
@@ -26,6 +26,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <variant>
 #include <vector>
 
 namespace TrenchBroom {
@@ -94,7 +95,7 @@ namespace TrenchBroom {
 
         class StringReferenceHolder : public StringHolder {
         private:
-            const StringType& m_value;
+            const StringType* m_value;
         public:
             explicit StringReferenceHolder(const StringType& value);
             ValueHolder* clone() const override;
@@ -191,11 +192,27 @@ namespace TrenchBroom {
         private:
             using IndexList = std::vector<size_t>;
             using ValuePtr = std::shared_ptr<ValueHolder>;
-            ValuePtr m_value;
+            /**
+             * Booleans, numbers, string references, null and undefined are stored inline, so creating and copying them
+             * does not allocate. All other values, including strings, share an immutable holder, so that references to
+             * their contents remain valid for as long as any copy of the value exists.
+             */
+            using Holder = std::variant<
+                NullValueHolder,
+                UndefinedValueHolder,
+                BooleanValueHolder,
+                NumberValueHolder,
+                StringReferenceHolder,
+                ValuePtr>;
+            Holder m_value;
             size_t m_line;
             size_t m_column;
         private:
-            Value(ValueHolder* holder, size_t line, size_t column);
+            Value(Holder holder, size_t line, size_t column);
+            Value(std::unique_ptr<ValueHolder> holder, size_t line, size_t column);
+
+            static Holder makeString(const StringType& value);
+            const ValueHolder& holder() const;
         public:
             Value(const BooleanType& value, size_t line, size_t column);
             explicit Value(const BooleanType& value);
@@ -223,13 +240,13 @@ namespace TrenchBroom {
 
             template <typename T>
             Value(const std::vector<T>& value, size_t line, size_t column) :
-            m_value(std::make_shared<ArrayValueHolder>(makeArray(value))),
+            m_value(std::in_place_type<ValuePtr>, std::make_shared<ArrayValueHolder>(makeArray(value))),
             m_line(line),
             m_column(column){}
 
             template <typename T>
             explicit Value(const std::vector<T>& value) :
-            m_value(std::make_shared<ArrayValueHolder>(makeArray(value))),
+            m_value(std::in_place_type<ValuePtr>, std::make_shared<ArrayValueHolder>(makeArray(value))),
             m_line(0),
             m_column(0) {}
 
@@ -238,13 +255,13 @@ namespace TrenchBroom {
 
             template <typename T, typename C>
             Value(const std::map<std::string, T, C>& value, size_t line, size_t column) :
-            m_value(std::make_shared<MapValueHolder>(makeMap(value))),
+            m_value(std::in_place_type<ValuePtr>, std::make_shared<MapValueHolder>(makeMap(value))),
             m_line(line),
             m_column(column) {}
 
             template <typename T, typename C>
             explicit Value(const std::map<std::string, T, C>& value) :
-            m_value(std::make_shared<MapValueHolder>(makeMap(value))),
+            m_value(std::in_place_type<ValuePtr>, std::make_shared<MapValueHolder>(makeMap(value))),
             m_line(0),
             m_column(0) {}
 
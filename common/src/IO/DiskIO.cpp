@@ -29,6 +29,7 @@
 #include <fstream>
 #include <string>
 
+#include <QDateTime>
 #include <QDir>
 #include <QFileInfo>
 
@@ -116,6 +117,15 @@ namespace TrenchBroom {
                 return fileInfo.exists() && fileInfo.isFile();
             }
 
+            std::int64_t modificationTime(const Path& path) {
+                const Path fixedPath = fixPath(path);
+                QFileInfo fileInfo = QFileInfo(pathAsQString(fixedPath));
+                if (!fileInfo.exists()) {
+                    throw FileSystemException("File does not exist: '" + fixedPath.asString() + "'");
+                }
+                return static_cast<std::int64_t>(fileInfo.lastModified().toMSecsSinceEpoch());
+            }
+
             std::vector<Path> getDirectoryContents(const Path& path) {
                 const Path fixedPath = fixPath(path);
                 QDir dir(pathAsQString(fixedPath));
@@ -138,7 +148,7 @@ namespace TrenchBroom {
                     throw FileNotFoundException(fixedPath.asString());
                 }
 
-                return std::make_shared<CFile>(fixedPath);
+                return std::make_shared<MappedFile>(fixedPath);
             }
 
             std::string readFile(const Path& path) {
@@ -22,6 +22,7 @@
 
 #include "IO/Path.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -37,6 +38,13 @@ namespace TrenchBroom {
             bool directoryExists(const Path& path);
             bool fileExists(const Path& path);
 
+            /**
+             * Returns the time at which the file at the given path was last modified, in milliseconds since the epoch.
+             *
+             * @throw FileSystemException if the file does not exist
+             */
+            std::int64_t modificationTime(const Path& path);
+
             std::vector<Path> getDirectoryContents(const Path& path);
             std::shared_ptr<File> openFile(const Path& path);
             std::string readFile(const Path& path);
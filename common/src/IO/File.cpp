@@ -22,6 +22,21 @@
 #include "Exceptions.h"
 #include "IO/IOUtils.h"
 
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 namespace TrenchBroom {
     namespace IO {
         File::File(const Path& path) :
@@ -39,7 +54,7 @@ namespace TrenchBroom {
         m_size(size) {}
 
         Reader OwningBufferFile::reader() const {
-            return Reader::from(m_buffer.get(), m_buffer.get() + m_size);
+            return Reader::from(m_buffer.get(), m_buffer.get() + m_size, m_buffer);
         }
 
         size_t OwningBufferFile::size() const {
@@ -90,6 +105,201 @@ namespace TrenchBroom {
             return m_file;
         }
 
+        /**
+         * Maps a file into memory and unmaps and closes it when destroyed.
+         */
+        class MappedFile::Mapping {
+        private:
+            Path m_path;
+            const char* m_begin;
+            const char* m_end;
+#ifdef _WIN32
+            void* m_fileHandle;
+            void* m_mappingHandle;
+            FILETIME m_modificationTime;
+#else
+            int m_fileDescriptor;
+            time_t m_modificationTime;
+#endif
+        public:
+            explicit Mapping(const Path& path);
+            ~Mapping();
+
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            const char* begin() const {
+                return m_begin;
+            }
+
+            const char* end() const {
+                return m_end;
+            }
+
+            /**
+             * Checks that the size and modification time of the file still match those it had when it was mapped.
+             *
+             * @throw FileSystemException if the file has been changed or its attributes cannot be read
+             */
+            void ensureUnchanged() const;
+        private:
+            void close();
+        };
+
+#ifdef _WIN32
+        MappedFile::Mapping::Mapping(const Path& path) :
+        m_path(path),
+        m_begin(nullptr),
+        m_end(nullptr),
+        m_fileHandle(INVALID_HANDLE_VALUE),
+        m_mappingHandle(nullptr),
+        m_modificationTime{} {
+            // allow other programs to keep writing, renaming and deleting the file while we have it open
+            m_fileHandle = CreateFileA(path.asString().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (m_fileHandle == INVALID_HANDLE_VALUE) {
+                throw FileSystemException("Cannot open file " + path.asString());
+            }
+
+            LARGE_INTEGER fileSize;
+            if (!GetFileSizeEx(m_fileHandle, &fileSize)) {
+                close();
+                throw FileSystemException("Cannot get size of file " + path.asString());
+            }
+            if (!GetFileTime(m_fileHandle, nullptr, nullptr, &m_modificationTime)) {
+                close();
+                throw FileSystemException("Cannot get modification time of file " + path.asString());
+            }
+
+            // empty files cannot be mapped
+            if (fileSize.QuadPart > 0) {
+                m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (m_mappingHandle == nullptr) {
+                    close();
+                    throw FileSystemException("Cannot map file " + path.asString());
+                }
+
+                const void* address = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+                if (address == nullptr) {
+                    close();
+                    throw FileSystemException("Cannot map file " + path.asString());
+                }
+
+                m_begin = static_cast<const char*>(address);
+                m_end = m_begin + static_cast<size_t>(fileSize.QuadPart);
+            }
+        }
+
+        void MappedFile::Mapping::ensureUnchanged() const {
+            LARGE_INTEGER fileSize;
+            FILETIME modificationTime;
+            if (!GetFileSizeEx(m_fileHandle, &fileSize) || !GetFileTime(m_fileHandle, nullptr, nullptr, &modificationTime)) {
+                throw FileSystemException("Cannot get attributes of file " + m_path.asString());
+            }
+            if (static_cast<size_t>(fileSize.QuadPart) != static_cast<size_t>(m_end - m_begin) || CompareFileTime(&modificationTime, &m_modificationTime) != 0) {
+                throw FileSystemException("File was changed while it was open: " + m_path.asString());
+            }
+        }
+
+        void MappedFile::Mapping::close() {
+            if (m_begin != nullptr) {
+                UnmapViewOfFile(m_begin);
+                m_begin = m_end = nullptr;
+            }
+            if (m_mappingHandle != nullptr) {
+                CloseHandle(m_mappingHandle);
+                m_mappingHandle = nullptr;
+            }
+            if (m_fileHandle != INVALID_HANDLE_VALUE) {
+                CloseHandle(m_fileHandle);
+                m_fileHandle = INVALID_HANDLE_VALUE;
+            }
+        }
+#else
+        MappedFile::Mapping::Mapping(const Path& path) :
+        m_path(path),
+        m_begin(nullptr),
+        m_end(nullptr),
+        m_fileDescriptor(-1),
+        m_modificationTime(0) {
+            m_fileDescriptor = ::open(path.asString().c_str(), O_RDONLY);
+            if (m_fileDescriptor < 0) {
+                throw FileSystemException("Cannot open file " + path.asString());
+            }
+
+            struct stat fileStat;
+            if (::fstat(m_fileDescriptor, &fileStat) != 0) {
+                close();
+                throw FileSystemException("Cannot get size of file " + path.asString());
+            }
+            m_modificationTime = fileStat.st_mtime;
+
+            // empty files cannot be mapped
+            if (fileStat.st_size > 0) {
+                const auto fileSize = static_cast<size_t>(fileStat.st_size);
+                void* address = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+                if (address == MAP_FAILED) {
+                    close();
+                    throw FileSystemException("Cannot map file " + path.asString());
+                }
+
+                m_begin = static_cast<const char*>(address);
+                m_end = m_begin + fileSize;
+            }
+        }
+
+        void MappedFile::Mapping::ensureUnchanged() const {
+            struct stat fileStat;
+            if (::fstat(m_fileDescriptor, &fileStat) != 0) {
+                throw FileSystemException("Cannot get attributes of file " + m_path.asString());
+            }
+            if (static_cast<size_t>(fileStat.st_size) != static_cast<size_t>(m_end - m_begin) || fileStat.st_mtime != m_modificationTime) {
+                throw FileSystemException("File was changed while it was open: " + m_path.asString());
+            }
+        }
+
+        void MappedFile::Mapping::close() {
+            if (m_begin != nullptr) {
+                ::munmap(const_cast<char*>(m_begin), static_cast<size_t>(m_end - m_begin));
+                m_begin = m_end = nullptr;
+            }
+            if (m_fileDescriptor >= 0) {
+                ::close(m_fileDescriptor);
+                m_fileDescriptor = -1;
+            }
+        }
+#endif
+
+        MappedFile::Mapping::~Mapping() {
+            close();
+        }
+
+        MappedFile::MappedFile(const Path& path) :
+        File(path),
+        m_mapping(std::make_shared<const Mapping>(path)) {}
+
+        MappedFile::~MappedFile() = default;
+
+        Reader MappedFile::reader() const {
+            ensureUnchanged();
+            return Reader::from(m_mapping->begin(), m_mapping->end(), m_mapping);
+        }
+
+        size_t MappedFile::size() const {
+            return static_cast<size_t>(m_mapping->end() - m_mapping->begin());
+        }
+
+        const char* MappedFile::begin() const {
+            return m_mapping->begin();
+        }
+
+        const char* MappedFile::end() const {
+            return m_mapping->end();
+        }
+
+        void MappedFile::ensureUnchanged() const {
+            m_mapping->ensureUnchanged();
+        }
+
         FileView::FileView(const Path& path, std::shared_ptr<File> file, const size_t offset, const size_t length) :
         File(path),
         m_file(std::move(file)),
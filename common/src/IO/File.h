@@ -63,11 +63,12 @@ namespace TrenchBroom {
         };
 
         /**
-         * A file that is backed by a memory buffer. The file takes ownership of the buffer.
+         * A file that is backed by a memory buffer. The file takes ownership of the buffer and shares it with the
+         * readers it returns, so that the readers remain valid after the file is destroyed.
          */
         class OwningBufferFile : public File {
         private:
-            std::unique_ptr<char[]> m_buffer;
+            std::shared_ptr<char[]> m_buffer;
             size_t m_size;
         public:
             /**
@@ -134,6 +135,54 @@ namespace TrenchBroom {
             std::FILE* file() const;
         };
 
+        /**
+         * A file that is backed by a physical file on the disk which is mapped into memory. The file is opened and mapped
+         * in the constructor and unmapped and closed in the destructor.
+         *
+         * The reader returned by this file reads directly from the mapped memory, so buffering it does not copy the file
+         * contents. The readers share the ownership of the mapping, so the file is only unmapped and closed once this
+         * file and all readers returned by it are destroyed.
+         *
+         * Accessing a mapped page beyond the end of a file that was truncated by another program raises a bus error,
+         * so callers must call ensureUnchanged() before they access the mapped memory directly. reader() does this
+         * itself. The check narrows, but cannot close, the window in which the file can be changed under us.
+         */
+        class MappedFile : public File {
+        private:
+            class Mapping;
+            std::shared_ptr<const Mapping> m_mapping;
+        public:
+            /**
+             * Creates a new file with the given path, opens the file for reading and maps it into memory.
+             *
+             * @param path the path of the file
+             *
+             * @throw FileSystemException if the file cannot be opened or mapped
+             */
+            explicit MappedFile(const Path& path);
+            ~MappedFile() override;
+
+            Reader reader() const override;
+            size_t size() const override;
+
+            /**
+             * Returns the start of the mapped memory region.
+             */
+            const char* begin() const;
+
+            /**
+             * Returns the end of the mapped memory region (position after the last byte).
+             */
+            const char* end() const;
+
+            /**
+             * Checks that the size and modification time of the file still match those it had when it was mapped.
+             *
+             * @throw FileSystemException if the file has been changed or its attributes cannot be read
+             */
+            void ensureUnchanged() const;
+        };
+
         /**
          * A file that is backed by a portion of a physical file.
          */
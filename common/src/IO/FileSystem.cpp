@@ -22,6 +22,7 @@
 #include "Exceptions.h"
 #include "IO/FileMatcher.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <string>
@@ -143,6 +144,50 @@ namespace TrenchBroom {
             }
         }
 
+        std::vector<std::shared_ptr<File>> FileSystem::openFiles(const std::vector<Path>& paths, std::vector<std::string>& errors) const {
+            auto fileSystems = std::vector<const FileSystem*>(paths.size(), nullptr);
+            auto fileErrors = std::vector<std::string>(paths.size());
+
+            for (size_t i = 0u; i < paths.size(); ++i) {
+                const auto& path = paths[i];
+                try {
+                    if (path.isAbsolute()) {
+                        fileErrors[i] = "Path is absolute: '" + path.asString() + "'";
+                    } else if (const auto* fileSystem = _findFileSystem(path)) {
+                        fileSystems[i] = fileSystem;
+                    } else {
+                        fileErrors[i] = "File not found: '" + path.asString() + "'";
+                    }
+                } catch (const PathException&) {
+                    fileErrors[i] = "Invalid path: '" + path.asString() + "'";
+                }
+            }
+
+            auto files = std::vector<std::shared_ptr<File>>(paths.size());
+            kdl::parallel_for(paths.size(), [&](const size_t i) {
+                if (fileSystems[i] != nullptr) {
+                    try {
+                        files[i] = fileSystems[i]->doOpenFile(paths[i]);
+                    } catch (const std::exception& e) {
+                        fileErrors[i] = e.what();
+                    }
+                }
+            });
+
+            auto result = std::vector<std::shared_ptr<File>>();
+            result.reserve(paths.size());
+
+            for (size_t i = 0u; i < paths.size(); ++i) {
+                if (files[i] != nullptr) {
+                    result.push_back(std::move(files[i]));
+                } else {
+                    errors.push_back(std::move(fileErrors[i]));
+                }
+            }
+
+            return result;
+        }
+
         Path FileSystem::_makeAbsolute(const Path& path) const {
             if (doFileExists(path) || doDirectoryExists(path)) {
                 // If the file is present in this file system, make it absolute here.
@@ -185,6 +230,16 @@ namespace TrenchBroom {
             }
         }
 
+        const FileSystem* FileSystem::_findFileSystem(const Path& path) const {
+            if (doFileExists(path)) {
+                return this;
+            } else if (m_next) {
+                return m_next->_findFileSystem(path);
+            } else {
+                return nullptr;
+            }
+        }
+
         bool FileSystem::doCanMakeAbsolute(const Path& /* path */) const {
             return false;
         }
@@ -115,6 +115,20 @@ namespace TrenchBroom {
 
             std::vector<Path> getDirectoryContents(const Path& directoryPath) const;
             std::shared_ptr<File> openFile(const Path& path) const;
+
+            /**
+             * Opens the files at the given paths. The file system containing each file is looked up on the calling
+             * thread, but the files are opened concurrently, so file systems that decompress their files when they
+             * are opened decompress many files at once.
+             *
+             * Files that cannot be opened are skipped, and an error message is added to the given errors for each
+             * of them.
+             *
+             * @param paths the paths of the files to open
+             * @param errors collects the errors for the files that could not be opened
+             * @return the opened files in the order of the given paths
+             */
+            std::vector<std::shared_ptr<File>> openFiles(const std::vector<Path>& paths, std::vector<std::string>& errors) const;
         private: // private API to be used for chaining, avoids multiple checks of parameters
             bool _canMakeAbsolute(const Path& path) const;
             Path _makeAbsolute(const Path& path) const;
@@ -122,6 +136,7 @@ namespace TrenchBroom {
             bool _fileExists(const Path& path) const;
             std::vector<Path> _getDirectoryContents(const Path& directoryPath) const;
             std::shared_ptr<File> _openFile(const Path& path) const;
+            const FileSystem* _findFileSystem(const Path& path) const;
 
             /**
              * Finds all items matching the given matcher at the given search path, optionally recursively. This method
@@ -208,6 +223,9 @@ namespace TrenchBroom {
 
             virtual std::vector<Path> doGetDirectoryContents(const Path& path) const = 0;
 
+            /**
+             * Opens the file at the given path. Must be safe to call concurrently for different paths, see openFiles.
+             */
             virtual std::shared_ptr<File> doOpenFile(const Path& path) const = 0;
         };
 
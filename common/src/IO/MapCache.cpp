@@ -0,0 +1,417 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCache.h"
+
+#include "Color.h"
+#include "Exceptions.h"
+#include "Logger.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/ParserStatus.h"
+#include "IO/Path.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+#include "IO/SimpleParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushFaceAttributes.h"
+#include "Model/EntityAttributes.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace {
+            const char Magic[] = { 'T', 'B', 'M', 'C' };
+            const std::uint32_t Version = 2u;
+
+            enum class Record : unsigned char {
+                BeginEntity,
+                EndEntity,
+                BeginBrush,
+                EndBrush,
+                BrushFace,
+                End
+            };
+
+            /**
+             * Logs messages to a logger and records them in a map cache.
+             */
+            class RecordingParserStatus : public ParserStatus {
+            private:
+                Logger& m_logger;
+                MapCacheWriter& m_cacheWriter;
+            public:
+                RecordingParserStatus(Logger& logger, MapCacheWriter& cacheWriter) :
+                ParserStatus(logger, ""),
+                m_logger(logger),
+                m_cacheWriter(cacheWriter) {}
+            private:
+                void doProgress(const double /* progress */) override {}
+
+                void doLog(const LogLevel level, const std::string& str) override {
+                    m_cacheWriter.message(level, str);
+                    m_logger.log(level, str);
+                }
+            };
+        }
+
+        Path mapCachePath(const Path& mapPath) {
+            return mapPath.addExtension("tbcache");
+        }
+
+        std::uint64_t mapContentHash(const char* begin, const char* end) {
+            // 64 bit FNV-1a
+            std::uint64_t hash = 14695981039346656037ull;
+            for (const char* cur = begin; cur != end; ++cur) {
+                hash ^= static_cast<unsigned char>(*cur);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::unique_ptr<Model::WorldNode> readWorldWithCache(const Path& mapPath, const char* mapBegin, const char* mapEnd, const Model::MapFormat format, const vm::bbox3& worldBounds, Logger& logger) {
+            const auto cachePath = mapCachePath(mapPath);
+
+            try {
+                if (const auto cache = MapCacheReader::open(cachePath, mapBegin, mapEnd, format)) {
+                    // replaying the cache reports the same messages as parsing the map did, except for those of the
+                    // tokenizer, so the recorded messages are logged instead
+                    NullLogger nullLogger;
+                    SimpleParserStatus parserStatus(nullLogger);
+                    WorldReader worldReader(mapBegin, mapEnd);
+                    auto world = worldReader.read(*cache, worldBounds, parserStatus);
+
+                    cache->logMessages(logger);
+                    logger.info() << "Loaded map from cache " << cachePath.asString();
+                    return world;
+                }
+            } catch (const Exception& e) {
+                logger.warn() << "Could not read map cache " << cachePath.asString() << ": " << e.what();
+            }
+
+            MapCacheWriter cacheWriter;
+            RecordingParserStatus parserStatus(logger, cacheWriter);
+            WorldReader worldReader(mapBegin, mapEnd);
+            worldReader.setCacheWriter(&cacheWriter);
+            auto world = worldReader.read(format, worldBounds, parserStatus);
+
+            try {
+                cacheWriter.write(cachePath, mapBegin, mapEnd);
+            } catch (const Exception& e) {
+                logger.warn() << "Could not write map cache " << cachePath.asString() << ": " << e.what();
+            }
+
+            return world;
+        }
+
+        MapCacheWriter::MapCacheWriter() :
+        m_format(Model::MapFormat::Unknown) {}
+
+        void MapCacheWriter::message(const LogLevel level, const std::string& message) {
+            m_messages.emplace_back(level, message);
+        }
+
+        void MapCacheWriter::formatSet(const Model::MapFormat format) {
+            m_format = format;
+        }
+
+        void MapCacheWriter::beginEntity(const size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes) {
+            writeValue(Record::BeginEntity);
+            writeValue<std::uint64_t>(line);
+            writeValue<std::uint64_t>(attributes.size());
+            for (const auto& attribute : attributes) {
+                writeString(attribute.name());
+                writeString(attribute.value());
+            }
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::endEntity(const size_t startLine, const size_t lineCount) {
+            writeValue(Record::EndEntity);
+            writeValue<std::uint64_t>(startLine);
+            writeValue<std::uint64_t>(lineCount);
+        }
+
+        void MapCacheWriter::beginBrush(const size_t line) {
+            writeValue(Record::BeginBrush);
+            writeValue<std::uint64_t>(line);
+        }
+
+        void MapCacheWriter::endBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes) {
+            writeValue(Record::EndBrush);
+            writeValue<std::uint64_t>(startLine);
+            writeValue<std::uint64_t>(lineCount);
+            writeExtraAttributes(extraAttributes);
+        }
+
+        void MapCacheWriter::brushFace(const size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY) {
+            writeValue(Record::BrushFace);
+            writeValue<std::uint64_t>(line);
+            writeVec(point1);
+            writeVec(point2);
+            writeVec(point3);
+
+            writeString(attribs.textureName());
+            writeValue<float>(attribs.xOffset());
+            writeValue<float>(attribs.yOffset());
+            writeValue<float>(attribs.xScale());
+            writeValue<float>(attribs.yScale());
+            writeValue<float>(attribs.rotation());
+            writeValue<std::int32_t>(attribs.surfaceContents());
+            writeValue<std::int32_t>(attribs.surfaceFlags());
+            writeValue<float>(attribs.surfaceValue());
+
+            const auto& color = attribs.color();
+            writeValue<float>(color.r());
+            writeValue<float>(color.g());
+            writeValue<float>(color.b());
+            writeValue<float>(color.a());
+
+            writeVec(texAxisX);
+            writeVec(texAxisY);
+        }
+
+        void MapCacheWriter::write(const Path& path, const char* mapBegin, const char* mapEnd) const {
+            std::ofstream stream(path.asString(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!stream.is_open()) {
+                throw FileSystemException("Cannot open file: " + path.asString());
+            }
+
+            const auto hash = mapContentHash(mapBegin, mapEnd);
+            const auto size = static_cast<std::uint64_t>(mapEnd - mapBegin);
+            const auto format = static_cast<std::int32_t>(m_format);
+            const auto end = Record::End;
+
+            stream.write(Magic, sizeof(Magic));
+            stream.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+            stream.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+            stream.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            stream.write(reinterpret_cast<const char*>(&format), sizeof(format));
+
+            const auto messageCount = static_cast<std::uint64_t>(m_messages.size());
+            stream.write(reinterpret_cast<const char*>(&messageCount), sizeof(messageCount));
+            for (const auto& [level, message] : m_messages) {
+                const auto messageLevel = static_cast<std::int32_t>(level);
+                const auto messageSize = static_cast<std::uint64_t>(message.size());
+                stream.write(reinterpret_cast<const char*>(&messageLevel), sizeof(messageLevel));
+                stream.write(reinterpret_cast<const char*>(&messageSize), sizeof(messageSize));
+                stream.write(message.data(), static_cast<std::streamsize>(message.size()));
+            }
+
+            stream.write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            stream.write(reinterpret_cast<const char*>(&end), sizeof(end));
+
+            if (!stream.good()) {
+                throw FileSystemException("Cannot write file: " + path.asString());
+            }
+        }
+
+        void MapCacheWriter::writeString(const std::string& str) {
+            writeValue<std::uint64_t>(str.size());
+            m_buffer.append(str);
+        }
+
+        void MapCacheWriter::writeVec(const vm::vec3& vec) {
+            writeValue<double>(vec.x());
+            writeValue<double>(vec.y());
+            writeValue<double>(vec.z());
+        }
+
+        void MapCacheWriter::writeExtraAttributes(const ExtraAttributes& extraAttributes) {
+            writeValue<std::uint64_t>(extraAttributes.size());
+            for (const auto& [name, extraAttribute] : extraAttributes) {
+                writeValue<std::int32_t>(extraAttribute.type());
+                writeString(name);
+                writeString(extraAttribute.strValue());
+                writeValue<std::uint64_t>(extraAttribute.line());
+                writeValue<std::uint64_t>(extraAttribute.column());
+            }
+        }
+
+        MapCacheReader::MapCacheReader(std::shared_ptr<File> file, const Model::MapFormat format, std::vector<Message> messages, const size_t recordsOffset) :
+        m_file(std::move(file)),
+        m_format(format),
+        m_messages(std::move(messages)),
+        m_recordsOffset(recordsOffset) {}
+
+        std::unique_ptr<MapCacheReader> MapCacheReader::open(const Path& path, const char* mapBegin, const char* mapEnd, const Model::MapFormat format) {
+            if (!Disk::fileExists(path)) {
+                return nullptr;
+            }
+
+            auto file = Disk::openFile(path);
+            auto reader = file->reader();
+
+            char magic[sizeof(Magic)];
+            reader.read(magic, sizeof(magic));
+            if (std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+                reader.read<std::uint32_t, std::uint32_t>() != Version) {
+                return nullptr;
+            }
+
+            const auto hash = reader.read<std::uint64_t, std::uint64_t>();
+            const auto size = reader.read<std::uint64_t, std::uint64_t>();
+            const auto cachedFormat = static_cast<Model::MapFormat>(reader.readInt<std::int32_t>());
+            if (size != static_cast<std::uint64_t>(mapEnd - mapBegin) ||
+                cachedFormat != format ||
+                hash != mapContentHash(mapBegin, mapEnd)) {
+                return nullptr;
+            }
+
+            auto messages = std::vector<Message>();
+            const auto messageCount = reader.readSize<std::uint64_t>();
+            for (size_t i = 0u; i < messageCount; ++i) {
+                const auto level = static_cast<LogLevel>(reader.readInt<std::int32_t>());
+                messages.emplace_back(level, readString(reader));
+            }
+
+            return std::make_unique<MapCacheReader>(std::move(file), format, std::move(messages), reader.position());
+        }
+
+        void MapCacheReader::replay(MapParser& parser, ParserStatus& status) const {
+            auto reader = m_file->reader();
+            reader.seekFromBegin(m_recordsOffset);
+
+            parser.formatSet(m_format);
+
+            std::vector<Model::EntityAttribute> attributes;
+            while (true) {
+                const auto record = static_cast<Record>(reader.readUnsignedChar<unsigned char>());
+                switch (record) {
+                    case Record::BeginEntity: {
+                        const auto line = reader.readSize<std::uint64_t>();
+                        const auto attributeCount = reader.readSize<std::uint64_t>();
+                        attributes.clear();
+                        // a corrupt count must not make us allocate more than the remaining cache can hold, and
+                        // every attribute takes at least the length prefixes of its name and value
+                        attributes.reserve(std::min(attributeCount, (reader.size() - reader.position()) / (2u * sizeof(std::uint64_t))));
+                        for (size_t i = 0u; i < attributeCount; ++i) {
+                            auto name = readString(reader);
+                            auto value = readString(reader);
+                            attributes.emplace_back(name, value);
+                        }
+                        const auto extraAttributes = readExtraAttributes(reader);
+                        parser.beginEntity(line, attributes, extraAttributes, status);
+                        break;
+                    }
+                    case Record::EndEntity: {
+                        const auto startLine = reader.readSize<std::uint64_t>();
+                        const auto lineCount = reader.readSize<std::uint64_t>();
+                        parser.endEntity(startLine, lineCount, status);
+                        break;
+                    }
+                    case Record::BeginBrush: {
+                        const auto line = reader.readSize<std::uint64_t>();
+                        parser.beginBrush(line, status);
+                        break;
+                    }
+                    case Record::EndBrush: {
+                        const auto startLine = reader.readSize<std::uint64_t>();
+                        const auto lineCount = reader.readSize<std::uint64_t>();
+                        const auto extraAttributes = readExtraAttributes(reader);
+                        parser.endBrush(startLine, lineCount, extraAttributes, status);
+                        break;
+                    }
+                    case Record::BrushFace: {
+                        const auto line = reader.readSize<std::uint64_t>();
+                        const auto point1 = readVec(reader);
+                        const auto point2 = readVec(reader);
+                        const auto point3 = readVec(reader);
+                        const auto attribs = readBrushFaceAttributes(reader);
+                        const auto texAxisX = readVec(reader);
+                        const auto texAxisY = readVec(reader);
+                        parser.brushFace(line, point1, point2, point3, attribs, texAxisX, texAxisY, status);
+                        break;
+                    }
+                    case Record::End:
+                        return;
+                    default:
+                        throw ReaderException("Unknown map cache record type " + std::to_string(static_cast<int>(record)));
+                }
+            }
+        }
+
+        void MapCacheReader::logMessages(Logger& logger) const {
+            for (const auto& [level, message] : m_messages) {
+                logger.log(level, message);
+            }
+        }
+
+        std::string MapCacheReader::readString(Reader& reader) {
+            const auto size = reader.readSize<std::uint64_t>();
+            if (size > reader.size() - reader.position()) {
+                // don't allocate a string for a corrupt length, the caller treats the exception as a cache miss
+                throw ReaderException("String length " + std::to_string(size) + " exceeds the size of the map cache");
+            }
+            std::string result(size, '\0');
+            reader.read(result.data(), size);
+            return result;
+        }
+
+        vm::vec3 MapCacheReader::readVec(Reader& reader) {
+            return reader.readVec<double, 3, FloatType>();
+        }
+
+        MapCacheReader::ExtraAttributes MapCacheReader::readExtraAttributes(Reader& reader) {
+            ExtraAttributes result;
+            const auto count = reader.readSize<std::uint64_t>();
+            for (size_t i = 0u; i < count; ++i) {
+                const auto type = static_cast<MapParser::ExtraAttribute::Type>(reader.readInt<std::int32_t>());
+                auto name = readString(reader);
+                auto value = readString(reader);
+                const auto line = reader.readSize<std::uint64_t>();
+                const auto column = reader.readSize<std::uint64_t>();
+                result.insert(std::make_pair(name, MapParser::ExtraAttribute(type, name, value, line, column)));
+            }
+            return result;
+        }
+
+        Model::BrushFaceAttributes MapCacheReader::readBrushFaceAttributes(Reader& reader) {
+            Model::BrushFaceAttributes attribs(readString(reader));
+
+            const auto xOffset = reader.readFloat<float>();
+            const auto yOffset = reader.readFloat<float>();
+            attribs.setOffset(vm::vec2f(xOffset, yOffset));
+
+            const auto xScale = reader.readFloat<float>();
+            const auto yScale = reader.readFloat<float>();
+            attribs.setScale(vm::vec2f(xScale, yScale));
+
+            attribs.setRotation(reader.readFloat<float>());
+            attribs.setSurfaceContents(reader.readInt<std::int32_t>());
+            attribs.setSurfaceFlags(reader.readInt<std::int32_t>());
+            attribs.setSurfaceValue(reader.readFloat<float>());
+
+            const auto r = reader.readFloat<float>();
+            const auto g = reader.readFloat<float>();
+            const auto b = reader.readFloat<float>();
+            const auto a = reader.readFloat<float>();
+            attribs.setColor(Color(r, g, b, a));
+
+            return attribs;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_MapCache
+#define TrenchBroom_MapCache
+
+#include "FloatType.h"
+#include "IO/MapParser.h"
+#include "Model/MapFormat.h"
+
+#include <vecmath/forward.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TrenchBroom {
+    class Logger;
+    enum class LogLevel;
+
+    namespace Model {
+        class BrushFaceAttributes;
+        class EntityAttribute;
+        class WorldNode;
+    }
+
+    namespace IO {
+        class File;
+        class ParserStatus;
+        class Path;
+        class Reader;
+
+        /**
+         * Returns the path of the cache file which belongs to the map file at the given path. The cache file is stored
+         * next to the map file.
+         */
+        Path mapCachePath(const Path& mapPath);
+
+        /**
+         * Computes the hash of the given map file contents which is used to decide whether a cache file is up to date.
+         */
+        std::uint64_t mapContentHash(const char* begin, const char* end);
+
+        /**
+         * Reads a world from the given map file contents using the cache file which belongs to the map file at the
+         * given path.
+         *
+         * If the cache file matches the given contents and format, it is replayed instead of parsing the map, and the
+         * messages that were logged when the map was parsed are logged again. Otherwise, the map is parsed and the cache
+         * file is rewritten. A cache file that cannot be read or written is reported and ignored.
+         *
+         * @throw ParserException if the map cannot be parsed
+         */
+        std::unique_ptr<Model::WorldNode> readWorldWithCache(const Path& mapPath, const char* mapBegin, const char* mapEnd, Model::MapFormat format, const vm::bbox3& worldBounds, Logger& logger);
+
+        /**
+         * Records the entities, brushes and brush faces reported by a map parser and writes them to a binary cache
+         * file. The cache stores the parsed values, so reading it does not require tokenizing the map file again.
+         *
+         * The map file remains the source of truth: the cache is keyed by the hash and size of the map file contents
+         * and is ignored by MapCacheReader if these don't match.
+         */
+        class MapCacheWriter {
+        private:
+            using ExtraAttributes = MapParser::ExtraAttributes;
+            using Message = std::pair<LogLevel, std::string>;
+
+            Model::MapFormat m_format;
+            std::string m_buffer;
+            std::vector<Message> m_messages;
+        public:
+            MapCacheWriter();
+
+            /**
+             * Records a message that was logged while reading the map, to be logged again when the cache is replayed.
+             */
+            void message(LogLevel level, const std::string& message);
+
+            void formatSet(Model::MapFormat format);
+            void beginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes);
+            void endEntity(size_t startLine, size_t lineCount);
+            void beginBrush(size_t line);
+            void endBrush(size_t startLine, size_t lineCount, const ExtraAttributes& extraAttributes);
+            void brushFace(size_t line, const vm::vec3& point1, const vm::vec3& point2, const vm::vec3& point3, const Model::BrushFaceAttributes& attribs, const vm::vec3& texAxisX, const vm::vec3& texAxisY);
+
+            /**
+             * Writes the recorded map to a cache file at the given path, keyed by the given map file contents.
+             *
+             * @param path the path of the cache file
+             * @param mapBegin the beginning of the contents of the map file that was parsed
+             * @param mapEnd the end of the contents of the map file that was parsed
+             *
+             * @throw FileSystemException if the cache file cannot be written
+             */
+            void write(const Path& path, const char* mapBegin, const char* mapEnd) const;
+        private:
+            template <typename T>
+            void writeValue(const T value) {
+                m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void writeString(const std::string& str);
+            void writeVec(const vm::vec3& vec);
+            void writeExtraAttributes(const ExtraAttributes& extraAttributes);
+        };
+
+        /**
+         * Reads a cache file written by MapCacheWriter and passes its contents to a map parser's callbacks in the same
+         * order and with the same values as the parser which recorded them.
+         *
+         * The cache file is memory mapped and read in place.
+         */
+        class MapCacheReader {
+        private:
+            using ExtraAttributes = MapParser::ExtraAttributes;
+            using Message = std::pair<LogLevel, std::string>;
+
+            std::shared_ptr<File> m_file;
+            Model::MapFormat m_format;
+            std::vector<Message> m_messages;
+            size_t m_recordsOffset;
+        public:
+            MapCacheReader(std::shared_ptr<File> file, Model::MapFormat format, std::vector<Message> messages, size_t recordsOffset);
+
+            /**
+             * Opens the cache file at the given path if it exists and if it was recorded from a map file with the
+             * given contents and format.
+             *
+             * @return the cache reader or null if there is no matching cache file
+             *
+             * @throw FileSystemException if the cache file cannot be opened
+             * @throw ReaderException if the header of the cache file is malformed
+             */
+            static std::unique_ptr<MapCacheReader> open(const Path& path, const char* mapBegin, const char* mapEnd, Model::MapFormat format);
+
+            /**
+             * Replays the recorded map to the given parser, starting with the format.
+             *
+             * @throw ReaderException if the cache file is truncated or malformed
+             */
+            void replay(MapParser& parser, ParserStatus& status) const;
+
+            /**
+             * Logs the messages that were recorded along with the map to the given logger, in their original order.
+             */
+            void logMessages(Logger& logger) const;
+        private:
+            static std::string readString(Reader& reader);
+            static vm::vec3 readVec(Reader& reader);
+            static ExtraAttributes readExtraAttributes(Reader& reader);
+            static Model::BrushFaceAttributes readBrushFaceAttributes(Reader& reader);
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_MapCache) */
@@ -22,124 +22,164 @@
 #include "Ensure.h"
 #include "Exceptions.h"
 #include "Macros.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityAttributes.h"
 
+#include <kdl/parallel.h>
+
+#include <cmath>
+#include <cstdio>
 #include <memory>
-#include <sstream>
+#include <string>
 
 namespace TrenchBroom {
     namespace IO {
+        /**
+         * Appends the given value to the given string exactly as printf would format it with "%.<precision>g".
+         *
+         * Most coordinates in map files are integers, and these are formatted directly. If the integer has at most
+         * `precision` digits, printf chooses the fixed notation and removes the trailing zeros and the decimal point,
+         * so only the digits remain. All other values are formatted by snprintf.
+         */
+        static void appendFloat(std::string& str, const double value, const int precision) {
+            static const double Limits[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17 };
+            assert(precision > 0 && precision <= 17);
+
+            if (value == std::trunc(value) && std::abs(value) < Limits[precision]) {
+                if (value == 0.0) {
+                    str.append(std::signbit(value) ? "-0" : "0");
+                    return;
+                }
+
+                char digits[20];
+                auto* end = digits + sizeof(digits);
+                auto* cur = end;
+
+                auto integer = static_cast<long long>(std::abs(value));
+                while (integer > 0) {
+                    *--cur = static_cast<char>('0' + integer % 10);
+                    integer /= 10;
+                }
+                if (value < 0.0) {
+                    str.push_back('-');
+                }
+                str.append(cur, end);
+            } else {
+                char buffer[32];
+                const auto length = std::snprintf(buffer, sizeof(buffer), "%.*g", precision, value);
+                str.append(buffer, static_cast<size_t>(length));
+            }
+        }
+
+        /**
+         * Appends the given integer to the given string exactly as printf would format it with "%d" or "%u".
+         */
+        template <typename T>
+        static void appendInt(std::string& str, const T value) {
+            str.append(std::to_string(value));
+        }
+
         class QuakeFileSerializer : public MapFileSerializer {
-        private:
-            std::string FacePointFormat;
-            std::string TextureInfoFormat;
-            std::string ValveTextureInfoFormat;
         public:
             explicit QuakeFileSerializer(FILE* stream) :
-            MapFileSerializer(stream),
-            FacePointFormat(getFacePointFormat()),
-            TextureInfoFormat(" %s %.6g %.6g %.6g %.6g %.6g"),
-            ValveTextureInfoFormat(" %s [ %.6g %.6g %.6g %.6g ] [ %.6g %.6g %.6g %.6g ] %.6g %.6g %.6g") {}
+            MapFileSerializer(stream) {}
         private:
-            static std::string getFacePointFormat() {
-                std::stringstream str;
-                str <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g ) " <<
-                "( %." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g " <<
-                "%." << FloatPrecision << "g )";
-                return str.str();
-            }
-        private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
+                str.push_back('\n');
                 return 1;
             }
         protected:
-            void writeFacePoints(FILE* stream, const Model::BrushFace& face) {
+            void writeFacePoints(std::string& str, const Model::BrushFace& face) const {
                 const Model::BrushFace::Points& points = face.points();
 
-                std::fprintf(stream, FacePointFormat.c_str(),
-                             points[0].x(),
-                             points[0].y(),
-                             points[0].z(),
-                             points[1].x(),
-                             points[1].y(),
-                             points[1].z(),
-                             points[2].x(),
-                             points[2].y(),
-                             points[2].z());
+                for (size_t i = 0u; i < 3u; ++i) {
+                    str.append(i == 0u ? "( " : " ( ");
+                    appendFloat(str, points[i].x(), FloatPrecision);
+                    str.push_back(' ');
+                    appendFloat(str, points[i].y(), FloatPrecision);
+                    str.push_back(' ');
+                    appendFloat(str, points[i].z(), FloatPrecision);
+                    str.append(" )");
+                }
             }
 
-            void writeTextureInfo(FILE* stream, const Model::BrushFace& face) {
+            void writeTextureInfo(std::string& str, const Model::BrushFace& face) const {
                 const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
-                std::fprintf(stream, TextureInfoFormat.c_str(),
-                             textureName.c_str(),
-                             static_cast<double>(face.attributes().xOffset()),
-                             static_cast<double>(face.attributes().yOffset()),
-                             static_cast<double>(face.attributes().rotation()),
-                             static_cast<double>(face.attributes().xScale()),
-                             static_cast<double>(face.attributes().yScale()));
+
+                str.push_back(' ');
+                str.append(textureName.c_str());
+                for (const float value : {
+                    face.attributes().xOffset(),
+                    face.attributes().yOffset(),
+                    face.attributes().rotation(),
+                    face.attributes().xScale(),
+                    face.attributes().yScale() }) {
+                    str.push_back(' ');
+                    appendFloat(str, static_cast<double>(value), 6);
+                }
             }
 
-            void writeValveTextureInfo(FILE* stream, const Model::BrushFace& face) {
+            void writeValveTextureInfo(std::string& str, const Model::BrushFace& face) const {
                 const std::string& textureName = face.attributes().textureName().empty() ? Model::BrushFaceAttributes::NoTextureName : face.attributes().textureName();
                 const vm::vec3 xAxis = face.textureXAxis();
                 const vm::vec3 yAxis = face.textureYAxis();
 
-                std::fprintf(stream, ValveTextureInfoFormat.c_str(),
-                             textureName.c_str(),
-
-                             xAxis.x(),
-                             xAxis.y(),
-                             xAxis.z(),
-                             static_cast<double>(face.attributes().xOffset()),
+                str.push_back(' ');
+                str.append(textureName.c_str());
 
-                             yAxis.x(),
-                             yAxis.y(),
-                             yAxis.z(),
-                             static_cast<double>(face.attributes().yOffset()),
+                writeValveTextureAxis(str, xAxis, face.attributes().xOffset());
+                writeValveTextureAxis(str, yAxis, face.attributes().yOffset());
 
-                             static_cast<double>(face.attributes().rotation()),
-                             static_cast<double>(face.attributes().xScale()),
-                             static_cast<double>(face.attributes().yScale()));
+                for (const float value : {
+                    face.attributes().rotation(),
+                    face.attributes().xScale(),
+                    face.attributes().yScale() }) {
+                    str.push_back(' ');
+                    appendFloat(str, static_cast<double>(value), 6);
+                }
+            }
+        private:
+            static void writeValveTextureAxis(std::string& str, const vm::vec3& axis, const float offset) {
+                str.append(" [ ");
+                appendFloat(str, axis.x(), 6);
+                str.push_back(' ');
+                appendFloat(str, axis.y(), 6);
+                str.push_back(' ');
+                appendFloat(str, axis.z(), 6);
+                str.push_back(' ');
+                appendFloat(str, static_cast<double>(offset), 6);
+                str.append(" ]");
             }
         };
 
         class Quake2FileSerializer : public QuakeFileSerializer {
-        private:
-            std::string SurfaceAttributesFormat;
         public:
             explicit Quake2FileSerializer(FILE* stream) :
-            QuakeFileSerializer(stream),
-            SurfaceAttributesFormat(" %d %d %.6g") {}
+            QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
 
                 // Neverball's "mapc" doesn't like it if surface attributes aren't present.
                 // This suggests the Radiants always output these, so it's probably a compatibility danger.
-                writeSurfaceAttributes(stream, face);
+                writeSurfaceAttributes(str, face);
 
-                std::fprintf(stream, "\n");
+                str.push_back('\n');
                 return 1;
             }
         protected:
-            void writeSurfaceAttributes(FILE* stream, const Model::BrushFace& face) {
-                std::fprintf(stream, SurfaceAttributesFormat.c_str(),
-                             face.attributes().surfaceContents(),
-                             face.attributes().surfaceFlags(),
-                             static_cast<double>(face.attributes().surfaceValue()));
+            void writeSurfaceAttributes(std::string& str, const Model::BrushFace& face) const {
+                str.push_back(' ');
+                appendInt(str, face.attributes().surfaceContents());
+                str.push_back(' ');
+                appendInt(str, face.attributes().surfaceFlags());
+                str.push_back(' ');
+                appendFloat(str, static_cast<double>(face.attributes().surfaceValue()), 6);
             }
         };
 
@@ -148,44 +188,43 @@ namespace TrenchBroom {
             explicit Quake2ValveFileSerializer(FILE* stream) :
             Quake2FileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                writeSurfaceAttributes(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeValveTextureInfo(str, face);
+                writeSurfaceAttributes(str, face);
 
-                std::fprintf(stream, "\n");
+                str.push_back('\n');
                 return 1;
             }
         };
 
         class DaikatanaFileSerializer : public Quake2FileSerializer {
-        private:
-            std::string SurfaceColorFormat;
         public:
             explicit DaikatanaFileSerializer(FILE* stream) :
-            Quake2FileSerializer(stream),
-            SurfaceColorFormat(" %d %d %d") {}
+            Quake2FileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
 
                 if (face.attributes().hasSurfaceAttributes() || face.attributes().hasColor()) {
-                    writeSurfaceAttributes(stream, face);
+                    writeSurfaceAttributes(str, face);
                 }
                 if (face.attributes().hasColor()) {
-                    writeSurfaceColor(stream, face);
+                    writeSurfaceColor(str, face);
                 }
 
-                std::fprintf(stream, "\n");
+                str.push_back('\n');
                 return 1;
             }
         protected:
-            void writeSurfaceColor(FILE* stream, const Model::BrushFace& face) {
-                std::fprintf(stream, SurfaceColorFormat.c_str(),
-                             static_cast<int>(face.attributes().color().r()),
-                             static_cast<int>(face.attributes().color().g()),
-                             static_cast<int>(face.attributes().color().b()));
+            void writeSurfaceColor(std::string& str, const Model::BrushFace& face) const {
+                str.push_back(' ');
+                appendInt(str, static_cast<int>(face.attributes().color().r()));
+                str.push_back(' ');
+                appendInt(str, static_cast<int>(face.attributes().color().g()));
+                str.push_back(' ');
+                appendInt(str, static_cast<int>(face.attributes().color().b()));
             }
         };
 
@@ -194,10 +233,10 @@ namespace TrenchBroom {
             explicit Hexen2FileSerializer(FILE* stream):
             QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeTextureInfo(stream, face);
-                std::fprintf(stream, " 0\n"); // extra value written here
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeTextureInfo(str, face);
+                str.append(" 0\n"); // extra value written here
                 return 1;
             }
         };
@@ -207,10 +246,10 @@ namespace TrenchBroom {
             explicit ValveFileSerializer(FILE* stream) :
             QuakeFileSerializer(stream) {}
         private:
-            size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) override {
-                writeFacePoints(stream, face);
-                writeValveTextureInfo(stream, face);
-                std::fprintf(stream, "\n");
+            size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const override {
+                writeFacePoints(str, face);
+                writeValveTextureInfo(str, face);
+                str.push_back('\n');
                 return 1;
             }
         };
@@ -239,56 +278,143 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * The amount of formatted output that is collected before it is written to the file.
+         */
+        static constexpr size_t BufferFlushSize = 1024u * 1024u;
+
+        /**
+         * The minimum number of brush faces of an entity before they are formatted on multiple threads.
+         */
+        static constexpr size_t ParallelFormattingMinFaceCount = 1024u;
+
         MapFileSerializer::MapFileSerializer(FILE* stream) :
         m_line(1),
-        m_stream(stream) {
+        m_stream(stream),
+        m_nextPreparedBrush(0u),
+        m_nextPreparedFace(0u) {
             ensure(m_stream != nullptr, "stream is null");
+            m_buffer.reserve(BufferFlushSize);
+        }
+
+        MapFileSerializer::~MapFileSerializer() {
+            flush();
         }
 
         void MapFileSerializer::doBeginFile() {}
-        void MapFileSerializer::doEndFile() {}
+
+        void MapFileSerializer::doEndFile() {
+            flush();
+        }
 
         void MapFileSerializer::doBeginEntity(const Model::Node* /* node */) {
-            std::fprintf(m_stream, "// entity %u\n", entityNo());
+            m_buffer.append("// entity ");
+            appendInt(m_buffer, entityNo());
+            m_buffer.push_back('\n');
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            m_buffer.append("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndEntity(const Model::Node* node) {
-            std::fprintf(m_stream, "}\n");
+            m_buffer.append("}\n");
             ++m_line;
             setFilePosition(node);
+            flushIfFull();
         }
 
         void MapFileSerializer::doEntityAttribute(const Model::EntityAttribute& attribute) {
-            std::fprintf(m_stream, "\"%s\" \"%s\"\n",
-                         escapeEntityAttribute( attribute.name()).c_str(),
-                         escapeEntityAttribute(attribute.value()).c_str());
+            m_buffer.push_back('"');
+            m_buffer.append(escapeEntityAttribute( attribute.name()).c_str());
+            m_buffer.append("\" \"");
+            m_buffer.append(escapeEntityAttribute(attribute.value()).c_str());
+            m_buffer.append("\"\n");
             ++m_line;
         }
 
+        void MapFileSerializer::doPrepareBrushes(const std::vector<const Model::BrushNode*>& brushNodes) {
+            m_preparedBrushes.clear();
+            m_nextPreparedBrush = 0u;
+            m_nextPreparedFace = 0u;
+
+            size_t faceCount = 0u;
+            for (const auto* brushNode : brushNodes) {
+                faceCount += brushNode->brush().faceCount();
+            }
+            if (faceCount < ParallelFormattingMinFaceCount) {
+                return;
+            }
+
+            // the faces only depend on themselves, so they can be formatted concurrently; the line numbers are assigned
+            // when the formatted brushes are written in order
+            m_preparedBrushes = kdl::vec_parallel_transform(brushNodes, [&](const Model::BrushNode* brushNode) {
+                PreparedBrush result;
+                for (const auto& face : brushNode->brush().faces()) {
+                    const auto lines = doWriteBrushFace(result.text, face);
+                    result.faces.emplace_back(result.text.size(), lines);
+                }
+                return result;
+            });
+        }
+
         void MapFileSerializer::doBeginBrush(const Model::BrushNode* /* brush */) {
-            std::fprintf(m_stream, "// brush %u\n", brushNo());
+            m_buffer.append("// brush ");
+            appendInt(m_buffer, brushNo());
+            m_buffer.push_back('\n');
             ++m_line;
             m_startLineStack.push_back(m_line);
-            std::fprintf(m_stream, "{\n");
+            m_buffer.append("{\n");
             ++m_line;
         }
 
         void MapFileSerializer::doEndBrush(const Model::BrushNode* brush) {
-            std::fprintf(m_stream, "}\n");
+            m_buffer.append("}\n");
             ++m_line;
             setFilePosition(brush);
+
+            if (m_nextPreparedBrush < m_preparedBrushes.size()) {
+                ++m_nextPreparedBrush;
+                m_nextPreparedFace = 0u;
+                if (m_nextPreparedBrush == m_preparedBrushes.size()) {
+                    m_preparedBrushes.clear();
+                    m_nextPreparedBrush = 0u;
+                }
+            }
+            flushIfFull();
         }
 
         void MapFileSerializer::doBrushFace(const Model::BrushFace& face) {
-            const size_t lines = doWriteBrushFace(m_stream, face);
+            size_t lines;
+            if (m_nextPreparedBrush < m_preparedBrushes.size()) {
+                const auto& preparedBrush = m_preparedBrushes[m_nextPreparedBrush];
+                assert(m_nextPreparedFace < preparedBrush.faces.size());
+
+                const auto start = m_nextPreparedFace > 0u ? std::get<0>(preparedBrush.faces[m_nextPreparedFace - 1u]) : 0u;
+                const auto [end, faceLines] = preparedBrush.faces[m_nextPreparedFace++];
+                m_buffer.append(preparedBrush.text, start, end - start);
+                lines = faceLines;
+            } else {
+                lines = doWriteBrushFace(m_buffer, face);
+            }
+
             face.setFilePosition(m_line, lines);
             m_line += lines;
         }
 
+        void MapFileSerializer::flushIfFull() {
+            if (m_buffer.size() >= BufferFlushSize) {
+                flush();
+            }
+        }
+
+        void MapFileSerializer::flush() {
+            if (!m_buffer.empty()) {
+                std::fwrite(m_buffer.data(), 1u, m_buffer.size(), m_stream);
+                m_buffer.clear();
+            }
+        }
+
         void MapFileSerializer::setFilePosition(const Model::Node* node) {
             const size_t start = startLine();
             node->setFilePosition(start, m_line - start);
@@ -25,6 +25,8 @@
 
 #include <cstdio> // for FILE*
 #include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom {
@@ -42,8 +44,26 @@ namespace TrenchBroom {
             LineStack m_startLineStack;
             size_t m_line;
             FILE* m_stream;
+
+            /**
+             * The formatted output that has not been written to the stream yet.
+             */
+            std::string m_buffer;
+
+            /**
+             * The faces of a brush that were formatted ahead of time, see doPrepareBrushes(). For each face, the offset
+             * of the end of its text and the number of lines it occupies are recorded.
+             */
+            struct PreparedBrush {
+                std::string text;
+                std::vector<std::tuple<size_t, size_t>> faces;
+            };
+            std::vector<PreparedBrush> m_preparedBrushes;
+            size_t m_nextPreparedBrush;
+            size_t m_nextPreparedFace;
         public:
             static std::unique_ptr<NodeSerializer> create(Model::MapFormat format, FILE* stream);
+            ~MapFileSerializer() override;
         protected:
             explicit MapFileSerializer(FILE* file);
         private:
@@ -53,14 +73,22 @@ namespace TrenchBroom {
             void doBeginEntity(const Model::Node* node) override;
             void doEndEntity(const Model::Node* node) override;
             void doEntityAttribute(const Model::EntityAttribute& attribute) override;
+            void doPrepareBrushes(const std::vector<const Model::BrushNode*>& brushNodes) override;
             void doBeginBrush(const Model::BrushNode* brush) override;
             void doEndBrush(const Model::BrushNode* brush) override;
             void doBrushFace(const Model::BrushFace& face) override;
         private:
             void setFilePosition(const Model::Node* node);
             size_t startLine();
+
+            void flushIfFull();
+            void flush();
         private:
-            virtual size_t doWriteBrushFace(FILE* stream, const Model::BrushFace& face) = 0;
+            /**
+             * Appends the given face to the given string and returns the number of lines written. Must be safe to call
+             * from several threads at once.
+             */
+            virtual size_t doWriteBrushFace(std::string& str, const Model::BrushFace& face) const = 0;
         };
     }
 }
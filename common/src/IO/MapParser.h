@@ -37,9 +37,14 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        class MapCacheReader;
+        class MapCacheWriter;
         class ParserStatus;
 
         class MapParser {
+        private:
+            friend class MapCacheReader;
+            friend class MapCacheWriter;
         protected:
             class ExtraAttribute {
             public:
@@ -59,6 +64,8 @@ namespace TrenchBroom {
                 Type type() const;
                 const std::string& name() const;
                 const std::string& strValue() const;
+                size_t line() const;
+                size_t column() const;
 
                 void assertType(Type expected) const;
 
@@ -70,8 +77,17 @@ namespace TrenchBroom {
             };
 
             using ExtraAttributes = std::map<std::string, ExtraAttribute>;
+        private:
+            MapCacheWriter* m_cacheWriter;
         public:
+            MapParser();
             virtual ~MapParser();
+
+            /**
+             * Records all parsed entities and brushes to the given cache writer, which can later be replayed by a
+             * MapCacheReader instead of parsing the map again. Pass null to stop recording.
+             */
+            void setCacheWriter(MapCacheWriter* cacheWriter);
         protected:
             void formatSet(Model::MapFormat format);
             void beginEntity(size_t line, const std::vector<Model::EntityAttribute>& attributes, const ExtraAttributes& extraAttributes, ParserStatus& status);
@@ -19,7 +19,9 @@
 
 #include "MapReader.h"
 
+#include "IO/MapCache.h"
 #include "IO/ParserStatus.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/EntityNode.h"
@@ -29,11 +31,13 @@
 #include "Model/ModelFactory.h"
 
 #include <kdl/map_utils.h>
+#include <kdl/parallel.h>
 #include <kdl/string_format.h>
 #include <kdl/string_utils.h>
 #include <kdl/vector_utils.h>
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -67,23 +71,49 @@ namespace TrenchBroom {
         StandardMapParser(begin, end),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_builtBrushCount(0u) {}
 
         MapReader::MapReader(const std::string& str) :
         StandardMapParser(str),
         m_factory(nullptr),
         m_brushParent(nullptr),
-        m_currentNode(nullptr) {}
+        m_currentNode(nullptr),
+        m_builtBrushCount(0u) {}
 
         void MapReader::readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
-            parseEntities(format, status);
+            try {
+                parseEntities(format, status);
+            } catch (...) {
+                discardNodes();
+                throw;
+            }
+            createNodes(status);
+            resolveNodes(status);
+        }
+
+        void MapReader::readEntities(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            m_worldBounds = worldBounds;
+            try {
+                cache.replay(*this, status);
+            } catch (...) {
+                discardNodes();
+                throw;
+            }
+            createNodes(status);
             resolveNodes(status);
         }
 
         void MapReader::readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             m_worldBounds = worldBounds;
-            parseBrushes(format, status);
+            try {
+                parseBrushes(format, status);
+            } catch (...) {
+                discardNodes();
+                throw;
+            }
+            createNodes(status);
         }
 
         void MapReader::readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
@@ -114,6 +144,8 @@ namespace TrenchBroom {
         }
 
         void MapReader::onEndEntity(const size_t startLine, const size_t lineCount, ParserStatus& status) {
+            buildBrushes(status);
+
             if (m_currentNode != nullptr)
                 setFilePosition(m_currentNode, startLine, lineCount);
             else
@@ -225,19 +257,13 @@ namespace TrenchBroom {
             m_brushParent = entity;
         }
 
-        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& status) {
-            try {
-                Model::BrushNode* brush = m_factory->createBrush(Model::Brush(m_worldBounds, std::move(m_faces)));
-                setFilePosition(brush, startLine, lineCount);
-                setExtraAttributes(brush, extraAttributes);
-
-                onBrush(m_brushParent, brush, status);
-                m_faces.clear();
-            } catch (GeometryException& e) {
-                status.error(startLine, kdl::str_to_string("Skipping brush: ", e.what()));
-                m_faces.clear(); // the faces will have been deleted by the brush's constructor
-            }
-
+        /**
+         * Only records the brush faces here, the brush geometry is built later in createNodes.
+         */
+        void MapReader::createBrush(const size_t startLine, const size_t lineCount, const ExtraAttributes& extraAttributes, ParserStatus& /* status */) {
+            m_nodeInfos.push_back({ m_brushParent, nullptr, m_brushInfos.size() });
+            m_brushInfos.push_back({ std::move(m_faces), startLine, lineCount, extraAttributes });
+            m_faces.clear();
         }
 
         MapReader::ParentInfo::Type MapReader::storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status) {
@@ -249,7 +275,7 @@ namespace TrenchBroom {
                     Model::LayerNode* layer = kdl::map_find_or_default(m_layers, layerId,
                         static_cast<Model::LayerNode*>(nullptr));
                     if (layer != nullptr)
-                        onNode(layer, node, status);
+                        m_nodeInfos.push_back({ layer, node, 0u });
                     else
                         m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::layer(layerId)));
                     return ParentInfo::Type_Layer;
@@ -265,7 +291,7 @@ namespace TrenchBroom {
                         Model::GroupNode* group = kdl::map_find_or_default(m_groups, groupId,
                             static_cast<Model::GroupNode*>(nullptr));
                         if (group != nullptr)
-                            onNode(group, node, status);
+                            m_nodeInfos.push_back({ group, node, 0u });
                         else
                             m_unresolvedNodes.push_back(std::make_pair(node, ParentInfo::group(groupId)));
                         return ParentInfo::Type_Group;
@@ -275,7 +301,7 @@ namespace TrenchBroom {
                 }
             }
 
-            onNode(nullptr, node, status);
+            m_nodeInfos.push_back({ nullptr, node, 0u });
             return ParentInfo::Type_None;
         }
 
@@ -293,6 +319,77 @@ namespace TrenchBroom {
             }
         }
 
+        /**
+         * Builds the geometry of the brushes parsed since the last call in parallel and reports the invalid ones in file
+         * order; called at the end of every entity, so that these errors appear in the same order as the messages of
+         * the parser.
+         */
+        void MapReader::buildBrushes(ParserStatus& status) {
+            const auto& worldBounds = m_worldBounds;
+            const auto first = m_builtBrushCount;
+            const auto count = m_brushInfos.size() - first;
+
+            std::vector<std::string> errors(count);
+            kdl::parallel_for(count, [&](const size_t i) {
+                auto& brushInfo = m_brushInfos[first + i];
+                try {
+                    brushInfo.brush = Model::Brush(worldBounds, std::move(brushInfo.faces));
+                } catch (const GeometryException& e) {
+                    errors[i] = e.what();
+                }
+            });
+
+            for (size_t i = 0u; i < count; ++i) {
+                const auto& brushInfo = m_brushInfos[first + i];
+                if (!brushInfo.brush.has_value()) {
+                    status.error(brushInfo.startLine, kdl::str_to_string("Skipping brush: ", errors[i]));
+                }
+            }
+
+            m_builtBrushCount = m_brushInfos.size();
+        }
+
+        /**
+         * Builds the geometry of the remaining brushes and then passes the parsed nodes and brushes to the subclass in
+         * file order; called after the whole map is parsed.
+         */
+        void MapReader::createNodes(ParserStatus& status) {
+            buildBrushes(status);
+
+            for (const auto& nodeInfo : m_nodeInfos) {
+                if (nodeInfo.node != nullptr) {
+                    onNode(nodeInfo.parent, nodeInfo.node, status);
+                } else {
+                    auto& brushInfo = m_brushInfos[nodeInfo.brushIndex];
+                    if (brushInfo.brush.has_value()) {
+                        Model::BrushNode* brushNode = m_factory->createBrush(std::move(*brushInfo.brush));
+                        setFilePosition(brushNode, brushInfo.startLine, brushInfo.lineCount);
+                        setExtraAttributes(brushNode, brushInfo.extraAttributes);
+
+                        onBrush(nodeInfo.parent, brushNode, status);
+                    }
+                }
+            }
+
+            m_nodeInfos.clear();
+            m_brushInfos.clear();
+            m_builtBrushCount = 0u;
+        }
+
+        /**
+         * Deletes the nodes which have been parsed, but not yet passed to the subclass; called if parsing fails.
+         */
+        void MapReader::discardNodes() {
+            for (const auto& nodeInfo : m_nodeInfos) {
+                delete nodeInfo.node;
+            }
+
+            m_nodeInfos.clear();
+            m_brushInfos.clear();
+            m_builtBrushCount = 0u;
+            m_faces.clear();
+        }
+
         /**
          * Resolves cases when a child is parsed before its parent; called after the whole map is parsed.
          */
@@ -22,6 +22,7 @@
 
 #include "FloatType.h"
 #include "IO/StandardMapParser.h"
+#include "Model/Brush.h"
 #include "Model/BrushFace.h"
 #include "Model/IdType.h"
 
@@ -29,6 +30,7 @@
 #include <vecmath/bbox.h>
 
 #include <map>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -44,6 +46,7 @@ namespace TrenchBroom {
     }
 
     namespace IO {
+        class MapCacheReader;
         class ParserStatus;
 
         class MapReader : public StandardMapParser {
@@ -82,6 +85,28 @@ namespace TrenchBroom {
             using NodeParentPair = std::pair<Model::Node*, ParentInfo>;
             using NodeParentList = std::vector<NodeParentPair>;
 
+            /**
+             * The faces, file position and extra attributes of a parsed brush. Once the geometry has been built, the
+             * faces have been moved into brush, which remains empty if the brush is invalid.
+             */
+            struct BrushInfo {
+                std::vector<Model::BrushFace> faces;
+                size_t startLine;
+                size_t lineCount;
+                ExtraAttributes extraAttributes;
+                std::optional<Model::Brush> brush;
+            };
+
+            /**
+             * A parsed node or brush which is handed to the subclass once the brush geometry has been built. If node is
+             * null, then this refers to the brush info at brushIndex.
+             */
+            struct NodeInfo {
+                Model::Node* parent;
+                Model::Node* node;
+                size_t brushIndex;
+            };
+
             vm::bbox3 m_worldBounds;
             Model::ModelFactory* m_factory;
 
@@ -92,11 +117,16 @@ namespace TrenchBroom {
             LayerMap m_layers;
             GroupMap m_groups;
             NodeParentList m_unresolvedNodes;
+
+            std::vector<BrushInfo> m_brushInfos;
+            size_t m_builtBrushCount;
+            std::vector<NodeInfo> m_nodeInfos;
         protected:
             MapReader(const char* begin, const char* end);
             explicit MapReader(const std::string& str);
 
             void readEntities(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
+            void readEntities(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushes(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
             void readBrushFaces(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
         private: // implement MapParser interface
@@ -115,6 +145,9 @@ namespace TrenchBroom {
             ParentInfo::Type storeNode(Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, ParserStatus& status);
             void stripParentAttributes(Model::AttributableNode* attributable, ParentInfo::Type parentType);
 
+            void buildBrushes(ParserStatus& status);
+            void createNodes(ParserStatus& status);
+            void discardNodes();
             void resolveNodes(ParserStatus& status);
             Model::Node* resolveParent(const ParentInfo& parentInfo) const;
 
@@ -34,17 +34,19 @@
 
 namespace TrenchBroom {
     namespace IO {
-        class NodeSerializer::BrushSerializer : public Model::ConstNodeVisitor {
+        class NodeSerializer::CollectBrushes : public Model::ConstNodeVisitor {
         private:
-            NodeSerializer& m_serializer;
+            std::vector<const Model::BrushNode*> m_brushes;
         public:
-            explicit BrushSerializer(NodeSerializer& serializer) : m_serializer(serializer) {}
-
+            const std::vector<const Model::BrushNode*>& brushes() const {
+                return m_brushes;
+            }
+        private:
             void doVisit(const Model::WorldNode* /* world */) override   {}
             void doVisit(const Model::LayerNode* /* layer */) override   {}
             void doVisit(const Model::GroupNode* /* group */) override   {}
             void doVisit(const Model::EntityNode* /* entity */) override {}
-            void doVisit(const Model::BrushNode* brush) override   { m_serializer.brush(brush); }
+            void doVisit(const Model::BrushNode* brush) override   { m_brushes.push_back(brush); }
         };
 
         const std::string& NodeSerializer::IdManager::getId(const Model::Node* t) const {
@@ -116,15 +118,16 @@ namespace TrenchBroom {
         void NodeSerializer::entity(const Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, const std::vector<Model::EntityAttribute>& parentAttributes, const Model::Node* brushParent) {
             beginEntity(node, attributes, parentAttributes);
 
-            BrushSerializer brushSerializer(*this);
-            brushParent->iterate(brushSerializer);
+            CollectBrushes collectBrushes;
+            brushParent->iterate(collectBrushes);
+            brushes(collectBrushes.brushes());
 
             endEntity(node);
         }
 
         void NodeSerializer::entity(const Model::Node* node, const std::vector<Model::EntityAttribute>& attributes, const std::vector<Model::EntityAttribute>& parentAttributes, const std::vector<Model::BrushNode*>& entityBrushes) {
             beginEntity(node, attributes, parentAttributes);
-            brushes(entityBrushes);
+            brushes(std::vector<const Model::BrushNode*>(std::begin(entityBrushes), std::end(entityBrushes)));
             endEntity(node);
         }
 
@@ -154,8 +157,9 @@ namespace TrenchBroom {
             doEntityAttribute(attribute);
         }
 
-        void NodeSerializer::brushes(const std::vector<Model::BrushNode*>& brushNodes) {
-            for (auto* brush : brushNodes) {
+        void NodeSerializer::brushes(const std::vector<const Model::BrushNode*>& brushNodes) {
+            doPrepareBrushes(brushNodes);
+            for (const auto* brush : brushNodes) {
                 this->brush(brush);
             }
         }
@@ -185,6 +189,8 @@ namespace TrenchBroom {
             doBrushFace(face);
         }
 
+        void NodeSerializer::doPrepareBrushes(const std::vector<const Model::BrushNode*>& /* brushNodes */) {}
+
         class NodeSerializer::GetParentAttributes : public Model::ConstNodeVisitor {
         private:
             const IdManager& m_layerIds;
@@ -40,7 +40,7 @@ namespace TrenchBroom {
     namespace IO {
         class NodeSerializer {
         private:
-            class BrushSerializer;
+            class CollectBrushes;
         protected:
             static const int FloatPrecision = 17;
             using ObjectNo = unsigned int;
@@ -85,7 +85,7 @@ namespace TrenchBroom {
             void entityAttributes(const std::vector<Model::EntityAttribute>& attributes);
             void entityAttribute(const Model::EntityAttribute& attribute);
 
-            void brushes(const std::vector<Model::BrushNode*>& brushNodes);
+            void brushes(const std::vector<const Model::BrushNode*>& brushNodes);
             void brush(const Model::BrushNode* brushNode);
 
             void beginBrush(const Model::BrushNode* brushNode);
@@ -111,6 +111,11 @@ namespace TrenchBroom {
             virtual void doEndEntity(const Model::Node* node) = 0;
             virtual void doEntityAttribute(const Model::EntityAttribute& attribute) = 0;
 
+            /**
+             * Called before the given brushes are written one after another. Subclasses may use this to format the
+             * brushes ahead of time, e.g. on several threads. The default implementation does nothing.
+             */
+            virtual void doPrepareBrushes(const std::vector<const Model::BrushNode*>& brushNodes);
             virtual void doBeginBrush(const Model::BrushNode* brushNode) = 0;
             virtual void doEndBrush(const Model::BrushNode* brushNode) = 0;
             virtual void doBrushFace(const Model::BrushFace& face) = 0;
@@ -54,8 +54,15 @@ namespace TrenchBroom {
 
             if (next().directoryExists(m_shaderSearchPath)) {
                 const auto paths = next().findItems(m_shaderSearchPath, FileExtensionMatcher("shader"));
-                for (const auto& path : paths) {
-                    const auto file = next().openFile(path);
+
+                // the shader files are usually stored in archives, so they are decompressed at once
+                auto errors = std::vector<std::string>();
+                const auto files = next().openFiles(paths, errors);
+                for (const auto& error : errors) {
+                    m_logger.warn() << "Skipping shader file: " << error;
+                }
+
+                for (const auto& file : files) {
                     auto bufferedReader = file->reader().buffer();
 
                     try {
@@ -63,7 +70,7 @@ namespace TrenchBroom {
                         SimpleParserStatus status(m_logger, file->path().asString());
                         kdl::vec_append(result, parser.parse(status));
                     } catch (const ParserException& e) {
-                        m_logger.warn() << "Skipping malformed shader file " << path << ": " << e.what();
+                        m_logger.warn() << "Skipping malformed shader file " << file->path() << ": " << e.what();
                     }
                 }
             }
@@ -27,6 +27,8 @@
 #include "IO/ResourceUtils.h"
 #include "Renderer/GL.h"
 
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -42,12 +44,7 @@ namespace TrenchBroom {
             }
 
             const auto& shader = shaderFile->object();
-            const auto texturePath = findTexturePath(shader);
-            if (texturePath.isEmpty()) {
-                throw AssetException("Could not find texture path for shader '" + shader.shaderPath.asString() + "'");
-            }
-
-            auto* texture = loadTextureImage(shader.shaderPath, texturePath);
+            auto* texture = loadTextureImage(shader);
             texture->setSurfaceParms(shader.surfaceParms);
             texture->setOpaque();
 
@@ -79,14 +76,27 @@ namespace TrenchBroom {
             return texture;
         }
 
-        Assets::Texture* Quake3ShaderTextureReader::loadTextureImage(const Path& shaderPath, const Path& imagePath) const {
-            const auto name = textureName(shaderPath);
-            if (!m_fs.fileExists(imagePath)) {
-                throw AssetException("Image file '" + imagePath.asString() + "' does not exist");
+        Assets::Texture* Quake3ShaderTextureReader::loadTextureImage(const Assets::Quake3Shader& shader) const {
+            Path imagePath;
+            {
+                // only looking up the image must be serialized, the image is opened and decoded without holding the lock
+                std::lock_guard<std::recursive_mutex> lock(fileSystemMutex());
+
+                imagePath = findTexturePath(shader);
+                if (imagePath.isEmpty()) {
+                    throw AssetException("Could not find texture path for shader '" + shader.shaderPath.asString() + "'");
+                }
+                if (!m_fs.fileExists(imagePath)) {
+                    throw AssetException("Image file '" + imagePath.asString() + "' does not exist");
+                }
             }
 
+            // opening a file may decompress it from an archive, which can be done concurrently
+            const auto imageFile = m_fs.openFile(imagePath);
+
+            const auto name = textureName(shader.shaderPath);
             FreeImageTextureReader imageReader(StaticNameStrategy(name), m_fs, m_logger);
-            return imageReader.readTexture(m_fs.openFile(imagePath));
+            return imageReader.readTexture(imageFile);
         }
 
         Path Quake3ShaderTextureReader::findTexturePath(const Assets::Quake3Shader& shader) const {
@@ -51,7 +51,7 @@ namespace TrenchBroom {
             Quake3ShaderTextureReader(const NameStrategy& nameStrategy, const FileSystem& fs, Logger& logger);
         private:
             Assets::Texture* doReadTexture(std::shared_ptr<File> file) const override;
-            Assets::Texture* loadTextureImage(const Path& shaderPath, const Path& imagePath) const;
+            Assets::Texture* loadTextureImage(const Assets::Quake3Shader& shader) const;
             Path findTexturePath(const Assets::Quake3Shader& shader) const;
             Path findTexture(const Path& texturePath) const;
         };
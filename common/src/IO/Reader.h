@@ -100,15 +100,16 @@ namespace TrenchBroom {
                  *
                  * If this reader source is not already buffered in memory, then this method will allocate a buffer to
                  * read the contents of this source into. The returned pointers will point to the begin and end of that
-                 * buffer, and the buffer itself will also be returned.
+                 * buffer, and the buffer itself will also be returned. If this source keeps its memory region alive,
+                 * then the object that owns the memory region is returned instead.
                  *
                  * @return a tuple containing of two pointers, the first of which points to the beginning of a memory
-                 * region and the second of which points to its end, and optionally a pointer to the newly allocated
-                 * memory that holds the data
+                 * region and the second of which points to its end, and optionally a pointer to the object that owns
+                 * the memory region
                  *
                  * @throw ReaderException if reading fails
                  */
-                std::tuple<const char*, const char*, std::unique_ptr<char[]>> buffer() const;
+                std::tuple<const char*, const char*, std::shared_ptr<const void>> buffer() const;
             private:
                 void ensurePosition(size_t position) const;
 
@@ -117,7 +118,7 @@ namespace TrenchBroom {
                 virtual void doRead(char* val, size_t size) = 0;
                 virtual void doSeek(size_t offset) = 0;
                 virtual std::unique_ptr<Source> doGetSubSource(size_t offset, size_t length) const = 0;
-                virtual std::tuple<const char*, const char*, std::unique_ptr<char[]>> doBuffer() const = 0;
+                virtual std::tuple<const char*, const char*, std::shared_ptr<const void>> doBuffer() const = 0;
             };
 
             /**
@@ -146,20 +147,22 @@ namespace TrenchBroom {
                 void doRead(char* val, size_t size) override;
                 void doSeek(size_t position) override;
                 std::unique_ptr<Source> doGetSubSource(size_t position, size_t length) const override;
-                std::tuple<const char*, const char*, std::unique_ptr<char[]>> doBuffer() const override;
+                std::tuple<const char*, const char*, std::shared_ptr<const void>> doBuffer() const override;
             private:
                 [[noreturn]] void throwError(const std::string& msg) const;
             };
         protected:
             /**
              * A reader source that reads from a memory region. Does not take ownership of the memory region and will
-             * not deallocate it.
+             * not deallocate it, but it can share the ownership of the object that owns the memory region to keep it
+             * alive. The sub sources of this source share the ownership, too.
              */
             class BufferSource : public Source {
             private:
                 const char* m_begin;
                 const char* m_end;
                 const char* m_current;
+                std::shared_ptr<const void> m_owner;
             public:
                 /**
                  * Creates a new reader source for the given memory region.
@@ -167,10 +170,11 @@ namespace TrenchBroom {
                  * @param begin the beginning of the memory region
                  * @param end the end of the memory region (as in, the position after the last byte), must not be
                  * before the given beginning
+                 * @param owner the object that owns the memory region, may be null
                  *
                  * @throw ReaderException if the given memory region is invalid
                  */
-                BufferSource(const char* begin, const char* end);
+                BufferSource(const char* begin, const char* end, std::shared_ptr<const void> owner = nullptr);
 
                 /**
                  * Returns the beginning of the underlying memory region.
@@ -187,7 +191,7 @@ namespace TrenchBroom {
                 void doRead(char* val, size_t size) override;
                 void doSeek(size_t position) override;
                 std::unique_ptr<Source> doGetSubSource(size_t position, size_t length) const override;
-                std::tuple<const char*, const char*, std::unique_ptr<char[]>> doBuffer() const override;
+                std::tuple<const char*, const char*, std::shared_ptr<const void>> doBuffer() const override;
             };
         protected:
             std::unique_ptr<Source> m_source;
@@ -221,6 +225,19 @@ namespace TrenchBroom {
              * @throw ReaderException if the reader cannot be created
              */
             static Reader from(const char* begin, const char* end);
+
+            /**
+             * Creates a new reader that reads from the given memory region and keeps the given owner of the memory
+             * region alive for as long as the reader or any reader derived from it exists.
+             *
+             * @param begin the beginning of the memory region
+             * @param end the end of the memory region (the position after the last byte)
+             * @param owner the object that owns the memory region
+             * @return the reader
+             *
+             * @throw ReaderException if the reader cannot be created
+             */
+            static Reader from(const char* begin, const char* end, std::shared_ptr<const void> owner);
         public:
             /**
              * Returns the size of the underlying reader source.
@@ -529,18 +546,16 @@ namespace TrenchBroom {
          * be created when calling the Reader::buffer() method.
          */
         class BufferedReader : public Reader {
-        private:
-            std::unique_ptr<char[]> m_buffer;
         public:
             /**
-             * Creates a new buffered reader for the given memory region. If the given buffer is not nullptr, it will
-             * be moved into this object and it will be destroyed when this object is destroyed.
+             * Creates a new buffered reader for the given memory region. If the given buffer is not nullptr, this
+             * object shares its ownership, so that the memory region stays valid while this object exists.
              *
              * @param begin the beginning of the memory region
              * @param end the end of the memory region (the position after the last byte)
-             * @param buffer the buffer to intern into this object
+             * @param buffer the object that owns the memory region, may be null
              */
-            BufferedReader(const char* begin, const char* end, std::unique_ptr<char[]> buffer);
+            BufferedReader(const char* begin, const char* end, std::shared_ptr<const void> buffer);
 
             /**
              * Returns the beginning of the underlying buffer memory region.
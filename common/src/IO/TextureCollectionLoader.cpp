@@ -20,6 +20,7 @@
 #include "TextureCollectionLoader.h"
 
 #include "Logger.h"
+#include "Assets/Texture.h"
 #include "Assets/TextureCollection.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
@@ -28,6 +29,9 @@
 #include "IO/TextureReader.h"
 #include "IO/WadFileSystem.h"
 
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
 #include <memory>
 #include <vector>
 
@@ -40,15 +44,20 @@ namespace TrenchBroom {
         TextureCollectionLoader::~TextureCollectionLoader() = default;
 
         std::unique_ptr<Assets::TextureCollection> TextureCollectionLoader::loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader) {
-            auto collection = std::make_unique<Assets::TextureCollection>(path);
+            auto files = doFindTextures(path, textureExtensions);
+            kdl::vec_erase_if(files, [&](const auto& file) {
+                return shouldExclude(file->path().lastComponent().deleteExtension().asString());
+            });
 
-            for (const auto& file : doFindTextures(path, textureExtensions)) {
-                const auto name = file->path().lastComponent().deleteExtension().asString();
-                if (shouldExclude(name)) {
-                    continue;
-                }
-                auto* texture = textureReader.readTexture(file);
-                collection->addTexture(texture);
+            // the files are already open, so decoding them does not access the file system unless the texture reader
+            // does so itself, in which case it takes care of synchronization
+            auto textures = kdl::vec_parallel_transform(files, [&](const auto& file) {
+                return std::unique_ptr<Assets::Texture>(textureReader.readTexture(file));
+            });
+
+            auto collection = std::make_unique<Assets::TextureCollection>(path);
+            for (auto& texture : textures) {
+                collection->addTexture(texture.release());
             }
 
             return collection;
@@ -63,6 +72,16 @@ namespace TrenchBroom {
             return false;
         }
 
+        TextureCollectionLoader::FileList TextureCollectionLoader::openFiles(const FileSystem& fs, const std::vector<Path>& paths) {
+            // archives decompress the files concurrently when they are opened together
+            std::vector<std::string> errors;
+            auto result = fs.openFiles(paths, errors);
+            for (const auto& error : errors) {
+                m_logger.warn() << error;
+            }
+            return result;
+        }
+
         FileTextureCollectionLoader::FileTextureCollectionLoader(Logger& logger, const std::vector<IO::Path>& searchPaths, const std::vector<std::string>& exclusions) :
         TextureCollectionLoader(logger, exclusions),
         m_searchPaths(searchPaths) {}
@@ -71,19 +90,7 @@ namespace TrenchBroom {
             const auto wadPath = Disk::resolvePath(m_searchPaths, path);
             WadFileSystem wadFS(wadPath, m_logger);
             const auto texturePaths = wadFS.findItems(Path(""), FileExtensionMatcher(extensions));
-
-            FileList result;
-            result.reserve(texturePaths.size());
-
-            for (const auto& texturePath : texturePaths)  {
-                try {
-                    result.push_back(wadFS.openFile(texturePath));
-                } catch (const std::exception& e) {
-                    m_logger.warn() << e.what();
-                }
-            }
-
-            return result;
+            return openFiles(wadFS, texturePaths);
         }
 
         DirectoryTextureCollectionLoader::DirectoryTextureCollectionLoader(Logger& logger, const FileSystem& gameFS, const std::vector<std::string>& exclusions) :
@@ -92,19 +99,7 @@ namespace TrenchBroom {
 
         TextureCollectionLoader::FileList DirectoryTextureCollectionLoader::doFindTextures(const Path& path, const std::vector<std::string>& extensions) {
             const auto texturePaths = m_gameFS.findItems(path, FileExtensionMatcher(extensions));
-
-            FileList result;
-            result.reserve(texturePaths.size());
-
-            for (const auto& texturePath : texturePaths) {
-                try {
-                    result.push_back(m_gameFS.openFile(texturePath));
-                } catch (const std::exception& e) {
-                    m_logger.warn() << e.what();
-                }
-            }
-
-            return result;
+            return openFiles(m_gameFS, texturePaths);
         }
     }
 }
@@ -50,6 +50,11 @@ namespace TrenchBroom {
             virtual ~TextureCollectionLoader();
         public:
             std::unique_ptr<Assets::TextureCollection> loadTextureCollection(const Path& path, const std::vector<std::string>& textureExtensions, const TextureReader& textureReader);
+        protected:
+            /**
+             * Opens the files at the given paths at once and logs a warning for each file that cannot be opened.
+             */
+            FileList openFiles(const FileSystem& fs, const std::vector<Path>& paths);
         private:
             bool shouldExclude(const std::string& textureName);
             virtual FileList doFindTextures(const Path& path, const std::vector<std::string>& extensions) = 0;
@@ -19,6 +19,7 @@
 
 #include "TextureLoader.h"
 
+#include "DeferredLogger.h"
 #include "Ensure.h"
 #include "Logger.h"
 #include "Assets/Palette.h"
@@ -41,11 +42,16 @@
 namespace TrenchBroom {
     namespace IO {
         TextureLoader::TextureLoader(const FileSystem& gameFS, const std::vector<IO::Path>& fileSearchPaths, const Model::TextureConfig& textureConfig, Logger& logger) :
+        m_logger(logger),
+        m_readerLogger(std::make_unique<DeferredLogger>()),
         m_textureExtensions(getTextureExtensions(textureConfig)),
-        m_textureReader(createTextureReader(gameFS, textureConfig, logger)),
+        m_textureReader(createTextureReader(gameFS, textureConfig, *m_readerLogger)),
         m_textureCollectionLoader(createTextureCollectionLoader(gameFS, fileSearchPaths, textureConfig, logger)) {
             ensure(m_textureReader != nullptr, "textureReader is null");
             ensure(m_textureCollectionLoader != nullptr, "textureCollectionLoader is null");
+
+            // forward the messages from loading the palette
+            m_readerLogger->flush(m_logger);
         }
 
         TextureLoader::~TextureLoader() = default;
@@ -104,7 +110,14 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<Assets::TextureCollection> TextureLoader::loadTextureCollection(const Path& path) {
-            return m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
+            try {
+                auto collection = m_textureCollectionLoader->loadTextureCollection(path, m_textureExtensions, *m_textureReader);
+                m_readerLogger->flush(m_logger);
+                return collection;
+            } catch (...) {
+                m_readerLogger->flush(m_logger);
+                throw;
+            }
         }
 
         void TextureLoader::loadTextures(const std::vector<Path>& paths, Assets::TextureManager& textureManager) {
@@ -27,6 +27,7 @@
 #include <vector>
 
 namespace TrenchBroom {
+    class DeferredLogger;
     class Logger;
 
     namespace Assets {
@@ -47,6 +48,12 @@ namespace TrenchBroom {
 
         class TextureLoader {
         private:
+            Logger& m_logger;
+            /**
+             * The texture reader may be called from worker threads, so it logs to this logger, which is flushed to
+             * m_logger after each texture collection is loaded.
+             */
+            std::unique_ptr<DeferredLogger> m_readerLogger;
             std::vector<std::string> m_textureExtensions;
             std::unique_ptr<TextureReader> m_textureReader;
             std::unique_ptr<TextureCollectionLoader> m_textureCollectionLoader;
@@ -92,6 +92,8 @@ namespace TrenchBroom {
                 return doReadTexture(file);
             } catch (const AssetException& e) {
                 m_logger.error() << "Could not read texture '" << file->path() << "': " << e.what();
+
+                std::lock_guard<std::recursive_mutex> lock(fileSystemMutex());
                 return loadDefaultTexture(m_fs, m_logger, textureName(file->path())).release();
             }
         }
@@ -104,6 +106,11 @@ namespace TrenchBroom {
             return m_nameStrategy->textureName(path.lastComponent().asString(), path);
         }
 
+        std::recursive_mutex& TextureReader::fileSystemMutex() {
+            static std::recursive_mutex mutex;
+            return mutex;
+        }
+
         bool TextureReader::checkTextureDimensions(const size_t width, const size_t height) {
             return width <= 8192 && height <= 8192;
         }
@@ -23,6 +23,7 @@
 #include "Macros.h"
 
 #include <memory>
+#include <mutex>
 #include <string>
 
 namespace TrenchBroom {
@@ -115,6 +116,8 @@ namespace TrenchBroom {
              * Loads a texture from the given file and returns it. If an error occurs while loading the texture,
              * the default texture is returned.
              *
+             * This function may be called concurrently from several threads, see fileSystemMutex().
+             *
              * @param file the file containing the texture
              * @return an Assets::Texture object allocated with new
              */
@@ -132,6 +135,14 @@ namespace TrenchBroom {
              */
             virtual Assets::Texture* doReadTexture(std::shared_ptr<File> file) const = 0;
         protected:
+            /**
+             * Texture readers may decode textures concurrently, but the file systems are not thread safe. Any access
+             * to a file system from within doReadTexture must hold a lock on this mutex, except for opening files,
+             * which file systems support concurrently. The mutex is recursive because loading the default texture may
+             * read another texture.
+             */
+            static std::recursive_mutex& fileSystemMutex();
+
             static bool checkTextureDimensions(size_t width, size_t height);
         public:
             static size_t mipSize(size_t width, size_t height, size_t mipLevel);
@@ -41,6 +41,15 @@ namespace TrenchBroom {
 
         std::unique_ptr<Model::WorldNode> WorldReader::read(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status) {
             readEntities(format, worldBounds, status);
+            return finishWorld(status);
+        }
+
+        std::unique_ptr<Model::WorldNode> WorldReader::read(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status) {
+            readEntities(cache, worldBounds, status);
+            return finishWorld(status);
+        }
+
+        std::unique_ptr<Model::WorldNode> WorldReader::finishWorld(ParserStatus& status) {
             sanitizeLayerSortIndicies(status);
             m_world->rebuildNodeTree();
             m_world->enableNodeTreeUpdates();
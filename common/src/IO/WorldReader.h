@@ -44,7 +44,15 @@ namespace TrenchBroom {
             explicit WorldReader(const std::string& str);
 
             std::unique_ptr<Model::WorldNode> read(Model::MapFormat format, const vm::bbox3& worldBounds, ParserStatus& status);
-        private:            
+
+            /**
+             * Reads the world from the given cache instead of parsing the map file contents.
+             *
+             * @throw ReaderException if the cache is malformed
+             */
+            std::unique_ptr<Model::WorldNode> read(const MapCacheReader& cache, const vm::bbox3& worldBounds, ParserStatus& status);
+        private:
+            std::unique_ptr<Model::WorldNode> finishWorld(ParserStatus& status);            
             void sanitizeLayerSortIndicies(ParserStatus& status);            
         private: // implement MapReader interface
             Model::ModelFactory& initialize(Model::MapFormat format) override;
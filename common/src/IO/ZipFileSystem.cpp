@@ -19,37 +19,58 @@
 
 #include "ZipFileSystem.h"
 
+#include "Exceptions.h"
 #include "IO/File.h"
+#include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
 
+#include <miniz/miniz.h>
+
+#include <cstring>
 #include <memory>
 #include <string>
 
 namespace TrenchBroom {
     namespace IO {
-        // ZipFileSystem::ZipCompressedFile
+        namespace {
+            const std::uint32_t LocalHeaderSignature = 0x04034b50;
+            // encryption, compressed patch data and strong encryption
+            const std::uint16_t UnsupportedFlags = 0x01 | 0x20 | 0x40;
+
+            /**
+             * Helper to get the filename of a file in the zip archive
+             */
+            std::string filename(mz_zip_archive& archive, const mz_uint fileIndex) {
+                // nameLen includes space for the null-terminator byte
+                const mz_uint nameLen = mz_zip_reader_get_filename(&archive, fileIndex, nullptr, 0);
+                if (nameLen == 0) {
+                    return "";
+                }
 
-        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(ZipFileSystem* owner, const mz_uint fileIndex) :
-        m_owner(owner),
-        m_fileIndex(fileIndex) {}
+                std::string result;
+                result.resize(static_cast<size_t>(nameLen - 1));
 
-        std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::doOpen() const {
-            const auto path = Path(m_owner->filename(m_fileIndex));
+                // NOTE: this will overwrite the std::string's null terminator, which is permitted in C++17 and later
+                mz_zip_reader_get_filename(&archive, fileIndex, result.data(), nameLen);
 
-            mz_zip_archive_file_stat stat;
-            if (!mz_zip_reader_file_stat(&m_owner->m_archive, m_fileIndex, &stat)) {
-                throw FileSystemException("mz_zip_reader_file_stat failed for " + path.asString());
+                return result;
             }
+        }
 
-            const auto uncompressedSize = static_cast<size_t>(stat.m_uncomp_size);
-            auto data = std::make_unique<char[]>(uncompressedSize);
-            auto* begin = data.get();
+        // ZipFileSystem::ZipCompressedFile
 
-            if (!mz_zip_reader_extract_to_mem(&m_owner->m_archive, m_fileIndex, begin, uncompressedSize, 0)) {
-                throw FileSystemException("mz_zip_reader_extract_to_mem failed for " + path.asString());
-            }
+        ZipFileSystem::ZipCompressedFile::ZipCompressedFile(const ZipFileSystem* owner, ZipEntry entry) :
+        m_owner(owner),
+        m_entry(std::move(entry)) {}
 
-            return std::make_shared<OwningBufferFile>(path, std::move(data), uncompressedSize);
+        std::shared_ptr<File> ZipFileSystem::ZipCompressedFile::doOpen() const {
+            const auto uncompressedSize = static_cast<size_t>(m_entry.uncompressedSize);
+            auto data = std::make_unique<char[]>(uncompressedSize);
+            m_owner->extract(m_entry, data.get());
+
+            return std::make_shared<OwningBufferFile>(Path(m_entry.name), std::move(data), uncompressedSize);
         }
 
         // ZipFileSystem
@@ -58,52 +79,133 @@ namespace TrenchBroom {
         ZipFileSystem(nullptr, path) {}
 
         ZipFileSystem::ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path) :
-        ImageFileSystem(std::move(next), path) {
+        ZipFileSystem(std::move(next), path, nullptr) {}
+
+        ZipFileSystem::ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path, std::shared_ptr<const ZipIndexCache> indexCache) :
+        ImageFileSystem(std::move(next), path),
+        m_indexCache(std::move(indexCache)) {
             initialize();
         }
 
-        ZipFileSystem::~ZipFileSystem() {
-            mz_zip_reader_end(&m_archive);
+        void ZipFileSystem::doReadDirectory() {
+            for (auto& entry : readEntries()) {
+                const auto path = Path(entry.name);
+                m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, std::move(entry)));
+            }
         }
 
-        void ZipFileSystem::doReadDirectory() {
-            mz_zip_zero_struct(&m_archive);
+        std::vector<ZipEntry> ZipFileSystem::readEntries() const {
+            if (m_indexCache == nullptr) {
+                return readCentralDirectory();
+            }
+
+            const auto archiveSize = static_cast<std::uint64_t>(m_file->size());
+            const auto modificationTime = Disk::modificationTime(m_path);
+            if (auto entries = m_indexCache->load(m_path, archiveSize, modificationTime)) {
+                return std::move(*entries);
+            }
 
-            if (mz_zip_reader_init_cfile(&m_archive, m_file->file(), m_file->size(), 0) != MZ_TRUE) {
-                throw FileSystemException("Error calling mz_zip_reader_init_cfile");
+            auto entries = readCentralDirectory();
+            try {
+                m_indexCache->store(m_path, archiveSize, modificationTime, entries);
+            } catch (const Exception&) {
+                // the cache only speeds up reading the archive the next time, so we can do without it
             }
+            return entries;
+        }
+
+        std::vector<ZipEntry> ZipFileSystem::readCentralDirectory() const {
+            mz_zip_archive archive;
+            mz_zip_zero_struct(&archive);
+
+            m_file->ensureUnchanged();
+            if (mz_zip_reader_init_mem(&archive, m_file->begin(), m_file->size(), 0) != MZ_TRUE) {
+                throw FileSystemException("Error calling mz_zip_reader_init_mem");
+            }
+
+            auto result = std::vector<ZipEntry>();
+
+            const mz_uint numFiles = mz_zip_reader_get_num_files(&archive);
+            result.reserve(numFiles);
 
-            const mz_uint numFiles = mz_zip_reader_get_num_files(&m_archive);
             for (mz_uint i = 0; i < numFiles; ++i) {
-                if (!mz_zip_reader_is_file_a_directory(&m_archive, i)) {
-                    const auto path = Path(filename(i));
-                    m_root.addFile(path, std::make_unique<ZipCompressedFile>(this, i));
+                mz_zip_archive_file_stat stat;
+                if (mz_zip_reader_file_stat(&archive, i, &stat) && !stat.m_is_directory) {
+                    auto entry = ZipEntry();
+                    entry.name = filename(archive, i);
+                    entry.localHeaderOffset = stat.m_local_header_ofs;
+                    entry.compressedSize = stat.m_comp_size;
+                    entry.uncompressedSize = stat.m_uncomp_size;
+                    entry.crc = stat.m_crc32;
+                    entry.method = stat.m_method;
+                    entry.flags = stat.m_bit_flag;
+                    result.push_back(std::move(entry));
                 }
             }
 
-            const auto err = mz_zip_get_last_error(&m_archive);
+            const auto err = mz_zip_get_last_error(&archive);
+            mz_zip_reader_end(&archive);
+
             if (err != MZ_ZIP_NO_ERROR) {
                 throw FileSystemException(std::string("Error while reading compressed file: ") + mz_zip_get_error_string(err));
             }
+
+            return result;
         }
 
         /**
-         * Helper to get the filename of a file in the zip archive
+         * Decompresses the given entry into the given buffer, which must be large enough to hold the uncompressed
+         * file. Only reads from the memory mapped archive, so this can be called concurrently. Fails with a
+         * FileSystemException if the archive was changed on disk since it was opened.
          */
-        std::string ZipFileSystem::filename(const mz_uint fileIndex) {
-            // nameLen includes space for the null-terminator byte
-            const mz_uint nameLen = mz_zip_reader_get_filename(&m_archive, fileIndex, nullptr, 0);
-            if (nameLen == 0) {
-                return "";
+        void ZipFileSystem::extract(const ZipEntry& entry, char* target) const {
+            if ((entry.flags & UnsupportedFlags) != 0) {
+                throw FileSystemException("Cannot extract encrypted file " + entry.name);
+            }
+            if (entry.method != 0 && entry.method != MZ_DEFLATED) {
+                throw FileSystemException("Cannot extract file " + entry.name + ": unsupported compression method");
             }
 
-            std::string result;
-            result.resize(static_cast<size_t>(nameLen - 1));
+            const char* data = nullptr;
+            try {
+                // the local header has a fixed size part followed by the file name and an extra field, whose lengths
+                // may differ from those in the central directory
+                auto reader = m_file->reader();
+                reader.seekFromBegin(static_cast<size_t>(entry.localHeaderOffset));
+                if (reader.readUnsignedInt<std::uint32_t>() != LocalHeaderSignature) {
+                    throw FileSystemException("Invalid local header for file " + entry.name);
+                }
 
-            // NOTE: this will overwrite the std::string's null terminator, which is permitted in C++17 and later
-            mz_zip_reader_get_filename(&m_archive, fileIndex, result.data(), nameLen);
+                reader.seekForward(22);
+                const auto nameLength = reader.readSize<std::uint16_t>();
+                const auto extraLength = reader.readSize<std::uint16_t>();
+                reader.seekForward(nameLength + extraLength);
 
-            return result;
+                if (entry.compressedSize > reader.size() - reader.position()) {
+                    throw FileSystemException("Compressed size exceeds archive size for file " + entry.name);
+                }
+                data = m_file->begin() + reader.position();
+            } catch (const ReaderException& e) {
+                throw FileSystemException("Invalid local header for file " + entry.name + ": " + e.what());
+            }
+
+            const auto compressedSize = static_cast<size_t>(entry.compressedSize);
+            const auto uncompressedSize = static_cast<size_t>(entry.uncompressedSize);
+            if (entry.method == 0) {
+                if (compressedSize != uncompressedSize) {
+                    throw FileSystemException("Size mismatch for stored file " + entry.name);
+                }
+                std::memcpy(target, data, uncompressedSize);
+            } else if (uncompressedSize > 0u) {
+                const auto size = tinfl_decompress_mem_to_mem(target, uncompressedSize, data, compressedSize, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+                if (size != uncompressedSize) {
+                    throw FileSystemException("Could not decompress file " + entry.name);
+                }
+            }
+
+            if (mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char*>(target), uncompressedSize) != entry.crc) {
+                throw FileSystemException("CRC check failed for file " + entry.name);
+            }
         }
     }
 }
@@ -21,25 +21,34 @@
 #define TRENCHBROOM_ZIPFILESYSTEM_H
 
 #include "IO/ImageFileSystem.h"
+#include "IO/ZipIndexCache.h"
 
 #include <memory>
-
-#include <miniz/miniz.h>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
         class Path;
 
+        /**
+         * A file system backed by a zip archive.
+         *
+         * The central directory of the archive is read once when the file system is initialized. If an index cache is
+         * given, the central directory is taken from the cache if the archive hasn't changed since it was cached.
+         *
+         * Files are decompressed directly from the memory mapped archive when they are opened. This doesn't modify
+         * any state, so files may be opened from several threads at once.
+         */
         class ZipFileSystem : public ImageFileSystem {
         private:
-            mz_zip_archive m_archive;
+            std::shared_ptr<const ZipIndexCache> m_indexCache;
         private:
             class ZipCompressedFile : public FileEntry {
             private:
-                ZipFileSystem* m_owner;
-                mz_uint m_fileIndex;
+                const ZipFileSystem* m_owner;
+                ZipEntry m_entry;
             public:
-                ZipCompressedFile(ZipFileSystem* owner, mz_uint fileIndex);
+                ZipCompressedFile(const ZipFileSystem* owner, ZipEntry entry);
             private:
                 std::shared_ptr<File> doOpen() const override;
             };
@@ -47,11 +56,13 @@ namespace TrenchBroom {
         public:
             explicit ZipFileSystem(const Path& path);
             ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path);
-            ~ZipFileSystem() override;
+            ZipFileSystem(std::shared_ptr<FileSystem> next, const Path& path, std::shared_ptr<const ZipIndexCache> indexCache);
         private:
             void doReadDirectory() override;
         private:
-            std::string filename(mz_uint fileIndex);
+            std::vector<ZipEntry> readEntries() const;
+            std::vector<ZipEntry> readCentralDirectory() const;
+            void extract(const ZipEntry& entry, char* target) const;
         };
     }
 }
@@ -0,0 +1,176 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ZipIndexCache.h"
+
+#include "Exceptions.h"
+#include "IO/DiskIO.h"
+#include "IO/File.h"
+#include "IO/Reader.h"
+#include "IO/ReaderException.h"
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace TrenchBroom {
+    namespace IO {
+        namespace {
+            const char Magic[] = { 'T', 'B', 'Z', 'I' };
+            const std::uint32_t Version = 1u;
+
+            template <typename T>
+            void writeValue(std::string& buffer, const T value) {
+                buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void writeString(std::string& buffer, const std::string& str) {
+                writeValue<std::uint64_t>(buffer, str.size());
+                buffer.append(str);
+            }
+
+            std::string readString(Reader& reader) {
+                const auto size = reader.readSize<std::uint64_t>();
+                if (size > reader.size() - reader.position()) {
+                    throw ReaderException("String size exceeds file size");
+                }
+
+                std::string result(size, '\0');
+                reader.read(result.data(), size);
+                return result;
+            }
+        }
+
+        bool operator==(const ZipEntry& lhs, const ZipEntry& rhs) {
+            return lhs.name == rhs.name &&
+                   lhs.localHeaderOffset == rhs.localHeaderOffset &&
+                   lhs.compressedSize == rhs.compressedSize &&
+                   lhs.uncompressedSize == rhs.uncompressedSize &&
+                   lhs.crc == rhs.crc &&
+                   lhs.method == rhs.method &&
+                   lhs.flags == rhs.flags;
+        }
+
+        bool operator!=(const ZipEntry& lhs, const ZipEntry& rhs) {
+            return !(lhs == rhs);
+        }
+
+        ZipIndexCache::ZipIndexCache(Path directory) :
+        m_directory(std::move(directory)) {}
+
+        Path ZipIndexCache::cacheFilePath(const Path& archivePath) const {
+            // 64 bit FNV-1a of the archive path, the path itself is stored in the cache file to detect collisions
+            const auto pathStr = archivePath.asString();
+            std::uint64_t hash = 14695981039346656037ull;
+            for (const auto c : pathStr) {
+                hash ^= static_cast<unsigned char>(c);
+                hash *= 1099511628211ull;
+            }
+
+            std::stringstream name;
+            name << std::hex << std::setw(16) << std::setfill('0') << hash << ".zidx";
+            return m_directory + Path(name.str());
+        }
+
+        std::optional<std::vector<ZipEntry>> ZipIndexCache::load(const Path& archivePath, const std::uint64_t archiveSize, const std::int64_t modificationTime) const {
+            try {
+                const auto cachePath = cacheFilePath(archivePath);
+                if (!Disk::fileExists(cachePath)) {
+                    return std::nullopt;
+                }
+
+                const auto file = Disk::openFile(cachePath);
+                auto reader = file->reader();
+
+                char magic[sizeof(Magic)];
+                reader.read(magic, sizeof(magic));
+                if (std::memcmp(magic, Magic, sizeof(Magic)) != 0 ||
+                    reader.read<std::uint32_t, std::uint32_t>() != Version ||
+                    reader.read<std::uint64_t, std::uint64_t>() != archiveSize ||
+                    reader.read<std::int64_t, std::int64_t>() != modificationTime ||
+                    readString(reader) != archivePath.asString()) {
+                    return std::nullopt;
+                }
+
+                const auto count = reader.readSize<std::uint64_t>();
+                if (count > reader.size()) {
+                    return std::nullopt;
+                }
+
+                auto result = std::vector<ZipEntry>();
+                result.reserve(count);
+
+                for (size_t i = 0u; i < count; ++i) {
+                    auto entry = ZipEntry();
+                    entry.name = readString(reader);
+                    entry.localHeaderOffset = reader.read<std::uint64_t, std::uint64_t>();
+                    entry.compressedSize = reader.read<std::uint64_t, std::uint64_t>();
+                    entry.uncompressedSize = reader.read<std::uint64_t, std::uint64_t>();
+                    entry.crc = reader.read<std::uint32_t, std::uint32_t>();
+                    entry.method = reader.read<std::uint16_t, std::uint16_t>();
+                    entry.flags = reader.read<std::uint16_t, std::uint16_t>();
+                    result.push_back(std::move(entry));
+                }
+
+                if (!reader.eof()) {
+                    return std::nullopt;
+                }
+
+                return result;
+            } catch (const Exception&) {
+                // a cache file that cannot be read is treated like a missing one
+                return std::nullopt;
+            }
+        }
+
+        void ZipIndexCache::store(const Path& archivePath, const std::uint64_t archiveSize, const std::int64_t modificationTime, const std::vector<ZipEntry>& entries) const {
+            std::string buffer;
+            buffer.append(Magic, sizeof(Magic));
+            writeValue<std::uint32_t>(buffer, Version);
+            writeValue<std::uint64_t>(buffer, archiveSize);
+            writeValue<std::int64_t>(buffer, modificationTime);
+            writeString(buffer, archivePath.asString());
+
+            writeValue<std::uint64_t>(buffer, entries.size());
+            for (const auto& entry : entries) {
+                writeString(buffer, entry.name);
+                writeValue<std::uint64_t>(buffer, entry.localHeaderOffset);
+                writeValue<std::uint64_t>(buffer, entry.compressedSize);
+                writeValue<std::uint64_t>(buffer, entry.uncompressedSize);
+                writeValue<std::uint32_t>(buffer, entry.crc);
+                writeValue<std::uint16_t>(buffer, entry.method);
+                writeValue<std::uint16_t>(buffer, entry.flags);
+            }
+
+            Disk::ensureDirectoryExists(m_directory);
+
+            const auto cachePath = cacheFilePath(archivePath);
+            std::ofstream stream(cachePath.asString(), std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!stream.is_open()) {
+                throw FileSystemException("Cannot open file: " + cachePath.asString());
+            }
+
+            stream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            if (!stream.good()) {
+                throw FileSystemException("Cannot write file: " + cachePath.asString());
+            }
+        }
+    }
+}
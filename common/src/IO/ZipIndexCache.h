@@ -0,0 +1,95 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_ZIPINDEXCACHE_H
+#define TRENCHBROOM_ZIPINDEXCACHE_H
+
+#include "IO/Path.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace IO {
+        /**
+         * A file entry of the central directory of a zip archive, reduced to the information needed to extract the
+         * file from the archive.
+         */
+        struct ZipEntry {
+            std::string name;
+            std::uint64_t localHeaderOffset;
+            std::uint64_t compressedSize;
+            std::uint64_t uncompressedSize;
+            std::uint32_t crc;
+            std::uint16_t method;
+            std::uint16_t flags;
+        };
+
+        bool operator==(const ZipEntry& lhs, const ZipEntry& rhs);
+        bool operator!=(const ZipEntry& lhs, const ZipEntry& rhs);
+
+        /**
+         * Stores the central directories of zip archives in a cache directory so that they need not be read again
+         * when an archive is opened the next time.
+         *
+         * Each archive has its own cache file, which is keyed by the size and the modification time of the archive.
+         * If either of these don't match, the cache file is ignored and should be replaced by the caller.
+         */
+        class ZipIndexCache {
+        private:
+            Path m_directory;
+        public:
+            explicit ZipIndexCache(Path directory);
+
+            /**
+             * Returns the path of the cache file for the archive at the given path.
+             */
+            Path cacheFilePath(const Path& archivePath) const;
+
+            /**
+             * Returns the cached entries of the archive at the given path if there is a cache file for the archive
+             * and if the archive has the given size and modification time. A missing, stale or malformed cache file
+             * is treated as a cache miss.
+             *
+             * @param archivePath the absolute path of the archive
+             * @param archiveSize the size of the archive in bytes
+             * @param modificationTime the modification time of the archive
+             * @return the cached entries or an empty optional if there is no matching cache file
+             */
+            std::optional<std::vector<ZipEntry>> load(const Path& archivePath, std::uint64_t archiveSize, std::int64_t modificationTime) const;
+
+            /**
+             * Writes the given entries of the archive at the given path to its cache file, replacing any existing
+             * cache file. The cache directory is created if it doesn't exist.
+             *
+             * @param archivePath the absolute path of the archive
+             * @param archiveSize the size of the archive in bytes
+             * @param modificationTime the modification time of the archive
+             * @param entries the entries of the archive's central directory
+             *
+             * @throw FileSystemException if the cache file cannot be written
+             */
+            void store(const Path& archivePath, std::uint64_t archiveSize, std::int64_t modificationTime, const std::vector<ZipEntry>& entries) const;
+        };
+    }
+}
+
+#endif //TRENCHBROOM_ZIPINDEXCACHE_H
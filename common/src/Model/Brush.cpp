@@ -19,6 +19,7 @@
 
 #include "Brush.h"
 
+#include "AABBTree.h"
 #include "Exceptions.h"
 #include "FloatType.h"
 #include "Polyhedron.h"
@@ -28,6 +29,7 @@
 #include "Model/ModelFactory.h"
 #include "Model/TexCoordSystem.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/intersection.h>
@@ -41,6 +43,7 @@
 
 #include <algorithm> // for std::remove
 #include <iterator>
+#include <numeric>
 #include <set>
 #include <string>
 #include <vector>
@@ -55,16 +58,10 @@ namespace TrenchBroom {
             updateGeometryFromFaces(worldBounds);
         }
 
-        class Brush::CopyCallback : public BrushGeometry::CopyCallback {
-        public:
-            void faceWasCopied(const BrushFaceGeometry* original, BrushFaceGeometry* copy) const override {
-                copy->setPayload(original->payload());
-            }
-        };
-
         Brush::Brush(const Brush& other) :
         m_faces(other.m_faces),
-        m_geometry(other.m_geometry ? std::make_unique<BrushGeometry>(*other.m_geometry, CopyCallback()) : nullptr) {
+        m_geometry(other.m_geometry) {
+            // the copied faces must be linked to the shared geometry
             if (m_geometry) {
                 for (BrushFaceGeometry* faceGeometry : m_geometry->faces()) {
                     if (const auto faceIndex = faceGeometry->payload()) {
@@ -93,14 +90,57 @@ namespace TrenchBroom {
         
         Brush::~Brush() = default;
 
-        void Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds) {
-            // First, add all faces to the brush geometry
-            BrushFace::sortFaces(m_faces);
-            
+        /**
+         * Brushes with at most this many faces are built by intersecting their face planes directly. Since every
+         * triple of planes is intersected, brushes with more faces are built by clipping.
+         */
+        static const size_t MaxFacesToIntersect = 64u;
+
+        /**
+         * Builds the geometry of a brush by intersecting the planes of the given faces, see BrushGeometry::fromPlanes.
+         * Returns null if the planes do not bound a valid polyhedron within the given world bounds, in which case the
+         * geometry must be built by clipping.
+         */
+        static std::unique_ptr<BrushGeometry> intersectFaces(std::vector<BrushFace>& faces, const vm::bbox3& worldBounds) {
+            std::vector<vm::plane3> planes;
+            planes.reserve(faces.size());
+            for (const auto& face : faces) {
+                planes.push_back(face.boundary());
+            }
+
+            auto result = BrushGeometry::fromPlanes(planes);
+            if (!result) {
+                return nullptr;
+            }
+
+            auto& [geometry, faceGeometries] = *result;
+
+            // clipping rejects brushes that touch or exceed the world bounds
+            const auto& bounds = geometry.bounds();
+            for (size_t i = 0u; i < 3u; ++i) {
+                if (bounds.min[i] <= worldBounds.min[i] || bounds.max[i] >= worldBounds.max[i]) {
+                    return nullptr;
+                }
+            }
+
+            for (size_t i = 0u; i < faces.size(); ++i) {
+                if (BrushFaceGeometry* faceGeometry = faceGeometries[i]) {
+                    faces[i].setGeometry(faceGeometry);
+                    faceGeometry->setPayload(i);
+                }
+            }
+
+            return std::make_unique<BrushGeometry>(std::move(geometry));
+        }
+
+        /**
+         * Builds the geometry of a brush by clipping a cube of the size of the world bounds with every face.
+         */
+        static std::unique_ptr<BrushGeometry> clipFaces(std::vector<BrushFace>& faces, const vm::bbox3& worldBounds) {
             auto geometry = std::make_unique<BrushGeometry>(worldBounds);
-            
-            for (size_t i = 0u; i < m_faces.size(); ++i) {
-                BrushFace& face = m_faces[i];
+
+            for (size_t i = 0u; i < faces.size(); ++i) {
+                BrushFace& face = faces[i];
                 const auto result = geometry->clip(face.boundary());
                 if (result.success()) {
                     BrushFaceGeometry* faceGeometry = result.face();
@@ -111,25 +151,56 @@ namespace TrenchBroom {
                 }
             }
 
+            return geometry;
+        }
+
+        void Brush::updateGeometryFromFaces(const vm::bbox3& worldBounds) {
+            // First, add all faces to the brush geometry
+            BrushFace::sortFaces(m_faces);
+
+            auto geometry = m_faces.size() <= MaxFacesToIntersect ? intersectFaces(m_faces, worldBounds) : nullptr;
+            if (geometry == nullptr) {
+                geometry = clipFaces(m_faces, worldBounds);
+            }
+
             // Correct vertex positions and heal short edges
             geometry->correctVertexPositions();
             if (!geometry->healEdges()) {
                 throw GeometryException("Brush is invalid");
             }
             
-            // Now collect all faces which still remain
-            std::vector<BrushFace> remainingFaces;
-            remainingFaces.reserve(m_faces.size());
-            
-            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+            // Now collect all faces which still remain, keeping them in sort order
+            std::vector<bool> remaining(m_faces.size(), false);
+            for (const BrushFaceGeometry* faceGeometry : geometry->faces()) {
                 if (const auto faceIndex = faceGeometry->payload()) {
-                    remainingFaces.push_back(std::move(m_faces[*faceIndex]));
-                    faceGeometry->setPayload(remainingFaces.size() - 1u);
+                    remaining[*faceIndex] = true;
                 } else {
                     throw GeometryException("Brush is not fully specified");
                 }
             }
 
+            std::vector<size_t> remainingIndices(m_faces.size());
+            std::vector<BrushFace> remainingFaces;
+            remainingFaces.reserve(m_faces.size());
+
+            for (size_t i = 0u; i < m_faces.size(); ++i) {
+                if (remaining[i]) {
+                    remainingIndices[i] = remainingFaces.size();
+                    remainingFaces.push_back(std::move(m_faces[i]));
+                }
+            }
+
+            for (BrushFaceGeometry* faceGeometry : geometry->faces()) {
+                faceGeometry->setPayload(remainingIndices[*faceGeometry->payload()]);
+            }
+
+            // Number the vertices so that the renderer can look up its data for a vertex without modifying the
+            // geometry, which is shared with the copies of this brush
+            BrushVertexPayload::Type vertexIndex = 0u;
+            for (BrushVertex* vertex : geometry->vertices()) {
+                vertex->setPayload(vertexIndex++);
+            }
+
             m_faces = std::move(remainingFaces);
             m_geometry = std::move(geometry);
             
@@ -374,12 +445,24 @@ namespace TrenchBroom {
         }
 
         bool Brush::canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const {
-            return doCanMoveVertices(worldBounds, vertices, delta, true).success;
+            return checkMoveVertices(worldBounds, vertices, delta).success;
+        }
+
+        Brush::CanMoveVerticesResult Brush::checkMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const {
+            return doCanMoveVertices(worldBounds, vertices, delta, true);
         }
 
         std::vector<vm::vec3> Brush::moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const bool uvLock) {
             doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
+            return findMovedVertices(vertexPositions, delta);
+        }
+
+        std::vector<vm::vec3> Brush::moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const BrushGeometry& newGeometry, const bool uvLock) {
+            doMoveVertices(worldBounds, vertexPositions, delta, newGeometry, uvLock);
+            return findMovedVertices(vertexPositions, delta);
+        }
 
+        std::vector<vm::vec3> Brush::findMovedVertices(const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta) const {
             // Collect the exact new positions of the moved vertices
             std::vector<vm::vec3> result;
             result.reserve(vertexPositions.size());
@@ -487,6 +570,10 @@ namespace TrenchBroom {
         }
 
         bool Brush::canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const {
+            return checkMoveEdges(worldBounds, edgePositions, delta).success;
+        }
+
+        Brush::CanMoveVerticesResult Brush::checkMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const {
             ensure(m_geometry != nullptr, "geometry is null");
             ensure(!edgePositions.empty(), "no edge positions");
 
@@ -494,19 +581,19 @@ namespace TrenchBroom {
             vm::segment3::get_vertices(
                 std::begin(edgePositions), std::end(edgePositions),
                 std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
 
             if (!result.success) {
-                return false;
+                return result;
             }
 
             for (const auto& edge : edgePositions) {
                 if (!result.geometry->hasEdge(edge.start() + delta, edge.end() + delta)) {
-                    return false;
+                    return CanMoveVerticesResult::rejectVertexMove();
                 }
             }
 
-            return true;
+            return result;
         }
 
         std::vector<vm::segment3> Brush::moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, const bool uvLock) {
@@ -517,6 +604,19 @@ namespace TrenchBroom {
                                   std::back_inserter(vertexPositions));
             doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
 
+            return findMovedEdges(edgePositions, delta);
+        }
+
+        std::vector<vm::segment3> Brush::moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, const BrushGeometry& newGeometry, const bool uvLock) {
+            std::vector<vm::vec3> vertexPositions;
+            vm::segment3::get_vertices(std::begin(edgePositions), std::end(edgePositions),
+                                  std::back_inserter(vertexPositions));
+            doMoveVertices(worldBounds, vertexPositions, delta, newGeometry, uvLock);
+
+            return findMovedEdges(edgePositions, delta);
+        }
+
+        std::vector<vm::segment3> Brush::findMovedEdges(const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const {
             std::vector<vm::segment3> result;
             result.reserve(edgePositions.size());
 
@@ -532,24 +632,28 @@ namespace TrenchBroom {
         }
 
         bool Brush::canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const {
+            return checkMoveFaces(worldBounds, facePositions, delta).success;
+        }
+
+        Brush::CanMoveVerticesResult Brush::checkMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const {
             ensure(m_geometry != nullptr, "geometry is null");
             ensure(!facePositions.empty(), "no face positions");
 
             std::vector<vm::vec3> vertexPositions;
             vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
-            const auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
+            auto result = doCanMoveVertices(worldBounds, vertexPositions, delta, false);
 
             if (!result.success) {
-                return false;
+                return result;
             }
 
             for (const auto& face : facePositions) {
                 if (!result.geometry->hasFace(face.vertices() + delta)) {
-                    return false;
+                    return CanMoveVerticesResult::rejectVertexMove();
                 }
             }
 
-            return true;
+            return result;
         }
 
         std::vector<vm::polygon3> Brush::moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, const bool uvLock) {
@@ -559,6 +663,18 @@ namespace TrenchBroom {
             vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
             doMoveVertices(worldBounds, vertexPositions, delta, uvLock);
 
+            return findMovedFaces(facePositions, delta);
+        }
+
+        std::vector<vm::polygon3> Brush::moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, const BrushGeometry& newGeometry, const bool uvLock) {
+            std::vector<vm::vec3> vertexPositions;
+            vm::polygon3::get_vertices(std::begin(facePositions), std::end(facePositions), std::back_inserter(vertexPositions));
+            doMoveVertices(worldBounds, vertexPositions, delta, newGeometry, uvLock);
+
+            return findMovedFaces(facePositions, delta);
+        }
+
+        std::vector<vm::polygon3> Brush::findMovedFaces(const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const {
             std::vector<vm::polygon3> result;
             result.reserve(facePositions.size());
 
@@ -721,7 +837,13 @@ namespace TrenchBroom {
                 }
             }
             
-            BrushGeometry newGeometry(newVertices);
+            const BrushGeometry newGeometry(newVertices);
+            doMoveVertices(worldBounds, vertexPositions, delta, newGeometry, uvLock);
+        }
+
+        void Brush::doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const BrushGeometry& newGeometry, const bool uvLock) {
+            ensure(m_geometry != nullptr, "geometry is null");
+            ensure(!vertexPositions.empty(), "no vertex positions");
 
             using VecMap = std::map<vm::vec3, vm::vec3>;
             VecMap vertexMapping;
@@ -838,14 +960,20 @@ namespace TrenchBroom {
             updateGeometryFromFaces(worldBounds);
         }
 
-        std::vector<Brush> Brush::subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<const Brush*>& subtrahends) const {
-            auto result = std::vector<BrushGeometry>{*m_geometry};
+        static std::vector<BrushGeometry> subtractGeometry(const BrushGeometry& minuend, const std::vector<const BrushGeometry*>& subtrahends) {
+            auto result = std::vector<BrushGeometry>{minuend};
 
-            for (auto* subtrahend : subtrahends) {
+            for (const auto* subtrahend : subtrahends) {
                 auto nextResults = std::vector<BrushGeometry>();
 
-                for (const BrushGeometry& fragment : result) {
-                    auto subFragments = fragment.subtract(*subtrahend->m_geometry);
+                for (BrushGeometry& fragment : result) {
+                    // fragments that cannot touch the subtrahend are kept as they are
+                    if (!fragment.bounds().intersects(subtrahend->bounds())) {
+                        nextResults.push_back(std::move(fragment));
+                        continue;
+                    }
+
+                    auto subFragments = fragment.subtract(*subtrahend);
 
                     nextResults.reserve(nextResults.size() + subFragments.size());
                     for (auto& subFragment : subFragments) {
@@ -856,17 +984,147 @@ namespace TrenchBroom {
                 result = std::move(nextResults);
             }
 
-            std::vector<Brush> brushes;
-            brushes.reserve(result.size());
+            return result;
+        }
 
-            for (const auto& geometry : result) {
-                try {
-                    auto brush = createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahends);
-                    brushes.push_back(std::move(brush));
-                } catch (const GeometryException&) {}
+        /**
+         * Returns the face of the given geometry that lies in the plane of the given face and faces the opposite way, or
+         * null if there is no such face.
+         */
+        static const BrushFaceGeometry* findOppositeFace(const BrushGeometry& geometry, const BrushFaceGeometry* face) {
+            const auto& plane = face->plane();
+            for (const auto* candidate : geometry.faces()) {
+                if (1.0 + vm::dot(face->normal(), candidate->normal()) < vm::constants<FloatType>::colinear_epsilon() &&
+                    plane.point_status(candidate->boundary().front()->origin()->position(), vm::constants<FloatType>::point_status_epsilon()) == vm::plane_status::inside) {
+                    return candidate;
+                }
             }
+            return nullptr;
+        }
 
-            return brushes;
+        /**
+         * Returns whether no vertex of `other` is above the plane of any face of `geometry` except `excludedFace`.
+         */
+        static bool isBelowFacePlanes(const BrushGeometry& other, const BrushGeometry& geometry, const BrushFaceGeometry* excludedFace) {
+            for (const auto* face : geometry.faces()) {
+                if (face == excludedFace) {
+                    continue;
+                }
+                for (const auto* vertex : other.vertices()) {
+                    if (face->pointStatus(vertex->position(), vm::constants<FloatType>::point_status_epsilon()) == vm::plane_status::above) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * Returns whether the union of the given geometries is convex. The geometries must not overlap.
+         *
+         * The union is convex if the geometries touch in a common plane and each of them is below all face planes of
+         * the other except for the one in the common plane, because then the union is exactly the intersection of the
+         * half spaces below these planes.
+         */
+        static bool isUnionConvex(const BrushGeometry& lhs, const BrushGeometry& rhs) {
+            for (const auto* lhsFace : lhs.faces()) {
+                if (const auto* rhsFace = findOppositeFace(rhs, lhsFace)) {
+                    return isBelowFacePlanes(rhs, lhs, lhsFace) && isBelowFacePlanes(lhs, rhs, rhsFace);
+                }
+            }
+            return false;
+        }
+
+        /**
+         * Replaces pairs of the given fragments by their convex hull as long as the union of the pair is convex. The
+         * fragments must not overlap.
+         *
+         * Every fragment is checked against the fragments that cannot be merged with any other fragment so far. When a
+         * pair is merged, the merged fragment is checked again, so every merge costs at most a linear number of checks.
+         */
+        static void mergeConvexFragments(std::vector<BrushGeometry>& fragments) {
+            auto worklist = std::move(fragments);
+            std::reverse(std::begin(worklist), std::end(worklist));
+
+            fragments = std::vector<BrushGeometry>();
+            fragments.reserve(worklist.size());
+
+            while (!worklist.empty()) {
+                auto fragment = std::move(worklist.back());
+                worklist.pop_back();
+
+                const auto it = std::find_if(std::begin(fragments), std::end(fragments), [&](const BrushGeometry& other) {
+                    return fragment.bounds().intersects(other.bounds()) && isUnionConvex(fragment, other);
+                });
+
+                if (it != std::end(fragments)) {
+                    auto hull = BrushGeometry(kdl::vec_concat(it->vertexPositions(), fragment.vertexPositions()));
+                    if (hull.polyhedron() && hull.closed()) {
+                        fragments.erase(it);
+                        worklist.push_back(std::move(hull));
+                        continue;
+                    }
+                }
+
+                fragments.push_back(std::move(fragment));
+            }
+        }
+
+        std::vector<Brush> Brush::subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<const Brush*>& subtrahends) const {
+            const auto subtrahendGeometries = kdl::vec_transform(subtrahends, [](const auto* subtrahend) {
+                return static_cast<const BrushGeometry*>(subtrahend->m_geometry.get());
+            });
+            return createBrushes(factory, worldBounds, defaultTextureName, subtractGeometry(*m_geometry, subtrahendGeometries), subtrahends);
+        }
+
+        std::vector<std::vector<Brush>> Brush::subtractAll(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<const Brush*>& minuends, const std::vector<const Brush*>& subtrahends) {
+            std::vector<size_t> subtrahendIndices(subtrahends.size());
+            std::iota(std::begin(subtrahendIndices), std::end(subtrahendIndices), 0u);
+
+            AABBTree<FloatType, 3, size_t> subtrahendTree;
+            subtrahendTree.clearAndBuild(subtrahendIndices, [&](const size_t index) {
+                return subtrahends[index]->bounds();
+            });
+
+            struct Fragments {
+                std::vector<const Brush*> subtrahends;
+                std::vector<BrushGeometry> geometries;
+            };
+
+            // only the geometry is computed in parallel, because creating brushes changes the usage counts of textures
+            const auto fragments = kdl::vec_parallel_transform(minuends, [&](const Brush* minuend) {
+                // the minuend is convex, so every subtrahend whose bounds are above one of its face planes is disjoint
+                const auto planes = kdl::vec_transform(minuend->faces(), [](const auto& face) { return face.boundary(); });
+                auto indices = subtrahendTree.findIntersectors(planes);
+                if (indices.empty()) {
+                    return Fragments{};
+                }
+
+                // keep the order of the subtrahends so that the result does not depend on the tree
+                std::sort(std::begin(indices), std::end(indices));
+                auto candidates = kdl::vec_transform(indices, [&](const size_t index) { return subtrahends[index]; });
+                const auto candidateGeometries = kdl::vec_transform(candidates, [](const auto* subtrahend) {
+                    return static_cast<const BrushGeometry*>(subtrahend->m_geometry.get());
+                });
+
+                auto geometries = subtractGeometry(*minuend->m_geometry, candidateGeometries);
+                mergeConvexFragments(geometries);
+                return Fragments{std::move(candidates), std::move(geometries)};
+            });
+
+            std::vector<std::vector<Brush>> result;
+            result.reserve(minuends.size());
+
+            for (size_t i = 0u; i < minuends.size(); ++i) {
+                const auto& minuend = *minuends[i];
+                if (fragments[i].subtrahends.empty()) {
+                    result.push_back({minuend});
+                } else {
+                    result.push_back(minuend.createBrushes(factory, worldBounds, defaultTextureName, fragments[i].geometries, fragments[i].subtrahends));
+                }
+            }
+
+            return result;
         }
 
         std::vector<Brush> Brush::subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const Brush& subtrahend) const {
@@ -925,6 +1183,20 @@ namespace TrenchBroom {
             return m_geometry->intersects(*brush.m_geometry);
         }
 
+        std::vector<Brush> Brush::createBrushes(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<BrushGeometry>& geometries, const std::vector<const Brush*>& subtrahends) const {
+            std::vector<Brush> brushes;
+            brushes.reserve(geometries.size());
+
+            for (const auto& geometry : geometries) {
+                try {
+                    auto brush = createBrush(factory, worldBounds, defaultTextureName, geometry, subtrahends);
+                    brushes.push_back(std::move(brush));
+                } catch (const GeometryException&) {}
+            }
+
+            return brushes;
+        }
+
         Brush Brush::createBrush(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const BrushGeometry& geometry, const std::vector<const Brush*>& subtrahends) const {
             std::vector<BrushFace> faces;
             faces.reserve(geometry.faceCount());
@@ -1007,5 +1279,25 @@ namespace TrenchBroom {
             
             return true;
         }
+
+        bool Brush::sharesGeometryWith(const Brush& other) const {
+            return m_geometry != nullptr && m_geometry == other.m_geometry;
+        }
+
+        size_t Brush::memorySize() const {
+            auto result = sizeof(Brush) + m_faces.capacity() * sizeof(BrushFace);
+            for (const auto& face : m_faces) {
+                result += face.attributes().textureName().capacity();
+            }
+
+            if (m_geometry != nullptr && m_geometry.use_count() == 1) {
+                result += sizeof(BrushGeometry);
+                result += m_geometry->vertexCount() * sizeof(BrushVertex);
+                result += m_geometry->edgeCount() * (sizeof(BrushEdge) + 2u * sizeof(BrushHalfEdge));
+                result += m_geometry->faceCount() * sizeof(BrushFaceGeometry);
+            }
+
+            return result;
+        }
     }
 }
@@ -38,8 +38,6 @@ namespace TrenchBroom {
 
         class Brush {
         private:
-            class CopyCallback;
-            
             /**
              * Epsilon value to use when finding a vertex after applying a vertex operation
              */
@@ -49,7 +47,12 @@ namespace TrenchBroom {
             using EdgeList = BrushEdgeList;
         private:
             std::vector<BrushFace> m_faces;
-            std::unique_ptr<BrushGeometry> m_geometry;
+            /**
+             * The geometry is never modified once it is built; operations that change the shape of this brush replace
+             * it. This allows copies of a brush to share its geometry, which makes copying a brush, e.g. when taking
+             * a snapshot for undo, cheap.
+             */
+            std::shared_ptr<BrushGeometry> m_geometry;
         public:
             Brush();
             Brush(const vm::bbox3& worldBounds, std::vector<BrushFace> faces);
@@ -113,9 +116,31 @@ namespace TrenchBroom {
 
             std::vector<const BrushFace*> incidentFaces(const BrushVertex* vertex) const;
 
+            /**
+             * The result of checking whether vertices, edges or faces of a brush can be moved. If the move is
+             * possible, it holds the geometry of the brush after the move, which can be passed to the move functions
+             * so that they do not have to compute it again.
+             */
+            struct CanMoveVerticesResult {
+            public:
+                bool success;
+                std::unique_ptr<BrushGeometry> geometry;
+            private:
+                CanMoveVerticesResult(bool s, BrushGeometry&& g);
+            public:
+                static CanMoveVerticesResult rejectVertexMove();
+                static CanMoveVerticesResult acceptVertexMove(BrushGeometry&& result);
+            };
+
             // vertex operations
             bool canMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const;
+            CanMoveVerticesResult checkMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertices, const vm::vec3& delta) const;
             std::vector<vm::vec3> moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool uvLock = false);
+            /**
+             * Moves the given vertices like the above function, but uses the given geometry as the result of the move.
+             * The geometry must have been returned by checkMoveVertices for the same arguments and this brush.
+             */
+            std::vector<vm::vec3> moveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const BrushGeometry& newGeometry, bool uvLock = false);
 
             bool canAddVertex(const vm::bbox3& worldBounds, const vm::vec3& position) const;
             BrushVertex* addVertex(const vm::bbox3& worldBounds, const vm::vec3& position);
@@ -128,25 +153,22 @@ namespace TrenchBroom {
 
             // edge operations
             bool canMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const;
+            CanMoveVerticesResult checkMoveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const;
             std::vector<vm::segment3> moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, bool uvLock = false);
+            std::vector<vm::segment3> moveEdges(const vm::bbox3& worldBounds, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta, const BrushGeometry& newGeometry, bool uvLock = false);
 
             // face operations
             bool canMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const;
+            CanMoveVerticesResult checkMoveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const;
             std::vector<vm::polygon3> moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, bool uvLock = false);
+            std::vector<vm::polygon3> moveFaces(const vm::bbox3& worldBounds, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta, const BrushGeometry& newGeometry, bool uvLock = false);
         private:
-            struct CanMoveVerticesResult {
-            public:
-                bool success;
-                std::unique_ptr<BrushGeometry> geometry;
-            private:
-                CanMoveVerticesResult(bool s, BrushGeometry&& g);
-            public:
-                static CanMoveVerticesResult rejectVertexMove();
-                static CanMoveVerticesResult acceptVertexMove(BrushGeometry&& result);
-            };
-
             CanMoveVerticesResult doCanMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, vm::vec3 delta, bool allowVertexRemoval) const;
             void doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, bool lockTexture);
+            void doMoveVertices(const vm::bbox3& worldBounds, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta, const BrushGeometry& newGeometry, bool lockTexture);
+            std::vector<vm::vec3> findMovedVertices(const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta) const;
+            std::vector<vm::segment3> findMovedEdges(const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta) const;
+            std::vector<vm::polygon3> findMovedFaces(const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta) const;
             /**
              * Tries to find 3 vertices in `left` and `right` that are related according to the PolyhedronMatcher, and
              * generates an affine transform for them which can then be used to implement UV lock.
@@ -186,6 +208,20 @@ namespace TrenchBroom {
              */
             std::vector<Brush> subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<const Brush*>& subtrahends) const;
             std::vector<Brush> subtract(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const Brush& subtrahend) const;
+
+            /**
+             * Subtracts the given subtrahends from each of the given minuends. The result is the same as calling
+             * subtract() for every minuend, except that adjacent fragments of a minuend are merged where their union is
+             * convex, so that fewer brushes are created.
+             *
+             * Only the subtrahends whose bounds intersect a minuend are subtracted from it. The fragments of the
+             * minuends are computed in parallel, but the resulting brushes are created on the calling thread.
+             *
+             * @param minuends the brushes to subtract from. The passed-in brushes are not modified.
+             * @param subtrahends the brushes to subtract. The passed-in brushes are not modified.
+             * @return the subtraction result for each minuend, in the order of the given minuends
+             */
+            static std::vector<std::vector<Brush>> subtractAll(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<const Brush*>& minuends, const std::vector<const Brush*>& subtrahends);
             void intersect(const vm::bbox3& worldBounds, const Brush& brush);
 
             // transformation
@@ -210,10 +246,23 @@ namespace TrenchBroom {
              * @return the newly created brush
              */
             Brush createBrush(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const BrushGeometry& geometry, const std::vector<const Brush*>& subtrahends) const;
+            std::vector<Brush> createBrushes(const ModelFactory& factory, const vm::bbox3& worldBounds, const std::string& defaultTextureName, const std::vector<BrushGeometry>& geometries, const std::vector<const Brush*>& subtrahends) const;
         public:
             void findIntegerPlanePoints(const vm::bbox3& worldBounds);
         private:
             bool checkFaceLinks() const;
+        public:
+            /**
+             * Indicates whether this brush shares its geometry with the given brush, i.e. one of the brushes is an
+             * unmodified copy of the other.
+             */
+            bool sharesGeometryWith(const Brush& other) const;
+
+            /**
+             * Returns an estimate of the number of bytes of memory used by this brush. The geometry is only counted if
+             * it is not shared with any other brush.
+             */
+            size_t memorySize() const;
         };
     }
 }
@@ -43,6 +43,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <vecmath/constants.h>
 #include <vecmath/intersection.h>
 #include <vecmath/vec.h>
 #include <vecmath/vec_ext.h>
@@ -109,6 +110,7 @@ namespace TrenchBroom {
             const NotifyNodeChange nodeChange(this);
             const NotifyPhysicalBoundsChange boundsChange(this);
             m_brush = std::move(brush);
+            m_facePlanes.clear();
             
             updateSelectedFaceCount();
             invalidateIssues();
@@ -217,6 +219,19 @@ namespace TrenchBroom {
 
         std::optional<std::tuple<FloatType, size_t>> BrushNode::findFaceHit(const vm::ray3& ray) const {
             if (!vm::is_nan(vm::intersect_ray_bbox(ray, logicalBounds()))) {
+                // Clip the ray against all face planes at once to find the face through which it enters the brush. Only
+                // if that doesn't yield a hit, e.g. because the ray grazes an edge or starts inside the brush, we fall
+                // back to testing every face.
+                const auto entryFace = findRayEntryPlane(ray, facePlanes(), vm::constants<FloatType>::point_status_epsilon());
+                if (!entryFace) {
+                    return std::nullopt;
+                }
+
+                const auto distance = m_brush.face(*entryFace).intersectWithRay(ray);
+                if (!vm::is_nan(distance)) {
+                    return std::make_tuple(distance, *entryFace);
+                }
+
                 for (size_t i = 0u; i < m_brush.faceCount(); ++i) {
                     const auto& face = m_brush.face(i);
                     const auto distance = face.intersectWithRay(ray);
@@ -228,6 +243,15 @@ namespace TrenchBroom {
             return std::nullopt;
         }
 
+        const PlaneList<FloatType>& BrushNode::facePlanes() const {
+            if (m_facePlanes.empty()) {
+                for (const auto& face : m_brush.faces()) {
+                    m_facePlanes.push_back(face.boundary());
+                }
+            }
+            return m_facePlanes;
+        }
+
         Node* BrushNode::doGetContainer() const {
             FindContainerVisitor visitor;
             escalate(visitor);
@@ -250,6 +274,7 @@ namespace TrenchBroom {
             const NotifyNodeChange nodeChange(this);
             const NotifyPhysicalBoundsChange boundsChange(this);
             m_brush.transform(transformation, lockTextures, worldBounds);
+            m_facePlanes.clear();
             
             invalidateIssues();
             invalidateVertexCache();
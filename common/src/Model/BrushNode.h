@@ -22,6 +22,7 @@
 
 #include "FloatType.h"
 #include "Macros.h"
+#include "SimdIntersection.h"
 #include "Model/Brush.h"
 #include "Model/BrushGeometry.h"
 #include "Model/HitType.h"
@@ -62,6 +63,7 @@ namespace TrenchBroom {
             mutable std::unique_ptr<Renderer::BrushRendererBrushCache> m_brushRendererBrushCache; // unique_ptr for breaking header dependencies
             Brush m_brush; // must be destroyed before the brush renderer cache
             size_t m_selectedFaceCount = 0u;
+            mutable PlaneList<FloatType> m_facePlanes; // lazily built for picking, cleared when the brush changes
         public:
             explicit BrushNode(Brush brush);
             ~BrushNode() override;
@@ -108,6 +110,7 @@ namespace TrenchBroom {
             void doFindNodesContaining(const vm::vec3& point, std::vector<Node*>& result) override;
 
             std::optional<std::tuple<FloatType, size_t>> findFaceHit(const vm::ray3& ray) const;
+            const PlaneList<FloatType>& facePlanes() const;
 
             Node* doGetContainer() const override;
             LayerNode* doGetLayer() const override;
@@ -22,21 +22,23 @@
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 
-#include <kdl/vector_utils.h>
-
 namespace TrenchBroom {
     namespace Model {
         BrushSnapshot::BrushSnapshot(BrushNode* brushNode) :
-        m_brushNode(brushNode) {
-            const Brush& brush = m_brushNode->brush();
-            for (const BrushFace& face : brush.faces()) {
-                BrushFace& copy = m_faces.emplace_back(face);
-                copy.setTexture(nullptr);
+        m_brushNode(brushNode),
+        m_brush(m_brushNode->brush()) {
+            // the textures may be unloaded before the snapshot is restored
+            for (BrushFace& face : m_brush.faces()) {
+                face.setTexture(nullptr);
             }
         }
 
-        void BrushSnapshot::doRestore(const vm::bbox3& worldBounds) {
-            m_brushNode->setBrush(Brush(worldBounds, std::move(m_faces)));
+        void BrushSnapshot::doRestore(const vm::bbox3& /* worldBounds */) {
+            m_brushNode->setBrush(std::move(m_brush));
+        }
+
+        size_t BrushSnapshot::doGetMemorySize() const {
+            return sizeof(BrushSnapshot) + m_brush.memorySize();
         }
     }
 }
@@ -20,24 +20,26 @@
 #ifndef TrenchBroom_BrushSnapshot
 #define TrenchBroom_BrushSnapshot
 
+#include "Model/Brush.h"
 #include "Model/NodeSnapshot.h"
 
-#include <vector>
-
 namespace TrenchBroom {
     namespace Model {
         class BrushNode;
-        class BrushFace;
 
+        /**
+         * Stores a copy of a brush. The copy shares its geometry with the brush until the brush is changed, and
+         * restoring the snapshot does not rebuild the geometry.
+         */
         class BrushSnapshot : public NodeSnapshot {
         private:
             BrushNode* m_brushNode;
-            std::vector<BrushFace> m_faces;
+            Brush m_brush;
         public:
             BrushSnapshot(BrushNode* brushNode);
         private:
-            void takeSnapshot(BrushNode* brushNode);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
         };
     }
 }
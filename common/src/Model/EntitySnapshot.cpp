@@ -30,5 +30,13 @@ namespace TrenchBroom {
         void EntitySnapshot::doRestore(const vm::bbox3& /* worldBounds */) {
             m_entity->setAttributes(m_attributesSnapshot);
         }
+
+        size_t EntitySnapshot::doGetMemorySize() const {
+            auto result = sizeof(EntitySnapshot) + m_attributesSnapshot.capacity() * sizeof(EntityAttribute);
+            for (const auto& attribute : m_attributesSnapshot) {
+                result += attribute.name().capacity() + attribute.value().capacity();
+            }
+            return result;
+        }
     }
 }
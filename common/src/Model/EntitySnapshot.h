@@ -36,6 +36,7 @@ namespace TrenchBroom {
             EntitySnapshot(EntityNode* entity);
         private:
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
         };
     }
 }
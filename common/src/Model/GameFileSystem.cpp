@@ -29,6 +29,7 @@
 #include "IO/Quake3ShaderFileSystem.h"
 #include "IO/SystemPaths.h"
 #include "IO/ZipFileSystem.h"
+#include "IO/ZipIndexCache.h"
 #include "Model/GameConfig.h"
 
 #include <kdl/string_compare.h>
@@ -128,7 +129,7 @@ namespace TrenchBroom {
                             m_next = std::make_shared<IO::DkPakFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
                         } else if (kdl::ci::str_is_equal(packageFormat, "zip")) {
                             logger.info() << "Adding file system package " << packagePath;
-                            m_next = std::make_shared<IO::ZipFileSystem>(m_next, diskFS.makeAbsolute(packagePath));
+                            m_next = std::make_shared<IO::ZipFileSystem>(m_next, diskFS.makeAbsolute(packagePath), zipIndexCache());
                         }
                     } catch (const std::exception& e) {
                         logger.error() << e.what();
@@ -137,6 +138,14 @@ namespace TrenchBroom {
             }
         }
 
+        std::shared_ptr<IO::ZipIndexCache> GameFileSystem::zipIndexCache() {
+            // games with many large packages start faster if the central directories need not be read every time
+            if (m_zipIndexCache == nullptr) {
+                m_zipIndexCache = std::make_shared<IO::ZipIndexCache>(IO::SystemPaths::userDataDirectory() + IO::Path("cache/zip"));
+            }
+            return m_zipIndexCache;
+        }
+
         void GameFileSystem::addShaderFileSystem(const GameConfig& config, Logger& logger) {
             // To support Quake 3 shaders, we add a shader file system that loads the shaders
             // and makes them available as virtual files.
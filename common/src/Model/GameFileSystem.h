@@ -31,6 +31,7 @@ namespace TrenchBroom {
     namespace IO {
         class Path;
         class Quake3ShaderFileSystem;
+        class ZipIndexCache;
     }
 
     namespace Model {
@@ -39,6 +40,7 @@ namespace TrenchBroom {
         class GameFileSystem : public IO::FileSystem {
         private:
             IO::Quake3ShaderFileSystem* m_shaderFS;
+            std::shared_ptr<IO::ZipIndexCache> m_zipIndexCache;
         public:
             GameFileSystem();
             void initialize(const GameConfig& config, const IO::Path& gamePath, const std::vector<IO::Path>& additionalSearchPaths, Logger& logger);
@@ -49,6 +51,7 @@ namespace TrenchBroom {
             void addShaderFileSystem(const GameConfig& config, Logger& logger);
             void addFileSystemPath(const IO::Path& path, Logger& logger);
             void addFileSystemPackages(const GameConfig& config, const IO::Path& searchPath, Logger& logger);
+            std::shared_ptr<IO::ZipIndexCache> zipIndexCache();
         private:
             bool doDirectoryExists(const IO::Path& path) const override;
             bool doFileExists(const IO::Path& path) const override;
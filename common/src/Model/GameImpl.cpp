@@ -22,6 +22,8 @@
 #include "Ensure.h"
 #include "Exceptions.h"
 #include "Macros.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
 #include "Assets/Palette.h"
 #include "Assets/EntityModel.h"
 #include "Assets/EntityDefinitionFileSpec.h"
@@ -37,6 +39,7 @@
 #include "IO/File.h"
 #include "IO/FileMatcher.h"
 #include "IO/IOUtils.h"
+#include "IO/MapCache.h"
 #include "IO/MdlParser.h"
 #include "IO/Md2Parser.h"
 #include "IO/Md3Parser.h"
@@ -142,9 +145,15 @@ namespace TrenchBroom {
         }
 
         std::unique_ptr<WorldNode> GameImpl::doLoadMap(const MapFormat format, const vm::bbox3& worldBounds, const IO::Path& path, Logger& logger) const {
-            IO::SimpleParserStatus parserStatus(logger);
-            auto file = IO::Disk::openFile(IO::Disk::fixPath(path));
+            const auto mapPath = IO::Disk::fixPath(path);
+            auto file = IO::Disk::openFile(mapPath);
             auto fileReader = file->reader().buffer();
+
+            if (pref(Preferences::UseMapCache)) {
+                return IO::readWorldWithCache(mapPath, std::begin(fileReader), std::end(fileReader), format, worldBounds, logger);
+            }
+
+            IO::SimpleParserStatus parserStatus(logger);
             IO::WorldReader worldReader(std::begin(fileReader), std::end(fileReader));
             return worldReader.read(format, worldBounds, parserStatus);
         }
@@ -38,6 +38,7 @@ namespace TrenchBroom {
         private:
             void takeSnapshot(GroupNode* group);
             void doRestore(const vm::bbox3& worldBounds) override;
+            size_t doGetMemorySize() const override;
         };
     }
 }
@@ -28,6 +28,7 @@
 
 #include <kdl/vector_utils.h>
 
+#include <atomic>
 #include <string>
 
 namespace TrenchBroom {
@@ -92,7 +93,8 @@ namespace TrenchBroom {
         }
 
         size_t Issue::nextSeqId() {
-            static size_t seqId = 0;
+            // issues may be generated on several threads at once
+            static std::atomic<size_t> seqId(0);
             return seqId++;
         }
 
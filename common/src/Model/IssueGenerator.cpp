@@ -47,6 +47,10 @@ namespace TrenchBroom {
             return m_quickFixes;
         }
 
+        bool IssueGenerator::threadSafe() const {
+            return doThreadSafe();
+        }
+
         void IssueGenerator::generate(WorldNode* worldNode, IssueList& issues) const {
             doGenerate(worldNode, issues);
         }
@@ -76,7 +80,11 @@ namespace TrenchBroom {
             assert(!kdl::vec_contains(m_quickFixes, quickFix));
             m_quickFixes.push_back(quickFix);
         }
- 
+
+        bool IssueGenerator::doThreadSafe() const {
+            return true;
+        }
+
         void IssueGenerator::doGenerate(WorldNode* worldNode,   IssueList& issues) const { doGenerate(static_cast<AttributableNode*>(worldNode), issues); }
         void IssueGenerator::doGenerate(LayerNode*,             IssueList&) const        {}
         void IssueGenerator::doGenerate(GroupNode*,             IssueList&) const        {}
@@ -51,6 +51,12 @@ namespace TrenchBroom {
             const std::string& description() const;
             const IssueQuickFixList& quickFixes() const;
 
+            /**
+             * Indicates whether this generator may run on different nodes concurrently. This is the case for
+             * generators whose results only depend on the node they are given.
+             */
+            bool threadSafe() const;
+
             void generate(WorldNode* worldNode,   IssueList& issues) const;
             void generate(LayerNode* layerNode,   IssueList& issues) const;
             void generate(GroupNode* groupNode,   IssueList& issues) const;
@@ -60,6 +66,8 @@ namespace TrenchBroom {
             IssueGenerator(IssueType type, const std::string& description);
             void addQuickFix(IssueQuickFix* quickFix);
         private:
+            virtual bool doThreadSafe() const;
+
             virtual void doGenerate(WorldNode* worldNode,           IssueList& issues) const;
             virtual void doGenerate(LayerNode* layerNode,           IssueList& issues) const;
             virtual void doGenerate(GroupNode* groupNode,           IssueList& issues) const;
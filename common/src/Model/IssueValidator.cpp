@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "IssueValidator.h"
+
+#include "Model/IssueGenerator.h"
+#include "Model/Node.h"
+
+#include <kdl/parallel.h>
+#include <kdl/vector_utils.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        using Clock = std::chrono::steady_clock;
+
+        IssueValidator::GeneratorStats::GeneratorStats(const IssueGenerator* i_generator) :
+        generator(i_generator),
+        time(0),
+        issueCount(0u) {}
+
+        IssueValidator::IssueValidator(const std::vector<IssueGenerator*>& generators, const size_t threadCount) :
+        m_generators(generators),
+        m_threadCount(threadCount),
+        m_nextNode(0u) {
+            for (size_t i = 0u; i < m_generators.size(); ++i) {
+                if (m_generators[i]->threadSafe()) {
+                    m_threadSafeGenerators.push_back(i);
+                } else {
+                    m_otherGenerators.push_back(i);
+                }
+                m_stats.emplace_back(m_generators[i]);
+            }
+        }
+
+        void IssueValidator::start(const std::vector<Node*>& nodes) {
+            m_nodes = kdl::vec_filter(nodes, [](const Node* node) { return !node->issuesValid(); });
+            m_nextNode = 0u;
+
+            for (auto& stats : m_stats) {
+                stats.time = std::chrono::nanoseconds(0);
+                stats.issueCount = 0u;
+            }
+        }
+
+        void IssueValidator::cancel() {
+            m_nodes.clear();
+            m_nextNode = 0u;
+        }
+
+        bool IssueValidator::finished() const {
+            return m_nextNode == m_nodes.size();
+        }
+
+        size_t IssueValidator::pendingNodeCount() const {
+            return m_nodes.size() - m_nextNode;
+        }
+
+        /**
+         * The time spent and the number of issues found by one generator for one node.
+         */
+        struct Sample {
+            std::chrono::nanoseconds time;
+            size_t issueCount;
+        };
+
+        template <typename F>
+        static Sample sample(std::vector<Issue*>& issues, F&& generate) {
+            const auto issueCount = issues.size();
+            const auto start = Clock::now();
+            generate();
+            return { Clock::now() - start, issues.size() - issueCount };
+        }
+
+        std::vector<Issue*> IssueValidator::validateNext(const size_t maxNodeCount) {
+            const auto first = m_nextNode;
+            const auto count = std::min(maxNodeCount, pendingNodeCount());
+            m_nextNode += count;
+
+            // a node might have been validated elsewhere since this validation was started
+            std::vector<Node*> nodes;
+            nodes.reserve(count);
+            for (size_t i = first; i < first + count; ++i) {
+                if (!m_nodes[i]->issuesValid()) {
+                    nodes.push_back(m_nodes[i]);
+                }
+            }
+
+            std::vector<std::vector<Issue*>> nodeIssues(nodes.size());
+            const auto sampleCount = m_threadSafeGenerators.size();
+            std::vector<Sample> samples(nodes.size() * sampleCount);
+
+            // every task only touches its own node, issue list and samples
+            kdl::parallel_for(nodes.size(), [&](const size_t i) {
+                auto* node = nodes[i];
+                auto& issues = nodeIssues[i];
+                for (size_t j = 0u; j < sampleCount; ++j) {
+                    const auto* generator = m_generators[m_threadSafeGenerators[j]];
+                    samples[i * sampleCount + j] = sample(issues, [&]() { node->generateIssues(generator, issues); });
+                }
+            }, m_threadCount);
+
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                for (size_t j = 0u; j < sampleCount; ++j) {
+                    const auto& s = samples[i * sampleCount + j];
+                    auto& stats = m_stats[m_threadSafeGenerators[j]];
+                    stats.time += s.time;
+                    stats.issueCount += s.issueCount;
+                }
+            }
+
+            std::vector<Issue*> result;
+            for (size_t i = 0u; i < nodes.size(); ++i) {
+                auto* node = nodes[i];
+                auto& issues = nodeIssues[i];
+                for (const auto index : m_otherGenerators) {
+                    const auto s = sample(issues, [&]() { node->generateIssues(m_generators[index], issues); });
+                    m_stats[index].time += s.time;
+                    m_stats[index].issueCount += s.issueCount;
+                }
+
+                kdl::vec_append(result, issues);
+                node->setIssues(std::move(issues));
+            }
+
+            return result;
+        }
+
+        const std::vector<IssueValidator::GeneratorStats>& IssueValidator::stats() const {
+            return m_stats;
+        }
+    }
+}
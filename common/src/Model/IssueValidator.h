@@ -0,0 +1,97 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_IssueValidator
+#define TrenchBroom_IssueValidator
+
+#include <kdl/parallel.h>
+
+#include <chrono>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        class Issue;
+        class IssueGenerator;
+        class Node;
+
+        /**
+         * Generates the issues of nodes whose issues are invalid. The nodes are validated in batches so that callers
+         * can present the issues of one batch before validating the next one.
+         *
+         * Within a batch, the thread safe generators run on several nodes concurrently. The remaining generators run
+         * on the calling thread afterwards. The time spent in each generator is recorded.
+         */
+        class IssueValidator {
+        public:
+            struct GeneratorStats {
+                const IssueGenerator* generator;
+                /**
+                 * The time spent in the generator, summed over all threads.
+                 */
+                std::chrono::nanoseconds time;
+                size_t issueCount;
+
+                explicit GeneratorStats(const IssueGenerator* generator);
+            };
+        private:
+            std::vector<IssueGenerator*> m_generators;
+            std::vector<size_t> m_threadSafeGenerators;
+            std::vector<size_t> m_otherGenerators;
+            size_t m_threadCount;
+
+            std::vector<Node*> m_nodes;
+            size_t m_nextNode;
+            std::vector<GeneratorStats> m_stats;
+        public:
+            explicit IssueValidator(const std::vector<IssueGenerator*>& generators, size_t threadCount = kdl::default_thread_count());
+
+            /**
+             * Starts validating the given nodes. Nodes whose issues are already valid are skipped. Any previous
+             * validation is abandoned, and the statistics are reset.
+             */
+            void start(const std::vector<Node*>& nodes);
+
+            /**
+             * Abandons the current validation. Must be called if any of the pending nodes might have been deleted.
+             */
+            void cancel();
+
+            bool finished() const;
+            size_t pendingNodeCount() const;
+
+            /**
+             * Validates the issues of the next batch of at most the given number of pending nodes, and stores them in
+             * their nodes.
+             *
+             * @param maxNodeCount the maximum number of nodes to validate
+             * @return the issues found in this batch
+             */
+            std::vector<Issue*> validateNext(size_t maxNodeCount);
+
+            /**
+             * Returns the statistics of all generators, in the order in which the generators were given, for the
+             * batches validated since the last call to start().
+             */
+            const std::vector<GeneratorStats>& stats() const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_IssueValidator) */
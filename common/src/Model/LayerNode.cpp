@@ -122,10 +122,10 @@ namespace TrenchBroom {
             return m_physicalBounds;
         }
 
-        Node* LayerNode::doClone(const vm::bbox3& worldBounds) const {
+        Node* LayerNode::doClone(const vm::bbox3& /* worldBounds */) const {
             LayerNode* layer = new LayerNode(doGetName());
             cloneAttributes(layer);
-            layer->addChildren(clone(worldBounds, children()));
+            layer->setAttributes(attributes());
             return layer;
         }
 
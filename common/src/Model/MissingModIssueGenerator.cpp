@@ -99,6 +99,11 @@ namespace TrenchBroom {
             addQuickFix(new MissingModIssueQuickFix());
         }
 
+        bool MissingModIssueGenerator::doThreadSafe() const {
+            // remembers the last mods that were checked
+            return false;
+        }
+
         void MissingModIssueGenerator::doGenerate(AttributableNode* node, IssueList& issues) const {
             assert(node != nullptr);
 
@@ -40,6 +40,7 @@ namespace TrenchBroom {
         public:
             MissingModIssueGenerator(std::weak_ptr<Game> game);
         private:
+            bool doThreadSafe() const override;
             void doGenerate(AttributableNode* node, IssueList& issues) const override;
         };
     }
@@ -20,10 +20,17 @@
 #include "ModelUtils.h"
 
 #include "Ensure.h"
+#include "Model/BrushNode.h"
 #include "Model/CollectNodesVisitor.h"
+#include "Model/EditorContext.h"
+#include "Model/WorldNode.h"
 
+#include <kdl/parallel.h>
 #include <kdl/vector_utils.h>
 
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -69,5 +76,108 @@ namespace TrenchBroom {
 
             return result;
         }
+
+        /**
+         * Below this number of exact tests, the tests are not worth distributing over several threads.
+         */
+        static const size_t MinParallelTests = 64u;
+
+        /**
+         * Collects the selectable nodes that match any of the given brushes according to the given predicate. Only
+         * nodes whose bounds intersect the bounds of a brush are considered, and if a group matches, it is returned
+         * instead of its members.
+         *
+         * The groups are tested on the calling thread, but the entities and brushes, which can be many, are tested
+         * concurrently against the brushes whose bounds they intersect.
+         */
+        template <typename M>
+        static std::vector<Node*> collectMatchingNodes(const WorldNode& world, const std::vector<BrushNode*>& brushes, const EditorContext& editorContext, const bool excludeBrushes, const M& matches) {
+            std::vector<Node*> candidates;
+            std::vector<std::vector<const BrushNode*>> candidateBrushes;
+            std::unordered_map<Node*, size_t> candidateIndices;
+            for (const auto* brush : brushes) {
+                for (auto* node : world.findNodesIntersecting(brush->logicalBounds())) {
+                    const auto [it, inserted] = candidateIndices.emplace(node, candidates.size());
+                    if (inserted) {
+                        candidates.push_back(node);
+                        candidateBrushes.emplace_back();
+                    }
+                    candidateBrushes[it->second].push_back(brush);
+                }
+            }
+
+            const auto isQuery = [&](const Node* node) {
+                return excludeBrushes && std::find(std::begin(brushes), std::end(brushes), node) != std::end(brushes);
+            };
+            const auto matchesAny = [&](const Node* node, const std::vector<const BrushNode*>& queries) {
+                return std::any_of(std::begin(queries), std::end(queries), [&](const auto* query) { return matches(query, node); });
+            };
+
+            // A group that matches is collected instead of its members, so the ancestors of each candidate are tested
+            // first, outermost first. The ancestors are tested against all brushes because their bounds are not known
+            // to the node tree.
+            const auto queries = std::vector<const BrushNode*>(std::begin(brushes), std::end(brushes));
+            std::unordered_map<const Node*, bool> ancestorMatches;
+            const auto findMatchingAncestor = [&](const Node* node) -> Node* {
+                std::vector<Node*> ancestors;
+                for (auto* parent = node->parent(); parent != nullptr; parent = parent->parent()) {
+                    ancestors.push_back(parent);
+                }
+
+                for (auto it = ancestors.rbegin(); it != ancestors.rend(); ++it) {
+                    auto* ancestor = *it;
+                    auto [entry, inserted] = ancestorMatches.emplace(ancestor, false);
+                    if (inserted) {
+                        entry->second = editorContext.selectable(ancestor) && !isQuery(ancestor) && matchesAny(ancestor, queries);
+                    }
+                    if (entry->second) {
+                        return ancestor;
+                    }
+                }
+                return nullptr;
+            };
+
+            std::vector<Node*> result;
+            std::unordered_set<Node*> collected;
+            std::vector<size_t> tests;
+            for (size_t i = 0u; i < candidates.size(); ++i) {
+                auto* candidate = candidates[i];
+                if (auto* ancestor = findMatchingAncestor(candidate)) {
+                    if (collected.insert(ancestor).second) {
+                        result.push_back(ancestor);
+                    }
+                } else if (editorContext.selectable(candidate) && !isQuery(candidate)) {
+                    tests.push_back(i);
+                }
+            }
+
+            std::vector<char> testResults(tests.size(), false);
+            const auto numThreads = tests.size() < MinParallelTests ? 1u : kdl::default_thread_count();
+            kdl::parallel_for(tests.size(), [&](const size_t i) {
+                const auto index = tests[i];
+                testResults[i] = matchesAny(candidates[index], candidateBrushes[index]);
+            }, numThreads);
+
+            for (size_t i = 0u; i < tests.size(); ++i) {
+                auto* candidate = candidates[tests[i]];
+                if (testResults[i] && collected.insert(candidate).second) {
+                    result.push_back(candidate);
+                }
+            }
+
+            return result;
+        }
+
+        std::vector<Node*> collectTouchingNodes(const WorldNode& world, const std::vector<BrushNode*>& brushes, const EditorContext& editorContext) {
+            return collectMatchingNodes(world, brushes, editorContext, true, [](const BrushNode* brush, const Node* node) {
+                return brush->intersects(node);
+            });
+        }
+
+        std::vector<Node*> collectContainedNodes(const WorldNode& world, const std::vector<BrushNode*>& brushes, const EditorContext& editorContext) {
+            return collectMatchingNodes(world, brushes, editorContext, false, [](const BrushNode* brush, const Node* node) {
+                return brush != node && brush->contains(node);
+            });
+        }
     }
 }
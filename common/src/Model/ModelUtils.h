@@ -28,7 +28,10 @@
 
 namespace TrenchBroom {
     namespace Model {
+        class BrushNode;
+        class EditorContext;
         class Node;
+        class WorldNode;
 
         std::vector<Node*> collectParents(const std::vector<Node*>& nodes);
         std::vector<Node*> collectParents(const std::map<Node*, std::vector<Node*>>& nodes);
@@ -43,6 +46,24 @@ namespace TrenchBroom {
         std::vector<Node*> collectChildren(const std::map<Node*, std::vector<Node*>>& nodes);
         std::vector<Node*> collectDescendants(const std::vector<Node*>& nodes);
         std::map<Node*, std::vector<Node*>> parentChildrenMap(const std::vector<Node*>& nodes);
+
+        /**
+         * Returns the selectable nodes of the given world that touch any of the given brushes, excluding the brushes
+         * themselves. If a group touches a brush, the group is returned instead of its members.
+         *
+         * The candidates are found using the world's node tree and then tested exactly, concurrently if there are
+         * many of them. The result is the same as that of a CollectTouchingNodesVisitor.
+         */
+        std::vector<Node*> collectTouchingNodes(const WorldNode& world, const std::vector<BrushNode*>& brushes, const EditorContext& editorContext);
+
+        /**
+         * Returns the selectable nodes of the given world that are contained in any of the given brushes. If a group
+         * is contained in a brush, the group is returned instead of its members.
+         *
+         * The candidates are found using the world's node tree and then tested exactly, concurrently if there are
+         * many of them. The result is the same as that of a CollectContainedNodesVisitor.
+         */
+        std::vector<Node*> collectContainedNodes(const WorldNode& world, const std::vector<BrushNode*>& brushes, const EditorContext& editorContext);
     }
 }
 
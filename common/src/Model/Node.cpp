@@ -606,6 +606,20 @@ namespace TrenchBroom {
             return m_issues;
         }
 
+        bool Node::issuesValid() const {
+            return m_issuesValid;
+        }
+
+        void Node::generateIssues(const IssueGenerator* generator, std::vector<Issue*>& issues) {
+            doGenerateIssues(generator, issues);
+        }
+
+        void Node::setIssues(std::vector<Issue*> issues) {
+            clearIssues();
+            m_issues = std::move(issues);
+            m_issuesValid = true;
+        }
+
         bool Node::issueHidden(const IssueType type) const {
             return (type & m_hiddenIssues) != 0;
         }
@@ -297,6 +297,24 @@ namespace TrenchBroom {
         public: // issue management
             const std::vector<Issue*>& issues(const std::vector<IssueGenerator*>& issueGenerators);
 
+            /**
+             * Indicates whether the issues of this node are up to date.
+             */
+            bool issuesValid() const;
+
+            /**
+             * Runs the given generator on this node and appends the issues it finds to the given vector. The issues of
+             * this node are not changed, so this can be called for different nodes concurrently if the generator
+             * allows it.
+             */
+            void generateIssues(const IssueGenerator* generator, std::vector<Issue*>& issues);
+
+            /**
+             * Replaces the issues of this node with the given issues and marks them as valid. This node takes
+             * ownership of the given issues.
+             */
+            void setIssues(std::vector<Issue*> issues);
+
             bool issueHidden(IssueType type) const;
             void setIssueHidden(IssueType type, bool hidden);
         public: // should only be called from this and from the world
@@ -20,7 +20,7 @@
 #ifndef TrenchBroom_Polyhedron_h
 #define TrenchBroom_Polyhedron_h
 
-#include "Allocator.h"
+#include "Polyhedron_Allocator.h"
 
 #include "Polyhedron_Forward.h"
 
@@ -36,6 +36,7 @@
 #include <limits>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <variant>
 #include <vector>
 #include <unordered_set>
@@ -47,10 +48,10 @@ namespace TrenchBroom {
         /**
          * Maps a vertex to its contained kdl::intrusive_circular_link member, used for intrusive_circular_list.
          */
-        template <typename T, typename FP, typename VP>
+        template <typename T, typename FP, typename VP, typename AP>
         struct Polyhedron_GetVertexLink {
-            kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP>>& operator()(Polyhedron_Vertex<T,FP,VP>* vertex) const;
-            const kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP>>& operator()(const Polyhedron_Vertex<T,FP,VP>* vertex) const;
+            kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP,AP>>& operator()(Polyhedron_Vertex<T,FP,VP,AP>* vertex) const;
+            const kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP,AP>>& operator()(const Polyhedron_Vertex<T,FP,VP,AP>* vertex) const;
         };
 
         /**
@@ -64,18 +65,18 @@ namespace TrenchBroom {
          *
          * The payload of a vertex can be used to store user data.
          */
-        template <typename T, typename FP, typename VP>
-        class Polyhedron_Vertex : public Allocator<Polyhedron_Vertex<T,FP,VP>> {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron_Vertex : public AP::template Element<Polyhedron_Vertex<T,FP,VP,AP>> {
         private:
-            friend class Polyhedron<T,FP,VP>;
-            friend class Polyhedron_Edge<T,FP,VP>;
-            friend class Polyhedron_HalfEdge<T,FP,VP>;
-            friend class Polyhedron_Face<T,FP,VP>;
-            friend struct Polyhedron_GetVertexLink<T,FP,VP>;
-
-            using Vertex = Polyhedron_Vertex<T,FP,VP>;
-            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
-            using Face = Polyhedron_Face<T,FP,VP>;
+            friend class Polyhedron<T,FP,VP,AP>;
+            friend class Polyhedron_Edge<T,FP,VP,AP>;
+            friend class Polyhedron_HalfEdge<T,FP,VP,AP>;
+            friend class Polyhedron_Face<T,FP,VP,AP>;
+            friend struct Polyhedron_GetVertexLink<T,FP,VP,AP>;
+
+            using Vertex = Polyhedron_Vertex<T,FP,VP,AP>;
+            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP,AP>;
+            using Face = Polyhedron_Face<T,FP,VP,AP>;
         private:
             /**
              * The vertex position.
@@ -180,10 +181,10 @@ namespace TrenchBroom {
         /**
          * Maps an edge to its contained kdl::intrusive_circular_link member, used for intrusive_circular_list.
          */
-        template <typename T, typename FP, typename VP>
+        template <typename T, typename FP, typename VP, typename AP>
         struct Polyhedron_GetEdgeLink {
-            kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP>>& operator()(Polyhedron_Edge<T,FP,VP>* edge) const;
-            const kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP>>& operator()(const Polyhedron_Edge<T,FP,VP>* edge) const;
+            kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP,AP>>& operator()(Polyhedron_Edge<T,FP,VP,AP>* edge) const;
+            const kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP,AP>>& operator()(const Polyhedron_Edge<T,FP,VP,AP>* edge) const;
         };
 
         /**
@@ -201,19 +202,19 @@ namespace TrenchBroom {
          * Furthermore, an edge has a link to its previous and next neighbours in the containing intrusive circular
          * list.
          */
-        template <typename T, typename FP, typename VP>
-        class Polyhedron_Edge : public Allocator<Polyhedron_Edge<T,FP,VP>> {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron_Edge : public AP::template Element<Polyhedron_Edge<T,FP,VP,AP>> {
         private:
-            friend class Polyhedron<T,FP,VP>;
-            friend class Polyhedron_Vertex<T,FP,VP>;
-            friend class Polyhedron_HalfEdge<T,FP,VP>;
-            friend class Polyhedron_Face<T,FP,VP>;
-            friend struct Polyhedron_GetEdgeLink<T,FP,VP>;
-
-            using Vertex = Polyhedron_Vertex<T,FP,VP>;
-            using Edge = Polyhedron_Edge<T,FP,VP>;
-            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
-            using Face = Polyhedron_Face<T,FP,VP>;
+            friend class Polyhedron<T,FP,VP,AP>;
+            friend class Polyhedron_Vertex<T,FP,VP,AP>;
+            friend class Polyhedron_HalfEdge<T,FP,VP,AP>;
+            friend class Polyhedron_Face<T,FP,VP,AP>;
+            friend struct Polyhedron_GetEdgeLink<T,FP,VP,AP>;
+
+            using Vertex = Polyhedron_Vertex<T,FP,VP,AP>;
+            using Edge = Polyhedron_Edge<T,FP,VP,AP>;
+            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP,AP>;
+            using Face = Polyhedron_Face<T,FP,VP,AP>;
         private:
             /**
              * The first half edge.
@@ -364,9 +365,10 @@ namespace TrenchBroom {
              *
              * @param plane the plane at which to split this edge
              * @param epsilon the epsilon value to use for point status checks
+             * @param allocator the allocator of the polyhedron that contains this edge
              * @return the newly created edge
              */
-            Edge* split(const vm::plane<T,3>& plane, T epsilon);
+            Edge* split(const vm::plane<T,3>& plane, T epsilon, AP& allocator);
 
             /**
              * Inserts a new vertex at the given position into this edge, creating two new half edges, and a new edge.
@@ -394,9 +396,10 @@ namespace TrenchBroom {
              * 1st vertex      new vertex      2nd vertex
              *
              * @param position the positition of the newly created vertex
+             * @param allocator the allocator of the polyhedron that contains this edge
              * @return the newly created edge
              */
-            Edge* insertVertex(const vm::vec<T,3>& position);
+            Edge* insertVertex(const vm::vec<T,3>& position, AP& allocator);
 
             /**
              * Flips this edge by swapping its first and second half edges.
@@ -448,10 +451,10 @@ namespace TrenchBroom {
         /**
          * Maps a half edge to its contained kdl::intrusive_circular_link member, used for intrusive_circular_list.
          */
-        template <typename T, typename FP, typename VP>
+        template <typename T, typename FP, typename VP, typename AP>
         struct Polyhedron_GetHalfEdgeLink {
-            kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP>>& operator()(Polyhedron_HalfEdge<T,FP,VP>* halfEdge) const;
-            const kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP>>& operator()(const Polyhedron_HalfEdge<T,FP,VP>* halfEdge) const;
+            kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP,AP>>& operator()(Polyhedron_HalfEdge<T,FP,VP,AP>* halfEdge) const;
+            const kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP,AP>>& operator()(const Polyhedron_HalfEdge<T,FP,VP,AP>* halfEdge) const;
         };
 
         /**
@@ -474,19 +477,19 @@ namespace TrenchBroom {
          * A half edge is stored in an intrusive circular list that belongs to the face whose boundary the half edge
          * belongs to.
          */
-        template <typename T, typename FP, typename VP>
-        class Polyhedron_HalfEdge : public Allocator<Polyhedron_HalfEdge<T,FP,VP>> {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron_HalfEdge : public AP::template Element<Polyhedron_HalfEdge<T,FP,VP,AP>> {
         private:
-            friend class Polyhedron<T,FP,VP>;
-            friend class Polyhedron_Vertex<T,FP,VP>;
-            friend class Polyhedron_Edge<T,FP,VP>;
-            friend class Polyhedron_Face<T,FP,VP>;
-            friend struct Polyhedron_GetHalfEdgeLink<T,FP,VP>;
-
-            using Vertex = Polyhedron_Vertex<T,FP,VP>;
-            using Edge = Polyhedron_Edge<T,FP,VP>;
-            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
-            using Face = Polyhedron_Face<T,FP,VP>;
+            friend class Polyhedron<T,FP,VP,AP>;
+            friend class Polyhedron_Vertex<T,FP,VP,AP>;
+            friend class Polyhedron_Edge<T,FP,VP,AP>;
+            friend class Polyhedron_Face<T,FP,VP,AP>;
+            friend struct Polyhedron_GetHalfEdgeLink<T,FP,VP,AP>;
+
+            using Vertex = Polyhedron_Vertex<T,FP,VP,AP>;
+            using Edge = Polyhedron_Edge<T,FP,VP,AP>;
+            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP,AP>;
+            using Face = Polyhedron_Face<T,FP,VP,AP>;
         private:
             /**
              * The origin vertex of this half edge.
@@ -668,10 +671,10 @@ namespace TrenchBroom {
         /**
          * Maps a face to its contained kdl::intrusive_circular_link member, used for intrusive_circular_list.
          */
-        template <typename T, typename FP, typename VP>
+        template <typename T, typename FP, typename VP, typename AP>
         struct Polyhedron_GetFaceLink {
-            kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP>>& operator()(Polyhedron_Face<T,FP,VP>* face) const;
-            const kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP>>& operator()(const Polyhedron_Face<T,FP,VP>* face) const;
+            kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP,AP>>& operator()(Polyhedron_Face<T,FP,VP,AP>* face) const;
+            const kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP,AP>>& operator()(const Polyhedron_Face<T,FP,VP,AP>* face) const;
         };
 
         /**
@@ -681,21 +684,21 @@ namespace TrenchBroom {
          * Furthermore, a face has a link to its previous and next neighbours in the containing intrusive circular
          * list.
          */
-        template <typename T, typename FP, typename VP>
-        class Polyhedron_Face : public Allocator<Polyhedron_Face<T,FP,VP>> {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron_Face : public AP::template Element<Polyhedron_Face<T,FP,VP,AP>> {
         private:
-            friend class Polyhedron<T,FP,VP>;
-            friend class Polyhedron_Vertex<T,FP,VP>;
-            friend class Polyhedron_Edge<T,FP,VP>;
-            friend class Polyhedron_HalfEdge<T,FP,VP>;
-            friend struct Polyhedron_GetFaceLink<T,FP,VP>;
-
-            using Vertex = Polyhedron_Vertex<T,FP,VP>;
-            using Edge = Polyhedron_Edge<T,FP,VP>;
-            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
-            using Face = Polyhedron_Face<T,FP,VP>;
-
-            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP>;
+            friend class Polyhedron<T,FP,VP,AP>;
+            friend class Polyhedron_Vertex<T,FP,VP,AP>;
+            friend class Polyhedron_Edge<T,FP,VP,AP>;
+            friend class Polyhedron_HalfEdge<T,FP,VP,AP>;
+            friend struct Polyhedron_GetFaceLink<T,FP,VP,AP>;
+
+            using Vertex = Polyhedron_Vertex<T,FP,VP,AP>;
+            using Edge = Polyhedron_Edge<T,FP,VP,AP>;
+            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP,AP>;
+            using Face = Polyhedron_Face<T,FP,VP,AP>;
+
+            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP,AP>;
         private:
             /**
              * The boundary of this face. The boundary of a face is a circular list of half edges, usually three or
@@ -1004,29 +1007,36 @@ namespace TrenchBroom {
             RayIntersection intersectWithRay(const vm::ray<T,3>& ray) const;
         };
 
-        template <typename T, typename FP, typename VP>
+        /**
+         * A convex polyhedron, represented as a half edge data structure.
+         *
+         * The elements of a polyhedron are allocated by the allocation policy AP, which is either
+         * Polyhedron_ArenaAllocator (the default) or Polyhedron_PoolAllocator.
+         */
+        template <typename T, typename FP, typename VP, typename AP>
         class Polyhedron {
         public:
             using FloatType = T;
             using FacePayloadType = FP;
             using VertexPayloadType = VP;
+            using AllocatorPolicy = AP;
         private:
             static constexpr const auto MinEdgeLength = T(0.01);
         public:
-            using Vertex = Polyhedron_Vertex<T,FP,VP>;
-            using Edge = Polyhedron_Edge<T,FP,VP>;
-            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP>;
-            using Face = Polyhedron_Face<T,FP,VP>;
+            using Vertex = Polyhedron_Vertex<T,FP,VP,AP>;
+            using Edge = Polyhedron_Edge<T,FP,VP,AP>;
+            using HalfEdge = Polyhedron_HalfEdge<T,FP,VP,AP>;
+            using Face = Polyhedron_Face<T,FP,VP,AP>;
         private:
             using VertexLink = kdl::intrusive_circular_link<Vertex>;
             using EdgeLink = kdl::intrusive_circular_link<Edge>;
             using HalfEdgeLink = kdl::intrusive_circular_link<HalfEdge>;
             using FaceLink = kdl::intrusive_circular_link<Face>;
         public:
-            using VertexList = Polyhedron_VertexList<T,FP,VP>;
-            using EdgeList = Polyhedron_EdgeList<T,FP,VP>;
-            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP>;
-            using FaceList = Polyhedron_FaceList<T,FP,VP>;
+            using VertexList = Polyhedron_VertexList<T,FP,VP,AP>;
+            using EdgeList = Polyhedron_EdgeList<T,FP,VP,AP>;
+            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP,AP>;
+            using FaceList = Polyhedron_FaceList<T,FP,VP,AP>;
         public:
             /**
              * Helper that maps a vertex to its position or a half edge to the position of its origin.
@@ -1060,6 +1070,12 @@ namespace TrenchBroom {
                 virtual void faceWasCopied(const Face* original, Face* copy) const;
             };
         private:
+            /**
+             * Allocates the vertices, edges, half edges and faces of this polyhedron. Must be declared before the
+             * element lists so that it outlives them.
+             */
+            AP m_allocator;
+
             /**
              * The vertices of this polyhedron, stored in a circular list that owns them.
              */
@@ -1109,39 +1125,55 @@ namespace TrenchBroom {
             /**
              * Copy constructor.
              */
-            Polyhedron(const Polyhedron<T,FP,VP>& other);
+            Polyhedron(const Polyhedron<T,FP,VP,AP>& other);
 
             /**
              * Copy constructor with callback. The callback can be used to set up the face and vertex payloads.
              *
              * @param callback the callback to call for every created face or vertex
              */
-            Polyhedron(const Polyhedron<T,FP,VP>& other, const CopyCallback& callback);
+            Polyhedron(const Polyhedron<T,FP,VP,AP>& other, const CopyCallback& callback);
 
             /**
              * Move constructor.
              */
-            Polyhedron(Polyhedron<T,FP,VP>&& other) noexcept;
+            Polyhedron(Polyhedron<T,FP,VP,AP>&& other) noexcept;
+
+            /**
+             * Destructor. If the allocation policy allows it, the elements are released without deleting them
+             * individually and their memory is freed together with the allocator.
+             */
+            ~Polyhedron();
         public: // copy and move assignment
             /**
              * Copy assignment operator.
              */
-            Polyhedron<T,FP,VP>& operator=(const Polyhedron<T,FP,VP>& other);
+            Polyhedron<T,FP,VP,AP>& operator=(const Polyhedron<T,FP,VP,AP>& other);
 
             /**
              * Move assignment operator.
              */
-            Polyhedron<T,FP,VP>& operator=(Polyhedron<T,FP,VP>&& other);
+            Polyhedron<T,FP,VP,AP>& operator=(Polyhedron<T,FP,VP,AP>&& other);
         private: // Copy helper
             class Copy;
         public: // swap function, must be implemented here because it's a public template
-            friend void swap(Polyhedron<T,FP,VP>& first, Polyhedron<T,FP,VP>& second) {
+            friend void swap(Polyhedron<T,FP,VP,AP>& first, Polyhedron<T,FP,VP,AP>& second) {
                 using std::swap;
+                swap(first.m_allocator, second.m_allocator);
                 swap(first.m_vertices, second.m_vertices);
                 swap(first.m_edges, second.m_edges);
                 swap(first.m_faces, second.m_faces);
                 swap(first.m_bounds, second.m_bounds);
             }
+        private: // element creation
+            /*
+             * The following functions create elements using the allocator of this polyhedron. The caller is
+             * responsible for storing the created elements.
+             */
+            Vertex* createVertex(const vm::vec<T,3>& position);
+            Edge* createEdge(HalfEdge* first, HalfEdge* second = nullptr);
+            HalfEdge* createHalfEdge(Vertex* origin);
+            Face* createFace(HalfEdgeList&& boundary, const vm::plane<T,3>& plane);
         public: // comparison operators
             /**
              * Returns true if this polyhedron is equal to the given polyhedron.
@@ -1162,6 +1194,11 @@ namespace TrenchBroom {
              */
             bool operator!=(const Polyhedron& other) const;
         public: // Accessors
+            /**
+             * Returns the allocator of this polyhedron.
+             */
+            const AP& allocator() const;
+
             /**
              * Returns the number of vertices of this polyhedron.
              */
@@ -1172,6 +1209,11 @@ namespace TrenchBroom {
              */
             const VertexList& vertices() const;
 
+            /**
+             * Returns the vertices of this polyhedron as a reference to the containing circular list.
+             */
+            VertexList& vertices();
+
             /**
              * Returns a vector containing the positions of all vertices of this polyhedron.
              */
@@ -1519,6 +1561,41 @@ namespace TrenchBroom {
             std::string exportObjSelectedFaces(const std::vector<const Face*>& faces) const;
 
             /* ====================== Implementation in Polyhedron_ConvexHull.h ====================== */
+        public: // Construction from planes
+            /**
+             * Constructs the convex polyhedron bounded by the given planes, whose normals must point outwards.
+             * Returns the polyhedron together with the face that lies on each plane, or null for planes that do not
+             * contribute a face to the polyhedron. The plane of each face is set to the corresponding given plane.
+             *
+             * Six axis aligned planes are turned into a cuboid directly. Otherwise, every triple of planes is
+             * intersected, and the intersection points that are not above any plane become the vertices. Each plane
+             * that contains at least three vertices becomes a face, and the edges are derived from the faces. Since
+             * all triples are intersected, this is only efficient for small numbers of planes.
+             *
+             * Nothing is returned if the planes do not bound a polyhedron, or if the faces of the polyhedron cannot be
+             * matched to the planes unambiguously, e.g. because some planes are almost coplanar.
+             *
+             * @param planes the planes bounding the polyhedron
+             * @return the polyhedron and its faces, indexed by plane
+             */
+            static std::optional<std::tuple<Polyhedron<T,FP,VP,AP>, std::vector<Face*>>> fromPlanes(const std::vector<vm::plane<T,3>>& planes);
+        private:
+            /**
+             * Matches the faces of this polyhedron to the given planes, see fromPlanes.
+             *
+             * @param planes the planes bounding this polyhedron
+             * @return the face that lies on each plane, or nothing if the faces cannot be matched unambiguously
+             */
+            std::optional<std::vector<Face*>> matchFacesToPlanes(const std::vector<vm::plane<T,3>>& planes);
+
+            /**
+             * Builds this polyhedron from the given planes by intersecting every triple of planes, see fromPlanes.
+             * This polyhedron must be empty. If nothing is returned, this polyhedron remains empty.
+             *
+             * @param planes the planes bounding this polyhedron
+             * @return the face that lies on each plane, or nothing if the planes do not bound a valid polyhedron
+             */
+            std::optional<std::vector<Face*>> intersectPlanes(const std::vector<vm::plane<T,3>>& planes);
         private: // Convex hull; adding and removing points
             /**
              * Adds the given points to this polyhedron. The effect of adding the given points to a polyhedron is that
@@ -0,0 +1,153 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Polyhedron_Allocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Model {
+        namespace {
+            /**
+             * Hands out pages to the arenas of all polyhedra. Pages are allocated in slabs to amortize the cost of
+             * aligned allocations, and returned pages are kept for reuse. Slabs are aligned to their size, so the slab
+             * of a page can be found from the page's address.
+             *
+             * Once all pages of a slab have been returned, the slab is kept for reuse unless MaxEmptySlabs slabs are
+             * already empty, in which case it is freed.
+             */
+            class PagePool {
+            private:
+                static constexpr size_t PagesPerSlab = 64u;
+                static constexpr size_t SlabSize = PagesPerSlab * Polyhedron_Arena::PageSize;
+                static constexpr size_t MaxEmptySlabs = 4u;
+
+                std::mutex m_mutex;
+                std::vector<void*> m_freePages;
+                std::unordered_map<unsigned char*, size_t> m_freePageCounts;
+                size_t m_emptySlabCount;
+            public:
+                PagePool() :
+                m_emptySlabCount(0u) {}
+
+                void* allocate() {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (m_freePages.empty()) {
+                        addSlab();
+                    }
+
+                    void* page = m_freePages.back();
+                    m_freePages.pop_back();
+
+                    auto& freePageCount = m_freePageCounts[slab(page)];
+                    if (freePageCount == PagesPerSlab) {
+                        --m_emptySlabCount;
+                    }
+                    --freePageCount;
+
+                    return page;
+                }
+
+                template <typename I>
+                void deallocate(I begin, I end) {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    for (auto it = begin; it != end; ++it) {
+                        void* page = *it;
+                        m_freePages.push_back(page);
+
+                        auto* pageSlab = slab(page);
+                        if (++m_freePageCounts[pageSlab] == PagesPerSlab) {
+                            if (m_emptySlabCount < MaxEmptySlabs) {
+                                ++m_emptySlabCount;
+                            } else {
+                                removeSlab(pageSlab);
+                            }
+                        }
+                    }
+                }
+            private:
+                static unsigned char* slab(void* page) {
+                    const auto address = reinterpret_cast<std::uintptr_t>(page);
+                    return reinterpret_cast<unsigned char*>(address & ~std::uintptr_t(SlabSize - 1u));
+                }
+
+                void addSlab() {
+                    auto* memory = static_cast<unsigned char*>(::operator new(SlabSize, std::align_val_t(SlabSize)));
+                    for (size_t i = 0u; i < PagesPerSlab; ++i) {
+                        m_freePages.push_back(memory + (PagesPerSlab - i - 1u) * Polyhedron_Arena::PageSize);
+                    }
+                    m_freePageCounts[memory] = PagesPerSlab;
+                    ++m_emptySlabCount;
+                }
+
+                void removeSlab(unsigned char* memory) {
+                    m_freePages.erase(std::remove_if(std::begin(m_freePages), std::end(m_freePages), [&](void* page) {
+                        return slab(page) == memory;
+                    }), std::end(m_freePages));
+                    m_freePageCounts.erase(memory);
+                    ::operator delete(memory, std::align_val_t(SlabSize));
+                }
+            };
+
+            PagePool& pagePool() {
+                // never destroyed, because polyhedra might be destroyed after the pool during static destruction
+                static auto* pool = new PagePool();
+                return *pool;
+            }
+        }
+
+        Polyhedron_Arena::Polyhedron_Arena() :
+        m_pages(nullptr),
+        m_pageCount(0u),
+        m_current(nullptr),
+        m_end(nullptr),
+        m_freeBlocks{} {}
+
+        Polyhedron_Arena::~Polyhedron_Arena() {
+            std::vector<void*> pages;
+            pages.reserve(m_pageCount);
+
+            PageHeader* page = m_pages;
+            while (page != nullptr) {
+                pages.push_back(page);
+                page = page->next;
+            }
+
+            pagePool().deallocate(std::begin(pages), std::end(pages));
+        }
+
+        size_t Polyhedron_Arena::allocatedBytes() const {
+            return m_pageCount * PageSize;
+        }
+
+        void Polyhedron_Arena::addPage() {
+            void* memory = pagePool().allocate();
+            m_pages = ::new (memory) PageHeader{this, m_pages};
+            ++m_pageCount;
+
+            m_current = static_cast<unsigned char*>(memory) + HeaderSize;
+            m_end = static_cast<unsigned char*>(memory) + PageSize;
+        }
+    }
+}
@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_Polyhedron_Allocator_h
+#define TrenchBroom_Polyhedron_Allocator_h
+
+#include "Allocator.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace TrenchBroom {
+    namespace Model {
+        /**
+         * Allocation policy that allocates the elements of all polyhedra from per-thread free lists that are backed by
+         * chunks shared by all threads, see Allocator. Every element is deleted individually when its polyhedron is
+         * destroyed.
+         */
+        class Polyhedron_PoolAllocator {
+        public:
+            /**
+             * The base class of the element type E.
+             */
+            template <typename E>
+            using Element = Allocator<E>;
+
+            /**
+             * Whether a polyhedron may release its elements without deleting them individually.
+             */
+            static constexpr bool ReleasesElements = false;
+        public:
+            /**
+             * Returns uninitialized memory for an element of type E.
+             */
+            template <typename E>
+            void* allocate() {
+#ifdef TB_ENABLE_ALLOCATOR
+                return Allocator<E>::operator new(sizeof(E));
+#else
+                return ::operator new(sizeof(E));
+#endif
+            }
+        };
+
+        /**
+         * A region of memory that provides the blocks for the elements of a single polyhedron.
+         *
+         * The blocks are carved out of pages of PageSize bytes which are aligned to their size. Every page starts with
+         * a header that points back to the owning arena, so that a block can be returned to its arena given only its
+         * address. Returned blocks are kept in free lists by size and are reused by subsequent allocations. All pages
+         * are returned at once when the arena is destroyed.
+         *
+         * Most brushes are cuboids whose elements take a little over 2 KiB, so the pages are kept small to limit the
+         * memory that is wasted in the last page of an arena. With 512 byte pages, a cube takes 2.5 KiB.
+         *
+         * The pages come from a pool that is shared by all arenas and allocates them from the system in slabs of
+         * several pages. The pool keeps a few completely unused slabs for reuse and gives all further unused slabs
+         * back to the system.
+         *
+         * An arena is not synchronized because it is owned by a single polyhedron, which must not be modified by
+         * several threads at once. The pool is synchronized, so arenas can be created and destroyed on any thread.
+         */
+        class Polyhedron_Arena {
+        public:
+            static constexpr size_t PageSize = 512u;
+            static constexpr size_t Granularity = alignof(void*);
+            static constexpr size_t MaxBlockSize = 256u;
+        private:
+            struct PageHeader {
+                Polyhedron_Arena* arena;
+                PageHeader* next;
+            };
+
+            struct FreeBlock {
+                FreeBlock* next;
+            };
+
+            static constexpr size_t HeaderSize = (sizeof(PageHeader) + Granularity - 1u) / Granularity * Granularity;
+            static_assert(MaxBlockSize <= PageSize - HeaderSize, "every block must fit into a page");
+
+            PageHeader* m_pages;
+            size_t m_pageCount;
+            unsigned char* m_current;
+            unsigned char* m_end;
+            std::array<FreeBlock*, MaxBlockSize / Granularity> m_freeBlocks;
+        public:
+            Polyhedron_Arena();
+            ~Polyhedron_Arena();
+
+            Polyhedron_Arena(const Polyhedron_Arena&) = delete;
+            Polyhedron_Arena& operator=(const Polyhedron_Arena&) = delete;
+
+            /**
+             * Returns the number of bytes that this arena has allocated from the system.
+             */
+            size_t allocatedBytes() const;
+
+            /**
+             * Returns an uninitialized block of the given size. The block is aligned to Granularity.
+             */
+            void* allocate(size_t size) {
+                const size_t blockSize = roundUp(size);
+                assert(blockSize <= MaxBlockSize);
+
+                FreeBlock*& freeBlock = m_freeBlocks[blockSize / Granularity - 1u];
+                if (freeBlock != nullptr) {
+                    FreeBlock* block = freeBlock;
+                    freeBlock = block->next;
+                    return block;
+                }
+
+                if (static_cast<size_t>(m_end - m_current) < blockSize) {
+                    addPage();
+                }
+
+                void* block = m_current;
+                m_current += blockSize;
+                return block;
+            }
+
+            /**
+             * Returns the given block of the given size to the arena that allocated it.
+             */
+            static void deallocate(void* block, const size_t size) {
+                const auto address = reinterpret_cast<std::uintptr_t>(block);
+                auto* page = reinterpret_cast<PageHeader*>(address & ~std::uintptr_t(PageSize - 1u));
+                page->arena->release(block, roundUp(size));
+            }
+        private:
+            static constexpr size_t roundUp(const size_t size) {
+                return (size + Granularity - 1u) / Granularity * Granularity;
+            }
+
+            void release(void* block, const size_t blockSize) {
+                auto* freeBlock = static_cast<FreeBlock*>(block);
+                FreeBlock*& head = m_freeBlocks[blockSize / Granularity - 1u];
+                freeBlock->next = head;
+                head = freeBlock;
+            }
+
+            void addPage();
+        };
+
+        /**
+         * Allocation policy that gives every polyhedron its own arena, see Polyhedron_Arena. The elements of a
+         * polyhedron are stored close to each other, and no locks are taken when elements are created or deleted.
+         * When a polyhedron is destroyed, its elements are released and all of its memory is freed at once.
+         *
+         * Elements that are released are not destroyed, so their payloads must be trivially destructible.
+         */
+        class Polyhedron_ArenaAllocator {
+        public:
+            /**
+             * The base class of the element type E. Elements can only be created by Polyhedron_ArenaAllocator, but
+             * they can be deleted with a delete expression, in which case their memory is reused by their arena.
+             */
+            template <typename E>
+            class Element {
+            public:
+                static void* operator new(size_t size) = delete;
+
+                static void operator delete(void* block) {
+                    Polyhedron_Arena::deallocate(block, sizeof(E));
+                }
+            };
+
+            /**
+             * Whether a polyhedron may release its elements without deleting them individually.
+             */
+            static constexpr bool ReleasesElements = true;
+        private:
+            std::unique_ptr<Polyhedron_Arena> m_arena;
+        public:
+            /**
+             * Returns uninitialized memory for an element of type E. The arena is created when it is first needed.
+             */
+            template <typename E>
+            void* allocate() {
+                static_assert(alignof(E) <= Polyhedron_Arena::Granularity, "element type must fit the arena's alignment");
+                static_assert(sizeof(E) <= Polyhedron_Arena::MaxBlockSize, "element type must fit the arena's block size");
+
+                if (m_arena == nullptr) {
+                    m_arena = std::make_unique<Polyhedron_Arena>();
+                }
+                return m_arena->allocate(sizeof(E));
+            }
+
+            /**
+             * Returns the number of bytes that the arena has allocated from the system.
+             */
+            size_t allocatedBytes() const {
+                return m_arena != nullptr ? m_arena->allocatedBytes() : 0u;
+            }
+        };
+    }
+}
+
+#endif
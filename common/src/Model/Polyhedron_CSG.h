@@ -26,8 +26,8 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP> Polyhedron<T,FP,VP>::intersect(Polyhedron other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP> Polyhedron<T,FP,VP,AP>::intersect(Polyhedron other) const {
             if (!polyhedron() || !other.polyhedron()) {
                 return Polyhedron();
             }
@@ -43,19 +43,19 @@ namespace TrenchBroom {
             return other;
         }
 
-        template <typename T, typename FP, typename VP>
-        std::vector<Polyhedron<T,FP,VP>> Polyhedron<T,FP,VP>::subtract(const Polyhedron& subtrahend) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::vector<Polyhedron<T,FP,VP,AP>> Polyhedron<T,FP,VP,AP>::subtract(const Polyhedron& subtrahend) const {
             Subtract subtract(*this, subtrahend);
             return subtract.result();
         }
 
-        template <typename T, typename FP, typename VP>
-        class Polyhedron<T,FP,VP>::Subtract {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron<T,FP,VP,AP>::Subtract {
         private:
             const Polyhedron& m_minuend;
             Polyhedron m_subtrahend;
 
-            using Fragments = std::vector<Polyhedron<T,FP,VP>>;
+            using Fragments = std::vector<Polyhedron<T,FP,VP,AP>>;
             Fragments m_fragments;
 
             using PlaneList = std::vector<vm::plane<T,3>>;
@@ -250,7 +250,7 @@ namespace TrenchBroom {
 
                 for (const Polyhedron& fragment : fragments) {
                     // the front fragments go directly into the result set.
-                    Polyhedron<T,FP,VP> fragmentInFront = fragment;
+                    Polyhedron<T,FP,VP,AP> fragmentInFront = fragment;
                     const auto frontClipResult = fragmentInFront.clip(curPlaneInv);
 
                     if (!frontClipResult.empty()) { // Polyhedron::clip() keeps the part behind the plane.
@@ -258,7 +258,7 @@ namespace TrenchBroom {
                     }
 
                     // back fragments need to be clipped by the rest of the subtrahend planes
-                    Polyhedron<T,FP,VP> fragmentBehind = fragment;
+                    Polyhedron<T,FP,VP,AP> fragmentBehind = fragment;
                     const auto backClipResult = fragmentBehind.clip(curPlane);
                     if (!backClipResult.empty()) {
                         backFragments.push_back(std::move(fragmentBehind));
@@ -21,8 +21,8 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkInvariant() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkInvariant() const {
             /*
              if (!checkConvex())
              return false;
@@ -54,8 +54,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkComponentCounts() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkComponentCounts() const {
             if (vertexCount() == 0u && edgeCount() == 0u && faceCount() == 0u)
                 return true; // empty
             if (vertexCount() == 1u && edgeCount() == 0u && faceCount() == 0u)
@@ -69,8 +69,8 @@ namespace TrenchBroom {
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkEulerCharacteristic() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkEulerCharacteristic() const {
             if (!polyhedron())
                 return true;
 
@@ -78,8 +78,8 @@ namespace TrenchBroom {
             return vertexCount() + faceCount() - edgeCount() == 2;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkVertices() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkVertices() const {
             const auto countIncidentEdges = [](const Vertex* vertex) -> size_t {
                 if (vertex->leaving() == nullptr) {
                     return 0u;
@@ -104,8 +104,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkOverlappingFaces() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkOverlappingFaces() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -121,8 +121,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkFaceBoundaries() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkFaceBoundaries() const {
             if (m_faces.empty()) {
                 return true;
             }
@@ -147,8 +147,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkFaceNeighbours() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkFaceNeighbours() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -171,8 +171,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkConvex() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkConvex() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -188,8 +188,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkClosed() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkClosed() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -207,8 +207,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkNoCoplanarFaces() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkNoCoplanarFaces() const {
             if (!polyhedron())
                 return true;
 
@@ -227,8 +227,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkNoDegenerateFaces() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkNoDegenerateFaces() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -249,8 +249,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkVertexLeavingEdges() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkVertexLeavingEdges() const {
             if (empty() || point()) {
                 return true;
             }
@@ -280,8 +280,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkEdges() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkEdges() const {
             if (!polyhedron()) {
                 return true;
             }
@@ -310,8 +310,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkEdgeLengths(const T minLength) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkEdgeLengths(const T minLength) const {
             if (m_edges.empty())
                 return true;
 
@@ -326,8 +326,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkLeavingEdges(const Vertex* v) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkLeavingEdges(const Vertex* v) const {
             assert(v != nullptr);
             const HalfEdge* firstEdge = v->leaving();
             assert(firstEdge != nullptr);
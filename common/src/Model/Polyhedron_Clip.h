@@ -32,36 +32,36 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::ClipResult::ClipResult(Face* face) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::ClipResult::ClipResult(Face* face) :
             m_value(face) {}
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::ClipResult::ClipResult(const FailureReason reason) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::ClipResult::ClipResult(const FailureReason reason) :
             m_value(reason) {}
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::ClipResult::unchanged() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::ClipResult::unchanged() const {
             return std::holds_alternative<FailureReason>(m_value) && std::get<FailureReason>(m_value) == FailureReason::Unchanged;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::ClipResult::empty() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::ClipResult::empty() const {
             return std::holds_alternative<FailureReason>(m_value) && std::get<FailureReason>(m_value) == FailureReason::Empty;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::ClipResult::success() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::ClipResult::success() const {
             return std::holds_alternative<Face*>(m_value);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::ClipResult::face() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Face* Polyhedron<T,FP,VP,AP>::ClipResult::face() const {
             return success() ? std::get<Face*>(m_value) : nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::ClipResult Polyhedron<T,FP,VP>::clip(const vm::plane<T,3>& plane) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::ClipResult Polyhedron<T,FP,VP,AP>::clip(const vm::plane<T,3>& plane) {
             assert(checkInvariant());
             
             if (const auto vertexResult = checkIntersects(plane)) {
@@ -134,8 +134,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        std::optional<typename Polyhedron<T,FP,VP>::ClipResult::FailureReason> Polyhedron<T,FP,VP>::checkIntersects(const vm::plane<T,3>& plane) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::optional<typename Polyhedron<T,FP,VP,AP>::ClipResult::FailureReason> Polyhedron<T,FP,VP,AP>::checkIntersects(const vm::plane<T,3>& plane) const {
             std::size_t above = 0u;
             std::size_t below = 0u;
             std::size_t inside = 0u;
@@ -167,8 +167,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        class Polyhedron<T,FP,VP>::NoSeamException : public Exception {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron<T,FP,VP,AP>::NoSeamException : public Exception {
         private:
             std::vector<Edge*> m_splitFaces;
         public:
@@ -180,8 +180,8 @@ namespace TrenchBroom {
             }
         };
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Seam Polyhedron<T,FP,VP>::intersectWithPlane(const vm::plane<T,3>& plane) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Seam Polyhedron<T,FP,VP,AP>::intersectWithPlane(const vm::plane<T,3>& plane) {
             Seam seam;
             std::vector<Edge*> splitFaces;
 
@@ -241,8 +241,8 @@ namespace TrenchBroom {
             return seam;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::HalfEdge* Polyhedron<T,FP,VP>::findInitialIntersectingEdge(const vm::plane<T,3>& plane) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::HalfEdge* Polyhedron<T,FP,VP,AP>::findInitialIntersectingEdge(const vm::plane<T,3>& plane) const {
             for (const Edge* currentEdge : m_edges) {
                 HalfEdge* halfEdge = currentEdge->firstEdge();
                 const vm::plane_status os = plane.point_status(halfEdge->origin()->position(), vm::constants<T>::point_status_epsilon());
@@ -289,8 +289,8 @@ namespace TrenchBroom {
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        std::tuple<typename Polyhedron<T,FP,VP>::HalfEdge*, bool> Polyhedron<T,FP,VP>::intersectWithPlane(HalfEdge* firstBoundaryEdge, const vm::plane<T,3>& plane) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::tuple<typename Polyhedron<T,FP,VP,AP>::HalfEdge*, bool> Polyhedron<T,FP,VP,AP>::intersectWithPlane(HalfEdge* firstBoundaryEdge, const vm::plane<T,3>& plane) {
 
             // Starting at the given edge, we search the boundary of the incident face until we find an edge that is either split in two by the given plane
             // or where its origin is inside it. In the first case, we split the found edge by inserting a vertex at the position where
@@ -321,7 +321,7 @@ namespace TrenchBroom {
                            (os == vm::plane_status::above && ds == vm::plane_status::below)) {
                     // We have to split the edge and insert a new vertex, which will become the origin or destination of the new seam edge.
                     Edge* currentEdge = currentBoundaryEdge->edge();
-                    Edge* newEdge = currentEdge->split(plane, vm::constants<T>::point_status_epsilon());
+                    Edge* newEdge = currentEdge->split(plane, vm::constants<T>::point_status_epsilon(), m_allocator);
                     m_edges.push_back(newEdge);
 
                     currentBoundaryEdge = currentBoundaryEdge->next();
@@ -364,19 +364,19 @@ namespace TrenchBroom {
             return std::make_tuple(seamDestination->previous(), faceWasSplit);
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::intersectWithPlane(HalfEdge* oldBoundaryFirst, HalfEdge* newBoundaryFirst) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::intersectWithPlane(HalfEdge* oldBoundaryFirst, HalfEdge* newBoundaryFirst) {
             HalfEdge* newBoundaryLast = oldBoundaryFirst->previous();
 
-            HalfEdge* oldBoundarySplitter = new HalfEdge(newBoundaryFirst->origin());
-            HalfEdge* newBoundarySplitter = new HalfEdge(oldBoundaryFirst->origin());
+            HalfEdge* oldBoundarySplitter = createHalfEdge(newBoundaryFirst->origin());
+            HalfEdge* newBoundarySplitter = createHalfEdge(oldBoundaryFirst->origin());
 
             Face* oldFace = oldBoundaryFirst->face();
             oldFace->insertIntoBoundaryAfter(newBoundaryLast, HalfEdgeList({ newBoundarySplitter }));
             HalfEdgeList newBoundary = oldFace->replaceBoundary(newBoundaryFirst, newBoundarySplitter, HalfEdgeList({ oldBoundarySplitter }));
 
-            Face* newFace = new Face(std::move(newBoundary), oldFace->plane());
-            Edge* newEdge = new Edge(oldBoundarySplitter, newBoundarySplitter);
+            Face* newFace = createFace(std::move(newBoundary), oldFace->plane());
+            Edge* newEdge = createEdge(oldBoundarySplitter, newBoundarySplitter);
 
             m_edges.push_back(newEdge);
             m_faces.push_back(newFace);
@@ -385,8 +385,8 @@ namespace TrenchBroom {
         /*
          Searches all edges leaving searchFrom's destination for an edge that is intersected by the given plane.
          */
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::HalfEdge* Polyhedron<T,FP,VP>::findNextIntersectingEdge(HalfEdge* searchFrom, const vm::plane<T,3>& plane) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::HalfEdge* Polyhedron<T,FP,VP,AP>::findNextIntersectingEdge(HalfEdge* searchFrom, const vm::plane<T,3>& plane) const {
             HalfEdge* currentEdge = searchFrom->next();
             HalfEdge* stopEdge = searchFrom->twin();
             do {
@@ -24,6 +24,7 @@
 
 #include "Polyhedron.h"
 #include "Exceptions.h"
+#include "SimdIntersection.h"
 
 #include <kdl/vector_utils.h>
 
@@ -33,15 +34,20 @@
 #include <vecmath/segment.h>
 #include <vecmath/util.h>
 
+#include <algorithm>
+#include <cmath>
 #include <list>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Model {
         namespace {
-            template <typename T, typename FP, typename VP>
-            vm::plane<T,3> makePlaneFromBoundary(const Polyhedron_HalfEdgeList<T,FP,VP>& boundary) {
+            template <typename T, typename FP, typename VP, typename AP>
+            vm::plane<T,3> makePlaneFromBoundary(const Polyhedron_HalfEdgeList<T,FP,VP,AP>& boundary) {
                 if (boundary.size() < 3) {
                     throw GeometryException("boundary must have at least thee vertices");
                 }
@@ -73,8 +79,283 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::addPoints(std::vector<vm::vec<T,3>> points) {
+        namespace {
+            /**
+             * Returns the cuboid bounded by the given planes if they are six axis aligned planes facing in all six
+             * directions.
+             */
+            template <typename T>
+            std::optional<vm::bbox<T,3>> axisAlignedBox(const std::vector<vm::plane<T,3>>& planes) {
+                if (planes.size() != 6u) {
+                    return std::nullopt;
+                }
+
+                vm::bbox<T,3> box;
+                unsigned found = 0u;
+                for (const auto& plane : planes) {
+                    const auto axis = vm::find_abs_max_component(plane.normal);
+                    if (vm::abs(plane.normal[axis]) != T(1) || plane.normal[(axis + 1u) % 3u] != T(0) || plane.normal[(axis + 2u) % 3u] != T(0)) {
+                        return std::nullopt;
+                    }
+
+                    const auto positive = plane.normal[axis] > T(0);
+                    const auto bit = 1u << (2u * axis + (positive ? 1u : 0u));
+                    if ((found & bit) != 0u) {
+                        return std::nullopt;
+                    }
+                    found |= bit;
+
+                    if (positive) {
+                        box.max[axis] = plane.distance;
+                    } else {
+                        box.min[axis] = -plane.distance;
+                    }
+                }
+
+                for (size_t i = 0u; i < 3u; ++i) {
+                    if (box.min[i] >= box.max[i]) {
+                        return std::nullopt;
+                    }
+                }
+                return box;
+            }
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        std::optional<std::tuple<Polyhedron<T,FP,VP,AP>, std::vector<typename Polyhedron<T,FP,VP,AP>::Face*>>> Polyhedron<T,FP,VP,AP>::fromPlanes(const std::vector<vm::plane<T,3>>& planes) {
+            if (planes.size() < 4u) {
+                return std::nullopt;
+            }
+
+            if (const auto box = axisAlignedBox(planes)) {
+                auto result = Polyhedron<T,FP,VP,AP>(*box);
+                if (auto faces = result.matchFacesToPlanes(planes)) {
+                    return std::make_tuple(std::move(result), std::move(*faces));
+                }
+                return std::nullopt;
+            }
+
+            auto result = Polyhedron<T,FP,VP,AP>();
+            if (auto faces = result.intersectPlanes(planes)) {
+                return std::make_tuple(std::move(result), std::move(*faces));
+            }
+            return std::nullopt;
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        std::optional<std::vector<typename Polyhedron<T,FP,VP,AP>::Face*>> Polyhedron<T,FP,VP,AP>::intersectPlanes(const std::vector<vm::plane<T,3>>& planes) {
+            assert(empty());
+
+            const auto epsilon = vm::constants<T>::point_status_epsilon();
+
+            // planes that are almost parallel yield imprecise intersection points
+            const auto minDeterminant = T(1e-6);
+
+            PlaneList<T> planeList;
+            for (const auto& plane : planes) {
+                planeList.push_back(plane);
+            }
+
+            // Find the vertices by intersecting every triple of planes. Several triples yield the same vertex if more
+            // than three planes meet in it.
+            std::vector<vm::vec<T,3>> positions;
+            for (size_t k = 2u; k < planes.size(); ++k) {
+                for (size_t j = 1u; j < k; ++j) {
+                    const auto& pj = planes[j];
+                    const auto& pk = planes[k];
+                    const auto jxk = vm::cross(pj.normal, pk.normal);
+                    for (size_t i = 0u; i < j; ++i) {
+                        const auto& pi = planes[i];
+                        const auto det = vm::dot(pi.normal, jxk);
+                        if (vm::abs(det) < minDeterminant) {
+                            continue;
+                        }
+
+                        const auto position = (pi.distance * jxk
+                            + pj.distance * vm::cross(pk.normal, pi.normal)
+                            + pk.distance * vm::cross(pi.normal, pj.normal)) / det;
+                        if (pointInHalfspaces(position, planeList, epsilon)) {
+                            const auto isSame = [&](const vm::vec<T,3>& other) { return vm::squared_distance(position, other) <= epsilon * epsilon; };
+                            if (std::none_of(std::begin(positions), std::end(positions), isSame)) {
+                                positions.push_back(position);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Every plane that contains at least three vertices becomes a face. Sort the vertices of each face in
+            // counter clockwise order when viewed from above its plane.
+            std::vector<std::vector<size_t>> faceVertices(planes.size());
+            std::vector<size_t> vertexFaceCounts(positions.size(), 0u);
+            size_t faceCount = 0u;
+            size_t halfEdgeCount = 0u;
+            for (size_t i = 0u; i < planes.size(); ++i) {
+                const auto& plane = planes[i];
+                auto& indices = faceVertices[i];
+                for (size_t v = 0u; v < positions.size(); ++v) {
+                    if (vm::abs(plane.point_distance(positions[v])) <= epsilon) {
+                        indices.push_back(v);
+                    }
+                }
+
+                if (indices.size() < 3u) {
+                    indices.clear();
+                    continue;
+                }
+
+                auto center = vm::vec<T,3>::zero();
+                for (const auto v : indices) {
+                    center = center + positions[v];
+                }
+                center = center / static_cast<T>(indices.size());
+
+                const auto u = vm::normalize(positions[indices.front()] - center);
+                const auto w = vm::cross(plane.normal, u);
+                const auto angle = [&](const size_t v) {
+                    const auto d = positions[v] - center;
+                    return std::atan2(vm::dot(d, w), vm::dot(d, u));
+                };
+                std::sort(std::begin(indices), std::end(indices), [&](const size_t lhs, const size_t rhs) { return angle(lhs) < angle(rhs); });
+
+                // the face must be strictly convex, otherwise the vertices are too close to each other or the plane
+                // only touches the polyhedron
+                for (size_t n = 0u; n < indices.size(); ++n) {
+                    const auto& a = positions[indices[n]];
+                    const auto& b = positions[indices[(n + 1u) % indices.size()]];
+                    const auto& c = positions[indices[(n + 2u) % indices.size()]];
+                    if (vm::dot(vm::cross(b - a, c - b), plane.normal) <= T(0) || vm::is_colinear(a, b, c)) {
+                        return std::nullopt;
+                    }
+                }
+
+                for (const auto v : indices) {
+                    ++vertexFaceCounts[v];
+                }
+                ++faceCount;
+                halfEdgeCount += indices.size();
+            }
+
+            // Check that the faces form a closed polyhedron: every vertex belongs to at least three faces, every half
+            // edge has a twin, and Euler's formula holds.
+            if (faceCount < 4u || halfEdgeCount % 2u != 0u) {
+                return std::nullopt;
+            }
+            for (const auto count : vertexFaceCounts) {
+                if (count < 3u) {
+                    return std::nullopt;
+                }
+            }
+
+            const auto key = [&](const size_t origin, const size_t destination) { return origin * positions.size() + destination; };
+            std::unordered_map<size_t, HalfEdge*> halfEdges;
+            for (const auto& indices : faceVertices) {
+                for (size_t n = 0u; n < indices.size(); ++n) {
+                    if (!halfEdges.emplace(key(indices[n], indices[(n + 1u) % indices.size()]), nullptr).second) {
+                        return std::nullopt;
+                    }
+                }
+            }
+            for (const auto& entry : halfEdges) {
+                const auto origin = entry.first / positions.size();
+                const auto destination = entry.first % positions.size();
+                if (halfEdges.count(key(destination, origin)) == 0u) {
+                    return std::nullopt;
+                }
+            }
+
+            const auto edgeCount = halfEdgeCount / 2u;
+            if (positions.size() + faceCount != edgeCount + 2u) {
+                return std::nullopt;
+            }
+
+            // The topology is valid, so create the vertices, faces, and edges.
+            std::vector<Vertex*> vertices;
+            vertices.reserve(positions.size());
+            for (const auto& position : positions) {
+                vertices.push_back(createVertex(position));
+                m_vertices.push_back(vertices.back());
+            }
+
+            std::vector<Face*> result(planes.size(), nullptr);
+            for (size_t i = 0u; i < planes.size(); ++i) {
+                const auto& indices = faceVertices[i];
+                if (!indices.empty()) {
+                    HalfEdgeList boundary;
+                    for (size_t n = 0u; n < indices.size(); ++n) {
+                        auto* halfEdge = createHalfEdge(vertices[indices[n]]);
+                        halfEdges[key(indices[n], indices[(n + 1u) % indices.size()])] = halfEdge;
+                        boundary.push_back(halfEdge);
+                    }
+
+                    result[i] = createFace(std::move(boundary), planes[i]);
+                    m_faces.push_back(result[i]);
+                }
+            }
+
+            for (const auto& entry : halfEdges) {
+                const auto origin = entry.first / positions.size();
+                const auto destination = entry.first % positions.size();
+                if (origin < destination) {
+                    m_edges.push_back(createEdge(entry.second, halfEdges[key(destination, origin)]));
+                }
+            }
+
+            updateBounds();
+            return result;
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        std::optional<std::vector<typename Polyhedron<T,FP,VP,AP>::Face*>> Polyhedron<T,FP,VP,AP>::matchFacesToPlanes(const std::vector<vm::plane<T,3>>& planes) {
+            const auto epsilon = vm::constants<T>::point_status_epsilon();
+            const auto isOnPlane = [&](const Face* face, const vm::plane<T,3>& plane) {
+                if (vm::dot(face->plane().normal, plane.normal) <= T(0)) {
+                    return false;
+                }
+                for (const HalfEdge* halfEdge : face->boundary()) {
+                    if (vm::abs(plane.point_distance(halfEdge->origin()->position())) > epsilon) {
+                        return false;
+                    }
+                }
+                return true;
+            };
+
+            // every face must lie on a plane; if several planes are identical, the first one gets the face
+            std::vector<Face*> result(planes.size(), nullptr);
+            for (Face* face : m_faces) {
+                bool matched = false;
+                for (size_t i = 0u; i < planes.size() && !matched; ++i) {
+                    if (result[i] == nullptr && isOnPlane(face, planes[i])) {
+                        result[i] = face;
+                        face->setPlane(planes[i]);
+                        matched = true;
+                    }
+                }
+                if (!matched) {
+                    return std::nullopt;
+                }
+            }
+
+            // a plane without a face must not touch the polyhedron in more than an edge
+            for (size_t i = 0u; i < planes.size(); ++i) {
+                if (result[i] == nullptr) {
+                    size_t count = 0u;
+                    for (const Vertex* vertex : m_vertices) {
+                        if (vm::abs(planes[i].point_distance(vertex->position())) <= epsilon) {
+                            ++count;
+                        }
+                    }
+                    if (count > 2u) {
+                        return std::nullopt;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::addPoints(std::vector<vm::vec<T,3>> points) {
             if (!points.empty()) {
                 kdl::vec_sort_and_remove_duplicates(points);
                 
@@ -85,8 +366,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addPoint(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addPoint(const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(checkInvariant());
 
             // quick test to discard vertices which would yield short edges
@@ -121,26 +402,26 @@ namespace TrenchBroom {
             return result;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addFirstPoint(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addFirstPoint(const vm::vec<T,3>& position) {
             assert(empty());
-            Vertex* newVertex = new Vertex(position);
+            Vertex* newVertex = createVertex(position);
             m_vertices.push_back(newVertex);
             return newVertex;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addSecondPoint(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addSecondPoint(const vm::vec<T,3>& position) {
             assert(point());
 
             Vertex* onlyVertex = *std::begin(m_vertices);
             if (position != onlyVertex->position()) {
-                Vertex* newVertex = new Vertex(position);
+                Vertex* newVertex = createVertex(position);
                 m_vertices.push_back(newVertex);
 
-                HalfEdge* halfEdge1 = new HalfEdge(onlyVertex);
-                HalfEdge* halfEdge2 = new HalfEdge(newVertex);
-                Edge* edge = new Edge(halfEdge1, halfEdge2);
+                HalfEdge* halfEdge1 = createHalfEdge(onlyVertex);
+                HalfEdge* halfEdge2 = createHalfEdge(newVertex);
+                Edge* edge = createEdge(halfEdge1, halfEdge2);
                 m_edges.push_back(edge);
                 return newVertex;
             } else {
@@ -148,8 +429,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addThirdPoint(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addThirdPoint(const vm::vec<T,3>& position) {
             assert(edge());
 
             Vertex* v1 = m_vertices.front();
@@ -162,8 +443,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addColinearThirdPoint(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addColinearThirdPoint(const vm::vec<T,3>& position) {
             assert(edge());
 
             auto* v1 = m_vertices.front();
@@ -184,8 +465,8 @@ namespace TrenchBroom {
             return v2;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addNonColinearThirdPoint(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addNonColinearThirdPoint(const vm::vec<T,3>& position) {
             assert(edge());
 
             Vertex* v1 = m_vertices.front();
@@ -199,8 +480,8 @@ namespace TrenchBroom {
             assert(h2->next() == h2);
             assert(h2->previous() == h2);
 
-            Vertex* v3 = new Vertex(position);
-            HalfEdge* h3 = new HalfEdge(v3);
+            Vertex* v3 = createVertex(position);
+            HalfEdge* h3 = createHalfEdge(v3);
 
             Edge* e1 = m_edges.front();
             e1->makeFirstEdge(h1);
@@ -212,10 +493,10 @@ namespace TrenchBroom {
             boundary.push_back(h3);
 
             const vm::plane<T,3> plane = makePlaneFromBoundary(boundary);
-            Face* face = new Face(std::move(boundary), plane);
+            Face* face = createFace(std::move(boundary), plane);
 
-            Edge* e2 = new Edge(h2);
-            Edge* e3 = new Edge(h3);
+            Edge* e2 = createEdge(h2);
+            Edge* e3 = createEdge(h3);
 
             m_vertices.push_back(v3);
             m_edges.push_back(e2);
@@ -226,8 +507,8 @@ namespace TrenchBroom {
         }
 
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addFurtherPoint(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addFurtherPoint(const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(faceCount() > 0u);
             if (faceCount() == 1u) {
                 return addFurtherPointToPolygon(position, planeEpsilon);
@@ -236,8 +517,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addFurtherPointToPolygon(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addFurtherPointToPolygon(const vm::vec<T,3>& position, const T planeEpsilon) {
             Face* face = m_faces.front();
             const vm::plane_status status = face->pointStatus(position, planeEpsilon);
             switch (status) {
@@ -253,8 +534,8 @@ namespace TrenchBroom {
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addPointToPolygon(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addPointToPolygon(const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(polygon());
 
             Face* face = m_faces.front();
@@ -296,9 +577,9 @@ namespace TrenchBroom {
             }
 
             // Now we know which edges are visible from the point. These will have to be replaced with two new edges.
-            Vertex* newVertex = new Vertex(position);
-            HalfEdge* h1 = new HalfEdge(firstVisibleEdge->origin());
-            HalfEdge* h2 = new HalfEdge(newVertex);
+            Vertex* newVertex = createVertex(position);
+            HalfEdge* h1 = createHalfEdge(firstVisibleEdge->origin());
+            HalfEdge* h2 = createHalfEdge(newVertex);
 
             face->insertIntoBoundaryAfter(lastVisibleEdge, HalfEdgeList({ h1 }));
             face->insertIntoBoundaryAfter(h1, HalfEdgeList({ h2 }));
@@ -306,8 +587,8 @@ namespace TrenchBroom {
 
             h1->setAsLeaving();
 
-            Edge* e1 = new Edge(h1);
-            Edge* e2 = new Edge(h2);
+            Edge* e1 = createEdge(h1);
+            Edge* e2 = createEdge(h2);
 
             // delete the visible vertices and edges.
             // the visible half edges are deleted when visibleEdges goes out of scope
@@ -328,17 +609,17 @@ namespace TrenchBroom {
             return newVertex;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::makePolygon(const std::vector<vm::vec<T,3>>& positions) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::makePolygon(const std::vector<vm::vec<T,3>>& positions) {
             assert(empty());
             assert(positions.size() > 2);
 
             HalfEdgeList boundary;
             for (size_t i = 0u; i < positions.size(); ++i) {
                 const vm::vec<T,3>& p = positions[i];
-                Vertex* v = new Vertex(p);
-                HalfEdge* h = new HalfEdge(v);
-                Edge* e = new Edge(h);
+                Vertex* v = createVertex(p);
+                HalfEdge* h = createHalfEdge(v);
+                Edge* e = createEdge(h);
 
                 m_vertices.push_back(v);
                 boundary.push_back(h);
@@ -346,12 +627,12 @@ namespace TrenchBroom {
             }
 
             const vm::plane<T,3> plane = makePlaneFromBoundary(boundary);
-            Face* f = new Face(std::move(boundary), plane);
+            Face* f = createFace(std::move(boundary), plane);
             m_faces.push_back(f);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::makePolyhedron(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::makePolyhedron(const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(polygon());
 
             Seam seam;
@@ -366,8 +647,8 @@ namespace TrenchBroom {
             return weave(seam, position, planeEpsilon);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::addFurtherPointToPolyhedron(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::addFurtherPointToPolyhedron(const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(polyhedron());
             
             auto seam = createSeamForHorizon(position, planeEpsilon);
@@ -393,8 +674,8 @@ namespace TrenchBroom {
             return weave(*seam, position, planeEpsilon);
         }
 
-        template <typename T, typename FP, typename VP>
-        class Polyhedron<T,FP,VP>::Seam {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron<T,FP,VP,AP>::Seam {
         private:
             using List = std::list<Edge*>;
             List m_edges;
@@ -579,8 +860,8 @@ namespace TrenchBroom {
             }
         };
         
-        template <typename T, typename FP, typename VP>
-        std::optional<typename Polyhedron<T,FP,VP>::Seam> Polyhedron<T,FP,VP>::createSeamForHorizon(const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::optional<typename Polyhedron<T,FP,VP,AP>::Seam> Polyhedron<T,FP,VP,AP>::createSeamForHorizon(const vm::vec<T,3>& position, const T planeEpsilon) {
             Face* initialVisibleFace = nullptr;
             for (Face* face : m_faces) {
                 if (face->plane().point_status(position, planeEpsilon) != vm::plane_status::below) {
@@ -601,8 +882,8 @@ namespace TrenchBroom {
             return seam;
         }
         
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::visitFace(const vm::vec<T,3>& position, HalfEdge* initialBoundaryEdge, std::unordered_set<Face*>& visitedFaces, Seam& seam, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::visitFace(const vm::vec<T,3>& position, HalfEdge* initialBoundaryEdge, std::unordered_set<Face*>& visitedFaces, Seam& seam, const T planeEpsilon) {
             HalfEdge* currentBoundaryEdge = initialBoundaryEdge;
             do {
                 Face* neighbour = currentBoundaryEdge->twin()->face();
@@ -620,8 +901,8 @@ namespace TrenchBroom {
             } while (currentBoundaryEdge != initialBoundaryEdge);
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::split(const Seam& seam) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::split(const Seam& seam) {
             assert(seam.size() >= 3);
             assert(!seam.hasMultipleLoops());
 
@@ -650,8 +931,8 @@ namespace TrenchBroom {
             deleteFaces(first, visitedFaces, verticesToDelete);
         }
 
-        template <typename T, typename FP, typename VP> template <typename FaceSet>
-        void Polyhedron<T,FP,VP>::deleteFaces(HalfEdge* first, FaceSet& visitedFaces, VertexList& verticesToDelete) {
+        template <typename T, typename FP, typename VP, typename AP> template <typename FaceSet>
+        void Polyhedron<T,FP,VP,AP>::deleteFaces(HalfEdge* first, FaceSet& visitedFaces, VertexList& verticesToDelete) {
             Face* face = first->face();
 
             // Have we already visited this face?
@@ -701,8 +982,8 @@ namespace TrenchBroom {
             m_faces.remove(face);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::sealWithSinglePolygon(const Seam& seam, const vm::plane<T,3>& plane) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Face* Polyhedron<T,FP,VP,AP>::sealWithSinglePolygon(const Seam& seam, const vm::plane<T,3>& plane) {
             assert(seam.size() >= 3);
             assert(!seam.hasMultipleLoops());
             assert(!empty() && !point() && !edge() && !polygon());
@@ -712,18 +993,18 @@ namespace TrenchBroom {
                 assert(!seamEdge->fullySpecified());
 
                 Vertex* origin = seamEdge->secondVertex();
-                HalfEdge* boundaryEdge = new HalfEdge(origin);
+                HalfEdge* boundaryEdge = createHalfEdge(origin);
                 boundary.push_back(boundaryEdge);
                 seamEdge->setSecondEdge(boundaryEdge);
             }
 
-            Face* face = new Face(std::move(boundary), plane);
+            Face* face = createFace(std::move(boundary), plane);
             m_faces.push_back(face);
             return face;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::checkSeamForWeaving(const Seam& seam, const vm::vec<T,3>& position) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::checkSeamForWeaving(const Seam& seam, const vm::vec<T,3>& position) const {
             assert(seam.size() >= 3);
             assert(!seam.hasMultipleLoops());
             assert(!empty() && !point() && !edge());
@@ -743,13 +1024,13 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::weave(const Seam& seam, const vm::vec<T,3>& position, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::weave(const Seam& seam, const vm::vec<T,3>& position, const T planeEpsilon) {
             assert(seam.size() >= 3);
             assert(!seam.hasMultipleLoops());
             assert(!empty() && !point() && !edge());
 
-            auto* top = new Vertex(position);
+            auto* top = createVertex(position);
 
             HalfEdge* first = nullptr;
             HalfEdge* last = nullptr;
@@ -759,9 +1040,9 @@ namespace TrenchBroom {
                 auto* v1 = edge->secondVertex();
                 auto* v2 = edge->firstVertex();
 
-                auto* h1 = new HalfEdge(top);
-                auto* h2 = new HalfEdge(v1);
-                auto* h3 = new HalfEdge(v2);
+                auto* h1 = createHalfEdge(top);
+                auto* h2 = createHalfEdge(v1);
+                auto* h3 = createHalfEdge(v2);
                 auto* h = h3;
 
                 HalfEdgeList boundary;
@@ -771,10 +1052,10 @@ namespace TrenchBroom {
                 edge->setSecondEdge(h2);
 
                 const vm::plane<T,3> plane = makePlaneFromBoundary(boundary);
-                m_faces.push_back(new Face(std::move(boundary), plane));
+                m_faces.push_back(createFace(std::move(boundary), plane));
                 
                 if (last != nullptr) {
-                    m_edges.push_back(new Edge(h1, last));
+                    m_edges.push_back(createEdge(h1, last));
                 }
                 
                 if (first == nullptr) {
@@ -785,7 +1066,7 @@ namespace TrenchBroom {
             }
 
             assert(first->face() != last->face());
-            m_edges.push_back(new Edge(first, last));
+            m_edges.push_back(createEdge(first, last));
             m_vertices.push_back(top);
 
             if (mergeCoplanarIncidentFaces(top, planeEpsilon)) {
@@ -795,8 +1076,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::mergeCoplanarIncidentFaces(Vertex* vertex, const T planeEpsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::mergeCoplanarIncidentFaces(Vertex* vertex, const T planeEpsilon) {
             assert(vertex != nullptr);
             assert(checkInvariant());
             
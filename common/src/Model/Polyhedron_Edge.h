@@ -31,18 +31,18 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP>>& Polyhedron_GetEdgeLink<T,FP,VP>::operator()(Polyhedron_Edge<T,FP,VP>* edge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP,AP>>& Polyhedron_GetEdgeLink<T,FP,VP,AP>::operator()(Polyhedron_Edge<T,FP,VP,AP>* edge) const {
             return edge->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        const kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP>>& Polyhedron_GetEdgeLink<T,FP,VP>::operator()(const Polyhedron_Edge<T,FP,VP>* edge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const kdl::intrusive_circular_link<Polyhedron_Edge<T,FP,VP,AP>>& Polyhedron_GetEdgeLink<T,FP,VP,AP>::operator()(const Polyhedron_Edge<T,FP,VP,AP>* edge) const {
             return edge->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Edge<T,FP,VP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Edge<T,FP,VP,AP>::Polyhedron_Edge(HalfEdge* first, HalfEdge* second) :
             m_first(first),
             m_second(second),
 #ifdef _MSC_VER
@@ -62,14 +62,14 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::Vertex* Polyhedron_Edge<T,FP,VP>::firstVertex() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::Vertex* Polyhedron_Edge<T,FP,VP,AP>::firstVertex() const {
             assert(m_first != nullptr);
             return m_first->origin();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::Vertex* Polyhedron_Edge<T,FP,VP>::secondVertex() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::Vertex* Polyhedron_Edge<T,FP,VP,AP>::secondVertex() const {
             assert(m_first != nullptr);
             if (m_second != nullptr) {
                 return m_second->origin();
@@ -78,20 +78,20 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::HalfEdge* Polyhedron_Edge<T,FP,VP>::firstEdge() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::HalfEdge* Polyhedron_Edge<T,FP,VP,AP>::firstEdge() const {
             assert(m_first != nullptr);
             return m_first;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::HalfEdge* Polyhedron_Edge<T,FP,VP>::secondEdge() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::HalfEdge* Polyhedron_Edge<T,FP,VP,AP>::secondEdge() const {
             assert(m_second != nullptr);
             return m_second;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::HalfEdge* Polyhedron_Edge<T,FP,VP>::twin(const HalfEdge* halfEdge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::HalfEdge* Polyhedron_Edge<T,FP,VP,AP>::twin(const HalfEdge* halfEdge) const {
             assert(halfEdge != nullptr);
             assert(halfEdge == m_first || halfEdge == m_second);
             if (halfEdge == m_first) {
@@ -101,42 +101,42 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_Edge<T,FP,VP>::vector() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_Edge<T,FP,VP,AP>::vector() const {
             return secondVertex()->position() - firstVertex()->position();
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_Edge<T,FP,VP>::center() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_Edge<T,FP,VP,AP>::center() const {
             assert(fullySpecified());
             return (m_first->origin()->position() + m_second->origin()->position()) / static_cast<T>(2.0);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::Face* Polyhedron_Edge<T,FP,VP>::firstFace() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::Face* Polyhedron_Edge<T,FP,VP,AP>::firstFace() const {
             assert(m_first != nullptr);
             return m_first->face();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Edge<T,FP,VP>::Face* Polyhedron_Edge<T,FP,VP>::secondFace() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Edge<T,FP,VP,AP>::Face* Polyhedron_Edge<T,FP,VP,AP>::secondFace() const {
             assert(m_second != nullptr);
             return m_second->face();
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Edge<T,FP,VP>::hasVertex(const Vertex* vertex) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Edge<T,FP,VP,AP>::hasVertex(const Vertex* vertex) const {
             return firstVertex() == vertex || secondVertex() == vertex;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Edge<T,FP,VP>::hasPosition(const vm::vec<T,3>& position, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Edge<T,FP,VP,AP>::hasPosition(const vm::vec<T,3>& position, const T epsilon) const {
             return (vm::is_equal( firstVertex()->position(), position, epsilon) ||
                     vm::is_equal(secondVertex()->position(), position, epsilon));
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Edge<T,FP,VP>::hasPositions(const vm::vec<T,3>& position1, const vm::vec<T,3>& position2, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Edge<T,FP,VP,AP>::hasPositions(const vm::vec<T,3>& position1, const vm::vec<T,3>& position2, const T epsilon) const {
             return ((vm::is_equal( firstVertex()->position(), position1, epsilon) &&
                      vm::is_equal(secondVertex()->position(), position2, epsilon)) ||
                     (vm::is_equal( firstVertex()->position(), position2, epsilon) &&
@@ -144,31 +144,31 @@ m_link(this)
             );
         }
 
-        template <typename T, typename FP, typename VP>
-        T Polyhedron_Edge<T,FP,VP>::distanceTo(const vm::vec<T,3>& position1, const vm::vec<T,3>& position2) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        T Polyhedron_Edge<T,FP,VP,AP>::distanceTo(const vm::vec<T,3>& position1, const vm::vec<T,3>& position2) const {
             const T pos1Distance = vm::min(vm::squared_distance(firstVertex()->position(), position1), vm::squared_distance(secondVertex()->position(), position1));
             const T pos2Distance = vm::min(vm::squared_distance(firstVertex()->position(), position2), vm::squared_distance(secondVertex()->position(), position2));
             return vm::max(pos1Distance, pos2Distance);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Edge<T,FP,VP>::fullySpecified() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Edge<T,FP,VP,AP>::fullySpecified() const {
             assert(m_first != nullptr);
             return m_second != nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Edge<T,FP,VP>* Polyhedron_Edge<T,FP,VP>::next() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Edge<T,FP,VP,AP>* Polyhedron_Edge<T,FP,VP,AP>::next() const {
             return m_link.next();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Edge<T,FP,VP>* Polyhedron_Edge<T,FP,VP>::previous() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Edge<T,FP,VP,AP>* Polyhedron_Edge<T,FP,VP,AP>::previous() const {
             return m_link.previous();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Edge<T,FP,VP>* Polyhedron_Edge<T,FP,VP>::split(const vm::plane<T,3>& plane, const T epsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Edge<T,FP,VP,AP>* Polyhedron_Edge<T,FP,VP,AP>::split(const vm::plane<T,3>& plane, const T epsilon, AP& allocator) {
             unused(epsilon);
             assert(epsilon >= static_cast<T>(0));
             
@@ -196,11 +196,11 @@ m_link(this)
             assert(dot > T(0.0) && dot < T(1.0));
 
             const vm::vec<T,3> position = startPos + dot * (endPos - startPos);
-            return insertVertex(position);
+            return insertVertex(position, allocator);
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Edge<T,FP,VP>* Polyhedron_Edge<T,FP,VP>::insertVertex(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Edge<T,FP,VP,AP>* Polyhedron_Edge<T,FP,VP,AP>::insertVertex(const vm::vec<T,3>& position, AP& allocator) {
             /*
              before:
 
@@ -220,14 +220,14 @@ m_link(this)
 
              */
 
-            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP>;
+            using HalfEdgeList = Polyhedron_HalfEdgeList<T,FP,VP,AP>;
 
             // create new vertices and new half edges originating from it
             // the caller is responsible for storing the newly created vertex!
-            Vertex* newVertex = new Vertex(position);
-            HalfEdge* newFirstEdge = new HalfEdge(newVertex);
+            Vertex* newVertex = ::new (allocator.template allocate<Vertex>()) Vertex(position);
+            HalfEdge* newFirstEdge = ::new (allocator.template allocate<HalfEdge>()) HalfEdge(newVertex);
             HalfEdge* oldFirstEdge = firstEdge();
-            HalfEdge* newSecondEdge = new HalfEdge(newVertex);
+            HalfEdge* newSecondEdge = ::new (allocator.template allocate<HalfEdge>()) HalfEdge(newVertex);
             HalfEdge* oldSecondEdge = secondEdge();
 
             // insert the new half edges into the corresponding faces
@@ -243,17 +243,17 @@ m_link(this)
             // and replace it with new2nd
             setSecondEdge(newSecondEdge);
 
-            return new Edge(newFirstEdge, oldSecondEdge);
+            return ::new (allocator.template allocate<Edge>()) Edge(newFirstEdge, oldSecondEdge);
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::flip() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::flip() {
             using std::swap;
             swap(m_first, m_second);
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::makeFirstEdge(HalfEdge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::makeFirstEdge(HalfEdge* edge) {
             assert(edge != nullptr);
             assert(m_first == edge || m_second == edge);
             if (edge != m_first) {
@@ -261,8 +261,8 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::makeSecondEdge(HalfEdge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::makeSecondEdge(HalfEdge* edge) {
             assert(edge != nullptr);
             assert(m_first == edge || m_second == edge);
             if (edge != m_second) {
@@ -270,21 +270,21 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::setFirstAsLeaving() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::setFirstAsLeaving() {
             assert(m_first != nullptr);
             m_first->setAsLeaving();
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::unsetSecondEdge() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::unsetSecondEdge() {
             assert(m_second != nullptr);
             m_second->unsetEdge();
             m_second = nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Edge<T,FP,VP>::setSecondEdge(HalfEdge* second) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Edge<T,FP,VP,AP>::setSecondEdge(HalfEdge* second) {
             assert(second != nullptr);
             assert(m_second == nullptr);
             assert(second->edge() == nullptr);
@@ -36,18 +36,18 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP>>& Polyhedron_GetFaceLink<T,FP,VP>::operator()(Polyhedron_Face<T,FP,VP>* face) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP,AP>>& Polyhedron_GetFaceLink<T,FP,VP,AP>::operator()(Polyhedron_Face<T,FP,VP,AP>* face) const {
             return face->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        const kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP>>& Polyhedron_GetFaceLink<T,FP,VP>::operator()(const Polyhedron_Face<T,FP,VP>* face) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const kdl::intrusive_circular_link<Polyhedron_Face<T,FP,VP,AP>>& Polyhedron_GetFaceLink<T,FP,VP,AP>::operator()(const Polyhedron_Face<T,FP,VP,AP>* face) const {
             return face->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Face<T,FP,VP>::Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T,3>& plane) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Face<T,FP,VP,AP>::Polyhedron_Face(HalfEdgeList&& boundary, const vm::plane<T,3>& plane) :
             m_boundary(std::move(boundary)),
             m_plane(plane),
             m_payload(FP::defaultValue()),
@@ -65,53 +65,53 @@ m_link(this)
             countAndSetFace(m_boundary.front(), m_boundary.back(), this);
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron_Face<T,FP,VP>::HalfEdgeList& Polyhedron_Face<T,FP,VP>::boundary() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron_Face<T,FP,VP,AP>::HalfEdgeList& Polyhedron_Face<T,FP,VP,AP>::boundary() const {
             return m_boundary;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::HalfEdgeList& Polyhedron_Face<T,FP,VP>::boundary() {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::HalfEdgeList& Polyhedron_Face<T,FP,VP,AP>::boundary() {
             return m_boundary;
         }
         
-        template <typename T, typename FP, typename VP>
-        const vm::plane<T,3>& Polyhedron_Face<T,FP,VP>::plane() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const vm::plane<T,3>& Polyhedron_Face<T,FP,VP,AP>::plane() const {
             return m_plane;
         }
         
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Face<T,FP,VP>::setPlane(const vm::plane<T,3>& plane) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Face<T,FP,VP,AP>::setPlane(const vm::plane<T,3>& plane) {
             m_plane = plane;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::Face* Polyhedron_Face<T,FP,VP>::next() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::Face* Polyhedron_Face<T,FP,VP,AP>::next() const {
             return m_link.next();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::Face* Polyhedron_Face<T,FP,VP>::previous() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::Face* Polyhedron_Face<T,FP,VP,AP>::previous() const {
             return m_link.previous();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename FP::Type Polyhedron_Face<T,FP,VP>::payload() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename FP::Type Polyhedron_Face<T,FP,VP,AP>::payload() const {
             return m_payload;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Face<T,FP,VP>::setPayload(typename FP::Type payload) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Face<T,FP,VP,AP>::setPayload(typename FP::Type payload) {
             m_payload = payload;
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron_Face<T,FP,VP>::vertexCount() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron_Face<T,FP,VP,AP>::vertexCount() const {
             return m_boundary.size();
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron_Face<T,FP,VP>::HalfEdge* Polyhedron_Face<T,FP,VP>::findHalfEdge(const vm::vec<T,3>& origin, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron_Face<T,FP,VP,AP>::HalfEdge* Polyhedron_Face<T,FP,VP,AP>::findHalfEdge(const vm::vec<T,3>& origin, const T epsilon) const {
             for (const HalfEdge* halfEdge : m_boundary) {
                 if (vm::is_equal(halfEdge->origin()->position(), origin, epsilon)) {
                     return halfEdge;
@@ -120,8 +120,8 @@ m_link(this)
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron_Face<T,FP,VP>::Edge* Polyhedron_Face<T,FP,VP>::findEdge(const vm::vec<T,3>& first, const vm::vec<T,3>& second, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron_Face<T,FP,VP,AP>::Edge* Polyhedron_Face<T,FP,VP,AP>::findEdge(const vm::vec<T,3>& first, const vm::vec<T,3>& second, const T epsilon) const {
             const HalfEdge* halfEdge = findHalfEdge(first, epsilon);
             if (halfEdge == nullptr) {
                 return nullptr;
@@ -139,14 +139,14 @@ m_link(this)
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_Face<T,FP,VP>::origin() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_Face<T,FP,VP,AP>::origin() const {
             const HalfEdge* edge = m_boundary.front();
             return edge->origin()->position();
         }
 
-        template <typename T, typename FP, typename VP>
-        std::vector<vm::vec<T,3>> Polyhedron_Face<T,FP,VP>::vertexPositions() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::vector<vm::vec<T,3>> Polyhedron_Face<T,FP,VP,AP>::vertexPositions() const {
             std::vector<vm::vec<T,3>> result;
             result.reserve(vertexCount());
             for (const auto* halfEdge : m_boundary) {
@@ -155,8 +155,8 @@ m_link(this)
             return result;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Face<T,FP,VP>::hasVertexPosition(const vm::vec<T,3>& position, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Face<T,FP,VP,AP>::hasVertexPosition(const vm::vec<T,3>& position, const T epsilon) const {
             for (const HalfEdge* halfEdge : m_boundary) {
                 if (vm::is_equal(halfEdge->origin()->position(), position, epsilon)) {
                     return true;
@@ -165,8 +165,8 @@ m_link(this)
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Face<T,FP,VP>::hasVertexPositions(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Face<T,FP,VP,AP>::hasVertexPositions(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
             if (positions.size() != vertexCount()) {
                 return false;
             }
@@ -180,8 +180,8 @@ m_link(this)
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        T Polyhedron_Face<T,FP,VP>::distanceTo(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        T Polyhedron_Face<T,FP,VP,AP>::distanceTo(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) const {
             if (positions.size() != vertexCount()) {
                 return maxDistance;
             }
@@ -217,8 +217,8 @@ m_link(this)
             return closestDistance;
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_Face<T,FP,VP>::normal() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_Face<T,FP,VP,AP>::normal() const {
             for (const HalfEdge* halfEdge : m_boundary) {
                 const auto& p1 = halfEdge->origin()->position();
                 const auto& p2 = halfEdge->next()->origin()->position();
@@ -232,13 +232,13 @@ m_link(this)
             return vm::vec<T,3>::zero();
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_Face<T,FP,VP>::center() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_Face<T,FP,VP,AP>::center() const {
             return vm::average(std::begin(m_boundary), std::end(m_boundary), [](const HalfEdge* e) { return e->origin()->position(); });
         }
 
-        template <typename T, typename FP, typename VP>
-        T Polyhedron_Face<T,FP,VP>::intersectWithRay(const vm::ray<T,3>& ray, const vm::side side) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        T Polyhedron_Face<T,FP,VP,AP>::intersectWithRay(const vm::ray<T,3>& ray, const vm::side side) const {
             const RayIntersection result = intersectWithRay(ray);
             if (result.none()) {
                 return result.distance();
@@ -255,8 +255,8 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::plane_status Polyhedron_Face<T,FP,VP>::pointStatus(const vm::vec<T,3>& point, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::plane_status Polyhedron_Face<T,FP,VP,AP>::pointStatus(const vm::vec<T,3>& point, const T epsilon) const {
             const auto norm = normal();
             const auto distance = vm::dot(point - origin(), norm);
             if (distance > epsilon) {
@@ -268,8 +268,8 @@ m_link(this)
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Face<T,FP,VP>::coplanar(const Face* other, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Face<T,FP,VP,AP>::coplanar(const Face* other, const T epsilon) const {
             assert(other != nullptr);
 
             // Test if the normals are colinear by checking their enclosed angle.
@@ -286,8 +286,8 @@ m_link(this)
             return verticesOnPlane(otherPlane, epsilon);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Face<T,FP,VP>::verticesOnPlane(const vm::plane<T,3>& plane, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Face<T,FP,VP,AP>::verticesOnPlane(const vm::plane<T,3>& plane, const T epsilon) const {
             for (const HalfEdge* halfEdge : m_boundary) {
                 const auto* vertex = halfEdge->origin();
                 if (plane.point_status(vertex->position(), epsilon) != vm::plane_status::inside) {
@@ -298,8 +298,8 @@ m_link(this)
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        T Polyhedron_Face<T,FP,VP>::maximumVertexDistance(const vm::plane<T,3>& plane) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        T Polyhedron_Face<T,FP,VP,AP>::maximumVertexDistance(const vm::plane<T,3>& plane) const {
             T maximumDistance = static_cast<T>(0);
             for (const HalfEdge* halfEdge : m_boundary) {
                 const auto* vertex = halfEdge->origin();
@@ -309,14 +309,14 @@ m_link(this)
             return maximumDistance;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Face<T,FP,VP>::flip() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Face<T,FP,VP,AP>::flip() {
             m_boundary.reverse();
             m_plane = m_plane.flip();
         }
 
-        template <typename T, typename FP, typename VP> template <typename H>
-        void Polyhedron_Face<T,FP,VP>::insertIntoBoundaryAfter(HalfEdge* after, H&& edges) {
+        template <typename T, typename FP, typename VP, typename AP> template <typename H>
+        void Polyhedron_Face<T,FP,VP,AP>::insertIntoBoundaryAfter(HalfEdge* after, H&& edges) {
             assert(after != nullptr);
             assert(after->face() == this);
 
@@ -324,8 +324,8 @@ m_link(this)
             m_boundary.insert(HalfEdgeList::iter(after->next()), std::forward<H>(edges));
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::HalfEdgeList Polyhedron_Face<T,FP,VP>::removeFromBoundary(HalfEdge* from, HalfEdge* to) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::HalfEdgeList Polyhedron_Face<T,FP,VP,AP>::removeFromBoundary(HalfEdge* from, HalfEdge* to) {
             assert(from != nullptr);
             assert(to != nullptr);
             assert(from->face() == this);
@@ -335,13 +335,13 @@ m_link(this)
             return m_boundary.remove(HalfEdgeList::iter(from), std::next(HalfEdgeList::iter(to)), removeCount);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::HalfEdgeList Polyhedron_Face<T,FP,VP>::removeFromBoundary(HalfEdge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::HalfEdgeList Polyhedron_Face<T,FP,VP,AP>::removeFromBoundary(HalfEdge* edge) {
             return removeFromBoundary(edge, edge);
         }
 
-        template <typename T, typename FP, typename VP> template <typename H>
-        typename Polyhedron_Face<T,FP,VP>::HalfEdgeList Polyhedron_Face<T,FP,VP>::replaceBoundary(HalfEdge* from, HalfEdge* to, H&& with) {
+        template <typename T, typename FP, typename VP, typename AP> template <typename H>
+        typename Polyhedron_Face<T,FP,VP,AP>::HalfEdgeList Polyhedron_Face<T,FP,VP,AP>::replaceBoundary(HalfEdge* from, HalfEdge* to, H&& with) {
             assert(from != nullptr);
             assert(to != nullptr);
             assert(from->face() == this);
@@ -352,8 +352,8 @@ m_link(this)
             return m_boundary.splice_replace(HalfEdgeList::iter(from), std::next(HalfEdgeList::iter(to)), removeCount, std::forward<H>(with));
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron_Face<T,FP,VP>::countAndSetFace(HalfEdge* from, HalfEdge* to, Face* face) {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron_Face<T,FP,VP,AP>::countAndSetFace(HalfEdge* from, HalfEdge* to, Face* face) {
             size_t count = 0u;
             auto* cur = from;
             do {
@@ -364,8 +364,8 @@ m_link(this)
             return count;
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron_Face<T,FP,VP>::countAndUnsetFace(HalfEdge* from, HalfEdge* to) {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron_Face<T,FP,VP,AP>::countAndUnsetFace(HalfEdge* from, HalfEdge* to) {
             size_t count = 0u;
             auto* cur = from;
             do {
@@ -376,8 +376,8 @@ m_link(this)
             return count;
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron_Face<T,FP,VP>::countSharedVertices(const Face* other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron_Face<T,FP,VP,AP>::countSharedVertices(const Face* other) const {
             assert(other != nullptr);
             assert(other != this);
 
@@ -396,8 +396,8 @@ m_link(this)
             return sharedVertexCount;
         }
 
-        template <typename T, typename FP, typename VP>
-        class Polyhedron_Face<T,FP,VP>::RayIntersection {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron_Face<T,FP,VP,AP>::RayIntersection {
         private:
             typedef enum {
                 Type_Front = 1,
@@ -443,8 +443,8 @@ m_link(this)
             }
         };
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Face<T,FP,VP>::RayIntersection Polyhedron_Face<T,FP,VP>::intersectWithRay(const vm::ray<T,3>& ray) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Face<T,FP,VP,AP>::RayIntersection Polyhedron_Face<T,FP,VP,AP>::intersectWithRay(const vm::ray<T,3>& ray) const {
             const vm::plane<T,3> plane(origin(), normal());
             const auto cos = dot(plane.normal, ray.direction);
 
@@ -24,18 +24,18 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP>>& Polyhedron_GetHalfEdgeLink<T,FP,VP>::operator()(Polyhedron_HalfEdge<T,FP,VP>* halfEdge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP,AP>>& Polyhedron_GetHalfEdgeLink<T,FP,VP,AP>::operator()(Polyhedron_HalfEdge<T,FP,VP,AP>* halfEdge) const {
             return halfEdge->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        const kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP>>& Polyhedron_GetHalfEdgeLink<T,FP,VP>::operator()(const Polyhedron_HalfEdge<T,FP,VP>* halfEdge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const kdl::intrusive_circular_link<Polyhedron_HalfEdge<T,FP,VP,AP>>& Polyhedron_GetHalfEdgeLink<T,FP,VP,AP>::operator()(const Polyhedron_HalfEdge<T,FP,VP,AP>* halfEdge) const {
             return halfEdge->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>::Polyhedron_HalfEdge(Vertex* origin) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>::Polyhedron_HalfEdge(Vertex* origin) :
             m_origin(origin),
             m_edge(nullptr),
             m_face(nullptr),
@@ -53,66 +53,66 @@ m_link(this)
             setAsLeaving();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>::~Polyhedron_HalfEdge() {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>::~Polyhedron_HalfEdge() {
             if (m_origin->leaving() == this)
                 m_origin->setLeaving(nullptr);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_HalfEdge<T,FP,VP>::Vertex* Polyhedron_HalfEdge<T,FP,VP>::origin() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_HalfEdge<T,FP,VP,AP>::Vertex* Polyhedron_HalfEdge<T,FP,VP,AP>::origin() const {
             return m_origin;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_HalfEdge<T,FP,VP>::Vertex* Polyhedron_HalfEdge<T,FP,VP>::destination() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_HalfEdge<T,FP,VP,AP>::Vertex* Polyhedron_HalfEdge<T,FP,VP,AP>::destination() const {
             return next()->origin();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_HalfEdge<T,FP,VP>::Edge* Polyhedron_HalfEdge<T,FP,VP>::edge() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_HalfEdge<T,FP,VP,AP>::Edge* Polyhedron_HalfEdge<T,FP,VP,AP>::edge() const {
             return m_edge;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_HalfEdge<T,FP,VP>::Face* Polyhedron_HalfEdge<T,FP,VP>::face() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_HalfEdge<T,FP,VP,AP>::Face* Polyhedron_HalfEdge<T,FP,VP,AP>::face() const {
             return m_face;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>* Polyhedron_HalfEdge<T,FP,VP>::next() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>* Polyhedron_HalfEdge<T,FP,VP,AP>::next() const {
             return m_link.next();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>* Polyhedron_HalfEdge<T,FP,VP>::previous() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>* Polyhedron_HalfEdge<T,FP,VP,AP>::previous() const {
             return m_link.previous();
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::vec<T,3> Polyhedron_HalfEdge<T,FP,VP>::vector() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::vec<T,3> Polyhedron_HalfEdge<T,FP,VP,AP>::vector() const {
             return destination()->position() - origin()->position();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>* Polyhedron_HalfEdge<T,FP,VP>::twin() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>* Polyhedron_HalfEdge<T,FP,VP,AP>::twin() const {
             assert(m_edge != nullptr);
             return m_edge->twin(this);
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>* Polyhedron_HalfEdge<T,FP,VP>::nextIncident() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>* Polyhedron_HalfEdge<T,FP,VP,AP>::nextIncident() const {
             return previous()->twin();
         }
 
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_HalfEdge<T,FP,VP>* Polyhedron_HalfEdge<T,FP,VP>::previousIncident() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_HalfEdge<T,FP,VP,AP>* Polyhedron_HalfEdge<T,FP,VP,AP>::previousIncident() const {
             return twin()->next();
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_HalfEdge<T,FP,VP>::hasOrigins(const std::vector<vm::vec<T,3>>& origins, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_HalfEdge<T,FP,VP,AP>::hasOrigins(const std::vector<vm::vec<T,3>>& origins, const T epsilon) const {
             const HalfEdge* edge = this;
             for (const vm::vec<T,3>& origin : origins) {
                 if (!vm::is_equal(edge->origin()->position(), origin, epsilon)) {
@@ -123,15 +123,15 @@ m_link(this)
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::plane_status Polyhedron_HalfEdge<T,FP,VP>::pointStatus(const vm::vec<T,3>& normal, const vm::vec<T,3>& point, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::plane_status Polyhedron_HalfEdge<T,FP,VP,AP>::pointStatus(const vm::vec<T,3>& normal, const vm::vec<T,3>& point, const T epsilon) const {
             const auto planeNormal = vm::normalize(vm::cross(vm::normalize(vector()), normal));
             const auto plane = vm::plane<T,3>(origin()->position(), planeNormal);
             return plane.point_status(point, epsilon);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_HalfEdge<T,FP,VP>::colinear(const HalfEdge* other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_HalfEdge<T,FP,VP,AP>::colinear(const HalfEdge* other) const {
             assert(other != nullptr);
             assert(other != this);
             assert(destination() == other->origin());
@@ -143,41 +143,41 @@ m_link(this)
             return vm::is_colinear(p0, p1, p2) && vm::dot(vector(), other->vector()) > 0.0;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::setOrigin(Vertex* origin) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::setOrigin(Vertex* origin) {
             assert(origin != nullptr);
             m_origin = origin;
             setAsLeaving();
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::setEdge(Edge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::setEdge(Edge* edge) {
             assert(edge != nullptr);
             assert(m_edge == nullptr);
             m_edge = edge;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::unsetEdge() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::unsetEdge() {
             assert(m_edge != nullptr);
             m_edge = nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::setFace(Face* face) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::setFace(Face* face) {
             assert(face != nullptr);
             assert(m_face == nullptr);
             m_face = face;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::unsetFace() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::unsetFace() {
             assert(m_face != nullptr);
             m_face = nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_HalfEdge<T,FP,VP>::setAsLeaving() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_HalfEdge<T,FP,VP,AP>::setAsLeaving() {
             m_origin->setLeaving(this);
         }
     }
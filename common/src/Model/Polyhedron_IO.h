@@ -30,8 +30,8 @@ namespace TrenchBroom {
         /**
          * Appends a textual representation of the given vertices' position to the given stream.
          */
-        template <typename T, typename FP, typename VP>
-        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Vertex<T,FP,VP>& vertex) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Vertex<T,FP,VP,AP>& vertex) {
             stream << vertex.position();
             return stream;
         }
@@ -39,8 +39,8 @@ namespace TrenchBroom {
         /**
          * Prints a textual description of the given edge to the given output stream.
          */
-        template <typename T, typename FP, typename VP>
-        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Edge<T,FP,VP>& edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Edge<T,FP,VP,AP>& edge) {
             if (edge.firstEdge() != nullptr) {
                 stream << *edge.firstEdge()->origin();
             } else {
@@ -58,8 +58,8 @@ namespace TrenchBroom {
         /**
          * Prints a textual description of the given half edge to the given output stream.
          */
-        template <typename T, typename FP, typename VP>
-        std::ostream& operator<<(std::ostream& stream, const Polyhedron_HalfEdge<T,FP,VP>& edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::ostream& operator<<(std::ostream& stream, const Polyhedron_HalfEdge<T,FP,VP,AP>& edge) {
             stream << *edge.origin() << " --> ";
             if (edge.destination() != nullptr) {
                 stream << *edge.destination();
@@ -72,9 +72,9 @@ namespace TrenchBroom {
         /**
          * Prints a textual description of the face to the given output stream.
          */
-        template <typename T, typename FP, typename VP>
-        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Face<T,FP,VP>& face) {
-            for (const Polyhedron_HalfEdge<T,FP,VP>* edge : face.boundary()) {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::ostream& operator<<(std::ostream& stream, const Polyhedron_Face<T,FP,VP,AP>& face) {
+            for (const Polyhedron_HalfEdge<T,FP,VP,AP>* edge : face.boundary()) {
                 stream << *edge << "\n";
             }
             return stream;
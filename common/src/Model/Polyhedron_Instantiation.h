@@ -29,18 +29,23 @@ namespace TrenchBroom {
     namespace Model {
         extern template class Polyhedron_Vertex<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
         extern template class Polyhedron_Vertex<FloatType, BrushFacePayload, BrushVertexPayload>;
+        extern template class Polyhedron_Vertex<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
 
         extern template class Polyhedron_Edge<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
         extern template class Polyhedron_Edge<FloatType, BrushFacePayload, BrushVertexPayload>;
+        extern template class Polyhedron_Edge<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
 
         extern template class Polyhedron_HalfEdge<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
         extern template class Polyhedron_HalfEdge<FloatType, BrushFacePayload, BrushVertexPayload>;
+        extern template class Polyhedron_HalfEdge<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
 
         extern template class Polyhedron_Face<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
         extern template class Polyhedron_Face<FloatType, BrushFacePayload, BrushVertexPayload>;
+        extern template class Polyhedron_Face<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
 
         extern template class Polyhedron<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload>;
         extern template class Polyhedron<FloatType, BrushFacePayload, BrushVertexPayload>;
+        extern template class Polyhedron<FloatType, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
     }
 }
 
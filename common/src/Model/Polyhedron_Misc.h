@@ -33,42 +33,43 @@
 #include <vecmath/util.h>
 
 #include <sstream>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        const vm::vec<T,3>& Polyhedron<T,FP,VP>::GetVertexPosition::operator()(const Vertex* vertex) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const vm::vec<T,3>& Polyhedron<T,FP,VP,AP>::GetVertexPosition::operator()(const Vertex* vertex) const {
             return vertex->position();
         }
 
-        template <typename T, typename FP, typename VP>
-        const vm::vec<T,3>& Polyhedron<T,FP,VP>::GetVertexPosition::operator()(const HalfEdge* halfEdge) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const vm::vec<T,3>& Polyhedron<T,FP,VP,AP>::GetVertexPosition::operator()(const HalfEdge* halfEdge) const {
             return halfEdge->origin()->position();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::CopyCallback::~CopyCallback() = default;
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::CopyCallback::~CopyCallback() = default;
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::CopyCallback::vertexWasCopied(const Vertex* /* original */, Vertex* /* copy */) const {}
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::CopyCallback::vertexWasCopied(const Vertex* /* original */, Vertex* /* copy */) const {}
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::CopyCallback::faceWasCopied(const Face* /* original */, Face* /* copy */) const {}
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::CopyCallback::faceWasCopied(const Face* /* original */, Face* /* copy */) const {}
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron() {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron() {
             updateBounds();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(std::initializer_list<vm::vec<T,3>> positions) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(std::initializer_list<vm::vec<T,3>> positions) {
             addPoints(std::vector<vm::vec<T,3>>(std::begin(positions), std::end(positions)));
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(const vm::bbox<T,3>& bounds) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(const vm::bbox<T,3>& bounds) :
             m_bounds(bounds) {
             if (m_bounds.min == m_bounds.max) {
                 addPoint(m_bounds.min, vm::constants<T>::point_status_epsilon());
@@ -86,14 +87,14 @@ namespace TrenchBroom {
             const vm::vec<T,3> p7(m_bounds.max.x(), m_bounds.max.y(), m_bounds.min.z());
             const vm::vec<T,3> p8(m_bounds.max.x(), m_bounds.max.y(), m_bounds.max.z());
 
-            Vertex* v1 = new Vertex(p1);
-            Vertex* v2 = new Vertex(p2);
-            Vertex* v3 = new Vertex(p3);
-            Vertex* v4 = new Vertex(p4);
-            Vertex* v5 = new Vertex(p5);
-            Vertex* v6 = new Vertex(p6);
-            Vertex* v7 = new Vertex(p7);
-            Vertex* v8 = new Vertex(p8);
+            Vertex* v1 = createVertex(p1);
+            Vertex* v2 = createVertex(p2);
+            Vertex* v3 = createVertex(p3);
+            Vertex* v4 = createVertex(p4);
+            Vertex* v5 = createVertex(p5);
+            Vertex* v6 = createVertex(p6);
+            Vertex* v7 = createVertex(p7);
+            Vertex* v8 = createVertex(p8);
 
             m_vertices.push_back(v1);
             m_vertices.push_back(v2);
@@ -105,128 +106,147 @@ namespace TrenchBroom {
             m_vertices.push_back(v8);
 
             // Front face
-            HalfEdge* f1h1 = new HalfEdge(v1);
-            HalfEdge* f1h2 = new HalfEdge(v5);
-            HalfEdge* f1h3 = new HalfEdge(v6);
-            HalfEdge* f1h4 = new HalfEdge(v2);
+            HalfEdge* f1h1 = createHalfEdge(v1);
+            HalfEdge* f1h2 = createHalfEdge(v5);
+            HalfEdge* f1h3 = createHalfEdge(v6);
+            HalfEdge* f1h4 = createHalfEdge(v2);
             HalfEdgeList f1b;
             f1b.push_back(f1h1);
             f1b.push_back(f1h2);
             f1b.push_back(f1h3);
             f1b.push_back(f1h4);
-            m_faces.push_back(new Face(std::move(f1b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_y())));
+            m_faces.push_back(createFace(std::move(f1b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_y())));
 
             // Left face
-            HalfEdge* f2h1 = new HalfEdge(v1);
-            HalfEdge* f2h2 = new HalfEdge(v2);
-            HalfEdge* f2h3 = new HalfEdge(v4);
-            HalfEdge* f2h4 = new HalfEdge(v3);
+            HalfEdge* f2h1 = createHalfEdge(v1);
+            HalfEdge* f2h2 = createHalfEdge(v2);
+            HalfEdge* f2h3 = createHalfEdge(v4);
+            HalfEdge* f2h4 = createHalfEdge(v3);
             HalfEdgeList f2b;
             f2b.push_back(f2h1);
             f2b.push_back(f2h2);
             f2b.push_back(f2h3);
             f2b.push_back(f2h4);
-            m_faces.push_back(new Face(std::move(f2b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_x())));
+            m_faces.push_back(createFace(std::move(f2b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_x())));
 
             // Bottom face
-            HalfEdge* f3h1 = new HalfEdge(v1);
-            HalfEdge* f3h2 = new HalfEdge(v3);
-            HalfEdge* f3h3 = new HalfEdge(v7);
-            HalfEdge* f3h4 = new HalfEdge(v5);
+            HalfEdge* f3h1 = createHalfEdge(v1);
+            HalfEdge* f3h2 = createHalfEdge(v3);
+            HalfEdge* f3h3 = createHalfEdge(v7);
+            HalfEdge* f3h4 = createHalfEdge(v5);
             HalfEdgeList f3b;
             f3b.push_back(f3h1);
             f3b.push_back(f3h2);
             f3b.push_back(f3h3);
             f3b.push_back(f3h4);
-            m_faces.push_back(new Face(std::move(f3b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_z())));
+            m_faces.push_back(createFace(std::move(f3b), vm::plane<T,3>(p1, vm::vec<T,3>::neg_z())));
 
             // Top face
-            HalfEdge* f4h1 = new HalfEdge(v2);
-            HalfEdge* f4h2 = new HalfEdge(v6);
-            HalfEdge* f4h3 = new HalfEdge(v8);
-            HalfEdge* f4h4 = new HalfEdge(v4);
+            HalfEdge* f4h1 = createHalfEdge(v2);
+            HalfEdge* f4h2 = createHalfEdge(v6);
+            HalfEdge* f4h3 = createHalfEdge(v8);
+            HalfEdge* f4h4 = createHalfEdge(v4);
             HalfEdgeList f4b;
             f4b.push_back(f4h1);
             f4b.push_back(f4h2);
             f4b.push_back(f4h3);
             f4b.push_back(f4h4);
-            m_faces.push_back(new Face(std::move(f4b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_z())));
+            m_faces.push_back(createFace(std::move(f4b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_z())));
 
             // Back face
-            HalfEdge* f5h1 = new HalfEdge(v3);
-            HalfEdge* f5h2 = new HalfEdge(v4);
-            HalfEdge* f5h3 = new HalfEdge(v8);
-            HalfEdge* f5h4 = new HalfEdge(v7);
+            HalfEdge* f5h1 = createHalfEdge(v3);
+            HalfEdge* f5h2 = createHalfEdge(v4);
+            HalfEdge* f5h3 = createHalfEdge(v8);
+            HalfEdge* f5h4 = createHalfEdge(v7);
             HalfEdgeList f5b;
             f5b.push_back(f5h1);
             f5b.push_back(f5h2);
             f5b.push_back(f5h3);
             f5b.push_back(f5h4);
-            m_faces.push_back(new Face(std::move(f5b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_y())));
+            m_faces.push_back(createFace(std::move(f5b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_y())));
 
             // Right face
-            HalfEdge* f6h1 = new HalfEdge(v5);
-            HalfEdge* f6h2 = new HalfEdge(v7);
-            HalfEdge* f6h3 = new HalfEdge(v8);
-            HalfEdge* f6h4 = new HalfEdge(v6);
+            HalfEdge* f6h1 = createHalfEdge(v5);
+            HalfEdge* f6h2 = createHalfEdge(v7);
+            HalfEdge* f6h3 = createHalfEdge(v8);
+            HalfEdge* f6h4 = createHalfEdge(v6);
             HalfEdgeList f6b;
             f6b.push_back(f6h1);
             f6b.push_back(f6h2);
             f6b.push_back(f6h3);
             f6b.push_back(f6h4);
-            m_faces.push_back(new Face(std::move(f6b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_x())));
-
-            m_edges.push_back(new Edge(f1h4, f2h1)); // v1, v2
-            m_edges.push_back(new Edge(f2h4, f3h1)); // v1, v3
-            m_edges.push_back(new Edge(f1h1, f3h4)); // v1, v5
-            m_edges.push_back(new Edge(f2h2, f4h4)); // v2, v4
-            m_edges.push_back(new Edge(f4h1, f1h3)); // v2, v6
-            m_edges.push_back(new Edge(f2h3, f5h1)); // v3, v4
-            m_edges.push_back(new Edge(f3h2, f5h4)); // v3, v7
-            m_edges.push_back(new Edge(f4h3, f5h2)); // v4, v8
-            m_edges.push_back(new Edge(f1h2, f6h4)); // v5, v6
-            m_edges.push_back(new Edge(f6h1, f3h3)); // v5, v7
-            m_edges.push_back(new Edge(f6h3, f4h2)); // v6, v8
-            m_edges.push_back(new Edge(f6h2, f5h3)); // v7, v8
+            m_faces.push_back(createFace(std::move(f6b), vm::plane<T,3>(p8, vm::vec<T,3>::pos_x())));
+
+            m_edges.push_back(createEdge(f1h4, f2h1)); // v1, v2
+            m_edges.push_back(createEdge(f2h4, f3h1)); // v1, v3
+            m_edges.push_back(createEdge(f1h1, f3h4)); // v1, v5
+            m_edges.push_back(createEdge(f2h2, f4h4)); // v2, v4
+            m_edges.push_back(createEdge(f4h1, f1h3)); // v2, v6
+            m_edges.push_back(createEdge(f2h3, f5h1)); // v3, v4
+            m_edges.push_back(createEdge(f3h2, f5h4)); // v3, v7
+            m_edges.push_back(createEdge(f4h3, f5h2)); // v4, v8
+            m_edges.push_back(createEdge(f1h2, f6h4)); // v5, v6
+            m_edges.push_back(createEdge(f6h1, f3h3)); // v5, v7
+            m_edges.push_back(createEdge(f6h3, f4h2)); // v6, v8
+            m_edges.push_back(createEdge(f6h2, f5h3)); // v7, v8
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(std::vector<vm::vec<T,3>> positions) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(std::vector<vm::vec<T,3>> positions) {
             addPoints(std::move(positions));
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(const Polyhedron<T,FP,VP,AP>& other) {
             Copy copy(other.faces(), other.edges(), other.vertices(), *this, CopyCallback());
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(const Polyhedron<T,FP,VP>& other, const CopyCallback& callback) {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(const Polyhedron<T,FP,VP,AP>& other, const CopyCallback& callback) {
             Copy copy(other.faces(), other.edges(), other.vertices(), *this, callback);
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::Polyhedron(Polyhedron<T,FP,VP>&& other) noexcept :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::Polyhedron(Polyhedron<T,FP,VP,AP>&& other) noexcept :
+            m_allocator(std::move(other.m_allocator)),
             m_vertices(std::move(other.m_vertices)),
             m_edges(std::move(other.m_edges)),
             m_faces(std::move(other.m_faces)),
             m_bounds(std::move(other.m_bounds)) {}
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>& Polyhedron<T,FP,VP>::operator=(const Polyhedron<T,FP,VP>& other) {
-            Polyhedron<T,FP,VP> copy(other);
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::~Polyhedron() {
+            if constexpr (AP::ReleasesElements) {
+                static_assert(std::is_trivially_destructible_v<typename FP::Type>, "face payload must be trivially destructible");
+                static_assert(std::is_trivially_destructible_v<typename VP::Type>, "vertex payload must be trivially destructible");
+
+                // the memory of the elements is freed when the allocator is destroyed
+                m_faces.release();
+                m_edges.release();
+                m_vertices.release();
+            }
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>& Polyhedron<T,FP,VP,AP>::operator=(const Polyhedron<T,FP,VP,AP>& other) {
+            Polyhedron<T,FP,VP,AP> copy(other);
             swap(*this, copy);
             return *this;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>& Polyhedron<T,FP,VP>::operator=(Polyhedron<T,FP,VP>&& other) = default;
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>& Polyhedron<T,FP,VP,AP>::operator=(Polyhedron<T,FP,VP,AP>&& other) {
+            // the old elements must be released before their allocator is replaced
+            Polyhedron<T,FP,VP,AP> moved(std::move(other));
+            swap(*this, moved);
+            return *this;
+        }
 
         /**
          * Copies a polyhedron.
          */
-        template <typename T, typename FP, typename VP>
-        class Polyhedron<T,FP,VP>::Copy {
+        template <typename T, typename FP, typename VP, typename AP>
+        class Polyhedron<T,FP,VP,AP>::Copy {
         private:
             using VertexMap = std::unordered_map<const Vertex*, Vertex*>;
             using VertexMapEntry = typename VertexMap::value_type;
@@ -284,7 +304,7 @@ namespace TrenchBroom {
         private:
             void copyVertices(const VertexList& originalVertices, const CopyCallback& callback) {
                 for (const Vertex* currentVertex : originalVertices) {
-                    Vertex* copy = new Vertex(currentVertex->position());
+                    Vertex* copy = m_destination.createVertex(currentVertex->position());
                     callback.vertexWasCopied(currentVertex, copy);
                     assert(m_vertexMap.count(currentVertex) == 0u);
                     m_vertexMap.insert(std::make_pair(currentVertex, copy));
@@ -306,7 +326,7 @@ namespace TrenchBroom {
                     myBoundary.push_back(copyHalfEdge(currentHalfEdge));
                 }
 
-                Face* copy = new Face(std::move(myBoundary), originalFace->plane());
+                Face* copy = m_destination.createFace(std::move(myBoundary), originalFace->plane());
                 callback.faceWasCopied(originalFace, copy);
                 m_faces.push_back(copy);
             }
@@ -315,7 +335,7 @@ namespace TrenchBroom {
                 const Vertex* originalOrigin = original->origin();
 
                 Vertex* myOrigin = findVertex(originalOrigin);
-                HalfEdge* copy = new HalfEdge(myOrigin);
+                HalfEdge* copy = m_destination.createHalfEdge(myOrigin);
                 assert(m_halfEdgeMap.count(original) == 0u);
                 m_halfEdgeMap.insert(std::make_pair(original, copy));
                 return copy;
@@ -336,11 +356,11 @@ namespace TrenchBroom {
             Edge* copyEdge(const Edge* original) {
                 HalfEdge* myFirst = findOrCopyHalfEdge(original->firstEdge());
                 if (!original->fullySpecified()) {
-                    return new Edge(myFirst);
+                    return m_destination.createEdge(myFirst);
                 }
 
                 HalfEdge* mySecond = findOrCopyHalfEdge(original->secondEdge());
-                return new Edge(myFirst, mySecond);
+                return m_destination.createEdge(myFirst, mySecond);
             }
 
             HalfEdge* findOrCopyHalfEdge(const HalfEdge* original) {
@@ -348,7 +368,7 @@ namespace TrenchBroom {
                 if (it == std::end(m_halfEdgeMap)) {
                     const Vertex* originalOrigin = original->origin();
                     Vertex* myOrigin = findVertex(originalOrigin);
-                    HalfEdge* copy = new HalfEdge(myOrigin);
+                    HalfEdge* copy = m_destination.createHalfEdge(myOrigin);
                     m_halfEdgeMap.insert(std::make_pair(original, copy));
                     return copy;
                 } else {
@@ -365,8 +385,28 @@ namespace TrenchBroom {
             }
         };
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::operator==(const Polyhedron& other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::createVertex(const vm::vec<T,3>& position) {
+            return ::new (m_allocator.template allocate<Vertex>()) Vertex(position);
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Edge* Polyhedron<T,FP,VP,AP>::createEdge(HalfEdge* first, HalfEdge* second) {
+            return ::new (m_allocator.template allocate<Edge>()) Edge(first, second);
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::HalfEdge* Polyhedron<T,FP,VP,AP>::createHalfEdge(Vertex* origin) {
+            return ::new (m_allocator.template allocate<HalfEdge>()) HalfEdge(origin);
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Face* Polyhedron<T,FP,VP,AP>::createFace(HalfEdgeList&& boundary, const vm::plane<T,3>& plane) {
+            return ::new (m_allocator.template allocate<Face>()) Face(std::move(boundary), plane);
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::operator==(const Polyhedron& other) const {
             if (vertexCount() != other.vertexCount()) {
                 return false;
             }
@@ -398,23 +438,33 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::operator!=(const Polyhedron& other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::operator!=(const Polyhedron& other) const {
             return !(*this == other);
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron<T,FP,VP>::vertexCount() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const AP& Polyhedron<T,FP,VP,AP>::allocator() const {
+            return m_allocator;
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron<T,FP,VP,AP>::vertexCount() const {
             return m_vertices.size();
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron<T,FP,VP>::VertexList& Polyhedron<T,FP,VP>::vertices() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron<T,FP,VP,AP>::VertexList& Polyhedron<T,FP,VP,AP>::vertices() const {
+            return m_vertices;
+        }
+
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::VertexList& Polyhedron<T,FP,VP,AP>::vertices() {
             return m_vertices;
         }
 
-        template <typename T, typename FP, typename VP>
-        std::vector<vm::vec<T,3>> Polyhedron<T,FP,VP>::vertexPositions() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::vector<vm::vec<T,3>> Polyhedron<T,FP,VP,AP>::vertexPositions() const {
             std::vector<vm::vec<T,3>> result;
             result.reserve(vertexCount());
             for (const Vertex* vertex : m_vertices) {
@@ -423,95 +473,95 @@ namespace TrenchBroom {
             return result;
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron<T,FP,VP>::edgeCount() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron<T,FP,VP,AP>::edgeCount() const {
             return m_edges.size();
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron<T,FP,VP>::EdgeList& Polyhedron<T,FP,VP>::edges() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron<T,FP,VP,AP>::EdgeList& Polyhedron<T,FP,VP,AP>::edges() const {
             return m_edges;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::hasEdge(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::hasEdge(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T epsilon) const {
             return findEdgeByPositions(pos1, pos2, epsilon) != nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        size_t Polyhedron<T,FP,VP>::faceCount() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        size_t Polyhedron<T,FP,VP,AP>::faceCount() const {
             return m_faces.size();
         }
 
-        template <typename T, typename FP, typename VP>
-        const typename Polyhedron<T,FP,VP>::FaceList& Polyhedron<T,FP,VP>::faces() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const typename Polyhedron<T,FP,VP,AP>::FaceList& Polyhedron<T,FP,VP,AP>::faces() const {
             return m_faces;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::FaceList& Polyhedron<T,FP,VP>::faces() {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::FaceList& Polyhedron<T,FP,VP,AP>::faces() {
             return m_faces;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::hasFace(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::hasFace(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
             return findFaceByPositions(positions, epsilon) != nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        const vm::bbox<T,3>& Polyhedron<T,FP,VP>::bounds() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const vm::bbox<T,3>& Polyhedron<T,FP,VP,AP>::bounds() const {
             return m_bounds;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::empty() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::empty() const {
             return vertexCount() == 0;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::point() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::point() const {
             return vertexCount() == 1;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edge() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edge() const {
             return vertexCount() == 2;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polygon() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polygon() const {
             return faceCount() == 1;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polyhedron() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polyhedron() const {
             return faceCount() > 3;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::closed() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::closed() const {
             return vertexCount() + faceCount() == edgeCount() + 2;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::clear() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::clear() {
             m_faces.clear();
             m_edges.clear();
             m_vertices.clear();
             updateBounds();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::FaceHit::FaceHit(Face* i_face, const T i_distance) : face(i_face), distance(i_distance) {}
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::FaceHit::FaceHit(Face* i_face, const T i_distance) : face(i_face), distance(i_distance) {}
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron<T,FP,VP>::FaceHit::FaceHit() : face(nullptr), distance(vm::nan<T>()) {}
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron<T,FP,VP,AP>::FaceHit::FaceHit() : face(nullptr), distance(vm::nan<T>()) {}
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::FaceHit::isMatch() const { return face != nullptr; }
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::FaceHit::isMatch() const { return face != nullptr; }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::FaceHit Polyhedron<T,FP,VP>::pickFace(const vm::ray<T,3>& ray) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::FaceHit Polyhedron<T,FP,VP,AP>::pickFace(const vm::ray<T,3>& ray) const {
             const auto side = polygon() ? vm::side::both : vm::side::front;
             auto* firstFace = m_faces.front();
             auto* currentFace = firstFace;
@@ -525,13 +575,13 @@ namespace TrenchBroom {
             return FaceHit();
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::hasVertex(const vm::vec<T,3>& position, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::hasVertex(const vm::vec<T,3>& position, const T epsilon) const {
             return findVertexByPosition(position, epsilon) != nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::hasAnyVertex(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::hasAnyVertex(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
             for (const vm::vec<T,3>& position : positions) {
                 if (hasVertex(position, epsilon)) {
                     return true;
@@ -540,8 +590,8 @@ namespace TrenchBroom {
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::hasAllVertices(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::hasAllVertices(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
             if (positions.size() != vertexCount()) {
                 return false;
             }
@@ -553,8 +603,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::findVertexByPosition(const vm::vec<T,3>& position, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::findVertexByPosition(const vm::vec<T,3>& position, const T epsilon) const {
             if (m_vertices.empty()) {
                 return nullptr;
             }
@@ -570,8 +620,8 @@ namespace TrenchBroom {
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Vertex* Polyhedron<T,FP,VP>::findClosestVertex(const vm::vec<T,3>& position, const T maxDistance) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Vertex* Polyhedron<T,FP,VP,AP>::findClosestVertex(const vm::vec<T,3>& position, const T maxDistance) const {
             if (m_vertices.empty()) {
                 return nullptr;
             }
@@ -592,8 +642,8 @@ namespace TrenchBroom {
             return closestVertex;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Edge* Polyhedron<T,FP,VP>::findEdgeByPositions(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Edge* Polyhedron<T,FP,VP,AP>::findEdgeByPositions(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T epsilon) const {
             if (m_edges.empty()) {
                 return nullptr;
             }
@@ -609,8 +659,8 @@ namespace TrenchBroom {
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Edge* Polyhedron<T,FP,VP>::findClosestEdge(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T maxDistance) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Edge* Polyhedron<T,FP,VP,AP>::findClosestEdge(const vm::vec<T,3>& pos1, const vm::vec<T,3>& pos2, const T maxDistance) const {
             if (m_edges.empty()) {
                 return nullptr;
             }
@@ -631,8 +681,8 @@ namespace TrenchBroom {
             return closestEdge;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findFaceByPositions(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Face* Polyhedron<T,FP,VP,AP>::findFaceByPositions(const std::vector<vm::vec<T,3>>& positions, const T epsilon) const {
             Face* firstFace = m_faces.front();
             Face* currentFace = firstFace;
             do {
@@ -644,8 +694,8 @@ namespace TrenchBroom {
             return nullptr;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Face* Polyhedron<T,FP,VP>::findClosestFace(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Face* Polyhedron<T,FP,VP,AP>::findClosestFace(const std::vector<vm::vec<T,3>>& positions, const T maxDistance) {
             auto closestDistance = maxDistance;
             Face* closestFace = nullptr;
 
@@ -662,8 +712,8 @@ namespace TrenchBroom {
             return closestFace;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::updateBounds() {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::updateBounds() {
             auto builder = typename vm::bbox<T,3>::builder();
             builder.add(std::begin(m_vertices), std::end(m_vertices), GetVertexPosition());
 
@@ -674,16 +724,16 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::correctVertexPositions(const size_t decimals, const T epsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::correctVertexPositions(const size_t decimals, const T epsilon) {
             for (auto* vertex : m_vertices) {
                 vertex->correctPosition(decimals, epsilon);
             }
             updateBounds();
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::healEdges(const T minLength) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::healEdges(const T minLength) {
             const T minLength2 = minLength * minLength;
 
             /*
@@ -721,8 +771,8 @@ namespace TrenchBroom {
             return polyhedron();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Edge* Polyhedron<T,FP,VP>::removeEdge(Edge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Edge* Polyhedron<T,FP,VP,AP>::removeEdge(Edge* edge) {
             // First, transfer all edges from the second to the first vertex of the given edge.
             // This results in the edge being a loop and the second vertex to be orphaned.
             auto* firstVertex = edge->firstVertex();
@@ -788,8 +838,8 @@ namespace TrenchBroom {
             return result;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron<T,FP,VP>::removeDegenerateFace(Face* face) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron<T,FP,VP,AP>::removeDegenerateFace(Face* face) {
             assert(face != nullptr);
             assert(face->vertexCount() == 2u);
 
@@ -842,8 +892,8 @@ namespace TrenchBroom {
             m_faces.remove(face);
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron<T,FP,VP>::Edge* Polyhedron<T,FP,VP>::mergeNeighbours(HalfEdge* borderFirst, Edge* validEdge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron<T,FP,VP,AP>::Edge* Polyhedron<T,FP,VP,AP>::mergeNeighbours(HalfEdge* borderFirst, Edge* validEdge) {
             Face* face = borderFirst->face();
             Face* neighbour = borderFirst->twin()->face();
 
@@ -938,8 +988,8 @@ namespace TrenchBroom {
             return validEdge;
         }
 
-        template <typename T, typename FP, typename VP>
-        void  Polyhedron<T,FP,VP>::mergeIncidentEdges(Vertex* vertex) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void  Polyhedron<T,FP,VP,AP>::mergeIncidentEdges(Vertex* vertex) {
             assert(vertex != nullptr);
             
             /*
@@ -987,8 +1037,8 @@ namespace TrenchBroom {
             m_vertices.remove(vertex);
         }
         
-        template <typename T, typename FP, typename VP>
-        std::string Polyhedron<T,FP,VP>::exportObj() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::string Polyhedron<T,FP,VP,AP>::exportObj() const {
             std::vector<const Face*> faces;
             for (const Face* face : m_faces) {
                 faces.push_back(face);
@@ -996,8 +1046,8 @@ namespace TrenchBroom {
             return exportObjSelectedFaces(faces);
         }
 
-        template <typename T, typename FP, typename VP>
-        std::string Polyhedron<T,FP,VP>::exportObjSelectedFaces(const std::vector<const Face*>& faces) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        std::string Polyhedron<T,FP,VP,AP>::exportObjSelectedFaces(const std::vector<const Face*>& faces) const {
             std::stringstream ss;
             std::vector<const Vertex*> vertices;
 
@@ -32,8 +32,8 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::contains(const vm::vec<T,3>& point, const T epsilon) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::contains(const vm::vec<T,3>& point, const T epsilon) const {
             if (!polyhedron()) {
                 return false;
             }
@@ -51,8 +51,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::contains(const Polyhedron& other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::contains(const Polyhedron& other) const {
             if (!polyhedron()) {
                 return false;
             }
@@ -69,8 +69,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::intersects(const Polyhedron& other) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::intersects(const Polyhedron& other) const {
             if (!bounds().intersects(other.bounds())) {
                 return false;
             }
@@ -122,8 +122,8 @@ namespace TrenchBroom {
             }
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::pointIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::pointIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.point());
             assert(rhs.point());
 
@@ -132,8 +132,8 @@ namespace TrenchBroom {
             return lhsPos == rhsPos;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::pointIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::pointIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.point());
             assert(rhs.edge());
 
@@ -145,8 +145,8 @@ namespace TrenchBroom {
             return vm::segment<T,3>(rhsStart, rhsEnd).contains(lhsPos, vm::constants<T>::almost_zero());
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::pointIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::pointIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.point());
             assert(rhs.polygon());
 
@@ -158,8 +158,8 @@ namespace TrenchBroom {
             return vm::polygon_contains_point(lhsPos, rhsNormal, std::begin(rhsBoundary), std::end(rhsBoundary), GetVertexPosition());
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::pointIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::pointIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.point());
             assert(rhs.polyhedron());
 
@@ -167,13 +167,13 @@ namespace TrenchBroom {
             return rhs.contains(lhsPos, vm::constants<T>::point_status_epsilon());
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edgeIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edgeIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
             return pointIntersectsEdge(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edgeIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edgeIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.edge());
             assert(rhs.edge());
 
@@ -210,8 +210,8 @@ namespace TrenchBroom {
             return dist.distance < epsilon2 && dist.position1 <= rayLen;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edgeIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edgeIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.edge());
             assert(rhs.polygon());
 
@@ -221,8 +221,8 @@ namespace TrenchBroom {
             return edgeIntersectsFace(lhsEdge, rhsFace);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edgeIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edgeIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.edge());
             assert(rhs.polyhedron());
 
@@ -254,8 +254,8 @@ namespace TrenchBroom {
             return backHit && !frontHit;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::edgeIntersectsFace(const Edge* lhsEdge, const Face* rhsFace) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::edgeIntersectsFace(const Edge* lhsEdge, const Face* rhsFace) {
             const auto& lhsStart = lhsEdge->firstVertex()->position();
             const auto& lhsEnd = lhsEdge->secondVertex()->position();
             const auto lhsRay = vm::ray<T,3>(lhsStart, normalize(lhsEnd - lhsStart));
@@ -285,18 +285,18 @@ namespace TrenchBroom {
             return dist <= rayLen;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polygonIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polygonIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
             return pointIntersectsPolygon(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polygonIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs){
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polygonIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs){
             return edgeIntersectsPolygon(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polygonIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polygonIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.polygon());
             assert(rhs.polygon());
 
@@ -306,8 +306,8 @@ namespace TrenchBroom {
             return faceIntersectsFace(lhsFace, rhsFace);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polygonIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polygonIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.polygon());
             assert(rhs.polyhedron());
 
@@ -322,8 +322,8 @@ namespace TrenchBroom {
             return rhs.contains(vertex->position(), vm::constants<T>::point_status_epsilon());
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::faceIntersectsFace(const Face* lhsFace, const Face* rhsFace) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::faceIntersectsFace(const Face* lhsFace, const Face* rhsFace) {
             const auto& lhsBoundary = lhsFace->boundary();
             const auto& rhsBoundary = rhsFace->boundary();
 
@@ -341,23 +341,23 @@ namespace TrenchBroom {
                 vm::polygon_contains_point(rhsVertex->position(), std::begin(lhsBoundary), std::end(lhsBoundary), GetVertexPosition()));
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polyhedronIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polyhedronIntersectsPoint(const Polyhedron& lhs, const Polyhedron& rhs) {
             return pointIntersectsPolyhedron(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polyhedronIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polyhedronIntersectsEdge(const Polyhedron& lhs, const Polyhedron& rhs) {
             return edgeIntersectsPolyhedron(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polyhedronIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polyhedronIntersectsPolygon(const Polyhedron& lhs, const Polyhedron& rhs) {
             return polygonIntersectsPolyhedron(rhs, lhs);
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::polyhedronIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::polyhedronIntersectsPolyhedron(const Polyhedron& lhs, const Polyhedron& rhs) {
             assert(lhs.polyhedron());
             assert(rhs.polyhedron());
 
@@ -398,8 +398,8 @@ namespace TrenchBroom {
             return true;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron<T,FP,VP>::separate(const FaceList& faces, const VertexList& vertices) {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron<T,FP,VP,AP>::separate(const FaceList& faces, const VertexList& vertices) {
             for (const auto* face : faces) {
                 const auto& plane = face->plane();
                 if (pointStatus(plane, vertices) == vm::plane_status::above) {
@@ -410,8 +410,8 @@ namespace TrenchBroom {
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        vm::plane_status Polyhedron<T,FP,VP>::pointStatus(const vm::plane<T,3>& plane, const VertexList& vertices) {
+        template <typename T, typename FP, typename VP, typename AP>
+        vm::plane_status Polyhedron<T,FP,VP,AP>::pointStatus(const vm::plane<T,3>& plane, const VertexList& vertices) {
             std::size_t above = 0u;
             std::size_t below = 0u;
 
@@ -26,18 +26,18 @@
 
 namespace TrenchBroom {
     namespace Model {
-        template <typename T, typename FP, typename VP>
-        kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP>>& Polyhedron_GetVertexLink<T,FP,VP>::operator()(Polyhedron_Vertex<T,FP,VP>* vertex) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP,AP>>& Polyhedron_GetVertexLink<T,FP,VP,AP>::operator()(Polyhedron_Vertex<T,FP,VP,AP>* vertex) const {
             return vertex->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        const kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP>>& Polyhedron_GetVertexLink<T,FP,VP>::operator()(const Polyhedron_Vertex<T,FP,VP>* vertex) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const kdl::intrusive_circular_link<Polyhedron_Vertex<T,FP,VP,AP>>& Polyhedron_GetVertexLink<T,FP,VP,AP>::operator()(const Polyhedron_Vertex<T,FP,VP,AP>* vertex) const {
             return vertex->m_link;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Vertex<T,FP,VP>::Polyhedron_Vertex(const vm::vec<T,3>& position) :
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Vertex<T,FP,VP,AP>::Polyhedron_Vertex(const vm::vec<T,3>& position) :
             m_position(position),
             m_leaving(nullptr),
 #ifdef _MSC_VER
@@ -51,56 +51,56 @@ m_link(this),
 #endif
             m_payload(VP::defaultValue()) {}
 
-        template <typename T, typename FP, typename VP>
-        const vm::vec<T,3>& Polyhedron_Vertex<T,FP,VP>::position() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        const vm::vec<T,3>& Polyhedron_Vertex<T,FP,VP,AP>::position() const {
             return m_position;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Vertex<T,FP,VP>::setPosition(const vm::vec<T,3>& position) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Vertex<T,FP,VP,AP>::setPosition(const vm::vec<T,3>& position) {
             m_position = position;
         }
 
-        template <typename T, typename FP, typename VP>
-        typename Polyhedron_Vertex<T,FP,VP>::HalfEdge* Polyhedron_Vertex<T,FP,VP>::leaving() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename Polyhedron_Vertex<T,FP,VP,AP>::HalfEdge* Polyhedron_Vertex<T,FP,VP,AP>::leaving() const {
             return m_leaving;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Vertex<T,FP,VP>::setLeaving(HalfEdge* edge) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Vertex<T,FP,VP,AP>::setLeaving(HalfEdge* edge) {
             assert(edge == nullptr || edge->origin() == this);
             m_leaving = edge;
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Vertex<T,FP,VP>* Polyhedron_Vertex<T,FP,VP>::next() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Vertex<T,FP,VP,AP>* Polyhedron_Vertex<T,FP,VP,AP>::next() const {
             return m_link.next();
         }
 
-        template <typename T, typename FP, typename VP>
-        Polyhedron_Vertex<T,FP,VP>* Polyhedron_Vertex<T,FP,VP>::previous() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        Polyhedron_Vertex<T,FP,VP,AP>* Polyhedron_Vertex<T,FP,VP,AP>::previous() const {
             return m_link.previous();
         }
 
-        template <typename T, typename FP, typename VP>
-        typename VP::Type Polyhedron_Vertex<T,FP,VP>::payload() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        typename VP::Type Polyhedron_Vertex<T,FP,VP,AP>::payload() const {
             return m_payload;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Vertex<T,FP,VP>::setPayload(typename VP::Type payload) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Vertex<T,FP,VP,AP>::setPayload(typename VP::Type payload) {
             m_payload = payload;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Vertex<T,FP,VP>::hasTwoIncidentEdges() const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Vertex<T,FP,VP,AP>::hasTwoIncidentEdges() const {
             assert(m_leaving != nullptr);
             HalfEdge* nextLeaving = m_leaving->nextIncident();
             return nextLeaving != m_leaving && nextLeaving->nextIncident() == m_leaving;
         }
 
-        template <typename T, typename FP, typename VP>
-        bool Polyhedron_Vertex<T,FP,VP>::incident(const Face* face) const {
+        template <typename T, typename FP, typename VP, typename AP>
+        bool Polyhedron_Vertex<T,FP,VP,AP>::incident(const Face* face) const {
             assert(face != nullptr);
             assert(m_leaving != nullptr);
 
@@ -113,8 +113,8 @@ m_link(this),
             return false;
         }
 
-        template <typename T, typename FP, typename VP>
-        void Polyhedron_Vertex<T,FP,VP>::correctPosition(const size_t decimals, const T epsilon) {
+        template <typename T, typename FP, typename VP, typename AP>
+        void Polyhedron_Vertex<T,FP,VP,AP>::correctPosition(const size_t decimals, const T epsilon) {
             m_position = vm::correct(m_position, decimals, epsilon);
         }
     }
@@ -38,6 +38,14 @@ namespace TrenchBroom {
                 snapshot->restore(worldBounds);
         }
 
+        size_t Snapshot::memorySize() const {
+            auto result = sizeof(Snapshot);
+            for (const NodeSnapshot* snapshot : m_nodeSnapshots) {
+                result += snapshot->memorySize();
+            }
+            return result;
+        }
+
         void Snapshot::takeSnapshot(Node* node) {
             NodeSnapshot* snapshot = node->takeSnapshot();
             if (snapshot != nullptr)
@@ -47,6 +47,11 @@ namespace TrenchBroom {
             ~Snapshot();
 
             void restoreNodes(const vm::bbox3& worldBounds);
+
+            /**
+             * Returns an estimate of the number of bytes of memory held by this snapshot.
+             */
+            size_t memorySize() const;
         private:
             void takeSnapshot(Node* node);
             
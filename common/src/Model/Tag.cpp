@@ -204,6 +204,14 @@ namespace TrenchBroom {
 
         TagMatcher::~TagMatcher() = default;
 
+        bool TagMatcher::matchesByTexture() const {
+            return false;
+        }
+
+        bool TagMatcher::matchesTexture(const Assets::Texture* /* texture */) const {
+            return false;
+        }
+
         void TagMatcher::enable(TagMatcherCallback& /* callback */, MapFacade& /* facade */) const {}
         void TagMatcher::disable(TagMatcherCallback& /* callback */, MapFacade& /* facade */) const {}
 
@@ -239,8 +247,20 @@ namespace TrenchBroom {
             return m_matcher->matches(taggable) ;
         }
 
+        bool SmartTag::matchesByTexture() const {
+            return m_matcher->matchesByTexture();
+        }
+
+        bool SmartTag::matchesTexture(const Assets::Texture* texture) const {
+            return m_matcher->matchesTexture(texture);
+        }
+
         void SmartTag::update(Taggable& taggable) const {
-            if (matches(taggable)) {
+            update(taggable, matches(taggable));
+        }
+
+        void SmartTag::update(Taggable& taggable, const bool matches) const {
+            if (matches) {
                 taggable.addTag(*this);
             } else {
                 taggable.removeTag(*this);
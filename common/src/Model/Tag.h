@@ -30,6 +30,10 @@
 #include <vector>
 
 namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
     namespace Model {
         class ConstTagVisitor;
         class TagManager;
@@ -299,6 +303,22 @@ namespace TrenchBroom {
              */
             virtual bool matches(const Taggable& taggable) const = 0;
 
+            /**
+             * Indicates whether this tag matcher decides whether a brush face matches only by looking at the face's
+             * texture. The tag manager caches the results of such matchers per texture.
+             *
+             * @return true if this tag matcher only depends on the texture of a brush face and false otherwise
+             */
+            virtual bool matchesByTexture() const;
+
+            /**
+             * Evaluates this tag matcher against the given texture. Only meaningful if matchesByTexture returns true.
+             *
+             * @param texture the texture to match against, may be null
+             * @return true if this matcher matches every brush face with the given texture and false otherwise
+             */
+            virtual bool matchesTexture(const Assets::Texture* texture) const;
+
             /**
              * Modifies the current selection so that this tag matcher would match it.
              *
@@ -365,6 +385,22 @@ namespace TrenchBroom {
              */
             bool matches(const Taggable& taggable) const;
 
+            /**
+             * Indicates whether this smart tag decides whether a brush face matches only by looking at its texture.
+             *
+             * @return true if this smart tag only depends on the texture of a brush face and false otherwise
+             */
+            bool matchesByTexture() const;
+
+            /**
+             * Indicates whether this smart tag matches every brush face with the given texture. Only meaningful if
+             * matchesByTexture returns true.
+             *
+             * @param texture the texture to match, may be null
+             * @return true if this smart tag matches the given texture and false otherwise
+             */
+            bool matchesTexture(const Assets::Texture* texture) const;
+
             /**
              * Updates the given tag depending on whether or not the matcher matches against it.
              *
@@ -372,6 +408,14 @@ namespace TrenchBroom {
              */
             void update(Taggable& taggable) const;
 
+            /**
+             * Adds this tag to or removes it from the given taggable depending on the given match result.
+             *
+             * @param taggable the taggable to update
+             * @param matches whether this smart tag matches the given taggable
+             */
+            void update(Taggable& taggable, bool matches) const;
+
             /**
              * Modifies the current selection so that this tag would match it.
              *
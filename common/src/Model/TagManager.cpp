@@ -20,15 +20,29 @@
 #include "TagManager.h"
 
 #include "Ensure.h"
+#include "Assets/Texture.h"
+#include "Model/BrushFace.h"
 #include "Model/Tag.h"
 #include "Model/TagType.h"
+#include "Model/TagVisitor.h"
+
+#include <kdl/string_compare.h>
 
 #include <algorithm>
+#include <atomic>
 #include <stdexcept>
 #include <string>
 
 namespace TrenchBroom {
     namespace Model {
+        static size_t nextGeneration() {
+            static std::atomic<size_t> generation(0u);
+            return ++generation;
+        }
+
+        TagManager::TagManager() :
+        m_generation(nextGeneration()) {}
+
         bool TagManager::TagCmp::operator()(const SmartTag& lhs, const SmartTag& rhs) const {
             return lhs.name() < rhs.name();
         }
@@ -81,6 +95,8 @@ namespace TrenchBroom {
 
         void TagManager::registerSmartTags(const std::vector<SmartTag>& tags) {
             m_smartTags = kdl::vector_set<SmartTag, TagCmp>(tags.size());
+            m_generation = nextGeneration();
+
             for (const auto& tag : tags) {
                 const size_t nextIndex = freeTagIndex();
                 auto [it, inserted] = m_smartTags.insert(tag);
@@ -95,11 +111,24 @@ namespace TrenchBroom {
 
         void TagManager::clearSmartTags() {
             m_smartTags.clear();
+            m_generation = nextGeneration();
         }
 
         void TagManager::updateTags(Taggable& taggable) const {
-            for (const auto& tag : m_smartTags) {
-                tag.update(taggable);
+            auto* texture = faceTexture(taggable);
+            if (texture == nullptr) {
+                for (const auto& tag : m_smartTags) {
+                    tag.update(taggable);
+                }
+            } else {
+                const auto textureMask = textureTagMask(*texture);
+                for (const auto& tag : m_smartTags) {
+                    if (tag.matchesByTexture()) {
+                        tag.update(taggable, (textureMask & tag.type()) != 0);
+                    } else {
+                        tag.update(taggable);
+                    }
+                }
             }
         }
 
@@ -109,5 +138,44 @@ namespace TrenchBroom {
             ensure(index <= Bits, "no more tag types");
             return index;
         }
+
+        class FaceTextureVisitor : public ConstTagVisitor {
+        private:
+            Assets::Texture* m_texture;
+        public:
+            FaceTextureVisitor() :
+            m_texture(nullptr) {}
+
+            Assets::Texture* texture() const {
+                return m_texture;
+            }
+
+            void visit(const BrushFace& face) override {
+                // the texture of a face is only updated after its attributes have changed, so it may be stale
+                auto* texture = face.texture();
+                if (texture != nullptr && kdl::ci::str_is_equal(texture->name(), face.attributes().textureName())) {
+                    m_texture = texture;
+                }
+            }
+        };
+
+        Assets::Texture* TagManager::faceTexture(const Taggable& taggable) const {
+            FaceTextureVisitor visitor;
+            taggable.accept(visitor);
+            return visitor.texture();
+        }
+
+        TagType::Type TagManager::textureTagMask(Assets::Texture& texture) const {
+            if (!texture.hasTagMask(m_generation)) {
+                auto tagMask = TagType::NoType;
+                for (const auto& tag : m_smartTags) {
+                    if (tag.matchesByTexture() && tag.matchesTexture(&texture)) {
+                        tagMask |= tag.type();
+                    }
+                }
+                texture.setTagMask(m_generation, tagMask);
+            }
+            return texture.tagMask();
+        }
     }
 }
@@ -21,12 +21,17 @@
 #define TRENCHBROOM_TAGMANAGER_H
 
 #include "Model/Tag.h"
+#include "Model/TagType.h"
 
 #include <kdl/vector_set.h>
 
 #include <string>
 
 namespace TrenchBroom {
+    namespace Assets {
+        class Texture;
+    }
+
     namespace Model {
         /**
          * Manages the tags used in a document and updates smart tags on taggable objects.
@@ -41,7 +46,15 @@ namespace TrenchBroom {
             };
 
             kdl::vector_set<SmartTag, TagCmp> m_smartTags;
+
+            /**
+             * Identifies the currently registered smart tags. Textures cache the results of the smart tags that only
+             * depend on the texture of a brush face together with the generation they were computed for.
+             */
+            size_t m_generation;
         public:
+            TagManager();
+
             /**
              * Returns a vector containing all smart tags registered with this manager.
              */
@@ -108,6 +121,8 @@ namespace TrenchBroom {
             void updateTags(Taggable& taggable) const;
         private:
             size_t freeTagIndex();
+            Assets::Texture* faceTexture(const Taggable& taggable) const;
+            TagType::Type textureTagMask(Assets::Texture& texture) const;
         };
     }
 }
@@ -63,6 +63,10 @@ namespace TrenchBroom {
             }
         }
 
+        bool TextureTagMatcher::matchesByTexture() const {
+            return true;
+        }
+
         void TextureTagMatcher::enable(TagMatcherCallback& callback, MapFacade& facade) const {
             const auto& textureManager = facade.textureManager();
             const auto& allTextures = textureManager.textures();
@@ -118,7 +122,7 @@ namespace TrenchBroom {
             return visitor.matches();
         }
 
-        bool TextureNameTagMatcher::matchesTexture(Assets::Texture *texture) const {
+        bool TextureNameTagMatcher::matchesTexture(const Assets::Texture* texture) const {
             if (texture == nullptr) {
                 return false;
             }
@@ -157,7 +161,7 @@ namespace TrenchBroom {
             return visitor.matches();
         }
 
-        bool SurfaceParmTagMatcher::matchesTexture(Assets::Texture *texture) const {
+        bool SurfaceParmTagMatcher::matchesTexture(const Assets::Texture* texture) const {
             if (texture == nullptr) {
                 return false;
             }
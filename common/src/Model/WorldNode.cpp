@@ -50,7 +50,8 @@ namespace TrenchBroom {
         m_attributableIndex(std::make_unique<AttributableNodeIndex>()),
         m_issueGeneratorRegistry(std::make_unique<IssueGeneratorRegistry>()),
         m_nodeTree(std::make_unique<NodeTree>()),
-        m_updateNodeTree(true) {
+        m_updateNodeTree(true),
+        m_nodeTreeModificationCount(0u) {
             addOrUpdateAttribute(AttributeNames::Classname, AttributeValues::WorldspawnClassname);
             createDefaultLayer();
         }
@@ -170,6 +171,37 @@ namespace TrenchBroom {
             bool operator()(const Model::Node* node) const   { return node->shouldAddToSpacialIndex(); }
         };
 
+        WorldNode::BulkNodeTreeInsertion::BulkNodeTreeInsertion(WorldNode& world) :
+        m_world(world),
+        m_inserted(false) {
+            m_world.disableNodeTreeUpdates();
+        }
+
+        WorldNode::BulkNodeTreeInsertion::~BulkNodeTreeInsertion() {
+            if (!m_inserted) {
+                m_world.enableNodeTreeUpdates();
+                try {
+                    m_world.rebuildNodeTree();
+                } catch (const NodeTreeException&) {
+                    // the node tree is left empty, which is the best we can do while unwinding
+                }
+            }
+        }
+
+        void WorldNode::BulkNodeTreeInsertion::insertNodes(const std::vector<Node*>& nodes) {
+            using CollectTreeNodes = CollectMatchingNodesVisitor<MatchTreeNodes>;
+
+            assert(!m_inserted);
+            m_inserted = true;
+            m_world.enableNodeTreeUpdates();
+
+            CollectTreeNodes collect;
+            Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), collect);
+
+            m_world.m_nodeTree->insertAll(collect.nodes(), [](const auto* node){ return node->physicalBounds(); });
+            ++m_world.m_nodeTreeModificationCount;
+        }
+
         void WorldNode::disableNodeTreeUpdates() {
             m_updateNodeTree = false;
         }
@@ -185,6 +217,19 @@ namespace TrenchBroom {
             acceptAndRecurse(collect);
 
             m_nodeTree->clearAndBuild(collect.nodes(), [](const auto* node){ return node->physicalBounds(); });
+            ++m_nodeTreeModificationCount;
+        }
+
+        size_t WorldNode::nodeTreeModificationCount() const {
+            return m_nodeTreeModificationCount;
+        }
+
+        std::vector<Node*> WorldNode::findNodesIntersecting(const std::vector<vm::plane3>& planes) const {
+            return m_nodeTree->findIntersectors(planes);
+        }
+
+        std::vector<Node*> WorldNode::findNodesIntersecting(const vm::bbox3& bounds) const {
+            return m_nodeTree->findIntersectors(bounds);
         }
 
         class WorldNode::InvalidateAllIssuesVisitor : public NodeVisitor {
@@ -216,6 +261,7 @@ namespace TrenchBroom {
         Node* WorldNode::doClone(const vm::bbox3& /* worldBounds */) const {
             WorldNode* world = m_factory->createWorld();
             cloneAttributes(world);
+            world->setAttributes(attributes());
             return world;
         }
 
@@ -223,10 +269,16 @@ namespace TrenchBroom {
             const std::vector<Node*>& myChildren = children();
             assert(myChildren[0] == m_defaultLayer);
 
-            WorldNode* world = m_factory->createWorld();
-            cloneAttributes(world);
+            WorldNode* world = static_cast<WorldNode*>(doClone(worldBounds));
 
-            world->defaultLayer()->addChildren(cloneRecursively(worldBounds, m_defaultLayer->children()));
+            LayerNode* defaultLayer = world->defaultLayer();
+            defaultLayer->setVisibilityState(m_defaultLayer->visibilityState());
+            defaultLayer->setLockState(m_defaultLayer->lockState());
+            defaultLayer->setAttributes(m_defaultLayer->attributes());
+
+            BulkNodeTreeInsertion bulkInsertion(*world);
+
+            defaultLayer->addChildren(cloneRecursively(worldBounds, m_defaultLayer->children()));
 
             if (myChildren.size() > 1) {
                 std::vector<Node*> childClones;
@@ -235,6 +287,8 @@ namespace TrenchBroom {
                 world->addChildren(childClones);
             }
 
+            bulkInsertion.insertNodes(world->children());
+
             return world;
         }
 
@@ -288,6 +342,7 @@ namespace TrenchBroom {
             if (m_updateNodeTree) {
                 AddNodeToNodeTree visitor(*m_nodeTree);
                 node->acceptAndRecurse(visitor);
+                ++m_nodeTreeModificationCount;
             }
         }
 
@@ -295,6 +350,7 @@ namespace TrenchBroom {
             if (m_updateNodeTree) {
                 RemoveNodeFromNodeTree visitor(*m_nodeTree);
                 node->acceptAndRecurse(visitor);
+                ++m_nodeTreeModificationCount;
             }
         }
 
@@ -302,6 +358,7 @@ namespace TrenchBroom {
             if (m_updateNodeTree) {
                 UpdateNodeInNodeTree visitor(*m_nodeTree);
                 node->accept(visitor);
+                ++m_nodeTreeModificationCount;
             }
         }
 
@@ -50,6 +50,7 @@ namespace TrenchBroom {
             using NodeTree = AABBTree<FloatType, 3, Node*>;
             std::unique_ptr<NodeTree> m_nodeTree;
             bool m_updateNodeTree;
+            size_t m_nodeTreeModificationCount;
         public:
             WorldNode(MapFormat mapFormat);
             ~WorldNode() override;
@@ -87,9 +88,52 @@ namespace TrenchBroom {
             class UpdateNodeInNodeTree;
         public: // node tree bulk updating
             class MatchTreeNodes;
+
+            /**
+             * Disables node tree updates of a world while it exists, so that many nodes can be added to the world and
+             * then be inserted into the node tree at once by calling insertNodes.
+             *
+             * If the guard is destroyed without insertNodes having been called, e.g. because an exception was thrown
+             * while adding the nodes, the node tree is rebuilt from scratch so that it matches the world again.
+             */
+            class BulkNodeTreeInsertion {
+            private:
+                WorldNode& m_world;
+                bool m_inserted;
+            public:
+                explicit BulkNodeTreeInsertion(WorldNode& world);
+                ~BulkNodeTreeInsertion();
+
+                /**
+                 * Inserts the given nodes and their descendants into the node tree of the world and re-enables node tree
+                 * updates.
+                 */
+                void insertNodes(const std::vector<Node*>& nodes);
+
+                deleteCopyAndMove(BulkNodeTreeInsertion)
+            };
+
             void disableNodeTreeUpdates();
             void enableNodeTreeUpdates();
             void rebuildNodeTree();
+
+            /**
+             * Returns a counter that is incremented whenever the node tree is modified. Callers can cache the results of
+             * spatial queries and reuse them for as long as this counter does not change.
+             */
+            size_t nodeTreeModificationCount() const;
+        public: // spatial queries
+            /**
+             * Returns the entities and brushes whose bounds intersect with the convex volume bounded by the given planes,
+             * e.g. a view frustum. The normals of the planes must point out of the volume. Some nodes close to the
+             * volume may be returned even if they don't intersect it.
+             */
+            std::vector<Node*> findNodesIntersecting(const std::vector<vm::plane3>& planes) const;
+
+            /**
+             * Returns the entities and brushes whose bounds intersect with the given bounds.
+             */
+            std::vector<Node*> findNodesIntersecting(const vm::bbox3& bounds) const;
         private:
             class InvalidateAllIssuesVisitor;
             void invalidateAllIssues();
@@ -133,6 +133,9 @@ namespace TrenchBroom {
         Preference<bool> TextureLock(IO::Path("Editor/Texture lock"), true);
         Preference<bool> UVLock(IO::Path("Editor/UV lock"), false);
 
+        Preference<bool> UseMapCache(IO::Path("Editor/Use map cache"), false);
+        Preference<int> UndoMemoryBudget(IO::Path("Editor/Undo memory budget"), 1024);
+
         Preference<IO::Path>& RendererFontPath() {
             static Preference<IO::Path> fontPath(IO::Path("Renderer/Font name"), IO::Path("fonts/SourceSansPro-Regular.otf"));
             return fontPath;
@@ -260,6 +263,8 @@ namespace TrenchBroom {
                 &TextureMagFilter,
                 &TextureLock,
                 &UVLock,
+                &UseMapCache,
+                &UndoMemoryBudget,
                 &RendererFontPath(),
                 &RendererFontSize,
                 &BrowserFontSize,
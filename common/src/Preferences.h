@@ -127,6 +127,9 @@ namespace TrenchBroom {
         extern Preference<bool> TextureLock;
         extern Preference<bool> UVLock;
 
+        extern Preference<bool> UseMapCache;
+        extern Preference<int> UndoMemoryBudget; // in MiB
+
         Preference<IO::Path>& RendererFontPath();
         extern Preference<int> RendererFontSize;
 
@@ -170,6 +170,8 @@ namespace TrenchBroom {
             block->nextOfSameSize = nullptr;
             block->prevOfSameSize = nullptr;
 
+            m_freeSize -= needed;
+
             if (block->size == needed) {
                 // lucky case: exact size. we're done
                 block->free = false;
@@ -218,6 +220,8 @@ namespace TrenchBroom {
             assert(block->prevOfSameSize == nullptr);
             assert(block->nextOfSameSize == nullptr);
 
+            m_freeSize += block->size;
+
             Block* left = block->left;
             Block* right = block->right;
 
@@ -315,6 +319,7 @@ namespace TrenchBroom {
 
         AllocationTracker::AllocationTracker(const Index initial_capacity)
                 : m_capacity(0),
+                  m_freeSize(0),
                   m_leftmostBlock(nullptr),
                   m_rightmostBlock(nullptr),
                   m_recycledBlockList(nullptr) {
@@ -326,6 +331,7 @@ namespace TrenchBroom {
 
         AllocationTracker::AllocationTracker()
                 : m_capacity(0),
+                  m_freeSize(0),
                   m_leftmostBlock(nullptr),
                   m_rightmostBlock(nullptr),
                   m_recycledBlockList(nullptr) {}
@@ -356,6 +362,7 @@ namespace TrenchBroom {
             if (m_capacity == 0) {
                 assert(newCapacity > 0);
                 m_capacity = newCapacity;
+                m_freeSize = newCapacity;
 
                 Block* newBlock = obtainBlock();
                 newBlock->pos = 0;
@@ -408,6 +415,7 @@ namespace TrenchBroom {
             }
 
             m_capacity += increase;
+            m_freeSize += increase;
 
             checkInvariants();
         }
@@ -422,6 +430,78 @@ namespace TrenchBroom {
             return false;
         }
 
+        AllocationTracker::Index AllocationTracker::freeSize() const {
+            return m_freeSize;
+        }
+
+        std::vector<AllocationTracker::Relocation> AllocationTracker::compact() {
+            checkInvariants();
+
+            std::vector<Relocation> result;
+            if (m_capacity == 0) {
+                return result;
+            }
+
+            // all free blocks are recycled and replaced by a single free block at the end
+            m_freeBlockSizeBins.clear();
+
+            Index pos = 0;
+            Block* last = nullptr;
+            Block* next;
+            for (Block* block = m_leftmostBlock; block != nullptr; block = next) {
+                next = block->right;
+
+                if (block->free) {
+                    block->prevOfSameSize = nullptr;
+                    block->nextOfSameSize = nullptr;
+                    recycle(block);
+                } else {
+                    if (block->pos != pos) {
+                        assert(block->pos > pos);
+                        result.push_back(Relocation{block->pos, pos, block->size});
+                        block->pos = pos;
+                    }
+
+                    block->left = last;
+                    block->right = nullptr;
+                    if (last == nullptr) {
+                        m_leftmostBlock = block;
+                    } else {
+                        last->right = block;
+                    }
+
+                    last = block;
+                    pos += block->size;
+                }
+            }
+
+            if (pos < m_capacity) {
+                Block* freeBlock = obtainBlock();
+                freeBlock->pos = pos;
+                freeBlock->size = m_capacity - pos;
+                freeBlock->prevOfSameSize = nullptr;
+                freeBlock->nextOfSameSize = nullptr;
+                freeBlock->left = last;
+                freeBlock->right = nullptr;
+                freeBlock->free = true;
+
+                if (last == nullptr) {
+                    m_leftmostBlock = freeBlock;
+                } else {
+                    last->right = freeBlock;
+                }
+
+                last = freeBlock;
+                linkToBinList(freeBlock);
+            }
+
+            m_rightmostBlock = last;
+            assert(m_freeSize == m_capacity - pos);
+
+            checkInvariants();
+            return result;
+        }
+
 // Testing / debugging
 
         std::vector<AllocationTracker::Range> AllocationTracker::freeBlocks() const {
@@ -470,9 +550,13 @@ namespace TrenchBroom {
 
             // check the left/right pointers, size, pos
             size_t totalSize = 0;
+            size_t freeSize = 0;
             for (Block* block = m_leftmostBlock; block != nullptr; block = block->right) {
                 assert(block->size != 0);
                 totalSize += block->size;
+                if (block->free) {
+                    freeSize += block->size;
+                }
 
                 if (block->right != nullptr) {
                     assert(block->right->left == block);
@@ -489,6 +573,7 @@ namespace TrenchBroom {
                 }
             }
             assert(m_capacity == totalSize);
+            assert(m_freeSize == freeSize);
 
             // check the size map
             for (const auto& headBlock : m_freeBlockSizeBins) {
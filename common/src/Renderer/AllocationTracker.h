@@ -70,6 +70,11 @@ namespace TrenchBroom {
              */
             Index m_capacity;
 
+            /**
+             * Always equal to the sum of `size` of all free Blocks.
+             */
+            Index m_freeSize;
+
             /**
              * Points to the Block with pos 0. Used to free all of the blocks in the destructor
              */
@@ -126,6 +131,33 @@ namespace TrenchBroom {
              */
             bool hasAllocations() const;
 
+            /**
+             * @return the total size of all free blocks. Constant time.
+             */
+            Index freeSize() const;
+
+            /**
+             * Describes a used block that was moved by compact().
+             */
+            struct Relocation {
+                Index oldPos;
+                Index newPos;
+                Index size;
+            };
+
+            /**
+             * Moves all used blocks to the start of the managed range, preserving their order, so that all free space
+             * forms a single free block at the end. The Block objects of the used blocks remain valid, but their `pos`
+             * may change.
+             *
+             * The caller must move the contents of the relocated blocks accordingly. The returned relocations are sorted
+             * by position and every block is moved towards the start, so applying them in order never overwrites the
+             * contents of a block that still has to be moved.
+             *
+             * @return the blocks that were moved
+             */
+            std::vector<Relocation> compact();
+
             // Testing / debugging
 
             class Range {
@@ -31,8 +31,11 @@
 #include "Renderer/BrushRendererBrushCache.h"
 #include "Renderer/RenderContext.h"
 
+#include <kdl/parallel.h>
+
 #include <cassert>
 #include <cstring>
+#include <tuple>
 #include <vector>
 
 namespace TrenchBroom {
@@ -133,7 +136,8 @@ namespace TrenchBroom {
         m_showOccludedEdges(false),
         m_forceTransparent(false),
         m_transparencyAlpha(1.0f),
-        m_showHiddenBrushes(false) {
+        m_showHiddenBrushes(false),
+        m_visibleBlocksValid(false) {
             clear();
         }
 
@@ -208,6 +212,7 @@ namespace TrenchBroom {
             m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
             m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_visibleBlocksValid = false;
         }
 
         void BrushRenderer::setFaceColor(const Color& faceColor) {
@@ -263,6 +268,13 @@ namespace TrenchBroom {
             }
         }
 
+        void BrushRenderer::setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes) {
+            if (visibleNodes != m_visibleNodes) {
+                m_visibleNodes = std::move(visibleNodes);
+                m_visibleBlocksValid = false;
+            }
+        }
+
         void BrushRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             renderOpaque(renderContext, renderBatch);
             renderTransparent(renderContext, renderBatch);
@@ -273,6 +285,9 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
+                if (!m_visibleBlocksValid) {
+                    validateVisibleBlocks();
+                }
                 if (renderContext.showFaces()) {
                     renderOpaqueFaces(renderBatch);
                 }
@@ -287,6 +302,9 @@ namespace TrenchBroom {
                 if (!valid()) {
                     validate();
                 }
+                if (!m_visibleBlocksValid) {
+                    validateVisibleBlocks();
+                }
                 if (renderContext.showFaces()) {
                     renderTransparentFaces(renderBatch);
                 }
@@ -315,6 +333,54 @@ namespace TrenchBroom {
             m_edgeRenderer.render(renderBatch, m_edgeColor);
         }
 
+        /**
+         * Unless at least this fraction of the brushes is culled, all indices are drawn at once because drawing many
+         * separate ranges is not worth skipping the few culled brushes.
+         */
+        static constexpr double MinCulledBrushFraction = 0.1;
+
+        void BrushRenderer::validateVisibleBlocks() {
+            std::shared_ptr<FaceRenderer::TextureToBlocksMap> opaqueBlocks;
+            std::shared_ptr<FaceRenderer::TextureToBlocksMap> transparentBlocks;
+            std::shared_ptr<IndexedEdgeRenderer::BlockList> edgeBlocks;
+
+            if (m_visibleNodes != nullptr) {
+                opaqueBlocks = std::make_shared<FaceRenderer::TextureToBlocksMap>();
+                transparentBlocks = std::make_shared<FaceRenderer::TextureToBlocksMap>();
+                edgeBlocks = std::make_shared<IndexedEdgeRenderer::BlockList>();
+
+                size_t visibleCount = 0u;
+                for (const auto& [brush, info] : m_brushInfo) {
+                    if (m_visibleNodes->count(brush) == 0u) {
+                        continue;
+                    }
+
+                    ++visibleCount;
+                    if (info.edgeIndicesKey != nullptr) {
+                        edgeBlocks->push_back(info.edgeIndicesKey);
+                    }
+                    for (const auto& [texture, block] : info.opaqueFaceIndicesKeys) {
+                        (*opaqueBlocks)[texture].push_back(block);
+                    }
+                    for (const auto& [texture, block] : info.transparentFaceIndicesKeys) {
+                        (*transparentBlocks)[texture].push_back(block);
+                    }
+                }
+
+                const auto culledCount = m_brushInfo.size() - visibleCount;
+                if (static_cast<double>(culledCount) < MinCulledBrushFraction * static_cast<double>(m_brushInfo.size())) {
+                    opaqueBlocks = nullptr;
+                    transparentBlocks = nullptr;
+                    edgeBlocks = nullptr;
+                }
+            }
+
+            m_opaqueFaceRenderer.setVisibleBlocks(std::move(opaqueBlocks));
+            m_transparentFaceRenderer.setVisibleBlocks(std::move(transparentBlocks));
+            m_edgeRenderer.setVisibleBlocks(std::move(edgeBlocks));
+            m_visibleBlocksValid = true;
+        }
+
         class BrushRenderer::FilterWrapper : public BrushRenderer::Filter {
         private:
             const Filter& m_filter;
@@ -338,11 +404,41 @@ namespace TrenchBroom {
             }
         };
 
+        /**
+         * The minimum number of brushes to validate at once before their caches are built on multiple threads.
+         */
+        static constexpr size_t ParallelValidationMinCount = 256u;
+
         void BrushRenderer::validate() {
             assert(!valid());
 
+            // evaluate filter. only evaluate the filter once per brush.
+            const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
+
+            std::vector<std::tuple<const Model::BrushNode*, Filter::RenderSettings>> brushesToValidate;
+            brushesToValidate.reserve(m_invalidBrushes.size());
+
             for (auto brush : m_invalidBrushes) {
-                validateBrush(brush);
+                const auto settings = wrapper.markFaces(brush);
+                const auto [facePolicy, edgePolicy] = settings;
+
+                // NOTE: this skips inserting the brush into m_brushInfo
+                if (facePolicy != Filter::FaceRenderPolicy::RenderNone ||
+                    edgePolicy != Filter::EdgeRenderPolicy::RenderNone) {
+                    brushesToValidate.emplace_back(brush, settings);
+                }
+            }
+
+            // The brush caches only depend on their own brush, so they can be built concurrently. Inserting the cached
+            // vertices and indices into the shared arrays must happen sequentially.
+            const auto threadCount = brushesToValidate.size() >= ParallelValidationMinCount ? kdl::default_thread_count() : 1u;
+            kdl::parallel_for(brushesToValidate.size(), [&](const size_t i) {
+                const auto* brush = std::get<0>(brushesToValidate[i]);
+                brush->brushRendererBrushCache().validateVertexCache(brush);
+            }, threadCount);
+
+            for (const auto& [brush, settings] : brushesToValidate) {
+                validateBrush(brush, settings);
             }
             m_invalidBrushes.clear();
             assert(valid());
@@ -350,6 +446,7 @@ namespace TrenchBroom {
             m_opaqueFaceRenderer = FaceRenderer(m_vertexArray, m_opaqueFaces, m_faceColor);
             m_transparentFaceRenderer = FaceRenderer(m_vertexArray, m_transparentFaces, m_faceColor);
             m_edgeRenderer = IndexedEdgeRenderer(m_vertexArray, m_edgeIndices);
+            m_visibleBlocksValid = false;
         }
 
         static size_t triIndicesCountForPolygon(const size_t vertexCount) {
@@ -438,22 +535,12 @@ namespace TrenchBroom {
             return false;
         }
 
-        void BrushRenderer::validateBrush(const Model::BrushNode* brush) {
+        void BrushRenderer::validateBrush(const Model::BrushNode* brush, const Filter::RenderSettings& settings) {
             assert(m_allBrushes.find(brush) != std::end(m_allBrushes));
             assert(m_invalidBrushes.find(brush) != std::end(m_invalidBrushes));
             assert(m_brushInfo.find(brush) == std::end(m_brushInfo));
 
-            const FilterWrapper wrapper(*m_filter, m_showHiddenBrushes);
-
-            // evaluate filter. only evaluate the filter once per brush.
-            const auto settings = wrapper.markFaces(brush);
-            const auto [facePolicy, edgePolicy] = settings;
-
-            if (facePolicy == Filter::FaceRenderPolicy::RenderNone &&
-                edgePolicy == Filter::EdgeRenderPolicy::RenderNone) {
-                // NOTE: this skips inserting the brush into m_brushInfo
-                return;
-            }
+            const auto edgePolicy = std::get<1>(settings);
 
             BrushInfo& info = m_brushInfo[brush];
 
@@ -602,6 +689,9 @@ namespace TrenchBroom {
 
             const BrushInfo& info = it->second;
 
+            // the collected allocations of the visible brushes may contain the allocations that are freed below
+            m_visibleBlocksValid = false;
+
             // update Vbo's
             m_vertexArray->deleteVerticesWithKey(info.vertexHolderKey);
             if (info.edgeIndicesKey != nullptr) {
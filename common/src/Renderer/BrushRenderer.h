@@ -37,6 +37,7 @@ namespace TrenchBroom {
         class BrushNode;
         class BrushFace;
         class EditorContext;
+        class Node;
     }
 
     namespace Renderer {
@@ -162,6 +163,9 @@ namespace TrenchBroom {
             float m_transparencyAlpha;
 
             bool m_showHiddenBrushes;
+
+            std::shared_ptr<const std::unordered_set<const Model::Node*>> m_visibleNodes;
+            bool m_visibleBlocksValid;
         public:
             template <typename FilterT>
             explicit BrushRenderer(const FilterT& filter) :
@@ -172,7 +176,8 @@ namespace TrenchBroom {
             m_showOccludedEdges(false),
             m_forceTransparent(false),
             m_transparencyAlpha(1.0f),
-            m_showHiddenBrushes(false) {
+            m_showHiddenBrushes(false),
+            m_visibleBlocksValid(false) {
                 clear();
             }
 
@@ -266,6 +271,12 @@ namespace TrenchBroom {
              * Specifies whether or not brushes which are currently hidden should be rendered regardless.
              */
             void setShowHiddenBrushes(bool showHiddenBrushes);
+
+            /**
+             * Restricts rendering to the given brushes, e.g. the brushes that intersect the view frustum. Only the index
+             * ranges of the given brushes are drawn. If the given pointer is null, all brushes are rendered.
+             */
+            void setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes);
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -275,6 +286,11 @@ namespace TrenchBroom {
             void renderTransparentFaces(RenderBatch& renderBatch);
             void renderEdges(RenderBatch& renderBatch);
 
+            /**
+             * Collects the index allocations of the visible brushes and passes them to the face and edge renderers.
+             */
+            void validateVisibleBlocks();
+
         public:
             /**
              * Only exposed for benchmarking.
@@ -282,7 +298,7 @@ namespace TrenchBroom {
             void validate();
         private:
             bool shouldDrawFaceInTransparentPass(const Model::BrushNode* brush, const Model::BrushFace& face) const;
-            void validateBrush(const Model::BrushNode* brush);
+            void validateBrush(const Model::BrushNode* brush, const Filter::RenderSettings& settings);
             void addBrush(const Model::BrushNode* brush);
             void removeBrush(const Model::BrushNode* brush);
 
@@ -87,6 +87,25 @@ namespace TrenchBroom {
             glAssert(glDrawElements(toGL(primType), renderCount, glType<Index>(), renderOffset));
         }
 
+        void IndexHolder::render(const PrimType primType, const std::vector<std::pair<size_t, size_t>>& ranges) const {
+            if (ranges.empty()) {
+                return;
+            }
+
+            std::vector<GLsizei> counts;
+            std::vector<const GLvoid*> offsets;
+            counts.reserve(ranges.size());
+            offsets.reserve(ranges.size());
+
+            for (const auto& [offset, count] : ranges) {
+                counts.push_back(static_cast<GLsizei>(count));
+                offsets.push_back(reinterpret_cast<const GLvoid*>(m_vbo->offset() + sizeof(Index) * offset));
+            }
+
+            const GLsizei primCount = static_cast<GLsizei>(ranges.size());
+            glAssert(glMultiDrawElements(toGL(primType), counts.data(), glType<Index>(), offsets.data(), primCount));
+        }
+
         std::shared_ptr<IndexHolder> IndexHolder::swap(std::vector<IndexHolder::Index> &elements) {
             return std::make_shared<IndexHolder>(elements);
         }
@@ -136,15 +155,57 @@ namespace TrenchBroom {
             m_indexHolder.render(primType, 0, m_indexHolder.size());
         }
 
+        void BrushIndexArray::render(const PrimType primType, std::vector<const AllocationTracker::Block*> blocks) const {
+            assert(m_indexHolder.prepared());
+
+            std::sort(std::begin(blocks), std::end(blocks), [](const auto* lhs, const auto* rhs) { return lhs->pos < rhs->pos; });
+
+            std::vector<std::pair<size_t, size_t>> ranges;
+            for (const auto* block : blocks) {
+                if (!ranges.empty() && ranges.back().first + ranges.back().second == block->pos) {
+                    ranges.back().second += block->size;
+                } else {
+                    ranges.emplace_back(block->pos, block->size);
+                }
+            }
+
+            m_indexHolder.render(primType, ranges);
+        }
+
         bool BrushIndexArray::prepared() const {
             return m_indexHolder.prepared();
         }
 
         void BrushIndexArray::prepare(VboManager& vboManager) {
+            if (!m_indexHolder.prepared() && shouldCompact()) {
+                compact();
+                vboManager.countCompaction();
+            }
+
             m_indexHolder.prepare(vboManager);
+            m_indexHolder.reportFreeElements(m_allocationTracker.freeSize(), m_allocationTracker.largestPossibleAllocation());
             assert(m_indexHolder.prepared());
         }
 
+        bool BrushIndexArray::shouldCompact() const {
+            // compact if at least a quarter of the indices is free, and at most half of the free indices are in one range
+            const auto freeSize = m_allocationTracker.freeSize();
+            return freeSize > 0u
+                   && 4u * freeSize >= m_allocationTracker.capacity()
+                   && 2u * m_allocationTracker.largestPossibleAllocation() <= freeSize;
+        }
+
+        void BrushIndexArray::compact() {
+            // the zeroed ranges of freed allocations are overwritten by the moved indices, and everything after the last
+            // allocation is zeroed, so no stale indices remain
+            for (const auto& relocation : m_allocationTracker.compact()) {
+                m_indexHolder.moveElements(relocation.oldPos, relocation.newPos, relocation.size);
+            }
+
+            const auto usedSize = m_allocationTracker.capacity() - m_allocationTracker.freeSize();
+            m_indexHolder.zeroRange(usedSize, m_allocationTracker.freeSize());
+        }
+
         void BrushIndexArray::setupIndices() {
             m_indexHolder.bindBlock();
         }
@@ -202,6 +263,7 @@ namespace TrenchBroom {
 
         void BrushVertexArray::prepare(VboManager& vboManager) {
             m_vertexHolder.prepare(vboManager);
+            m_vertexHolder.reportFreeElements(m_allocationTracker.freeSize(), m_allocationTracker.largestPossibleAllocation());
             assert(m_vertexHolder.prepared());
         }
     }
@@ -32,8 +32,10 @@
 #include <vecmath/vec.h>
 
 #include <cassert>
+#include <cstring>
 #include <memory>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
@@ -75,6 +77,11 @@ namespace TrenchBroom {
             DirtyRangeTracker m_dirtyRange;
             VboManager* m_vboManager;
             Vbo* m_vbo;
+
+            /**
+             * The sizes of this buffer as last reported to the VBO manager, see reportFreeElements().
+             */
+            TrackedVboBytes m_reportedBytes;
         private:
             void freeBlock() {
                 if (m_vbo != nullptr) {
@@ -107,7 +114,8 @@ namespace TrenchBroom {
             m_snapshot(),
             m_dirtyRange(0),
             m_vboManager(nullptr),
-            m_vbo(nullptr) {}
+            m_vbo(nullptr),
+            m_reportedBytes() {}
 
             /**
              * NOTE: This destructively moves the contents of `elements` into the Holder.
@@ -117,7 +125,8 @@ namespace TrenchBroom {
             m_snapshot(),
             m_dirtyRange(elements.size()),
             m_vboManager(nullptr),
-            m_vbo(nullptr) {
+            m_vbo(nullptr),
+            m_reportedBytes() {
 
                 const size_t elementsCount = elements.size();
                 m_dirtyRange.markDirty(0, elementsCount);
@@ -135,6 +144,9 @@ namespace TrenchBroom {
             virtual ~VboHolder() {
                 // TODO: Revisit this revisiting OpenGL resource management. We should not store the VboManager,
                 // since it represents a safe time to delete the OpenGL buffer object.
+                if (m_vboManager != nullptr) {
+                    m_vboManager->updateTrackedBytes(m_reportedBytes, TrackedVboBytes());
+                }
                 freeBlock();
             }
 
@@ -152,6 +164,33 @@ namespace TrenchBroom {
                 return m_snapshot.data() + offsetWithinBlock;
             }
 
+            /**
+             * Moves the given range of elements to the given offset. The ranges may overlap.
+             */
+            void moveElements(const size_t fromOffset, const size_t toOffset, const size_t elementCount) {
+                assert(fromOffset + elementCount <= m_snapshot.size());
+                assert(toOffset + elementCount <= m_snapshot.size());
+
+                m_dirtyRange.markDirty(toOffset, elementCount);
+                std::memmove(m_snapshot.data() + toOffset, m_snapshot.data() + fromOffset, elementCount * sizeof(T));
+            }
+
+            /**
+             * For buffers managed by an allocation tracker, reports the number of currently free elements and the size
+             * of the largest free block to the VBO manager, which uses them to compute the free space and fragmentation
+             * statistics. Has no effect until this buffer has been prepared.
+             */
+            void reportFreeElements(const size_t freeElementCount, const size_t largestFreeElementCount) {
+                if (m_vboManager != nullptr) {
+                    auto bytes = TrackedVboBytes();
+                    bytes.size = m_snapshot.size() * sizeof(T);
+                    bytes.free = freeElementCount * sizeof(T);
+                    bytes.largestFree = largestFreeElementCount * sizeof(T);
+                    m_vboManager->updateTrackedBytes(m_reportedBytes, bytes);
+                    m_reportedBytes = bytes;
+                }
+            }
+
             bool prepared() const {
                 // NOTE: this returns true if the capacity is 0
                 return m_dirtyRange.clean();
@@ -175,8 +214,14 @@ namespace TrenchBroom {
 
                 // resize?
                 if (m_dirtyRange.capacity() != (m_vbo->capacity() / sizeof(T))) {
-                    freeBlock();
-                    allocateBlock(vboManager);
+                    if (m_vboManager->streamingUploads()) {
+                        // keep the buffer object and only replace its storage
+                        m_vbo->orphanAndWriteArray(m_snapshot.data(), m_snapshot.size());
+                        m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
+                    } else {
+                        freeBlock();
+                        allocateBlock(vboManager);
+                    }
                     assert(prepared());
                     return;
                 }
@@ -187,10 +232,16 @@ namespace TrenchBroom {
                     const size_t pos = m_dirtyRange.m_dirtyPos;
                     const size_t size = m_dirtyRange.m_dirtySize;
 
-                    const size_t bytesFromStart = pos * sizeof(T);
-                    m_vbo->writeArray(bytesFromStart,
-                                      m_snapshot.data() + pos,
-                                      size);
+                    if (m_vboManager->streamingUploads() && 2u * size >= m_snapshot.size()) {
+                        // most of the buffer is rewritten anyway, so upload all of it into fresh storage rather than
+                        // updating storage that may still be in use by the GPU
+                        m_vbo->orphanAndWriteArray(m_snapshot.data(), m_snapshot.size());
+                    } else {
+                        const size_t bytesFromStart = pos * sizeof(T);
+                        m_vbo->writeArray(bytesFromStart,
+                                          m_snapshot.data() + pos,
+                                          size);
+                    }
                 }
 
                 m_dirtyRange = DirtyRangeTracker(m_snapshot.size());
@@ -225,6 +276,11 @@ namespace TrenchBroom {
             explicit IndexHolder(std::vector<Index>& elements);
             void zeroRange(size_t offsetWithinBlock, size_t count);
             void render(PrimType primType, size_t offset, size_t count) const;
+            /**
+             * Renders the given ranges of indices with a single draw call. The ranges are given as pairs of offset and
+             * count.
+             */
+            void render(PrimType primType, const std::vector<std::pair<size_t, size_t>>& ranges) const;
 
             static std::shared_ptr<IndexHolder> swap(std::vector<Index>& elements);
         };
@@ -239,6 +295,17 @@ namespace TrenchBroom {
             AllocationTracker m_allocationTracker;
         public:
             BrushIndexArray();
+        private:
+            /**
+             * Indicates whether the free ranges are scattered enough to warrant compacting the indices.
+             */
+            bool shouldCompact() const;
+
+            /**
+             * Moves all allocated indices to the start of the array and zeroes the remaining indices.
+             */
+            void compact();
+        public:
 
             /**
              * Returns true if there are any valid indices to render. Ranges zeroed by zeroElementsWithKey() do not count.
@@ -261,6 +328,13 @@ namespace TrenchBroom {
             void zeroElementsWithKey(AllocationTracker::Block* key);
 
             void render(const PrimType primType) const;
+
+            /**
+             * Renders only the indices of the given allocations. The allocations are read when this function is called,
+             * so it must be called after prepare() because compacting the indices may move them. Allocations that are
+             * adjacent in the index array are merged into a single range.
+             */
+            void render(PrimType primType, std::vector<const AllocationTracker::Block*> blocks) const;
             bool prepared() const;
             void prepare(VboManager& vboManager);
 
@@ -25,6 +25,7 @@
 #include "Model/Polyhedron.h"
 
 #include <algorithm>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -68,6 +69,10 @@ namespace TrenchBroom {
             m_cachedFacesSortedByTexture.clear();
             m_cachedFacesSortedByTexture.reserve(brush.faceCount());
 
+            // Maps the number of each vertex, which the brush stores in the vertex payload, to an index relative to
+            // the brush's first vertex being 0. This is used below when building the edge cache.
+            std::vector<size_t> vertexIndices(brush.vertexCount());
+
             for (const Model::BrushFace& face : brush.faces()) {
                 const auto indexOfFirstVertexRelativeToBrush = m_cachedVertices.size();
 
@@ -77,12 +82,9 @@ namespace TrenchBroom {
                     Model::BrushHalfEdge* current = *it;
                     Model::BrushVertex* vertex = current->origin();
 
-                    // Set the vertex payload to the index, relative to the brush's first vertex being 0.
-                    // This is used below when building the edge cache.
-                    // NOTE: we'll overwrite the payload as we visit the same vertex several times while visiting
+                    // NOTE: we'll overwrite the index as we visit the same vertex several times while visiting
                     // different faces, this is fine.
-                    const auto currentIndex = m_cachedVertices.size();
-                    vertex->setPayload(static_cast<GLuint>(currentIndex));
+                    vertexIndices[vertex->payload()] = m_cachedVertices.size();
 
                     const auto& position = vertex->position();
                     m_cachedVertices.emplace_back(vm::vec3f(position), vm::vec3f(face.boundary().normal), face.textureCoords(position));
@@ -114,8 +116,8 @@ namespace TrenchBroom {
                 const auto& face1 = brush.face(*faceIndex1);
                 const auto& face2 = brush.face(*faceIndex2);
                 
-                const auto vertexIndex1RelativeToBrush = currentEdge->firstVertex()->payload();
-                const auto vertexIndex2RelativeToBrush = currentEdge->secondVertex()->payload();
+                const auto vertexIndex1RelativeToBrush = vertexIndices[currentEdge->firstVertex()->payload()];
+                const auto vertexIndex2RelativeToBrush = vertexIndices[currentEdge->secondVertex()->payload()];
 
                 m_cachedEdges.emplace_back(&face1, &face2, vertexIndex1RelativeToBrush, vertexIndex2RelativeToBrush);
             }
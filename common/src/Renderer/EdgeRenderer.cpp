@@ -165,10 +165,11 @@ namespace TrenchBroom {
 
         // IndexedEdgeRenderer::Render
 
-        IndexedEdgeRenderer::Render::Render(const EdgeRenderer::Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray) :
+        IndexedEdgeRenderer::Render::Render(const EdgeRenderer::Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray, std::shared_ptr<const BlockList> visibleBlocks) :
         RenderBase(params),
         m_vertexArray(std::move(vertexArray)),
-        m_indexArray(std::move(indexArray)) {}
+        m_indexArray(std::move(indexArray)),
+        m_visibleBlocks(std::move(visibleBlocks)) {}
 
         void IndexedEdgeRenderer::Render::prepareVerticesAndIndices(VboManager& vboManager) {
             m_vertexArray->prepare(vboManager);
@@ -185,7 +186,11 @@ namespace TrenchBroom {
         void IndexedEdgeRenderer::Render::doRenderVertices(RenderContext&) {
             m_vertexArray->setupVertices();
             m_indexArray->setupIndices();
-            m_indexArray->render(PrimType::Lines);
+            if (m_visibleBlocks != nullptr) {
+                m_indexArray->render(PrimType::Lines, *m_visibleBlocks);
+            } else {
+                m_indexArray->render(PrimType::Lines);
+            }
             m_vertexArray->cleanupVertices();
             m_indexArray->cleanupIndices();
         }
@@ -200,7 +205,8 @@ namespace TrenchBroom {
 
         IndexedEdgeRenderer::IndexedEdgeRenderer(const IndexedEdgeRenderer& other) :
         m_vertexArray(other.m_vertexArray),
-        m_indexArray(other.m_indexArray) {}
+        m_indexArray(other.m_indexArray),
+        m_visibleBlocks(other.m_visibleBlocks) {}
 
         IndexedEdgeRenderer& IndexedEdgeRenderer::operator=(IndexedEdgeRenderer other) {
             using std::swap;
@@ -212,10 +218,15 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArray, right.m_indexArray);
+            swap(left.m_visibleBlocks, right.m_visibleBlocks);
+        }
+
+        void IndexedEdgeRenderer::setVisibleBlocks(std::shared_ptr<const BlockList> visibleBlocks) {
+            m_visibleBlocks = std::move(visibleBlocks);
         }
 
         void IndexedEdgeRenderer::doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) {
-            renderBatch.addOneShot(new Render(params, m_vertexArray, m_indexArray));
+            renderBatch.addOneShot(new Render(params, m_vertexArray, m_indexArray, m_visibleBlocks));
         }
     }
 }
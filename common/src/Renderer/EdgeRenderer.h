@@ -21,11 +21,13 @@
 #define TrenchBroom_EdgeRenderer
 
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/IndexRangeMap.h"
 #include "Renderer/Renderable.h"
 #include "Renderer/VertexArray.h"
 
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -101,13 +103,16 @@ namespace TrenchBroom {
         };
 
         class IndexedEdgeRenderer : public EdgeRenderer {
+        public:
+            using BlockList = std::vector<const AllocationTracker::Block*>;
         private:
             class Render : public RenderBase, public IndexedRenderable {
             private:
                 std::shared_ptr<BrushVertexArray> m_vertexArray;
                 std::shared_ptr<BrushIndexArray> m_indexArray;
+                std::shared_ptr<const BlockList> m_visibleBlocks;
             public:
-                Render(const Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray);
+                Render(const Params& params, std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray, std::shared_ptr<const BlockList> visibleBlocks);
             private:
                 void prepareVerticesAndIndices(VboManager& vboManager) override;
                 void doRender(RenderContext& renderContext) override;
@@ -116,6 +121,7 @@ namespace TrenchBroom {
         private:
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<BrushIndexArray> m_indexArray;
+            std::shared_ptr<const BlockList> m_visibleBlocks;
         public:
             IndexedEdgeRenderer();
             IndexedEdgeRenderer(std::shared_ptr<BrushVertexArray> vertexArray, std::shared_ptr<BrushIndexArray> indexArray);
@@ -124,6 +130,12 @@ namespace TrenchBroom {
             IndexedEdgeRenderer& operator=(IndexedEdgeRenderer other);
 
             friend void swap(IndexedEdgeRenderer& left, IndexedEdgeRenderer& right);
+
+            /**
+             * Restricts rendering to the given index allocations. If the given pointer is null, all indices are
+             * rendered.
+             */
+            void setVisibleBlocks(std::shared_ptr<const BlockList> visibleBlocks);
         private:
             void doRender(RenderBatch& renderBatch, const EdgeRenderer::Params& params) override;
         };
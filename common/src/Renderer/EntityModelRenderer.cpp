@@ -114,6 +114,10 @@ namespace TrenchBroom {
             m_showHiddenEntities = showHiddenEntities;
         }
 
+        void EntityModelRenderer::setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes) {
+            m_visibleNodes = std::move(visibleNodes);
+        }
+
         void EntityModelRenderer::render(RenderBatch& renderBatch) {
             renderBatch.add(this);
         }
@@ -140,6 +144,9 @@ namespace TrenchBroom {
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
                     continue;
                 }
+                if (m_visibleNodes != nullptr && m_visibleNodes->count(entity) == 0u) {
+                    continue;
+                }
 
                 auto* renderer = entry.second;
 
@@ -24,6 +24,8 @@
 #include "Renderer/Renderable.h"
 
 #include <map>
+#include <memory>
+#include <unordered_set>
 
 namespace TrenchBroom {
     class Logger;
@@ -35,6 +37,7 @@ namespace TrenchBroom {
     namespace Model {
         class EditorContext;
         class EntityNode;
+        class Node;
     }
 
     namespace Renderer {
@@ -56,6 +59,8 @@ namespace TrenchBroom {
             Color m_tintColor;
 
             bool m_showHiddenEntities;
+
+            std::shared_ptr<const std::unordered_set<const Model::Node*>> m_visibleNodes;
         public:
             EntityModelRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
             ~EntityModelRenderer() override;
@@ -94,6 +99,12 @@ namespace TrenchBroom {
             bool showHiddenEntities() const;
             void setShowHiddenEntities(bool showHiddenEntities);
 
+            /**
+             * Restricts rendering to the models of the given entities. If the given pointer is null, the models of all
+             * entities are rendered.
+             */
+            void setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes);
+
             void render(RenderBatch& renderBatch);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
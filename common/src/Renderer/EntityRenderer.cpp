@@ -152,6 +152,11 @@ namespace TrenchBroom {
             m_showHiddenEntities = showHiddenEntities;
         }
 
+        void EntityRenderer::setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes) {
+            m_modelRenderer.setVisibleNodes(visibleNodes);
+            m_visibleNodes = std::move(visibleNodes);
+        }
+
         void EntityRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             if (!m_entities.empty()) {
                 renderBounds(renderContext, renderBatch);
@@ -213,7 +218,7 @@ namespace TrenchBroom {
                 renderService.setBackgroundColor(m_overlayBackgroundColor);
 
                 for (const Model::EntityNode* entity : m_entities) {
-                    if (m_showHiddenEntities || m_editorContext.visible(entity)) {
+                    if ((m_showHiddenEntities || m_editorContext.visible(entity)) && !culled(entity)) {
                         if (entity->group() == nullptr || entity->group() == m_editorContext.currentGroup()) {
                             if (m_showOccludedOverlays)
                                 renderService.setShowOccludedObjects();
@@ -243,6 +248,9 @@ namespace TrenchBroom {
                 if (!m_showHiddenEntities && !m_editorContext.visible(entity)) {
                     continue;
                 }
+                if (culled(entity)) {
+                    continue;
+                }
 
                 const auto rotation = vm::mat4x4f(entity->rotation());
                 const auto direction = rotation * vm::vec3f::pos_x();
@@ -272,6 +280,10 @@ namespace TrenchBroom {
             }
         }
 
+        bool EntityRenderer::culled(const Model::EntityNode* entity) const {
+            return m_visibleNodes != nullptr && m_visibleNodes->count(entity) == 0u;
+        }
+
         std::vector<vm::vec3f> EntityRenderer::arrowHead(const float length, const float width) const {
             // clockwise winding
             std::vector<vm::vec3f> result(3);
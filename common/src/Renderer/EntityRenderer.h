@@ -28,6 +28,8 @@
 
 #include <vecmath/forward.h>
 
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -40,6 +42,7 @@ namespace TrenchBroom {
     namespace Model {
         class EditorContext;
         class EntityNode;
+        class Node;
     }
 
     namespace Renderer {
@@ -73,6 +76,8 @@ namespace TrenchBroom {
             bool m_showAngles;
             Color m_angleColor;
             bool m_showHiddenEntities;
+
+            std::shared_ptr<const std::unordered_set<const Model::Node*>> m_visibleNodes;
         public:
             EntityRenderer(Logger& logger, Assets::EntityModelManager& entityModelManager, const Model::EditorContext& editorContext);
 
@@ -99,6 +104,12 @@ namespace TrenchBroom {
             void setAngleColor(const Color& angleColor);
 
             void setShowHiddenEntities(bool showHiddenEntities);
+
+            /**
+             * Restricts rendering of entity models, classnames and angles to the given entities. If the given pointer is
+             * null, all entities are rendered.
+             */
+            void setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes);
         public: // rendering
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
@@ -109,6 +120,8 @@ namespace TrenchBroom {
             void renderModels(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderClassnames(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderAngles(RenderContext& renderContext, RenderBatch& renderBatch);
+
+            bool culled(const Model::EntityNode* entity) const;
             std::vector<vm::vec3f> arrowHead(float length, float width) const;
 
             struct BuildColoredSolidBoundsVertices;
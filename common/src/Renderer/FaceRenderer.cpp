@@ -47,7 +47,8 @@ namespace TrenchBroom {
             void before(const Assets::Texture* texture) override {
                 if (texture != nullptr) {
                     texture->activate();
-                    shader.set("ApplyTexture", applyTexture);
+                    // textures that are still waiting to be uploaded are rendered using their average color
+                    shader.set("ApplyTexture", applyTexture && texture->isPrepared());
                     shader.set("Color", texture->averageColor());
                 } else {
                     shader.set("ApplyTexture", false);
@@ -79,6 +80,7 @@ namespace TrenchBroom {
         IndexedRenderable(other),
         m_vertexArray(other.m_vertexArray),
         m_indexArrayMap(other.m_indexArrayMap),
+        m_visibleBlocks(other.m_visibleBlocks),
         m_faceColor(other.m_faceColor),
         m_grayscale(other.m_grayscale),
         m_tint(other.m_tint),
@@ -95,6 +97,7 @@ namespace TrenchBroom {
             using std::swap;
             swap(left.m_vertexArray, right.m_vertexArray);
             swap(left.m_indexArrayMap, right.m_indexArrayMap);
+            swap(left.m_visibleBlocks, right.m_visibleBlocks);
             swap(left.m_faceColor, right.m_faceColor);
             swap(left.m_grayscale, right.m_grayscale);
             swap(left.m_tint, right.m_tint);
@@ -118,6 +121,10 @@ namespace TrenchBroom {
             m_alpha = alpha;
         }
 
+        void FaceRenderer::setVisibleBlocks(std::shared_ptr<const TextureToBlocksMap> visibleBlocks) {
+            m_visibleBlocks = std::move(visibleBlocks);
+        }
+
         void FaceRenderer::render(RenderBatch& renderBatch) {
             renderBatch.add(this);
         }
@@ -186,6 +193,15 @@ namespace TrenchBroom {
                         continue;
                     }
 
+                    const std::vector<const AllocationTracker::Block*>* visibleBlocks = nullptr;
+                    if (m_visibleBlocks != nullptr) {
+                        const auto it = m_visibleBlocks->find(texture);
+                        if (it == std::end(*m_visibleBlocks)) {
+                            continue;
+                        }
+                        visibleBlocks = &it->second;
+                    }
+
                     const bool enableMasked = texture != nullptr && texture->masked();
                     
                     // set any per-texture uniforms
@@ -194,7 +210,11 @@ namespace TrenchBroom {
 
                     func.before(texture);
                     brushIndexHolderPtr->setupIndices();
-                    brushIndexHolderPtr->render(PrimType::Triangles);
+                    if (visibleBlocks != nullptr) {
+                        brushIndexHolderPtr->render(PrimType::Triangles, *visibleBlocks);
+                    } else {
+                        brushIndexHolderPtr->render(PrimType::Triangles);
+                    }
                     brushIndexHolderPtr->cleanupIndices();
                     func.after(texture);
                 }
@@ -21,6 +21,7 @@
 #define TrenchBroom_FaceRenderer
 
 #include "Color.h"
+#include "Renderer/AllocationTracker.h"
 #include "Renderer/Renderable.h"
 
 #include <vecmath/forward.h>
@@ -28,6 +29,7 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 namespace TrenchBroom {
     namespace Assets {
@@ -40,6 +42,8 @@ namespace TrenchBroom {
         class RenderBatch;
 
         class FaceRenderer : public IndexedRenderable {
+        public:
+            using TextureToBlocksMap = std::unordered_map<const Assets::Texture*, std::vector<const AllocationTracker::Block*>>;
         private:
             struct RenderFunc;
 
@@ -47,6 +51,7 @@ namespace TrenchBroom {
 
             std::shared_ptr<BrushVertexArray> m_vertexArray;
             std::shared_ptr<TextureToBrushIndicesMap> m_indexArrayMap;
+            std::shared_ptr<const TextureToBlocksMap> m_visibleBlocks;
             Color m_faceColor;
             bool m_grayscale;
             bool m_tint;
@@ -65,6 +70,12 @@ namespace TrenchBroom {
             void setTintColor(const Color& color);
             void setAlpha(float alpha);
 
+            /**
+             * Restricts rendering to the given index allocations per texture. Textures that are missing from the given
+             * map are not rendered at all. If the given pointer is null, all indices are rendered.
+             */
+            void setVisibleBlocks(std::shared_ptr<const TextureToBlocksMap> visibleBlocks);
+
             void render(RenderBatch& renderBatch);
             static vm::vec3f gridColorForTexture(const Assets::Texture* texture);
         private:
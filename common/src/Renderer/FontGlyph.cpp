@@ -31,35 +31,37 @@ namespace TrenchBroom {
         m_h(static_cast<float>(h)),
         m_a(static_cast<int>(a)) {}
 
-        void FontGlyph::appendVertices(std::vector<vm::vec2f>& vertices, const int xOffset, const int yOffset, const size_t textureSize, const bool clockwise) const {
+        void FontGlyph::appendVertices(std::vector<vm::vec2f>& vertices, const int xOffset, const int yOffset, const vm::vec2f& textureSize, const bool clockwise) const {
             const auto fxOffset = static_cast<float>(xOffset);
             const auto fyOffset = static_cast<float>(yOffset);
-            const auto ftextureSize = static_cast<float>(textureSize);
+            const auto texCoords = [&](const float x, const float y) {
+                return vm::vec2f(x / textureSize.x(), y / textureSize.y());
+            };
 
             if (clockwise) {
                 vertices.push_back(vm::vec2f(fxOffset, fyOffset));
-                vertices.push_back(vm::vec2f(m_x, m_y + m_h) / ftextureSize);
+                vertices.push_back(texCoords(m_x, m_y + m_h));
 
                 vertices.push_back(vm::vec2f(fxOffset, fyOffset + m_h));
-                vertices.push_back(vm::vec2f(m_x, m_y) / ftextureSize);
+                vertices.push_back(texCoords(m_x, m_y));
 
                 vertices.push_back(vm::vec2f(fxOffset + m_w, fyOffset + m_h));
-                vertices.push_back(vm::vec2f(m_x + m_w, m_y) / ftextureSize);
+                vertices.push_back(texCoords(m_x + m_w, m_y));
 
                 vertices.push_back(vm::vec2f(fxOffset + m_w, fyOffset));
-                vertices.push_back(vm::vec2f(m_x + m_w, m_y + m_h) / ftextureSize);
+                vertices.push_back(texCoords(m_x + m_w, m_y + m_h));
             } else {
                 vertices.push_back(vm::vec2f(fxOffset, fyOffset));
-                vertices.push_back(vm::vec2f(m_x, m_y + m_h) / ftextureSize);
+                vertices.push_back(texCoords(m_x, m_y + m_h));
 
                 vertices.push_back(vm::vec2f(fxOffset + m_w, fyOffset));
-                vertices.push_back(vm::vec2f(m_x + m_w, m_y + m_h) / ftextureSize);
+                vertices.push_back(texCoords(m_x + m_w, m_y + m_h));
 
                 vertices.push_back(vm::vec2f(fxOffset + m_w, fyOffset + m_h));
-                vertices.push_back(vm::vec2f(m_x + m_w, m_y) / ftextureSize);
+                vertices.push_back(texCoords(m_x + m_w, m_y));
 
                 vertices.push_back(vm::vec2f(fxOffset, fyOffset + m_h));
-                vertices.push_back(vm::vec2f(m_x, m_y) / ftextureSize);
+                vertices.push_back(texCoords(m_x, m_y));
             }
         }
 
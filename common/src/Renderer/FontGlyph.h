@@ -36,7 +36,7 @@ namespace TrenchBroom {
         public:
             FontGlyph(size_t x, size_t y, size_t w, size_t h, size_t a);
 
-            void appendVertices(std::vector<vm::vec2f>& vertices, int xOffset, int yOffset, size_t textureSize, bool clockwise) const;
+            void appendVertices(std::vector<vm::vec2f>& vertices, int xOffset, int yOffset, const vm::vec2f& textureSize, bool clockwise) const;
             int advance() const;
         };
     }
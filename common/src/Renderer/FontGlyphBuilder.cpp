@@ -28,20 +28,22 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        FontGlyphBuilder::FontGlyphBuilder(const size_t maxAscend, size_t cellSize, const size_t margin, FontTexture& texture) :
+        FontGlyphBuilder::FontGlyphBuilder(const size_t maxAscend, size_t cellSize, const size_t margin, FontTexture& texture, const size_t top) :
         m_maxAscend(maxAscend),
         m_cellSize(cellSize),
         m_margin(margin),
-        m_textureSize(texture.m_size),
-        m_textureBuffer(texture.m_buffer),
+        m_textureWidth(texture.m_width),
+        m_textureHeight(texture.m_height),
+        m_textureBuffer(texture.m_buffer.data()),
         m_x(m_margin),
-        m_y(m_margin) {
+        m_y(top + m_margin) {
             ensure(m_textureBuffer != nullptr, "textureBuffer is null");
+            texture.m_dirty = true;
         }
 
         FontGlyph FontGlyphBuilder::createGlyph(const size_t left, const size_t top, const size_t width, const size_t height, const size_t advance, const char* glyphBuffer, const size_t pitch) {
 
-            if (m_x + m_cellSize + m_margin > m_textureSize) {
+            if (m_x + m_cellSize + m_margin > m_textureWidth) {
                 m_x = m_margin;
                 m_y += m_cellSize + m_margin;
             }
@@ -57,8 +59,8 @@ namespace TrenchBroom {
             const size_t y = m_y + m_maxAscend - top;
 
             for (size_t r = 0; r < height; ++r) {
-                const size_t index = (r + y) * m_textureSize + x;
-                assert(index + width < m_textureSize * m_textureSize);
+                const size_t index = (r + y) * m_textureWidth + x;
+                assert(index + width < m_textureWidth * m_textureHeight);
                 std::memcpy(m_textureBuffer + index, glyphBuffer + r * pitch, width);
             }
         }
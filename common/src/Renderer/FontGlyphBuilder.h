@@ -32,13 +32,18 @@ namespace TrenchBroom {
             size_t m_maxAscend;
             size_t m_cellSize;
             size_t m_margin;
-            size_t m_textureSize;
+            size_t m_textureWidth;
+            size_t m_textureHeight;
             char* m_textureBuffer;
 
             size_t m_x;
             size_t m_y;
         public:
-            FontGlyphBuilder(size_t maxAscend, size_t cellSize, size_t margin, FontTexture& texture);
+            /**
+             * Creates a builder that draws glyphs into the band of the given texture that starts at the given top, see
+             * FontTexture::allocate.
+             */
+            FontGlyphBuilder(size_t maxAscend, size_t cellSize, size_t margin, FontTexture& texture, size_t top);
 
             FontGlyph createGlyph(size_t left, size_t top, size_t width, size_t height, size_t advance, const char* glyphBuffer, size_t pitch);
         private:
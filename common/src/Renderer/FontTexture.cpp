@@ -20,85 +20,111 @@
 #include "FontTexture.h"
 
 #include "Ensure.h"
-#include "Macros.h"
 
+#include <algorithm>
 #include <cassert>
-#include <cstring>
-#include <memory>
+#include <utility>
 
 namespace TrenchBroom {
     namespace Renderer {
         FontTexture::FontTexture() :
-        m_size(0),
-        m_buffer(nullptr),
-        m_textureId(0) {}
-
-        FontTexture::FontTexture(const size_t cellCount, const size_t cellSize, const size_t margin) :
-        m_size(computeTextureSize(cellCount, cellSize, margin)),
-        m_buffer(nullptr),
-        m_textureId(0) {
-            m_buffer = new char[m_size * m_size];
-            std::memset(m_buffer, 0, m_size * m_size);
-        }
+        FontTexture(0u) {}
+
+        FontTexture::FontTexture(const size_t width) :
+        m_width(width),
+        m_height(0u),
+        m_usedHeight(0u),
+        m_textureId(0),
+        m_dirty(false),
+        m_generation(0u) {}
 
         FontTexture::FontTexture(const FontTexture& other) :
-        m_size(other.m_size),
-        m_buffer(nullptr),
-        m_textureId(0) {
-            m_buffer = new char[m_size * m_size];
-            std::memcpy(m_buffer, other.m_buffer, m_size * m_size);
-        }
+        m_width(other.m_width),
+        m_height(other.m_height),
+        m_usedHeight(other.m_usedHeight),
+        m_buffer(other.m_buffer),
+        m_textureId(0),
+        m_dirty(!m_buffer.empty()),
+        m_generation(other.m_generation) {}
 
         FontTexture& FontTexture::operator=(FontTexture other) {
             using std::swap;
-            swap(m_size, other.m_size);
+            swap(m_width, other.m_width);
+            swap(m_height, other.m_height);
+            swap(m_usedHeight, other.m_usedHeight);
             swap(m_buffer, other.m_buffer);
             swap(m_textureId, other.m_textureId);
+            swap(m_dirty, other.m_dirty);
+            swap(m_generation, other.m_generation);
             return *this;
         }
 
         FontTexture::~FontTexture() {
-            m_size = 0;
             if (m_textureId != 0) {
                 glAssert(glDeleteTextures(1, &m_textureId));
                 m_textureId = 0;
             }
-            delete [] m_buffer;
-            m_buffer = nullptr;
         }
 
-        size_t FontTexture::size() const {
-            return m_size;
+        size_t FontTexture::width() const {
+            return m_width;
+        }
+
+        size_t FontTexture::height() const {
+            return m_height;
+        }
+
+        size_t FontTexture::generation() const {
+            return m_generation;
+        }
+
+        size_t FontTexture::allocate(const size_t cellCount, const size_t cellSize, const size_t margin) {
+            ensure(cellSize + 2u * margin <= m_width, "cell does not fit into texture");
+
+            const size_t cellsPerRow = (m_width - margin) / (cellSize + margin);
+            const size_t rowCount = (cellCount + cellsPerRow - 1u) / cellsPerRow;
+            const size_t top = m_usedHeight;
+            m_usedHeight += margin + rowCount * (cellSize + margin);
+
+            if (m_usedHeight > m_height) {
+                size_t height = std::max(m_height, size_t(1));
+                while (height < m_usedHeight) {
+                    height = height << 1;
+                }
+
+                // the rows are stored contiguously, so growing appends rows at the bottom
+                m_height = height;
+                m_buffer.resize(m_width * m_height, 0);
+                ++m_generation;
+            }
+
+            return top;
         }
 
         void FontTexture::activate() {
             if (m_textureId == 0) {
-                ensure(m_buffer != nullptr, "buffer is null");
+                ensure(!m_buffer.empty(), "buffer is empty");
                 glAssert(glGenTextures(1, &m_textureId));
                 glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
                 glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
                 glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
                 glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
                 glAssert(glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
-                glAssert(glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, static_cast<GLsizei>(m_size), static_cast<GLsizei>(m_size), 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, m_buffer));
-                delete [] m_buffer;
-                m_buffer = nullptr;
+                m_dirty = true;
             }
 
             assert(m_textureId > 0);
             glAssert(glBindTexture(GL_TEXTURE_2D, m_textureId));
+
+            // the buffer is kept so that the glyphs of fonts added later can be uploaded along with the existing ones
+            if (m_dirty) {
+                glAssert(glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE, static_cast<GLsizei>(m_width), static_cast<GLsizei>(m_height), 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, m_buffer.data()));
+                m_dirty = false;
+            }
         }
 
         void FontTexture::deactivate() {
             glAssert(glBindTexture(GL_TEXTURE_2D, 0));
         }
-
-        size_t FontTexture::computeTextureSize(const size_t cellCount, const size_t cellSize, const size_t margin) const {
-            const size_t minTextureSize = margin + cellCount * (cellSize + margin);
-            size_t textureSize = 1;
-            while (textureSize < minTextureSize)
-                textureSize = textureSize << 1;
-            return textureSize;
-        }
     }
 }
@@ -22,30 +22,56 @@
 
 #include "Renderer/GL.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         class FontGlyphBuilder;
 
+        /**
+         * A texture atlas that holds the glyphs of one or more fonts. Fonts of the same typeface share an atlas
+         * regardless of their size, each font occupying a band of rows. The atlas has a fixed width and grows in height
+         * when a band does not fit. Growing changes the texture coordinates of the glyphs, so callers that cache
+         * texture coordinates must check the generation of the atlas.
+         */
         class FontTexture {
         private:
-            size_t m_size;
-            char* m_buffer;
+            size_t m_width;
+            size_t m_height;
+            size_t m_usedHeight;
+            std::vector<char> m_buffer;
             GLuint m_textureId;
+            bool m_dirty;
+            size_t m_generation;
 
             friend class FontGlyphBuilder;
         public:
             FontTexture();
-            FontTexture(size_t cellCount, size_t cellSize, size_t margin);
+            explicit FontTexture(size_t width);
             FontTexture(const FontTexture& other);
             FontTexture& operator=(FontTexture other);
             ~FontTexture();
 
-            size_t size() const;
+            size_t width() const;
+            size_t height() const;
+
+            /**
+             * Returns a number that changes whenever the height of this atlas changes.
+             */
+            size_t generation() const;
+
+            /**
+             * Reserves a band of rows that fits the given number of glyph cells, growing this atlas if necessary.
+             *
+             * @param cellCount the number of cells
+             * @param cellSize the width and height of each cell
+             * @param margin the margin around each cell
+             * @return the top of the band
+             */
+            size_t allocate(size_t cellCount, size_t cellSize, size_t margin);
 
             void activate();
             void deactivate();
-        private:
-            size_t computeTextureSize(size_t cellCount, size_t cellSize, size_t margin) const;
         };
     }
 }
@@ -50,7 +50,7 @@ namespace TrenchBroom {
 
         std::unique_ptr<TextureFont> FreeTypeFontFactory::doCreateFont(const FontDescriptor& fontDescriptor) {
             FT_Face face = loadFont(fontDescriptor);
-            auto font = buildFont(face, fontDescriptor.minChar(), fontDescriptor.charCount());
+            auto font = buildFont(face, fontDescriptor);
             FT_Done_Face(face);
 
             return font;
@@ -71,11 +71,40 @@ namespace TrenchBroom {
             return face;
         }
 
-        std::unique_ptr<TextureFont> FreeTypeFontFactory::buildFont(FT_Face face, const unsigned char firstChar, const unsigned char charCount) {
+        std::shared_ptr<FontTexture> FreeTypeFontFactory::findTexture(const FontDescriptor& fontDescriptor, const size_t cellSize, const size_t margin) {
+            static const size_t TextureWidth = 512u;
+
+            const size_t minWidth = cellSize + 2u * margin;
+            if (minWidth > TextureWidth) {
+                // fonts that are too large for the shared atlas get their own texture
+                size_t width = TextureWidth;
+                while (width < minWidth) {
+                    width = width << 1;
+                }
+                return std::make_shared<FontTexture>(width);
+            }
+
+            const FontDescriptor key(fontDescriptor.path(), 0u, fontDescriptor.minChar(), fontDescriptor.maxChar());
+            auto& texture = m_textures[key];
+            if (auto result = texture.lock()) {
+                return result;
+            }
+
+            auto result = std::make_shared<FontTexture>(TextureWidth);
+            texture = result;
+            return result;
+        }
+
+        std::unique_ptr<TextureFont> FreeTypeFontFactory::buildFont(FT_Face face, const FontDescriptor& fontDescriptor) {
+            static const size_t Margin = 3u;
+
+            const unsigned char firstChar = fontDescriptor.minChar();
+            const unsigned char charCount = fontDescriptor.charCount();
             const Metrics metrics = computeMetrics(face, firstChar, charCount);
 
-            std::unique_ptr<FontTexture> texture = std::make_unique<FontTexture>(charCount, metrics.cellSize, metrics.lineHeight);
-            FontGlyphBuilder glyphBuilder(metrics.maxAscend, metrics.cellSize, 3, *texture);
+            std::shared_ptr<FontTexture> texture = findTexture(fontDescriptor, metrics.cellSize, Margin);
+            const size_t top = texture->allocate(charCount, metrics.cellSize, Margin);
+            FontGlyphBuilder glyphBuilder(metrics.maxAscend, metrics.cellSize, Margin, *texture, top);
 
             FT_GlyphSlot glyph = face->glyph;
             std::vector<FontGlyph> glyphs;
@@ -23,18 +23,25 @@
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+#include "Renderer/FontDescriptor.h"
 #include "Renderer/FontFactory.h"
 
+#include <map>
 #include <memory>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class FontDescriptor;
+        class FontTexture;
         class TextureFont;
 
         class FreeTypeFontFactory : public FontFactory {
         private:
             FT_Library m_library;
+            /**
+             * The glyph atlases shared by the fonts of each typeface, keyed by a descriptor of size 0. The atlases are
+             * owned by the fonts.
+             */
+            std::map<FontDescriptor, std::weak_ptr<FontTexture>> m_textures;
         public:
             FreeTypeFontFactory();
             ~FreeTypeFontFactory() override;
@@ -42,7 +49,8 @@ namespace TrenchBroom {
             std::unique_ptr<TextureFont> doCreateFont(const FontDescriptor& fontDescriptor) override;
 
             FT_Face loadFont(const FontDescriptor& fontDescriptor);
-            std::unique_ptr<TextureFont> buildFont(FT_Face face, unsigned char firstChar, unsigned char charCount);
+            std::shared_ptr<FontTexture> findTexture(const FontDescriptor& fontDescriptor, size_t cellSize, size_t margin);
+            std::unique_ptr<TextureFont> buildFont(FT_Face face, const FontDescriptor& fontDescriptor);
 
             Metrics computeMetrics(FT_Face face, unsigned char firstChar, unsigned char charCount) const;
         };
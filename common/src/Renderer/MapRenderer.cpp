@@ -33,6 +33,7 @@
 #include "Model/NodeVisitor.h"
 #include "Model/WorldNode.h"
 #include "Renderer/BrushRenderer.h"
+#include "Renderer/Camera.h"
 #include "Renderer/EntityLinkRenderer.h"
 #include "Renderer/ObjectRenderer.h"
 #include "Renderer/RenderBatch.h"
@@ -44,7 +45,11 @@
 #include <kdl/memory_utils.h>
 #include <kdl/vector_set.h>
 
+#include <vecmath/plane.h>
+
+#include <algorithm>
 #include <set>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -165,6 +170,7 @@ namespace TrenchBroom {
         }
 
         void MapRenderer::clear() {
+            m_cullingResults.clear();
             m_defaultRenderer->clear();
             m_selectionRenderer->clear();
             m_lockedRenderer->clear();
@@ -188,6 +194,7 @@ namespace TrenchBroom {
 
         void MapRenderer::render(RenderContext& renderContext, RenderBatch& renderBatch) {
             commitPendingChanges();
+            cullObjects(renderContext);
             setupGL(renderBatch);
             renderDefaultOpaque(renderContext, renderBatch);
             renderLockedOpaque(renderContext, renderBatch);
@@ -205,6 +212,52 @@ namespace TrenchBroom {
             document->commitPendingAssets();
         }
 
+        void MapRenderer::cullObjects(const RenderContext& renderContext) {
+            auto document = kdl::mem_lock(m_document);
+            const Model::WorldNode* world = document->world();
+
+            std::shared_ptr<const VisibleNodes> visibleNodes;
+            if (world != nullptr) {
+                vm::plane3f topPlane, rightPlane, bottomPlane, leftPlane;
+                renderContext.camera().frustumPlanes(topPlane, rightPlane, bottomPlane, leftPlane);
+                visibleNodes = findVisibleNodes(*world, { topPlane, rightPlane, bottomPlane, leftPlane });
+            }
+
+            m_defaultRenderer->setVisibleNodes(visibleNodes);
+            m_selectionRenderer->setVisibleNodes(visibleNodes);
+            m_lockedRenderer->setVisibleNodes(visibleNodes);
+        }
+
+        std::shared_ptr<const MapRenderer::VisibleNodes> MapRenderer::findVisibleNodes(const Model::WorldNode& world, std::vector<vm::plane3f> frustumPlanes) {
+            const auto modificationCount = world.nodeTreeModificationCount();
+            const auto it = std::find_if(std::begin(m_cullingResults), std::end(m_cullingResults), [&](const CullingResult& result) {
+                return result.world == &world && result.frustumPlanes == frustumPlanes;
+            });
+
+            if (it != std::end(m_cullingResults)) {
+                auto result = std::move(*it);
+                m_cullingResults.erase(it);
+
+                if (result.nodeTreeModificationCount == modificationCount) {
+                    m_cullingResults.push_back(std::move(result));
+                    return m_cullingResults.back().visibleNodes;
+                }
+            } else if (m_cullingResults.size() == MaxCullingResults) {
+                m_cullingResults.erase(std::begin(m_cullingResults));
+            }
+
+            auto planes = std::vector<vm::plane3>();
+            planes.reserve(frustumPlanes.size());
+            for (const auto& plane : frustumPlanes) {
+                planes.emplace_back(plane);
+            }
+
+            const auto nodes = world.findNodesIntersecting(planes);
+            auto visibleNodes = std::make_shared<const VisibleNodes>(std::begin(nodes), std::end(nodes));
+            m_cullingResults.push_back(CullingResult{ &world, modificationCount, std::move(frustumPlanes), visibleNodes });
+            return visibleNodes;
+        }
+
         class SetupGL : public Renderable {
         private:
             void doRender(RenderContext&) override {
@@ -22,8 +22,11 @@
 
 #include "Macros.h"
 
+#include <vecmath/forward.h>
+
 #include <map>
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -45,6 +48,7 @@ namespace TrenchBroom {
         class GroupNode;
         class LayerNode;
         class Node;
+        class WorldNode;
     }
 
     namespace Renderer {
@@ -67,6 +71,26 @@ namespace TrenchBroom {
             std::unique_ptr<ObjectRenderer> m_selectionRenderer;
             std::unique_ptr<ObjectRenderer> m_lockedRenderer;
             std::unique_ptr<EntityLinkRenderer> m_entityLinkRenderer;
+
+            using VisibleNodes = std::unordered_set<const Model::Node*>;
+
+            /**
+             * The result of culling the objects against a camera's view frustum. It remains valid as long as neither the
+             * frustum planes nor the world's node tree have changed.
+             */
+            struct CullingResult {
+                const Model::WorldNode* world;
+                size_t nodeTreeModificationCount;
+                std::vector<vm::plane3f> frustumPlanes;
+                std::shared_ptr<const VisibleNodes> visibleNodes;
+            };
+
+            /**
+             * Since all map views share one map renderer, we keep the culling results of the most recently rendered
+             * views, ordered from least to most recently used.
+             */
+            static const size_t MaxCullingResults = 4u;
+            std::vector<CullingResult> m_cullingResults;
         public:
             explicit MapRenderer(std::weak_ptr<View::MapDocument> document);
             ~MapRenderer();
@@ -84,6 +108,14 @@ namespace TrenchBroom {
             void render(RenderContext& renderContext, RenderBatch& renderBatch);
         private:
             void commitPendingChanges();
+
+            /**
+             * Finds the brushes and entities that intersect the camera's view frustum and restricts the object renderers
+             * to them. If the frustum and the node tree are unchanged since a view was last rendered, the previously
+             * found set of nodes is reused.
+             */
+            void cullObjects(const RenderContext& renderContext);
+            std::shared_ptr<const VisibleNodes> findVisibleNodes(const Model::WorldNode& world, std::vector<vm::plane3f> frustumPlanes);
             void setupGL(RenderBatch& renderBatch);
             void renderDefaultOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderDefaultTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
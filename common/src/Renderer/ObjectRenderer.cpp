@@ -136,6 +136,11 @@ namespace TrenchBroom {
             m_brushRenderer.setShowHiddenBrushes(showHiddenObjects);
         }
 
+        void ObjectRenderer::setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes) {
+            m_entityRenderer.setVisibleNodes(visibleNodes);
+            m_brushRenderer.setVisibleNodes(std::move(visibleNodes));
+        }
+
         void ObjectRenderer::renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch) {
             m_brushRenderer.renderOpaque(renderContext, renderBatch);
             m_entityRenderer.render(renderContext, renderBatch);
@@ -24,6 +24,8 @@
 #include "Renderer/EntityRenderer.h"
 #include "Renderer/GroupRenderer.h"
 
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace TrenchBroom {
@@ -39,6 +41,7 @@ namespace TrenchBroom {
         class EditorContext;
         class EntityNode;
         class GroupNode;
+        class Node;
     }
 
     namespace Renderer {
@@ -90,6 +93,12 @@ namespace TrenchBroom {
             void setBrushEdgeColor(const Color& brushEdgeColor);
 
             void setShowHiddenObjects(bool showHiddenObjects);
+
+            /**
+             * Restricts rendering of brushes and entities to the given nodes. If the given pointer is null, all objects
+             * are rendered.
+             */
+            void setVisibleNodes(std::shared_ptr<const std::unordered_set<const Model::Node*>> visibleNodes);
         public: // rendering
             void renderOpaque(RenderContext& renderContext, RenderBatch& renderBatch);
             void renderTransparent(RenderContext& renderContext, RenderBatch& renderBatch);
@@ -35,6 +35,8 @@
 #include <vecmath/vec.h>
 #include <vecmath/mat_ext.h>
 
+#include <map>
+
 namespace TrenchBroom {
     namespace Renderer {
         const float TextRenderer::DefaultMaxViewDistance = 768.0f;
@@ -43,14 +45,11 @@ namespace TrenchBroom {
         const size_t TextRenderer::RectCornerSegments = 3;
         const float TextRenderer::RectCornerRadius = 3.0f;
 
-        TextRenderer::Entry::Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
-        size(i_size),
+        TextRenderer::Entry::Entry(std::shared_ptr<const TextureFont::StringQuads> i_quads, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor) :
+        quads(std::move(i_quads)),
         offset(i_offset),
         textColor(i_textColor),
-        backgroundColor(i_backgroundColor) {
-            using std::swap;
-            swap(vertices, i_vertices);
-        }
+        backgroundColor(i_backgroundColor) {}
 
         TextRenderer::EntryCollection::EntryCollection() :
         textVertexCount(0),
@@ -77,39 +76,46 @@ namespace TrenchBroom {
             if (distance <= 0.0f)
                 return;
 
-            if (!isVisible(renderContext, string, position, distance, onTop))
+            if (!isInRange(renderContext, distance, onTop))
                 return;
 
             FontManager& fontManager = renderContext.fontManager();
             TextureFont& font = fontManager.font(m_fontDescriptor);
 
-            std::vector<vm::vec2f> vertices = font.quads(string, true);
+            // the quads of strings that are rendered in every frame are cached by the font
+            auto quads = font.cachedQuads(string, true);
+            const vm::vec2f& size = quads->size;
+            if (!isVisible(renderContext, size, position))
+                return;
+
             const float alphaFactor = computeAlphaFactor(renderContext, distance, onTop);
-            const vm::vec2f size = font.measure(string);
             const vm::vec3f offset = position.offset(camera, size);
 
             if (onTop)
-                addEntry(m_entriesOnTop, Entry(vertices, size, offset,
+                addEntry(m_entriesOnTop, Entry(std::move(quads), offset,
                                                Color(textColor, alphaFactor * textColor.a()),
                                                Color(backgroundColor, alphaFactor * backgroundColor.a())));
             else
-                addEntry(m_entries, Entry(vertices, size, offset,
+                addEntry(m_entries, Entry(std::move(quads), offset,
                                           Color(textColor, alphaFactor * textColor.a()),
                                           Color(backgroundColor, alphaFactor * backgroundColor.a())));
         }
 
-        bool TextRenderer::isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, const float distance, const bool onTop) const {
+        bool TextRenderer::isInRange(RenderContext& renderContext, const float distance, const bool onTop) const {
             if (!onTop) {
                 if (renderContext.render3D() && distance > m_maxViewDistance)
                     return false;
                 if (renderContext.render2D() && renderContext.camera().zoom() < m_minZoomFactor)
                     return false;
             }
+            return true;
+        }
 
+        bool TextRenderer::isVisible(RenderContext& renderContext, const vm::vec2f& stringSize, const TextAnchor& position) const {
             const Camera& camera = renderContext.camera();
             const Camera::Viewport& viewport = camera.viewport();
 
-            const vm::vec2f size = stringSize(renderContext, string);
+            const vm::vec2f size = round(stringSize);
             const vm::vec2f offset = vm::vec2f(position.offset(camera, size)) - m_inset;
             const vm::vec2f actualSize = size + 2.0f * m_inset;
 
@@ -134,16 +140,10 @@ namespace TrenchBroom {
             }
         }
 
-        void TextRenderer::addEntry(EntryCollection& collection, const Entry& entry) {
-            collection.entries.push_back(entry);
-            collection.textVertexCount += entry.vertices.size();
+        void TextRenderer::addEntry(EntryCollection& collection, Entry&& entry) {
+            collection.textVertexCount += entry.quads->vertices.size() / 2u;
             collection.rectVertexCount += roundedRect2DVertexCount(RectCornerSegments);
-        }
-
-        vm::vec2f TextRenderer::stringSize(RenderContext& renderContext, const AttrString& string) const {
-            FontManager& fontManager = renderContext.fontManager();
-            TextureFont& font = fontManager.font(m_fontDescriptor);
-            return round(font.measure(string));
+            collection.entries.push_back(std::move(entry));
         }
 
         void TextRenderer::doPrepareVertices(VboManager& vboManager) {
@@ -170,8 +170,8 @@ namespace TrenchBroom {
         }
 
         void TextRenderer::addEntry(const Entry& entry, const bool /* onTop */, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices) {
-            const std::vector<vm::vec2f>& stringVertices = entry.vertices;
-            const vm::vec2f& stringSize = entry.size;
+            const std::vector<vm::vec2f>& stringVertices = entry.quads->vertices;
+            const vm::vec2f& stringSize = entry.quads->size;
 
             const vm::vec3f& offset = entry.offset;
 
@@ -184,13 +184,30 @@ namespace TrenchBroom {
                 textVertices.emplace_back(vm::vec3f(position2 + offset.xy(), -offset.z()), texCoords, textColor);
             }
 
-            const std::vector<vm::vec2f> rect = roundedRect2D(stringSize + 2.0f * m_inset, RectCornerRadius, RectCornerSegments);
+            const std::vector<vm::vec2f>& rect = backgroundRect(stringSize + 2.0f * m_inset);
             for (size_t i = 0; i < rect.size(); ++i) {
                 const vm::vec2f& vertex = rect[i];
                 rectVertices.emplace_back(vm::vec3f(vertex + offset.xy() + stringSize / 2.0f, -offset.z()), rectColor);
             }
         }
 
+        /**
+         * Returns the background of a string of the given size. Most strings share a few sizes, so the backgrounds are
+         * cached across frames.
+         */
+        const std::vector<vm::vec2f>& TextRenderer::backgroundRect(const vm::vec2f& size) {
+            static std::map<vm::vec2f, std::vector<vm::vec2f>> cache;
+            if (cache.size() >= 1024u) {
+                cache.clear();
+            }
+
+            auto it = cache.lower_bound(size);
+            if (it == std::end(cache) || size < it->first) {
+                it = cache.emplace_hint(it, size, roundedRect2D(size, RectCornerRadius, RectCornerSegments));
+            }
+            return it->second;
+        }
+
         void TextRenderer::doRender(RenderContext& renderContext) {
             const Camera::Viewport& viewport = renderContext.camera().viewport();
             const vm::mat4x4f projection = vm::ortho_matrix(
@@ -23,12 +23,14 @@
 #include "Color.h"
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/Renderable.h"
+#include "Renderer/TextureFont.h"
 #include "Renderer/VertexArray.h"
 #include "Renderer/GLVertexType.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <memory>
 #include <vector>
 
 namespace TrenchBroom {
@@ -46,13 +48,12 @@ namespace TrenchBroom {
             static const float RectCornerRadius;
 
             struct Entry {
-                std::vector<vm::vec2f> vertices;
-                vm::vec2f size;
+                std::shared_ptr<const TextureFont::StringQuads> quads;
                 vm::vec3f offset;
                 Color textColor;
                 Color backgroundColor;
 
-                Entry(std::vector<vm::vec2f>& i_vertices, const vm::vec2f& i_size, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
+                Entry(std::shared_ptr<const TextureFont::StringQuads> i_quads, const vm::vec3f& i_offset, const Color& i_textColor, const Color& i_backgroundColor);
             };
 
             using EntryList = std::vector<Entry>;
@@ -86,16 +87,16 @@ namespace TrenchBroom {
         private:
             void renderString(RenderContext& renderContext, const Color& textColor, const Color& backgroundColor, const AttrString& string, const TextAnchor& position, bool onTop);
 
-            bool isVisible(RenderContext& renderContext, const AttrString& string, const TextAnchor& position, float distance, bool onTop) const;
+            bool isInRange(RenderContext& renderContext, float distance, bool onTop) const;
+            bool isVisible(RenderContext& renderContext, const vm::vec2f& size, const TextAnchor& position) const;
             float computeAlphaFactor(const RenderContext& renderContext, float distance, bool onTop) const;
-            void addEntry(EntryCollection& collection, const Entry& entry);
-
-            vm::vec2f stringSize(RenderContext& renderContext, const AttrString& string) const;
+            void addEntry(EntryCollection& collection, Entry&& entry);
         private:
             void doPrepareVertices(VboManager& vboManager) override;
             void prepare(EntryCollection& collection, bool onTop, VboManager& vboManager);
 
             void addEntry(const Entry& entry, bool onTop, std::vector<TextVertex>& textVertices, std::vector<RectVertex>& rectVertices);
+            static const std::vector<vm::vec2f>& backgroundRect(const vm::vec2f& size);
 
             void doRender(RenderContext& renderContext) override;
             void render(EntryCollection& collection, RenderContext& renderContext);
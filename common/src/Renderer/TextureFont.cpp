@@ -32,12 +32,15 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        TextureFont::TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
+        const size_t TextureFont::MaxCachedStrings = 8192u;
+
+        TextureFont::TextureFont(std::shared_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, const int lineHeight, const unsigned char firstChar, const unsigned char charCount) :
         m_texture(std::move(texture)),
         m_glyphs(glyphs),
         m_lineHeight(lineHeight),
         m_firstChar(firstChar),
-        m_charCount(charCount) {}
+        m_charCount(charCount),
+        m_cachedQuadsGeneration(m_texture->generation()) {}
 
         TextureFont::~TextureFont() = default;
 
@@ -172,10 +175,29 @@ namespace TrenchBroom {
             return measureString.size();
         }
 
+        std::shared_ptr<const TextureFont::StringQuads> TextureFont::cachedQuads(const AttrString& string, const bool clockwise) {
+            if (m_cachedQuadsGeneration != m_texture->generation() || m_cachedQuads.size() >= MaxCachedStrings) {
+                // entries that are still in use are kept alive by their users
+                m_cachedQuads.clear();
+                m_cachedQuadsGeneration = m_texture->generation();
+            }
+
+            auto key = std::make_pair(string, clockwise);
+            auto it = m_cachedQuads.lower_bound(key);
+            if (it == std::end(m_cachedQuads) || m_cachedQuads.key_comp()(key, it->first)) {
+                auto quads = std::make_shared<StringQuads>();
+                quads->vertices = this->quads(string, clockwise);
+                quads->size = measure(string);
+                it = m_cachedQuads.emplace_hint(it, std::move(key), std::move(quads));
+            }
+            return it->second;
+        }
+
         std::vector<vm::vec2f> TextureFont::quads(const std::string& string, const bool clockwise, const vm::vec2f& offset) const {
             std::vector<vm::vec2f> result;
             result.reserve(string.length() * 4 * 2);
 
+            const auto textureSize = vm::vec2f(static_cast<float>(m_texture->width()), static_cast<float>(m_texture->height()));
             auto x = static_cast<int>(vm::round(offset.x()));
             auto y = static_cast<int>(vm::round(offset.y()));
             for (size_t i = 0; i < string.length(); i++) {
@@ -192,7 +214,7 @@ namespace TrenchBroom {
 
                 const auto& glyph = m_glyphs[static_cast<size_t>(c - m_firstChar)];
                 if (c != ' ') {
-                    glyph.appendVertices(result, x, y, m_texture->size(), clockwise);
+                    glyph.appendVertices(result, x, y, textureSize, clockwise);
                 }
 
                 x += glyph.advance();
@@ -21,30 +21,45 @@
 #define TrenchBroom_Font
 
 #include "Macros.h"
+#include "Renderer/AttrString.h"
 
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <map>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TrenchBroom {
     namespace Renderer {
-        class AttrString;
         class FontGlyph;
         class FontTexture;
 
         class TextureFont {
+        public:
+            /**
+             * The quads of a string at offset zero together with its size, see quads and measure.
+             */
+            struct StringQuads {
+                std::vector<vm::vec2f> vertices;
+                vm::vec2f size;
+            };
         private:
-            std::unique_ptr<FontTexture> m_texture;
+            static const size_t MaxCachedStrings;
+
+            std::shared_ptr<FontTexture> m_texture;
             std::vector<FontGlyph> m_glyphs;
             int m_lineHeight;
 
             unsigned char m_firstChar;
             unsigned char m_charCount;
+
+            std::map<std::pair<AttrString, bool>, std::shared_ptr<const StringQuads>> m_cachedQuads;
+            size_t m_cachedQuadsGeneration;
         public:
-            TextureFont(std::unique_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
+            TextureFont(std::shared_ptr<FontTexture> texture, const std::vector<FontGlyph>& glyphs, int lineHeight, unsigned char firstChar, unsigned char charCount);
             ~TextureFont();
 
             deleteCopyAndMove(TextureFont)
@@ -52,6 +67,17 @@ namespace TrenchBroom {
             std::vector<vm::vec2f> quads(const AttrString& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const AttrString& string) const;
 
+            /**
+             * Returns the quads and the size of the given string. The result is cached, so strings that are rendered
+             * in every frame, such as entity labels, are only laid out once. The cache is discarded when it grows too
+             * large or when the texture coordinates of the glyphs change.
+             *
+             * @param string the string
+             * @param clockwise whether the vertices of each quad are in clockwise order
+             * @return the quads and the size of the string
+             */
+            std::shared_ptr<const StringQuads> cachedQuads(const AttrString& string, bool clockwise);
+
             std::vector<vm::vec2f> quads(const std::string& string, bool clockwise, const vm::vec2f& offset = vm::vec2f::zero()) const;
             vm::vec2f measure(const std::string& string) const;
 
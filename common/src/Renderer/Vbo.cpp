@@ -25,9 +25,11 @@
 
 namespace TrenchBroom {
     namespace Renderer {
-        Vbo::Vbo(GLenum type, const size_t capacity, const GLenum usage) :
+        Vbo::Vbo(VboManager* vboManager, GLenum type, const size_t capacity, const GLenum usage) :
         m_type(type),
-        m_capacity(capacity) {
+        m_usage(usage),
+        m_capacity(capacity),
+        m_vboManager(vboManager) {
             assert(m_type == GL_ELEMENT_ARRAY_BUFFER
                    || m_type == GL_ARRAY_BUFFER);
 
@@ -63,5 +65,24 @@ namespace TrenchBroom {
             assert(m_bufferId != 0);
             glAssert(glBindBuffer(m_type, 0));
         }
+
+        size_t Vbo::orphanAndWrite(const GLvoid* data, const size_t size) {
+            assert(m_bufferId != 0);
+
+            const auto sizei = static_cast<GLsizeiptr>(size);
+            glAssert(glBindBuffer(m_type, m_bufferId));
+            if (size == m_capacity) {
+                // the classic orphaning idiom, which drivers recognize even if they would otherwise reuse the storage
+                glAssert(glBufferData(m_type, sizei, nullptr, m_usage));
+                glAssert(glBufferSubData(m_type, 0, sizei, data));
+            } else {
+                glAssert(glBufferData(m_type, sizei, data, m_usage));
+                m_vboManager->updateVboSize(m_capacity, size);
+                m_capacity = size;
+            }
+
+            m_vboManager->countUploadedBytes(size);
+            return size;
+        }
     }
 }
@@ -39,14 +39,16 @@ namespace TrenchBroom {
              * e.g. GL_ARRAY_BUFFER or GL_ELEMENT_ARRAY_BUFFER
              */
             GLenum m_type;
+            GLenum m_usage;
             size_t m_capacity;
             GLuint m_bufferId;
+            VboManager* m_vboManager;
 
             /**
              * Immediately creates and binds to a buffer of the given type and capacity.
              * The contents are initially unspecified.
              */
-            Vbo(GLenum type, size_t capacity, GLenum usage);
+            Vbo(VboManager* vboManager, GLenum type, size_t capacity, GLenum usage);
             ~Vbo();
 
             /**
@@ -99,8 +101,31 @@ namespace TrenchBroom {
                 glAssert(glBindBuffer(m_type, m_bufferId));
                 glAssert(glBufferSubData(m_type, offset, sizei, ptr));
 
+                m_vboManager->countUploadedBytes(size);
                 return size;
             }
+
+            /**
+             * Replaces the entire contents of this VBO with the given C array. The capacity of the VBO changes to the
+             * size of the array.
+             *
+             * The current storage of the VBO is orphaned, so the driver can hand out new storage instead of waiting
+             * until pending draw calls that use the old contents have finished.
+             *
+             * @tparam T        element type
+             * @param array     elements to write
+             * @param count     number of elements to write
+             * @return          number of bytes written
+             */
+            template <typename T>
+            size_t orphanAndWriteArray(const T* array, const size_t count) {
+                static_assert(std::is_trivially_copyable<T>::value);
+                static_assert(std::is_standard_layout<T>::value);
+
+                return orphanAndWrite(static_cast<const GLvoid*>(array), count * sizeof(T));
+            }
+        private:
+            size_t orphanAndWrite(const GLvoid* data, size_t size);
         };
     }
 }
@@ -24,6 +24,7 @@
 #include "Macros.h"
 
 #include <algorithm> // for std::max
+#include <cassert>
 
 namespace TrenchBroom {
     namespace Renderer {
@@ -56,10 +57,15 @@ namespace TrenchBroom {
         m_peakVboCount(0u),
         m_currentVboCount(0u),
         m_currentVboSize(0u),
-        m_shaderManager(shaderManager) {}
+        m_shaderManager(shaderManager),
+        m_streamingUploads(true),
+        m_bytesUploadedThisFrame(0u),
+        m_bytesUploadedLastFrame(0u),
+        m_compactionCount(0u),
+        m_trackedBytes() {}
 
         Vbo* VboManager::allocateVbo(VboType type, const size_t capacity, const VboUsage usage) {
-            auto* result = new Vbo(typeToOpenGL(type), capacity, usageToOpenGL(usage));
+            auto* result = new Vbo(this, typeToOpenGL(type), capacity, usageToOpenGL(usage));
 
             m_currentVboSize += capacity;
             m_currentVboCount++;
@@ -88,6 +94,64 @@ namespace TrenchBroom {
             return m_currentVboSize;
         }
 
+        bool VboManager::streamingUploads() const {
+            return m_streamingUploads;
+        }
+
+        void VboManager::setStreamingUploads(const bool streamingUploads) {
+            m_streamingUploads = streamingUploads;
+        }
+
+        void VboManager::beginFrame() {
+            m_bytesUploadedLastFrame = m_bytesUploadedThisFrame;
+            m_bytesUploadedThisFrame = 0u;
+        }
+
+        size_t VboManager::bytesUploadedLastFrame() const {
+            return m_bytesUploadedLastFrame;
+        }
+
+        size_t VboManager::compactionCount() const {
+            return m_compactionCount;
+        }
+
+        void VboManager::countCompaction() {
+            ++m_compactionCount;
+        }
+
+        double VboManager::freeRatio() const {
+            if (m_trackedBytes.size == 0u) {
+                return 0.0;
+            }
+            return static_cast<double>(m_trackedBytes.free) / static_cast<double>(m_trackedBytes.size);
+        }
+
+        double VboManager::fragmentationRatio() const {
+            if (m_trackedBytes.free == 0u) {
+                return 0.0;
+            }
+            return 1.0 - static_cast<double>(m_trackedBytes.largestFree) / static_cast<double>(m_trackedBytes.free);
+        }
+
+        void VboManager::updateTrackedBytes(const TrackedVboBytes& oldBytes, const TrackedVboBytes& newBytes) {
+            assert(m_trackedBytes.size >= oldBytes.size);
+            assert(m_trackedBytes.free >= oldBytes.free);
+            assert(m_trackedBytes.largestFree >= oldBytes.largestFree);
+            assert(newBytes.largestFree <= newBytes.free && newBytes.free <= newBytes.size);
+
+            m_trackedBytes.size = m_trackedBytes.size - oldBytes.size + newBytes.size;
+            m_trackedBytes.free = m_trackedBytes.free - oldBytes.free + newBytes.free;
+            m_trackedBytes.largestFree = m_trackedBytes.largestFree - oldBytes.largestFree + newBytes.largestFree;
+        }
+
+        void VboManager::countUploadedBytes(const size_t bytes) {
+            m_bytesUploadedThisFrame += bytes;
+        }
+
+        void VboManager::updateVboSize(const size_t oldCapacity, const size_t newCapacity) {
+            m_currentVboSize = m_currentVboSize - oldCapacity + newCapacity;
+        }
+
         ShaderManager& VboManager::shaderManager() {
             return *m_shaderManager;
         }
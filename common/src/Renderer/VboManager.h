@@ -39,12 +39,30 @@ namespace TrenchBroom {
             DynamicDraw
         };
 
+        /**
+         * The size of a VBO managed by an allocation tracker, the number of its bytes that are not allocated, and the
+         * size of its largest free block, all in bytes.
+         */
+        struct TrackedVboBytes {
+            size_t size = 0u;
+            size_t free = 0u;
+            size_t largestFree = 0u;
+        };
+
         class VboManager {
         private:
+            friend class Vbo;
+
             size_t m_peakVboCount;
             size_t m_currentVboCount;
             size_t m_currentVboSize;
             ShaderManager* m_shaderManager;
+
+            bool m_streamingUploads;
+            size_t m_bytesUploadedThisFrame;
+            size_t m_bytesUploadedLastFrame;
+            size_t m_compactionCount;
+            TrackedVboBytes m_trackedBytes;
         public:
             explicit VboManager(ShaderManager* shaderManager);
             /**
@@ -58,7 +76,53 @@ namespace TrenchBroom {
             size_t currentVboCount() const;
             size_t currentVboSize() const;
 
+            /**
+             * Indicates whether VBOs should be updated in streaming mode. In streaming mode, a VBO that has to be resized
+             * or mostly rewritten is orphaned and refilled instead of being deleted and recreated or updated in place.
+             * This avoids stalls when the driver would otherwise have to wait for pending draw calls. Enabled by
+             * default.
+             */
+            bool streamingUploads() const;
+            void setStreamingUploads(bool streamingUploads);
+
+            /**
+             * Must be called once at the start of every frame to update the per frame statistics.
+             */
+            void beginFrame();
+
+            /**
+             * Returns the number of bytes uploaded to VBOs during the last completed frame.
+             */
+            size_t bytesUploadedLastFrame() const;
+
+            /**
+             * Returns the number of times that VBOs managed by an allocation tracker have been compacted.
+             */
+            size_t compactionCount() const;
+            void countCompaction();
+
+            /**
+             * Returns the fraction of the bytes of all VBOs managed by allocation trackers that are currently not
+             * allocated, or 0 if there are no such VBOs.
+             */
+            double freeRatio() const;
+
+            /**
+             * Returns the fraction of the free bytes of all VBOs managed by allocation trackers that do not belong to
+             * the largest free block of their VBO, or 0 if there are no free bytes. This is 0 if the free space of every
+             * VBO is contiguous and approaches 1 as it is scattered over many small blocks.
+             */
+            double fragmentationRatio() const;
+
+            /**
+             * Replaces the previously reported sizes of a VBO managed by an allocation tracker with the given new values.
+             */
+            void updateTrackedBytes(const TrackedVboBytes& oldBytes, const TrackedVboBytes& newBytes);
+
             ShaderManager& shaderManager();
+        private:
+            void countUploadedBytes(size_t bytes);
+            void updateVboSize(size_t oldCapacity, size_t newCapacity);
         };
     }
 }
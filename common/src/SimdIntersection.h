@@ -0,0 +1,429 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRENCHBROOM_SIMDINTERSECTION_H
+#define TRENCHBROOM_SIMDINTERSECTION_H
+
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define TRENCHBROOM_SIMD_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TRENCHBROOM_SIMD_SSE2
+#endif
+
+/*
+ * Kernels that test a single ray against several boxes or planes at once. The boxes and planes are expected in
+ * structure of arrays layout, that is, one array per component.
+ *
+ * If the compiler targets AVX or SSE2, the kernels process 4 (8) or 2 (4) double (float) values per instruction,
+ * otherwise they fall back to scalar code. The scalar code is also used for any remaining values that do not fill a
+ * whole register, and for types and dimensions that have no vectorized implementation.
+ */
+namespace TrenchBroom {
+    /**
+     * The maximum number of boxes or planes that can be tested with a single call to a kernel. This is the size of the
+     * bit mask returned by the kernels.
+     */
+    static constexpr size_t RayBatchSize = 8u;
+
+    namespace SimdDetail {
+        /**
+         * Maps the vectorized operations required by the kernels to the intrinsics of the target instruction set.
+         * Only specialized for the types and instruction sets that are supported.
+         */
+        template <typename T>
+        struct Lanes {
+            static constexpr size_t Count = 1u;
+        };
+
+#if defined(TRENCHBROOM_SIMD_AVX)
+        template <>
+        struct Lanes<double> {
+            using V = __m256d;
+            static constexpr size_t Count = 4u;
+
+            static V load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, const V v) { _mm256_storeu_pd(p, v); }
+            static V set(const double d) { return _mm256_set1_pd(d); }
+            static V add(const V a, const V b) { return _mm256_add_pd(a, b); }
+            static V sub(const V a, const V b) { return _mm256_sub_pd(a, b); }
+            static V mul(const V a, const V b) { return _mm256_mul_pd(a, b); }
+            static V div(const V a, const V b) { return _mm256_div_pd(a, b); }
+            static V min(const V a, const V b) { return _mm256_min_pd(a, b); }
+            static V max(const V a, const V b) { return _mm256_max_pd(a, b); }
+            static unsigned lessEqual(const V a, const V b) { return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ))); }
+        };
+
+        template <>
+        struct Lanes<float> {
+            using V = __m256;
+            static constexpr size_t Count = 8u;
+
+            static V load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, const V v) { _mm256_storeu_ps(p, v); }
+            static V set(const float f) { return _mm256_set1_ps(f); }
+            static V add(const V a, const V b) { return _mm256_add_ps(a, b); }
+            static V sub(const V a, const V b) { return _mm256_sub_ps(a, b); }
+            static V mul(const V a, const V b) { return _mm256_mul_ps(a, b); }
+            static V div(const V a, const V b) { return _mm256_div_ps(a, b); }
+            static V min(const V a, const V b) { return _mm256_min_ps(a, b); }
+            static V max(const V a, const V b) { return _mm256_max_ps(a, b); }
+            static unsigned lessEqual(const V a, const V b) { return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ))); }
+        };
+#elif defined(TRENCHBROOM_SIMD_SSE2)
+        template <>
+        struct Lanes<double> {
+            using V = __m128d;
+            static constexpr size_t Count = 2u;
+
+            static V load(const double* p) { return _mm_loadu_pd(p); }
+            static void store(double* p, const V v) { _mm_storeu_pd(p, v); }
+            static V set(const double d) { return _mm_set1_pd(d); }
+            static V add(const V a, const V b) { return _mm_add_pd(a, b); }
+            static V sub(const V a, const V b) { return _mm_sub_pd(a, b); }
+            static V mul(const V a, const V b) { return _mm_mul_pd(a, b); }
+            static V div(const V a, const V b) { return _mm_div_pd(a, b); }
+            static V min(const V a, const V b) { return _mm_min_pd(a, b); }
+            static V max(const V a, const V b) { return _mm_max_pd(a, b); }
+            static unsigned lessEqual(const V a, const V b) { return static_cast<unsigned>(_mm_movemask_pd(_mm_cmple_pd(a, b))); }
+        };
+
+        template <>
+        struct Lanes<float> {
+            using V = __m128;
+            static constexpr size_t Count = 4u;
+
+            static V load(const float* p) { return _mm_loadu_ps(p); }
+            static void store(float* p, const V v) { _mm_storeu_ps(p, v); }
+            static V set(const float f) { return _mm_set1_ps(f); }
+            static V add(const V a, const V b) { return _mm_add_ps(a, b); }
+            static V sub(const V a, const V b) { return _mm_sub_ps(a, b); }
+            static V mul(const V a, const V b) { return _mm_mul_ps(a, b); }
+            static V div(const V a, const V b) { return _mm_div_ps(a, b); }
+            static V min(const V a, const V b) { return _mm_min_ps(a, b); }
+            static V max(const V a, const V b) { return _mm_max_ps(a, b); }
+            static unsigned lessEqual(const V a, const V b) { return static_cast<unsigned>(_mm_movemask_ps(_mm_cmple_ps(a, b))); }
+        };
+#endif
+    }
+
+    /**
+     * Tests a ray against several axis aligned boxes at once. A box is hit if the ray intersects it at a non-negative
+     * distance, or if the box contains the ray's origin.
+     *
+     * The ray dependent values are computed once when the test is created, so a test should be reused for all boxes
+     * that are tested against the same ray.
+     *
+     * @tparam T the floating point type
+     * @tparam S the number of dimensions
+     */
+    template <typename T, size_t S>
+    class RayBoxTest {
+    private:
+        using Lanes = SimdDetail::Lanes<T>;
+
+        vm::vec<T,S> m_origin;
+        vm::vec<T,S> m_invDirection;
+        std::array<bool, S> m_parallel;
+    public:
+        explicit RayBoxTest(const vm::ray<T,S>& ray) :
+            m_origin(ray.origin) {
+            for (size_t i = 0u; i < S; ++i) {
+                m_parallel[i] = ray.direction[i] == static_cast<T>(0);
+                m_invDirection[i] = m_parallel[i] ? static_cast<T>(0) : static_cast<T>(1) / ray.direction[i];
+            }
+        }
+
+        /**
+         * Tests the ray against the given boxes. The minimum and maximum coordinates of the boxes are passed as one array
+         * per component.
+         *
+         * @param min the minimum coordinates of the boxes, one array per component
+         * @param max the maximum coordinates of the boxes, one array per component
+         * @param count the number of boxes to test, at most RayBatchSize
+         * @return a bit mask where bit i is set if and only if box i is hit
+         */
+        unsigned operator()(const std::array<const T*, S>& min, const std::array<const T*, S>& max, const size_t count) const {
+            assert(count <= RayBatchSize);
+
+            unsigned result = 0u;
+            size_t first = 0u;
+            if constexpr (Lanes::Count > 1u) {
+                for (; first + Lanes::Count <= count; first += Lanes::Count) {
+                    result |= testLanes(min, max, first) << first;
+                }
+            }
+            for (; first < count; ++first) {
+                if (test(min, max, first)) {
+                    result |= 1u << first;
+                }
+            }
+            return result;
+        }
+
+        /**
+         * Tests the ray against a single box.
+         *
+         * @param min the minimum coordinates of the boxes, one array per component
+         * @param max the maximum coordinates of the boxes, one array per component
+         * @param index the index of the box to test
+         * @return true if the box is hit and false otherwise
+         */
+        bool test(const std::array<const T*, S>& min, const std::array<const T*, S>& max, const size_t index) const {
+            auto tMin = static_cast<T>(0);
+            auto tMax = std::numeric_limits<T>::max();
+            for (size_t i = 0u; i < S; ++i) {
+                if (m_parallel[i]) {
+                    if (m_origin[i] < min[i][index] || m_origin[i] > max[i][index]) {
+                        return false;
+                    }
+                } else {
+                    const auto t1 = (min[i][index] - m_origin[i]) * m_invDirection[i];
+                    const auto t2 = (max[i][index] - m_origin[i]) * m_invDirection[i];
+                    tMin = std::max(tMin, std::min(t1, t2));
+                    tMax = std::min(tMax, std::max(t1, t2));
+                    if (tMin > tMax) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+    private:
+        unsigned testLanes(const std::array<const T*, S>& min, const std::array<const T*, S>& max, const size_t first) const {
+            using L = Lanes;
+            constexpr auto allLanes = (1u << L::Count) - 1u;
+
+            auto tMin = L::set(static_cast<T>(0));
+            auto tMax = L::set(std::numeric_limits<T>::max());
+            auto result = allLanes;
+            for (size_t i = 0u; i < S; ++i) {
+                const auto boxMin = L::load(min[i] + first);
+                const auto boxMax = L::load(max[i] + first);
+                const auto origin = L::set(m_origin[i]);
+                if (m_parallel[i]) {
+                    result &= L::lessEqual(boxMin, origin) & L::lessEqual(origin, boxMax);
+                } else {
+                    const auto invDirection = L::set(m_invDirection[i]);
+                    const auto t1 = L::mul(L::sub(boxMin, origin), invDirection);
+                    const auto t2 = L::mul(L::sub(boxMax, origin), invDirection);
+                    tMin = L::max(tMin, L::min(t1, t2));
+                    tMax = L::min(tMax, L::max(t1, t2));
+                }
+            }
+            return result & L::lessEqual(tMin, tMax);
+        }
+    };
+
+    /**
+     * A list of planes in structure of arrays layout.
+     *
+     * @tparam T the floating point type
+     */
+    template <typename T>
+    struct PlaneList {
+        std::vector<T> normalX;
+        std::vector<T> normalY;
+        std::vector<T> normalZ;
+        std::vector<T> distance;
+
+        bool empty() const {
+            return distance.empty();
+        }
+
+        size_t size() const {
+            return distance.size();
+        }
+
+        void clear() {
+            normalX.clear();
+            normalY.clear();
+            normalZ.clear();
+            distance.clear();
+        }
+
+        void push_back(const vm::plane<T,3>& plane) {
+            normalX.push_back(plane.normal.x());
+            normalY.push_back(plane.normal.y());
+            normalZ.push_back(plane.normal.z());
+            distance.push_back(plane.distance);
+        }
+    };
+
+    /**
+     * Tests whether the given point is contained in the intersection of the half spaces below the given planes, that
+     * is, whether its distance to every plane is at most the given epsilon.
+     *
+     * @tparam T the floating point type
+     * @param point the point to test
+     * @param planes the planes bounding the half spaces
+     * @param epsilon the epsilon value
+     * @return true if the point is below or on every plane and false otherwise
+     */
+    template <typename T>
+    bool pointInHalfspaces(const vm::vec<T,3>& point, const PlaneList<T>& planes, const T epsilon) {
+        using L = SimdDetail::Lanes<T>;
+
+        size_t i = 0u;
+        if constexpr (L::Count > 1u) {
+            constexpr auto allLanes = (1u << L::Count) - 1u;
+
+            const auto pX = L::set(point.x());
+            const auto pY = L::set(point.y());
+            const auto pZ = L::set(point.z());
+            const auto eps = L::set(epsilon);
+
+            for (; i + L::Count <= planes.size(); i += L::Count) {
+                const auto nX = L::load(planes.normalX.data() + i);
+                const auto nY = L::load(planes.normalY.data() + i);
+                const auto nZ = L::load(planes.normalZ.data() + i);
+                const auto d = L::load(planes.distance.data() + i);
+
+                const auto dot = L::add(L::add(L::mul(nX, pX), L::mul(nY, pY)), L::mul(nZ, pZ));
+                if (L::lessEqual(L::sub(dot, d), eps) != allLanes) {
+                    return false;
+                }
+            }
+        }
+
+        for (; i < planes.size(); ++i) {
+            const auto normal = vm::vec<T,3>(planes.normalX[i], planes.normalY[i], planes.normalZ[i]);
+            if (vm::dot(normal, point) - planes.distance[i] > epsilon) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * For each of the given planes, computes the cosine of the angle between the plane normal and the given ray's
+     * direction, and the distance from the ray's origin to the plane along the ray. For planes parallel to the ray, the
+     * distance is not a finite number.
+     *
+     * @tparam T the floating point type
+     * @param ray the ray
+     * @param planes the planes
+     * @param first the index of the first plane to test
+     * @param count the number of planes to test, at most RayBatchSize
+     * @param cosines receives the cosines
+     * @param distances receives the distances
+     */
+    template <typename T>
+    void intersectRayPlanes(const vm::ray<T,3>& ray, const PlaneList<T>& planes, const size_t first, const size_t count, T* cosines, T* distances) {
+        using L = SimdDetail::Lanes<T>;
+        assert(count <= RayBatchSize);
+        assert(first + count <= planes.size());
+
+        size_t i = 0u;
+        if constexpr (L::Count > 1u) {
+            const auto dirX = L::set(ray.direction.x());
+            const auto dirY = L::set(ray.direction.y());
+            const auto dirZ = L::set(ray.direction.z());
+            const auto orgX = L::set(ray.origin.x());
+            const auto orgY = L::set(ray.origin.y());
+            const auto orgZ = L::set(ray.origin.z());
+
+            for (; i + L::Count <= count; i += L::Count) {
+                const auto nX = L::load(planes.normalX.data() + first + i);
+                const auto nY = L::load(planes.normalY.data() + first + i);
+                const auto nZ = L::load(planes.normalZ.data() + first + i);
+                const auto d = L::load(planes.distance.data() + first + i);
+
+                const auto cos = L::add(L::add(L::mul(nX, dirX), L::mul(nY, dirY)), L::mul(nZ, dirZ));
+                const auto dot = L::add(L::add(L::mul(nX, orgX), L::mul(nY, orgY)), L::mul(nZ, orgZ));
+                L::store(cosines + i, cos);
+                L::store(distances + i, L::div(L::sub(d, dot), cos));
+            }
+        }
+
+        for (; i < count; ++i) {
+            const auto index = first + i;
+            const auto normal = vm::vec<T,3>(planes.normalX[index], planes.normalY[index], planes.normalZ[index]);
+            cosines[i] = vm::dot(normal, ray.direction);
+            distances[i] = (planes.distance[index] - vm::dot(normal, ray.origin)) / cosines[i];
+        }
+    }
+
+    /**
+     * Clips the given ray against the given planes, which must bound a convex polyhedron and whose normals must point
+     * outwards.
+     *
+     * If the ray clearly misses the polyhedron, that is, by more than the given epsilon, nothing is returned. Otherwise,
+     * the index of the plane through which the ray enters the polyhedron is returned. Note that this plane is only a
+     * candidate: callers must still check whether the ray actually hits the corresponding face. This happens if the ray
+     * only grazes the polyhedron, or if the ray's origin is contained in it.
+     *
+     * @tparam T the floating point type
+     * @param ray the ray
+     * @param planes the planes bounding the polyhedron
+     * @param epsilon the epsilon value
+     * @return the index of the plane through which the ray enters the polyhedron, or nothing if the ray misses it
+     */
+    template <typename T>
+    std::optional<size_t> findRayEntryPlane(const vm::ray<T,3>& ray, const PlaneList<T>& planes, const T epsilon) {
+        auto entryPlane = size_t(0);
+        auto entryDistance = -std::numeric_limits<T>::max();
+        auto exitDistance = std::numeric_limits<T>::max();
+
+        std::array<T, RayBatchSize> cosines;
+        std::array<T, RayBatchSize> distances;
+        for (size_t first = 0u; first < planes.size(); first += RayBatchSize) {
+            const auto count = std::min(RayBatchSize, planes.size() - first);
+            intersectRayPlanes(ray, planes, first, count, cosines.data(), distances.data());
+
+            for (size_t i = 0u; i < count; ++i) {
+                if (cosines[i] < static_cast<T>(0)) {
+                    if (distances[i] > entryDistance) {
+                        entryDistance = distances[i];
+                        entryPlane = first + i;
+                    }
+                } else if (cosines[i] > static_cast<T>(0)) {
+                    exitDistance = std::min(exitDistance, distances[i]);
+                } else {
+                    // the ray is parallel to the plane, so it misses if its origin is in front of the plane
+                    const auto index = first + i;
+                    const auto normal = vm::vec<T,3>(planes.normalX[index], planes.normalY[index], planes.normalZ[index]);
+                    if (vm::dot(normal, ray.origin) - planes.distance[index] > epsilon) {
+                        return std::nullopt;
+                    }
+                }
+            }
+        }
+
+        if (exitDistance < -epsilon || entryDistance > exitDistance + epsilon) {
+            return std::nullopt;
+        }
+        return entryPlane;
+    }
+}
+
+#endif //TRENCHBROOM_SIMDINTERSECTION_H
@@ -48,7 +48,7 @@ namespace TrenchBroom {
         VertexCommand(type, name, brushes),
         m_vertices(vertices) {}
 
-        bool AddBrushVerticesCommand::doCanDoVertexOperation(const MapDocument* document) const {
+        bool AddBrushVerticesCommand::doCanDoVertexOperation(const MapDocument* document) {
             const vm::bbox3& worldBounds = document->worldBounds();
             for (const auto& entry : m_vertices) {
                 const vm::vec3& position = entry.first;
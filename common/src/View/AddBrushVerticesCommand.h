@@ -41,7 +41,7 @@ namespace TrenchBroom {
 
             AddBrushVerticesCommand(CommandType type, const std::string& name, const std::vector<Model::BrushNode*>& brushes, const VertexToBrushesMap& vertices);
         private:
-            bool doCanDoVertexOperation(const MapDocument* document) const override;
+            bool doCanDoVertexOperation(const MapDocument* document) override;
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
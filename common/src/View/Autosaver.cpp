@@ -19,9 +19,16 @@
 
 #include "Autosaver.h"
 
+#include "DeferredLogger.h"
 #include "Exceptions.h"
 #include "IO/DiskFileSystem.h"
 #include "IO/DiskIO.h"
+#include "Model/Brush.h"
+#include "Model/BrushNode.h"
+#include "Model/EntityNode.h"
+#include "Model/Game.h"
+#include "Model/NodeVisitor.h"
+#include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 
 #include <kdl/memory_utils.h>
@@ -31,6 +38,7 @@
 
 #include <algorithm> // for std::sort
 #include <cassert>
+#include <exception>
 #include <limits>
 #include <memory>
 
@@ -67,9 +75,25 @@ namespace TrenchBroom {
         m_saveInterval(saveInterval),
         m_maxBackups(maxBackups),
         m_lastSaveTime(Clock::now()),
-        m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()) {}
+        m_lastModificationCount(kdl::mem_lock(m_document)->modificationCount()),
+        m_saveInBackground(false),
+        m_backgroundLogger(std::make_unique<DeferredLogger>()) {}
+
+        Autosaver::~Autosaver() {
+            if (m_backgroundSave.valid()) {
+                m_backgroundSave.wait();
+            }
+        }
+
+        void Autosaver::setSaveInBackground(const bool saveInBackground) {
+            m_saveInBackground = saveInBackground;
+        }
 
         void Autosaver::triggerAutosave(Logger& logger) {
+            if (!finishBackgroundSave(logger)) {
+                return;
+            }
+
             if (kdl::mem_expired(m_document)) {
                 return;
             }
@@ -95,7 +119,29 @@ namespace TrenchBroom {
                 return;
             }
 
-            autosave(logger, document);
+            if (m_saveInBackground) {
+                autosaveInBackground(logger, document);
+            } else {
+                autosave(logger, document);
+            }
+        }
+
+        void Autosaver::waitForBackgroundSave(Logger& logger) {
+            if (m_backgroundSave.valid()) {
+                m_backgroundSave.wait();
+            }
+            finishBackgroundSave(logger);
+        }
+
+        bool Autosaver::finishBackgroundSave(Logger& logger) {
+            if (m_backgroundSave.valid()) {
+                if (m_backgroundSave.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+                    return false;
+                }
+                m_backgroundSave.get();
+            }
+            m_backgroundLogger->flush(logger);
+            return true;
         }
 
         void Autosaver::autosave(Logger& logger, std::shared_ptr<MapDocument> document) {
@@ -107,26 +153,106 @@ namespace TrenchBroom {
 
             try {
                 auto fs = createBackupFileSystem(logger, mapPath);
-                auto backups = collectBackups(fs, mapBasename);
+                const auto backupFilePath = fs.makeAbsolute(prepareBackups(logger, fs, mapBasename));
 
-                thinBackups(logger, fs, backups);
-                cleanBackups(fs, backups, mapBasename);
+                m_lastSaveTime = Clock::now();
+                m_lastModificationCount = document->modificationCount();
+                document->saveDocumentTo(backupFilePath);
 
-                assert(backups.size() < m_maxBackups);
-                const auto backupNo = backups.size() + 1;
+                logger.info() << "Created autosave backup at " << backupFilePath;
+            } catch (const FileSystemException& e) {
+                logger.error() << "Aborting autosave: " << e.what();
+            }
+        }
 
-                const auto backupFilePath = fs.makeAbsolute(makeBackupName(mapBasename, backupNo));
+        /**
+         * Detaches the nodes of a world snapshot from the textures, entity definitions and entity models, which may be
+         * unloaded while the snapshot is written and must not be touched from another thread. The map file only
+         * refers to these assets by name.
+         */
+        class ReleaseSnapshotAssets : public Model::NodeVisitor {
+        private:
+            void doVisit(Model::WorldNode* /* world */) override {}
+            void doVisit(Model::LayerNode* /* layer */) override {}
+            void doVisit(Model::GroupNode* /* group */) override {}
+
+            void doVisit(Model::EntityNode* entity) override {
+                entity->setDefinition(nullptr);
+                entity->setModelFrame(nullptr);
+            }
+
+            void doVisit(Model::BrushNode* brush) override {
+                for (size_t i = 0u; i < brush->brush().faceCount(); ++i) {
+                    brush->setFaceTexture(i, nullptr);
+                }
+            }
+        };
+
+        static std::unique_ptr<Model::WorldNode> snapshotWorld(const MapDocument& document) {
+            // copying a brush shares its geometry with the original, so this is much cheaper than writing the map
+            auto snapshot = std::unique_ptr<Model::WorldNode>(static_cast<Model::WorldNode*>(document.world()->cloneRecursively(document.worldBounds())));
+
+            ReleaseSnapshotAssets releaseAssets;
+            snapshot->acceptAndRecurse(releaseAssets);
+
+            return snapshot;
+        }
+
+        void Autosaver::autosaveInBackground(Logger& logger, std::shared_ptr<MapDocument> document) {
+            const auto& mapPath = document->path();
+            assert(IO::Disk::fileExists(IO::Disk::fixPath(mapPath)));
+
+            const auto mapFilename = mapPath.lastComponent();
+            const auto mapBasename = mapFilename.deleteExtension();
+
+            // the temporary file is not matched by BackupFileMatcher, so it is never mistaken for a backup
+            const auto tempFilename = IO::Path(kdl::str_to_string(mapBasename, ".autosave"));
+
+            try {
+                auto fs = createBackupFileSystem(logger, mapPath);
+                const auto autosavePath = fs.root();
 
                 m_lastSaveTime = Clock::now();
                 m_lastModificationCount = document->modificationCount();
-                document->saveDocumentTo(backupFilePath);
 
-                logger.info() << "Created autosave backup at " << backupFilePath;
+                auto game = document->game();
+                auto snapshot = snapshotWorld(*document);
+
+                m_backgroundSave = std::async(std::launch::async, [this, game = std::move(game), snapshot = std::move(snapshot), autosavePath, mapBasename, tempFilename]() {
+                    auto& backgroundLogger = *m_backgroundLogger;
+                    try {
+                        IO::WritableDiskFileSystem backupFs(autosavePath, false);
+                        game->writeMap(*snapshot, backupFs.makeAbsolute(tempFilename));
+
+                        const auto backupFilename = prepareBackups(backgroundLogger, backupFs, mapBasename);
+                        backupFs.moveFile(tempFilename, backupFilename, true);
+
+                        backgroundLogger.info() << "Created autosave backup at " << backupFs.makeAbsolute(backupFilename);
+                    } catch (const FileSystemException& e) {
+                        backgroundLogger.error() << "Aborting autosave: " << e.what();
+                    } catch (const std::exception& e) {
+                        // an escaping exception would be rethrown by finishBackgroundSave and skip flushing the log
+                        backgroundLogger.error() << "Aborting autosave: " << e.what();
+                    }
+                });
             } catch (const FileSystemException& e) {
                 logger.error() << "Aborting autosave: " << e.what();
+            } catch (const std::exception& e) {
+                // std::async throws std::system_error if it cannot start the thread
+                logger.error() << "Aborting autosave: " << e.what();
             }
         }
 
+        IO::Path Autosaver::prepareBackups(Logger& logger, IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const {
+            auto backups = collectBackups(fs, mapBasename);
+
+            thinBackups(logger, fs, backups);
+            cleanBackups(fs, backups, mapBasename);
+
+            assert(backups.size() < m_maxBackups);
+            return makeBackupName(mapBasename, backups.size() + 1);
+        }
+
         IO::WritableDiskFileSystem Autosaver::createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const {
             const auto basePath = mapPath.deleteLastComponent();
             const auto autosavePath = basePath + IO::Path("autosave");
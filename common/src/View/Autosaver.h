@@ -23,9 +23,12 @@
 #include "IO/Path.h"
 
 #include <chrono>
+#include <future>
 #include <memory>
+#include <vector>
 
 namespace TrenchBroom {
+    class DeferredLogger;
     class Logger;
 
     namespace IO {
@@ -70,13 +73,46 @@ namespace TrenchBroom {
              * The modification count that was last recorded.
              */
             size_t m_lastModificationCount;
-            
+
+            /**
+             * Whether the map is written and the backups are rotated on a worker thread.
+             */
+            bool m_saveInBackground;
+            std::unique_ptr<DeferredLogger> m_backgroundLogger;
+            std::future<void> m_backgroundSave;
         public:
             explicit Autosaver(std::weak_ptr<MapDocument> document, std::chrono::milliseconds saveInterval = std::chrono::milliseconds(10 * 60 * 1000), size_t maxBackups = 50);
+            ~Autosaver();
+
+            /**
+             * If enabled, only a copy of the world is taken while the caller waits. Writing the copy to a temporary
+             * file in the autosave directory and deleting, renaming and moving the backup files is done on a worker
+             * thread, and its log messages are passed on to the logger on the next call to triggerAutosave(). Disabled
+             * by default.
+             */
+            void setSaveInBackground(bool saveInBackground);
 
             void triggerAutosave(Logger& logger);
+
+            /**
+             * Blocks until a backup that is being finished on a worker thread is in place.
+             */
+            void waitForBackgroundSave(Logger& logger);
         private:
+            /**
+             * Collects the log messages of a backup that was finished on a worker thread. Returns false if the backup
+             * is still being finished.
+             */
+            bool finishBackgroundSave(Logger& logger);
+
             void autosave(Logger& logger, std::shared_ptr<View::MapDocument> document);
+            void autosaveInBackground(Logger& logger, std::shared_ptr<View::MapDocument> document);
+
+            /**
+             * Deletes and renumbers the existing backups so that a new one can be added, and returns the name of the
+             * new backup.
+             */
+            IO::Path prepareBackups(Logger& logger, IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             IO::WritableDiskFileSystem createBackupFileSystem(Logger& logger, const IO::Path& mapPath) const;
             std::vector<IO::Path> collectBackups(const IO::WritableDiskFileSystem& fs, const IO::Path& mapBasename) const;
             void thinBackups(Logger& logger, IO::WritableDiskFileSystem& fs, std::vector<IO::Path>& backups) const;
@@ -0,0 +1,136 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellItemIndex.h"
+
+#include "Ensure.h"
+
+#include <kdl/parallel.h>
+#include <kdl/string_format.h>
+
+#include <algorithm>
+#include <numeric>
+
+namespace TrenchBroom {
+    namespace View {
+        static uint32_t trigram(const std::string& str, const size_t position) {
+            return static_cast<uint32_t>(static_cast<unsigned char>(str[position])) << 16u |
+                   static_cast<uint32_t>(static_cast<unsigned char>(str[position + 1u])) << 8u |
+                   static_cast<uint32_t>(static_cast<unsigned char>(str[position + 2u]));
+        }
+
+        CellItemIndex::CellItemIndex(const std::vector<std::string>& names) :
+        m_nameOrder(names.size()),
+        m_nameRank(names.size()) {
+            m_names.reserve(names.size());
+            for (const auto& name : names) {
+                m_names.push_back(kdl::str_to_lower(name));
+            }
+
+            std::iota(std::begin(m_nameOrder), std::end(m_nameOrder), 0u);
+            std::stable_sort(std::begin(m_nameOrder), std::end(m_nameOrder), [&](const size_t lhs, const size_t rhs) {
+                return m_names[lhs] < m_names[rhs];
+            });
+
+            // the posting lists are built in name order so that candidates are already sorted
+            for (size_t i = 0u; i < m_nameOrder.size(); ++i) {
+                const auto item = m_nameOrder[i];
+                m_nameRank[item] = i;
+
+                const auto& name = m_names[item];
+                for (size_t j = 0u; j + 3u <= name.size(); ++j) {
+                    auto& items = m_trigrams[trigram(name, j)];
+                    if (items.empty() || items.back() != item) {
+                        items.push_back(item);
+                    }
+                }
+            }
+        }
+
+        size_t CellItemIndex::size() const {
+            return m_names.size();
+        }
+
+        size_t CellItemIndex::nameRank(const size_t item) const {
+            ensure(item < m_nameRank.size(), "item index out of range");
+            return m_nameRank[item];
+        }
+
+        const std::vector<size_t>& CellItemIndex::match(const std::string& pattern) {
+            const auto lowerPattern = kdl::str_to_lower(pattern);
+            if (lowerPattern.empty()) {
+                m_lastPattern.clear();
+                return m_nameOrder;
+            }
+            if (lowerPattern == m_lastPattern) {
+                return m_lastMatches;
+            }
+
+            const auto& candidates = this->candidates(lowerPattern);
+            const auto isMatch = [&](const size_t item) {
+                return m_names[item].find(lowerPattern) != std::string::npos;
+            };
+
+            static const size_t ChunkSize = 4096u;
+            std::vector<size_t> matches;
+            if (candidates.size() <= ChunkSize) {
+                std::copy_if(std::begin(candidates), std::end(candidates), std::back_inserter(matches), isMatch);
+            } else {
+                const auto chunkCount = (candidates.size() + ChunkSize - 1u) / ChunkSize;
+                std::vector<std::vector<size_t>> chunkMatches(chunkCount);
+                kdl::parallel_for(chunkCount, [&](const size_t i) {
+                    const auto first = std::next(std::begin(candidates), static_cast<std::ptrdiff_t>(i * ChunkSize));
+                    const auto last = std::next(first, static_cast<std::ptrdiff_t>(std::min(ChunkSize, candidates.size() - i * ChunkSize)));
+                    std::copy_if(first, last, std::back_inserter(chunkMatches[i]), isMatch);
+                });
+                for (const auto& chunk : chunkMatches) {
+                    matches.insert(std::end(matches), std::begin(chunk), std::end(chunk));
+                }
+            }
+
+            m_lastPattern = lowerPattern;
+            m_lastMatches = std::move(matches);
+            return m_lastMatches;
+        }
+
+        const std::vector<size_t>& CellItemIndex::candidates(const std::string& pattern) const {
+            // every item that contains the pattern also contains the previous pattern
+            if (!m_lastPattern.empty() && pattern.find(m_lastPattern) != std::string::npos) {
+                return m_lastMatches;
+            }
+
+            if (pattern.size() < 3u) {
+                return m_nameOrder;
+            }
+
+            static const std::vector<size_t> None;
+            const std::vector<size_t>* result = nullptr;
+            for (size_t i = 0u; i + 3u <= pattern.size(); ++i) {
+                const auto it = m_trigrams.find(trigram(pattern, i));
+                if (it == std::end(m_trigrams)) {
+                    return None;
+                }
+                if (result == nullptr || it->second.size() < result->size()) {
+                    result = &it->second;
+                }
+            }
+            return *result;
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_CellItemIndex
+#define TrenchBroom_CellItemIndex
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        /**
+         * Indexes the names of the items shown in a cell view so that the items can be filtered and sorted by name
+         * without comparing every name on every change of the filter text.
+         *
+         * Items are identified by their position in the list of names the index was built from. The names are sorted
+         * once when the index is built, and every match returns the matching items in that order. Names are matched
+         * without case sensitivity.
+         *
+         * To find the items whose names contain a pattern, only the items that contain the rarest trigram of the
+         * pattern are checked. If the pattern extends the previous pattern, e.g. while the user is typing, only the
+         * previous matches are checked. Large numbers of candidates are checked concurrently.
+         */
+        class CellItemIndex {
+        private:
+            std::vector<std::string> m_names;
+            std::vector<size_t> m_nameOrder;
+            std::vector<size_t> m_nameRank;
+            std::unordered_map<uint32_t, std::vector<size_t>> m_trigrams;
+
+            std::string m_lastPattern;
+            std::vector<size_t> m_lastMatches;
+        public:
+            /**
+             * Creates an index of the given names.
+             *
+             * @param names the names of the items, indexed by item
+             */
+            explicit CellItemIndex(const std::vector<std::string>& names = {});
+
+            /**
+             * Returns the number of indexed items.
+             */
+            size_t size() const;
+
+            /**
+             * Returns the position of the given item when all items are sorted by name.
+             *
+             * @param item the item
+             * @return the position of the item
+             */
+            size_t nameRank(size_t item) const;
+
+            /**
+             * Returns the items whose names contain the given pattern, sorted by name.
+             *
+             * @param pattern the pattern to match, all items match an empty pattern
+             * @return the matching items
+             */
+            const std::vector<size_t>& match(const std::string& pattern);
+        private:
+            const std::vector<size_t>& candidates(const std::string& pattern) const;
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_CellItemIndex) */
@@ -0,0 +1,59 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CellLabelCache.h"
+
+#include "Ensure.h"
+#include "Renderer/FontManager.h"
+#include "Renderer/TextureFont.h"
+
+namespace TrenchBroom {
+    namespace View {
+        CellLabelCache::CellLabelCache() :
+        m_maxWidth(0.0f),
+        m_minFontSize(0u) {}
+
+        void CellLabelCache::reset(const Renderer::FontDescriptor& font, const float maxWidth, const size_t minFontSize) {
+            if (m_font && m_font->compare(font) == 0 && m_maxWidth == maxWidth && m_minFontSize == minFontSize) {
+                return;
+            }
+
+            m_font = font;
+            m_maxWidth = maxWidth;
+            m_minFontSize = minFontSize;
+            m_labels.clear();
+        }
+
+        const CellLabel& CellLabelCache::label(Renderer::FontManager& fontManager, const std::string& text) {
+            ensure(m_font.has_value(), "font must be set");
+
+            auto it = m_labels.find(text);
+            if (it == std::end(m_labels)) {
+                const auto font = fontManager.selectFontSize(*m_font, text, m_maxWidth, m_minFontSize);
+                const auto size = fontManager.font(font).measure(text);
+                it = m_labels.emplace(text, CellLabel{font, size}).first;
+            }
+            return it->second;
+        }
+
+        void CellLabelCache::clear() {
+            m_labels.clear();
+        }
+    }
+}
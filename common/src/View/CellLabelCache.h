@@ -0,0 +1,78 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TrenchBroom_CellLabelCache
+#define TrenchBroom_CellLabelCache
+
+#include "Renderer/FontDescriptor.h"
+
+#include <vecmath/vec.h>
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace TrenchBroom {
+    namespace Renderer {
+        class FontManager;
+    }
+
+    namespace View {
+        struct CellLabel {
+            Renderer::FontDescriptor font;
+            vm::vec2f size;
+        };
+
+        /**
+         * Caches the font and the size of the labels shown in a cell view. A label is shown in the largest font size
+         * that fits the maximum width, see Renderer::FontManager::selectFontSize. Measuring a label is expensive
+         * compared to laying out its cell, so each label is measured only once until the font or the maximum width
+         * change.
+         */
+        class CellLabelCache {
+        private:
+            std::optional<Renderer::FontDescriptor> m_font;
+            float m_maxWidth;
+            size_t m_minFontSize;
+            std::unordered_map<std::string, CellLabel> m_labels;
+        public:
+            CellLabelCache();
+
+            /**
+             * Sets the font, the maximum width and the minimum font size of the labels. If any of these differ from
+             * the current values, the cached labels are discarded.
+             */
+            void reset(const Renderer::FontDescriptor& font, float maxWidth, size_t minFontSize);
+
+            /**
+             * Returns the font and the size of the given label, measuring it if it is not cached yet. The font must
+             * have been set by calling reset.
+             *
+             * @param fontManager the font manager to measure the label with
+             * @param text the text of the label
+             * @return the font and the size of the label
+             */
+            const CellLabel& label(Renderer::FontManager& fontManager, const std::string& text);
+
+            void clear();
+        };
+    }
+}
+
+#endif /* defined(TrenchBroom_CellLabelCache) */
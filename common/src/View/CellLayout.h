@@ -513,7 +513,7 @@ namespace TrenchBroom {
                 m_height = 2.0f * m_outerMargin;
                 m_valid = true;
                 if (!m_groups.empty()) {
-                    auto copy = m_groups;
+                    auto copy = std::move(m_groups);
                     m_groups.clear();
 
                     for (size_t i = 0; i < copy.size(); ++i) {
@@ -29,6 +29,7 @@
 #include <kdl/vector_utils.h>
 
 #include <algorithm>
+#include <limits>
 
 #include <QDateTime>
 
@@ -142,6 +143,14 @@ namespace TrenchBroom {
             bool doCollateWith(UndoableCommand*) override {
                 return false;
             }
+
+            size_t doGetMemorySize() const override {
+                size_t result = 0u;
+                for (const auto& command : m_commands) {
+                    result += command->memorySize();
+                }
+                return result;
+            }
         };
 
         const Command::CommandType CommandProcessor::TransactionCommand::Type = Command::freeType();
@@ -149,6 +158,8 @@ namespace TrenchBroom {
         CommandProcessor::CommandProcessor(MapDocumentCommandFacade* document, const std::chrono::milliseconds collationInterval) :
         m_document(document),
         m_collationInterval(collationInterval),
+        m_undoMemoryBudget(std::numeric_limits<size_t>::max()),
+        m_undoMemorySize(0u),
         m_lastCommandTimestamp(std::chrono::time_point<std::chrono::system_clock>()) {}
 
         CommandProcessor::~CommandProcessor() = default;
@@ -177,6 +188,21 @@ namespace TrenchBroom {
             }
         }
 
+        size_t CommandProcessor::undoMemoryBudget() const {
+            return m_undoMemoryBudget;
+        }
+
+        void CommandProcessor::setUndoMemoryBudget(const size_t undoMemoryBudget) {
+            m_undoMemoryBudget = undoMemoryBudget;
+            if (m_transactionStack.empty()) {
+                trimUndoStack();
+            }
+        }
+
+        size_t CommandProcessor::undoMemorySize() const {
+            return m_undoMemorySize;
+        }
+
         void CommandProcessor::startTransaction(const std::string& name) {
             m_transactionStack.push_back(TransactionState(name));
         }
@@ -205,6 +231,8 @@ namespace TrenchBroom {
             auto result = executeCommand(command.get());
             if (result->success()) {
                 m_undoStack.clear();
+                m_undoMemorySizes.clear();
+                m_undoMemorySize = 0u;
                 m_redoStack.clear();
             }
             return result;
@@ -280,6 +308,8 @@ namespace TrenchBroom {
 
             clearRepeatStack();
             m_undoStack.clear();
+            m_undoMemorySizes.clear();
+            m_undoMemorySize = 0u;
             m_redoStack.clear();
             m_lastCommandTimestamp = std::chrono::time_point<std::chrono::system_clock>();
         }
@@ -379,6 +409,11 @@ namespace TrenchBroom {
             if (collatable(collate, timestamp)) {
                 auto& lastCommand = m_undoStack.back();
                 if (lastCommand->collateWith(command.get())) {
+                    const auto memorySize = lastCommand->memorySize();
+                    m_undoMemorySize = m_undoMemorySize - m_undoMemorySizes.back() + memorySize;
+                    m_undoMemorySizes.back() = memorySize;
+
+                    trimUndoStack();
                     return false;
                 }
             }
@@ -387,7 +422,12 @@ namespace TrenchBroom {
                 pushToRepeatStack(command.get());
             }
 
+            const auto memorySize = command->memorySize();
             m_undoStack.push_back(std::move(command));
+            m_undoMemorySizes.push_back(memorySize);
+            m_undoMemorySize += memorySize;
+
+            trimUndoStack();
             return true;
         }
 
@@ -396,10 +436,35 @@ namespace TrenchBroom {
             assert(!m_undoStack.empty());
 
             auto lastCommand = kdl::vec_pop_back(m_undoStack);
+            m_undoMemorySize -= kdl::vec_pop_back(m_undoMemorySizes);
             popFromRepeatStack(lastCommand.get());
             return lastCommand;
         }
 
+        void CommandProcessor::trimUndoStack() {
+            assert(m_transactionStack.empty());
+
+            if (m_undoMemoryBudget == std::numeric_limits<size_t>::max()) {
+                return;
+            }
+
+            // remove the oldest commands until the remaining ones fit the budget, but keep the topmost command
+            size_t removeCount = 0u;
+            while (m_undoMemorySize > m_undoMemoryBudget && removeCount + 1u < m_undoStack.size()) {
+                m_undoMemorySize -= m_undoMemorySizes[removeCount];
+                ++removeCount;
+            }
+
+            if (removeCount > 0u) {
+                const auto firstKept = std::next(std::begin(m_undoStack), static_cast<std::ptrdiff_t>(removeCount));
+                for (auto it = std::begin(m_undoStack); it != firstKept; ++it) {
+                    kdl::vec_erase(m_repeatStack, it->get());
+                }
+                m_undoStack.erase(std::begin(m_undoStack), firstKept);
+                m_undoMemorySizes.erase(std::begin(m_undoMemorySizes), std::next(std::begin(m_undoMemorySizes), static_cast<std::ptrdiff_t>(removeCount)));
+            }
+        }
+
         bool CommandProcessor::collatable(const bool collate, const std::chrono::system_clock::time_point timestamp) const {
             return collate && !m_undoStack.empty() && timestamp - m_lastCommandTimestamp <= m_collationInterval;
         }
@@ -50,6 +50,10 @@ namespace TrenchBroom {
          *
          * The command processor supports nested transactions. Each transaction can be committed or rolled back
          * individually. Committing a nested transaction adds it as a command to the containing transaction.
+         *
+         * The memory held by the commands on the undo stack can be limited by an undo memory budget. If the commands
+         * exceed the budget, the oldest commands are removed from the undo stack until they fit. The budget is enforced
+         * using the sizes of the commands as they were when they were pushed, see m_undoMemorySizes.
          */
         class CommandProcessor {
         private:
@@ -62,12 +66,31 @@ namespace TrenchBroom {
              * Limits the time after which to succeeding commands can be collated.
              */
             std::chrono::milliseconds m_collationInterval;
+            /**
+             * The maximum number of bytes of memory that the commands on the undo stack may hold, see
+             * UndoableCommand::memorySize. The topmost command is always kept, even if it exceeds the budget.
+             */
+            size_t m_undoMemoryBudget;
 
             /**
              * Holds the commands that were executed so far, with the most recently executed command at the
              * end of the vector.
              */
             std::vector<std::unique_ptr<UndoableCommand>> m_undoStack;
+            /**
+             * Holds the memory size of each command on the undo stack, see UndoableCommand::memorySize. The size of a
+             * command is determined when it is pushed and updated when another command is collated into it.
+             *
+             * These sizes are an approximation. A snapshot that shares brush geometry with the document does not count
+             * the geometry, but once the document replaces that geometry, the snapshot becomes its only owner and holds
+             * more memory than was recorded. The sizes are not recomputed because that would take time proportional to
+             * the size of the undo stack on every command, so the undo stack may exceed its budget somewhat.
+             */
+            std::vector<size_t> m_undoMemorySizes;
+            /**
+             * The sum of m_undoMemorySizes.
+             */
+            size_t m_undoMemorySize;
 
             /**
              * Holds the commands that were undone, with the most recently undone command at the beginning of
@@ -167,6 +190,21 @@ namespace TrenchBroom {
              */
             const std::string& redoCommandName() const;
 
+            /**
+             * Returns the maximum number of bytes of memory that the commands on the undo stack may hold.
+             */
+            size_t undoMemoryBudget() const;
+            /**
+             * Sets the maximum number of bytes of memory that the commands on the undo stack may hold and removes the
+             * oldest commands from the undo stack if they exceed the given budget.
+             *
+             * @param undoMemoryBudget the budget in bytes
+             */
+            void setUndoMemoryBudget(size_t undoMemoryBudget);
+            /**
+             * Returns an estimate of the number of bytes of memory held by the commands on the undo stack.
+             */
+            size_t undoMemorySize() const;
             /**
              * Starts a new transaction. If a transaction is currently executing, then the newly started transaction
              * becomes a nested transaction and will be added as a command to its parent transaction upon commit.
@@ -393,6 +431,13 @@ namespace TrenchBroom {
              * @return the topmost command of the undo stack
              */
             std::unique_ptr<UndoableCommand> popFromUndoStack();
+            /**
+             * Removes the oldest commands from the undo stack until the remaining commands fit the undo memory budget.
+             * The topmost command is never removed.
+             *
+             * Precondition: no transaction is currently executing
+             */
+            void trimUndoStack();
 
             bool collatable(bool collate, std::chrono::system_clock::time_point timestamp) const;
 
@@ -80,5 +80,9 @@ namespace TrenchBroom {
         bool CopyTexCoordSystemFromFaceCommand::doCollateWith(UndoableCommand*) {
             return false;
         }
+
+        size_t CopyTexCoordSystemFromFaceCommand::doGetMemorySize() const {
+            return m_snapshot != nullptr ? m_snapshot->memorySize() : 0u;
+        }
     }
 }
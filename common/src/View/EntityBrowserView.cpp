@@ -45,7 +45,6 @@
 
 #include <kdl/overload.h>
 #include <kdl/skip_iterator.h>
-#include <kdl/string_compare.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/forward.h>
@@ -86,9 +85,11 @@ namespace TrenchBroom {
             m_rotation = vRotation * hRotation;
 
             m_entityDefinitionManager.usageCountDidChangeNotifier.addObserver(this, &EntityBrowserView::usageCountDidChange);
+            m_entityModelManager.modelsWereLoadedNotifier.addObserver(this, &EntityBrowserView::modelsWereLoaded);
         }
 
         EntityBrowserView::~EntityBrowserView() {
+            m_entityModelManager.modelsWereLoadedNotifier.removeObserver(this, &EntityBrowserView::modelsWereLoaded);
             clear();
         }
 
@@ -133,6 +134,12 @@ namespace TrenchBroom {
             update();
         }
 
+        void EntityBrowserView::modelsWereLoaded(const std::vector<IO::Path>& /* paths */) {
+            // the cells of entities whose models were loaded must be resized
+            invalidate();
+            update();
+        }
+
         void EntityBrowserView::doInitLayout(Layout& layout) {
             layout.setOuterMargin(5.0f);
             layout.setGroupMargin(5.0f);
@@ -149,6 +156,13 @@ namespace TrenchBroom {
             assert(fontSize > 0);
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            m_labelCache.reset(font, layout.maxCellWidth(), 5);
+
+            updateDefinitionIndex();
+            m_matchingDefinitions.assign(m_definitions.size(), false);
+            for (const size_t item : m_definitionIndex.match(m_filterText)) {
+                m_matchingDefinitions[item] = true;
+            }
 
             if (m_group) {
                 for (const auto& group : m_entityDefinitionManager.groups()) {
@@ -183,13 +197,43 @@ namespace TrenchBroom {
             return prefix + name;
         }
 
-        void EntityBrowserView::addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Renderer::FontDescriptor& font) {
-            if ((!m_hideUnused || definition->usageCount() > 0) &&
-                (m_filterText.empty() || kdl::ci::str_contains(definition->name(), m_filterText))) {
+        /**
+         * Rebuilds the definition index if the entity definitions have changed.
+         */
+        void EntityBrowserView::updateDefinitionIndex() {
+            const auto& definitions = m_entityDefinitionManager.definitions();
+
+            // a definition may have been reloaded at the address of a definition with a different name
+            bool unchanged = definitions.size() == m_definitions.size();
+            for (size_t i = 0u; i < definitions.size() && unchanged; ++i) {
+                unchanged = definitions[i] == m_definitions[i] && definitions[i]->name() == m_definitionNames[i];
+            }
+            if (unchanged) {
+                return;
+            }
 
-                const auto maxCellWidth = layout.maxCellWidth();
-                const auto actualFont = fontManager().selectFontSize(font, definition->name(), maxCellWidth, 5);
-                const auto actualSize = fontManager().font(actualFont).measure(definition->name());
+            m_definitions.assign(std::begin(definitions), std::end(definitions));
+            m_definitionNames.clear();
+            m_definitionItems.clear();
+            for (size_t i = 0u; i < m_definitions.size(); ++i) {
+                m_definitionNames.push_back(m_definitions[i]->name());
+                m_definitionItems.emplace(m_definitions[i], i);
+            }
+            m_definitionIndex = CellItemIndex(m_definitionNames);
+        }
+
+        bool EntityBrowserView::isVisible(const Assets::PointEntityDefinition* definition) const {
+            if (m_hideUnused && definition->usageCount() == 0) {
+                return false;
+            }
+
+            const auto it = m_definitionItems.find(definition);
+            return it != std::end(m_definitionItems) && m_matchingDefinitions[it->second];
+        }
+
+        void EntityBrowserView::addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Renderer::FontDescriptor& font) {
+            if (isVisible(definition)) {
+                const auto& label = m_labelCache.label(fontManager(), definition->name());
                 const auto spec = Assets::safeGetModelSpecification(m_logger, definition->name(), [&]() {
                     return definition->defaultModel();
                 });
@@ -212,10 +256,10 @@ namespace TrenchBroom {
                 }
 
                 const auto boundsSize = rotatedBounds.size();
-                layout.addItem(QVariant::fromValue(std::make_shared<EntityCellData>(definition, modelRenderer, actualFont, rotatedBounds)),
+                layout.addItem(QVariant::fromValue(std::make_shared<EntityCellData>(definition, modelRenderer, label.font, rotatedBounds)),
                                boundsSize.y(),
                                boundsSize.z(),
-                               actualSize.x(),
+                               label.size.x(),
                                static_cast<float>(font.size()) + 2.0f);
             }
         }
@@ -235,6 +279,12 @@ namespace TrenchBroom {
             renderBounds(layout, y, height);
             renderModels(layout, y, height, transformation);
             renderNames(layout, y, height, projection);
+
+            // models that were queued while laying out the cells are loaded in the background
+            m_entityModelManager.loadPendingModels();
+            if (m_entityModelManager.hasPendingModels()) {
+                update();
+            }
         }
 
         bool EntityBrowserView::doShouldRenderFocusIndicator() const {
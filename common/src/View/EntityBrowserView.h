@@ -22,6 +22,8 @@
 
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
+#include "View/CellItemIndex.h"
+#include "View/CellLabelCache.h"
 #include "View/CellView.h"
 
 #include <vecmath/forward.h>
@@ -29,18 +31,24 @@
 #include <vecmath/bbox.h>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace TrenchBroom {
     class Logger;
 
     namespace Assets {
+        class EntityDefinition;
         class EntityDefinitionManager;
         enum class EntityDefinitionSortOrder;
         class EntityModelManager;
         class PointEntityDefinition;
     }
 
+    namespace IO {
+        class Path;
+    }
+
     namespace Renderer {
         class FontDescriptor;
         class TexturedRenderer;
@@ -79,6 +87,13 @@ namespace TrenchBroom {
             bool m_hideUnused;
             Assets::EntityDefinitionSortOrder m_sortOrder;
             std::string m_filterText;
+
+            std::vector<const Assets::EntityDefinition*> m_definitions;
+            std::vector<std::string> m_definitionNames;
+            std::unordered_map<const Assets::EntityDefinition*, size_t> m_definitionItems;
+            CellItemIndex m_definitionIndex;
+            std::vector<bool> m_matchingDefinitions;
+            CellLabelCache m_labelCache;
         public:
             EntityBrowserView(QScrollBar* scrollBar,
                               GLContextManager& contextManager,
@@ -93,6 +108,7 @@ namespace TrenchBroom {
             void setFilterText(const std::string& filterText);
         private:
             void usageCountDidChange();
+            void modelsWereLoaded(const std::vector<IO::Path>& paths);
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
@@ -100,6 +116,8 @@ namespace TrenchBroom {
             bool dndEnabled() override;
             QString dndData(const Cell& cell) override;
 
+            void updateDefinitionIndex();
+            bool isVisible(const Assets::PointEntityDefinition* definition) const;
             void addEntityToLayout(Layout& layout, const Assets::PointEntityDefinition* definition, const Renderer::FontDescriptor& font);
 
             void doClear() override;
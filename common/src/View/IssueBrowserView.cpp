@@ -20,9 +20,11 @@
 #include "IssueBrowserView.h"
 
 #include "Ensure.h"
-#include "Model/CollectMatchingIssuesVisitor.h"
+#include "Model/CollectNodesVisitor.h"
 #include "Model/Issue.h"
+#include "Model/IssueGenerator.h"
 #include "Model/IssueQuickFix.h"
+#include "Model/IssueValidator.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocument.h"
 
@@ -30,6 +32,7 @@
 #include <kdl/vector_utils.h>
 #include <kdl/vector_set.h>
 
+#include <chrono>
 #include <vector>
 
 #include <QHBoxLayout>
@@ -40,6 +43,16 @@
 
 namespace TrenchBroom {
     namespace View {
+        /**
+         * The number of nodes whose issues are validated before the browser shows them.
+         */
+        static const size_t ValidationBatchSize = 4096u;
+
+        /**
+         * The generator timings are logged if validating took at least this long.
+         */
+        static constexpr auto SlowValidationTime = std::chrono::milliseconds(100);
+
         IssueBrowserView::IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent) :
         QWidget(parent),
         m_document(document),
@@ -50,6 +63,8 @@ namespace TrenchBroom {
             bindEvents();
         }
 
+        IssueBrowserView::~IssueBrowserView() = default;
+
         void IssueBrowserView::createGui() {
             m_tableModel = new IssueBrowserModel(this);
 
@@ -129,17 +144,84 @@ namespace TrenchBroom {
             document->select(nodes);
         }
 
+        /**
+         * Shows the issues of the nodes whose issues are valid right away, and starts validating the remaining nodes.
+         * Their issues are added batch by batch, see validateNextBatch().
+         */
         void IssueBrowserView::updateIssues() {
             auto document = kdl::mem_lock(m_document);
             Model::WorldNode* world = document->world();
             if (world != nullptr) {
                 const std::vector<Model::IssueGenerator*>& issueGenerators = world->registeredIssueGenerators();
-                Model::CollectMatchingIssuesVisitor<IssueVisible> visitor(issueGenerators, IssueVisible(m_hiddenGenerators, m_showHiddenIssues));
-                world->acceptAndRecurse(visitor);
 
-                std::vector<Model::Issue*> issues = visitor.issues();
+                Model::CollectNodesVisitor collect;
+                world->acceptAndRecurse(collect);
+
+                const IssueVisible visible(m_hiddenGenerators, m_showHiddenIssues);
+                std::vector<Model::Issue*> issues;
+                std::vector<Model::Node*> invalidNodes;
+                for (Model::Node* node : collect.nodes()) {
+                    if (node->issuesValid()) {
+                        for (Model::Issue* issue : node->issues(issueGenerators)) {
+                            if (visible(issue)) {
+                                issues.push_back(issue);
+                            }
+                        }
+                    } else {
+                        invalidNodes.push_back(node);
+                    }
+                }
+
                 kdl::vec_sort(issues, IssueCmp());
                 m_tableModel->setIssues(std::move(issues));
+
+                m_validator = std::make_unique<Model::IssueValidator>(issueGenerators);
+                m_validator->start(invalidNodes);
+                validateNextBatch();
+            }
+        }
+
+        /**
+         * Validates the next batch of nodes and adds their visible issues to the table. If nodes remain, the next batch
+         * is validated after pending events have been processed, so that the browser stays responsive.
+         *
+         * Newly generated issues have larger sequence IDs than the issues in the table, so the table stays sorted if
+         * they are inserted at the top.
+         */
+        void IssueBrowserView::validateNextBatch() {
+            if (m_validator == nullptr || m_validator->finished()) {
+                return;
+            }
+
+            const IssueVisible visible(m_hiddenGenerators, m_showHiddenIssues);
+            std::vector<Model::Issue*> issues = kdl::vec_filter(m_validator->validateNext(ValidationBatchSize), visible);
+            kdl::vec_sort(issues, IssueCmp());
+            m_tableModel->prependIssues(issues);
+
+            if (m_validator->finished()) {
+                logValidationStats();
+            } else {
+                QMetaObject::invokeMethod(this, "validateNextBatch", Qt::QueuedConnection);
+            }
+        }
+
+        void IssueBrowserView::logValidationStats() const {
+            auto stats = m_validator->stats();
+
+            auto total = std::chrono::nanoseconds(0);
+            for (const auto& generatorStats : stats) {
+                total += generatorStats.time;
+            }
+            if (total < SlowValidationTime) {
+                return;
+            }
+
+            kdl::vec_sort(stats, [](const auto& lhs, const auto& rhs) { return lhs.time > rhs.time; });
+
+            auto document = kdl::mem_lock(m_document);
+            for (const auto& generatorStats : stats) {
+                const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(generatorStats.time);
+                document->debug() << "Issue generator '" << generatorStats.generator->description() << "' took " << ms.count() << "ms and found " << generatorStats.issueCount << " issues";
             }
         }
 
@@ -261,6 +343,11 @@ namespace TrenchBroom {
         void IssueBrowserView::invalidate() {
             m_valid = false;
 
+            // the pending nodes might be about to be deleted
+            if (m_validator != nullptr) {
+                m_validator->cancel();
+            }
+
             QMetaObject::invokeMethod(this, "validate", Qt::QueuedConnection);
         }
 
@@ -284,6 +371,16 @@ namespace TrenchBroom {
             endResetModel();
         }
 
+        void IssueBrowserModel::prependIssues(const std::vector<Model::Issue*>& issues) {
+            if (issues.empty()) {
+                return;
+            }
+
+            beginInsertRows(QModelIndex(), 0, static_cast<int>(issues.size()) - 1);
+            m_issues.insert(std::begin(m_issues), std::begin(issues), std::end(issues));
+            endInsertRows();
+        }
+
         const std::vector<Model::Issue*>& IssueBrowserModel::issues() {
             return m_issues;
         }
@@ -35,6 +35,7 @@ namespace TrenchBroom {
     namespace Model {
         class Issue;
         class IssueQuickFix;
+        class IssueValidator;
     }
 
     namespace View {
@@ -50,11 +51,13 @@ namespace TrenchBroom {
             bool m_showHiddenIssues;
 
             bool m_valid;
+            std::unique_ptr<Model::IssueValidator> m_validator;
 
             QTableView* m_tableView;
             IssueBrowserModel* m_tableModel;
         public:
             explicit IssueBrowserView(std::weak_ptr<MapDocument> document, QWidget* parent = nullptr);
+            ~IssueBrowserView() override;
         private:
             void createGui();
         public:
@@ -68,6 +71,7 @@ namespace TrenchBroom {
             class IssueCmp;
 
             void updateIssues();
+            void logValidationStats() const;
 
             std::vector<Model::Issue*> collectIssues(const QList<QModelIndex>& indices) const;
             std::vector<Model::IssueQuickFix*> collectQuickFixes(const QList<QModelIndex>& indices) const;
@@ -88,11 +92,13 @@ namespace TrenchBroom {
             void invalidate();
         public slots:
             void validate();
+            void validateNextBatch();
         };
 
         /**
          * Trivial QAbstractTableModel subclass, when the issues list changes,
          * it just refreshes the entire list with beginResetModel()/endResetModel().
+         * Issues that are validated in the background are inserted at the top.
          */
         class IssueBrowserModel : public QAbstractTableModel {
             Q_OBJECT
@@ -102,6 +108,10 @@ namespace TrenchBroom {
             explicit IssueBrowserModel(QObject* parent);
 
             void setIssues(std::vector<Model::Issue*> issues);
+            /**
+             * Inserts the given issues before the current issues.
+             */
+            void prependIssues(const std::vector<Model::Issue*>& issues);
             const std::vector<Model::Issue*>& issues();
         public: // QAbstractTableModel overrides
             int rowCount(const QModelIndex& parent) const override;
@@ -88,6 +88,34 @@ namespace TrenchBroom {
             renderService.renderFilledPolygon(polygon);
         }
 
+        std::vector<vm::plane3> Lasso::boundingPlanes() const {
+            const auto box = this->box();
+            const auto [invertible, inverseTransform] = invert(m_transform);
+            assert(invertible); unused(invertible);
+
+            const std::vector<vm::vec3> corners = {
+                inverseTransform * vm::vec3(box.min.x(), box.min.y(), 0.0),
+                inverseTransform * vm::vec3(box.min.x(), box.max.y(), 0.0),
+                inverseTransform * vm::vec3(box.max.x(), box.max.y(), 0.0),
+                inverseTransform * vm::vec3(box.max.x(), box.min.y(), 0.0)
+            };
+            const auto center = inverseTransform * vm::vec3(box.center().x(), box.center().y(), 0.0);
+
+            std::vector<vm::plane3> result;
+            for (size_t i = 0u; i < corners.size(); ++i) {
+                const auto& first = corners[i];
+                const auto& second = corners[(i + 1u) % corners.size()];
+                const auto direction = vm::vec3(m_camera.pickRay(vm::vec3f(first)).direction);
+
+                const auto [valid, plane] = vm::from_points(first, second, first + direction);
+                if (!valid) {
+                    return {};
+                }
+                result.push_back(plane.point_status(center) == vm::plane_status::above ? plane.flip() : plane);
+            }
+            return result;
+        }
+
         vm::plane3 Lasso::plane() const {
             return vm::plane3(vm::vec3(m_camera.defaultPoint(static_cast<float>(m_distance))), vm::vec3(m_camera.direction()));
         }
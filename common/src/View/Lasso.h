@@ -25,6 +25,8 @@
 #include <vecmath/plane.h>
 #include <vecmath/bbox.h>
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace Renderer {
         class Camera;
@@ -60,6 +62,15 @@ namespace TrenchBroom {
             bool selects(const H& h) const {
                 return selects(h, plane(), box());
             }
+
+            /**
+             * Returns the planes bounding the volume swept by this lasso's rectangle along the pick rays of the camera.
+             * Every point selected by this lasso lies within this volume. The normals of the planes point out of the
+             * volume. If the rectangle is degenerate, no planes are returned.
+             *
+             * @return the bounding planes
+             */
+            std::vector<vm::plane3> boundingPlanes() const;
         private:
             bool selects(const vm::vec3& point, const vm::plane3& plane, const vm::bbox2& box) const;
             bool selects(const vm::segment3& edge, const vm::plane3& plane, const vm::bbox2& box) const;
@@ -19,6 +19,7 @@
 
 #include "View/MapDocument.h"
 
+#include "Exceptions.h"
 #include "PreferenceManager.h"
 #include "Preferences.h"
 #include "Assets/AssetUtils.h"
@@ -41,14 +42,12 @@
 #include "Model/BrushGeometry.h"
 #include "Model/ChangeBrushFaceAttributesRequest.h"
 #include "Model/CollectAttributableNodesVisitor.h"
-#include "Model/CollectContainedNodesVisitor.h"
 #include "Model/CollectMatchingBrushFacesVisitor.h"
 #include "Model/CollectNodesVisitor.h"
 #include "Model/CollectSelectableNodesVisitor.h"
 #include "Model/CollectSelectableBrushFacesVisitor.h"
 #include "Model/CollectSelectableNodesWithFilePositionVisitor.h"
 #include "Model/CollectSelectedNodesVisitor.h"
-#include "Model/CollectTouchingNodesVisitor.h"
 #include "Model/ComputeNodeBoundsVisitor.h"
 #include "Model/EditorContext.h"
 #include "Model/EmptyAttributeNameIssueGenerator.h"
@@ -126,6 +125,7 @@
 #include <kdl/collection_utils.h>
 #include <kdl/map_utils.h>
 #include <kdl/memory_utils.h>
+#include <kdl/vector_set.h>
 #include <kdl/vector_utils.h>
 
 #include <vecmath/polygon.h>
@@ -627,10 +627,7 @@ namespace TrenchBroom {
         void MapDocument::selectTouching(const bool del) {
             const std::vector<Model::BrushNode*>& brushes = m_selectedNodes.brushes();
 
-            Model::CollectTouchingNodesVisitor<std::vector<Model::BrushNode*>::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
-
-            const std::vector<Model::Node*> nodes = visitor.nodes();
+            const std::vector<Model::Node*> nodes = Model::collectTouchingNodes(*m_world, brushes, editorContext());
 
             Transaction transaction(this, "Select Touching");
             if (del)
@@ -643,10 +640,7 @@ namespace TrenchBroom {
         void MapDocument::selectInside(const bool del) {
             const std::vector<Model::BrushNode*>& brushes = m_selectedNodes.brushes();
 
-            Model::CollectContainedNodesVisitor<std::vector<Model::BrushNode*>::const_iterator> visitor(std::begin(brushes), std::end(brushes), editorContext());
-            m_world->acceptAndRecurse(visitor);
-
-            const std::vector<Model::Node*> nodes = visitor.nodes();
+            const std::vector<Model::Node*> nodes = Model::collectContainedNodes(*m_world, brushes, editorContext());
 
             Transaction transaction(this, "Select Inside");
             if (del)
@@ -1559,10 +1553,12 @@ namespace TrenchBroom {
             std::map<Model::Node*, std::vector<Model::Node*>> toAdd;
             std::vector<Model::Node*> toRemove(std::begin(subtrahendNodes), std::end(subtrahendNodes));
             const std::vector<const Model::Brush*> subtrahends = kdl::vec_transform(subtrahendNodes, [](const auto* subtrahendNode) { return &subtrahendNode->brush(); });
-            
-            for (Model::BrushNode* minuendNode : minuendNodes) {
-                const Model::Brush& minuend = minuendNode->brush();
-                std::vector<Model::Brush> resultBrushes = minuend.subtract(*m_world, m_worldBounds, currentTextureName(), subtrahends);
+            const std::vector<const Model::Brush*> minuends = kdl::vec_transform(minuendNodes, [](const auto* minuendNode) { return &minuendNode->brush(); });
+
+            std::vector<std::vector<Model::Brush>> results = Model::Brush::subtractAll(*m_world, m_worldBounds, currentTextureName(), minuends, subtrahends);
+            for (size_t i = 0u; i < minuendNodes.size(); ++i) {
+                Model::BrushNode* minuendNode = minuendNodes[i];
+                std::vector<Model::Brush>& resultBrushes = results[i];
                 if (!resultBrushes.empty()) {
                     const std::vector<Model::BrushNode*> resultNodes = kdl::vec_transform(std::move(resultBrushes), [&](auto brush) { return m_world->createBrush(std::move(brush)); });
                     kdl::vec_append(toAdd[minuendNode->parent()], resultNodes);
@@ -1909,6 +1905,11 @@ namespace TrenchBroom {
 
         void MapDocument::commitPendingAssets() {
             m_textureManager->commitChanges();
+            m_entityModelManager->loadPendingModels();
+        }
+
+        bool MapDocument::hasPendingAssets() const {
+            return m_textureManager->hasPendingChanges() || m_entityModelManager->hasPendingModels();
         }
 
         void MapDocument::pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const {
@@ -2240,6 +2241,49 @@ namespace TrenchBroom {
             Model::Node::acceptAndRecurse(std::begin(nodes), std::end(nodes), visitor);
         }
 
+        class MapDocument::CollectEntitiesWithModels : public Model::NodeVisitor {
+        private:
+            Logger& m_logger;
+            kdl::vector_set<IO::Path> m_modelPaths;
+            std::vector<Model::Node*> m_nodes;
+        public:
+            CollectEntitiesWithModels(Logger& logger, const std::vector<IO::Path>& modelPaths) :
+            m_logger(logger),
+            m_modelPaths(std::begin(modelPaths), std::end(modelPaths)) {}
+
+            const std::vector<Model::Node*>& nodes() const {
+                return m_nodes;
+            }
+        private:
+            void doVisit(Model::WorldNode*) override         {}
+            void doVisit(Model::LayerNode*) override         {}
+            void doVisit(Model::GroupNode*) override         {}
+            void doVisit(Model::EntityNode* entity) override {
+                const auto modelSpec = Assets::safeGetModelSpecification(m_logger, entity->classname(), [&]() {
+                    return entity->modelSpecification();
+                });
+                if (m_modelPaths.count(modelSpec.path) > 0u) {
+                    m_nodes.push_back(entity);
+                }
+            }
+            void doVisit(Model::BrushNode*) override         {}
+        };
+
+        void MapDocument::entityModelsWereLoaded(const std::vector<IO::Path>& paths) {
+            if (m_world == nullptr) {
+                return;
+            }
+
+            CollectEntitiesWithModels visitor(logger(), paths);
+            m_world->acceptAndRecurse(visitor);
+
+            const auto& nodes = visitor.nodes();
+            if (!nodes.empty()) {
+                Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyNodes(nodesWillChangeNotifier, nodesDidChangeNotifier, nodes);
+                setEntityModels(nodes);
+            }
+        }
+
         std::vector<IO::Path> MapDocument::externalSearchPaths() const {
             std::vector<IO::Path> searchPaths;
             if (!m_path.isEmpty() && m_path.isAbsolute()) {
@@ -2462,6 +2506,7 @@ namespace TrenchBroom {
             brushFacesDidChangeNotifier.addObserver(this, &MapDocument::updateFaceTags);
             modsDidChangeNotifier.addObserver(this, &MapDocument::updateAllFaceTags);
             textureCollectionsDidChangeNotifier.addObserver(this, &MapDocument::updateAllFaceTags);
+            m_entityModelManager->modelsWereLoadedNotifier.addObserver(this, &MapDocument::entityModelsWereLoaded);
         }
 
         void MapDocument::unbindObservers() {
@@ -2481,15 +2526,17 @@ namespace TrenchBroom {
             brushFacesDidChangeNotifier.removeObserver(this, &MapDocument::updateFaceTags);
             modsDidChangeNotifier.removeObserver(this, &MapDocument::updateAllFaceTags);
             textureCollectionsDidChangeNotifier.removeObserver(this, &MapDocument::updateAllFaceTags);
+            m_entityModelManager->modelsWereLoadedNotifier.removeObserver(this, &MapDocument::entityModelsWereLoaded);
         }
 
         void MapDocument::preferenceDidChange(const IO::Path& path) {
             if (isGamePathPreference(path)) {
                 const Model::GameFactory& gameFactory = Model::GameFactory::instance();
                 const IO::Path newGamePath = gameFactory.gamePath(m_game->gameName());
-                m_game->setGamePath(newGamePath, logger());
 
+                // models may still be loading from the old game file system
                 clearEntityModels();
+                m_game->setGamePath(newGamePath, logger());
                 setEntityModels();
 
                 reloadTextures();
@@ -464,6 +464,7 @@ namespace TrenchBroom {
             virtual std::unique_ptr<CommandResult> doExecuteAndStore(std::unique_ptr<UndoableCommand>&& command) = 0;
         public: // asset state management
             void commitPendingAssets();
+            bool hasPendingAssets() const;
         public: // picking
             void pick(const vm::ray3& pickRay, Model::PickResult& pickResult) const;
             std::vector<Model::Node*> findNodesContaining(const vm::vec3& point) const;
@@ -523,6 +524,9 @@ namespace TrenchBroom {
             void setEntityModels(const std::vector<Model::Node*>& nodes);
             void unsetEntityModels();
             void unsetEntityModels(const std::vector<Model::Node*>& nodes);
+
+            class CollectEntitiesWithModels;
+            void entityModelsWereLoaded(const std::vector<IO::Path>& paths);
         protected: // search paths and mods
             std::vector<IO::Path> externalSearchPaths() const;
             void updateGameSearchPaths();
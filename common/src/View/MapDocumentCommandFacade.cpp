@@ -36,6 +36,7 @@
 #include "Model/GroupNode.h"
 #include "Model/Issue.h"
 #include "Model/ModelUtils.h"
+#include "Model/Polyhedron.h"
 #include "Model/Snapshot.h"
 #include "Model/TransformObjectVisitor.h"
 #include "Model/WorldNode.h"
@@ -53,8 +54,10 @@
 #include <vecmath/segment.h>
 #include <vecmath/polygon.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -67,6 +70,7 @@ namespace TrenchBroom {
 
         MapDocumentCommandFacade::MapDocumentCommandFacade() :
         m_commandProcessor(std::make_unique<CommandProcessor>(this)) {
+            m_commandProcessor->setUndoMemoryBudget(static_cast<size_t>(std::max(pref(Preferences::UndoMemoryBudget), 1)) * 1024u * 1024u);
             bindObservers();
         }
 
@@ -238,6 +242,21 @@ namespace TrenchBroom {
             const std::vector<Model::Node*> parents = collectParents(nodes);
             Notifier<const std::vector<Model::Node*>&>::NotifyBeforeAndAfter notifyParents(nodesWillChangeNotifier, nodesDidChangeNotifier, parents);
 
+            // Inserting many nodes into the node tree one at a time yields a badly balanced tree, so when adding many
+            // nodes at once (e.g. when pasting), we build a subtree from the added nodes and insert that instead.
+            static const size_t BulkInsertThreshold = 1024u;
+            size_t addedNodeCount = 0u;
+            for (const auto& entry : nodes) {
+                for (const Model::Node* child : entry.second) {
+                    addedNodeCount += child->descendantCount() + 1u;
+                }
+            }
+
+            std::optional<Model::WorldNode::BulkNodeTreeInsertion> bulkInsertion;
+            if (addedNodeCount >= BulkInsertThreshold) {
+                bulkInsertion.emplace(*m_world);
+            }
+
             std::vector<Model::Node*> addedNodes;
             for (const auto& entry : nodes) {
                 Model::Node* parent = entry.first;
@@ -246,6 +265,10 @@ namespace TrenchBroom {
                 kdl::vec_append(addedNodes, children);
             }
 
+            if (bulkInsertion) {
+                bulkInsertion->insertNodes(addedNodes);
+            }
+
             setEntityDefinitions(addedNodes);
             setEntityModels(addedNodes);
             setTextures(addedNodes);
@@ -779,7 +802,7 @@ namespace TrenchBroom {
             return true;
         }
 
-        std::vector<vm::vec3> MapDocumentCommandFacade::performMoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices, const vm::vec3& delta) {
+        std::vector<vm::vec3> MapDocumentCommandFacade::performMoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries) {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
@@ -791,7 +814,8 @@ namespace TrenchBroom {
                 Model::BrushNode* brushNode = entry.first;
                 Model::Brush brush = brushNode->brush();
                 const std::vector<vm::vec3>& oldPositions = entry.second;
-                const std::vector<vm::vec3> newPositions = brush.moveVertices(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock));
+                const Model::BrushGeometry& newGeometry = *newGeometries.at(brushNode);
+                const std::vector<vm::vec3> newPositions = brush.moveVertices(m_worldBounds, oldPositions, delta, newGeometry, pref(Preferences::UVLock));
                 kdl::vec_append(newVertexPositions, newPositions);
                 brushNode->setBrush(std::move(brush));
             }
@@ -802,7 +826,7 @@ namespace TrenchBroom {
             return newVertexPositions;
         }
 
-        std::vector<vm::segment3> MapDocumentCommandFacade::performMoveEdges(const std::map<Model::BrushNode*, std::vector<vm::segment3>>& edges, const vm::vec3& delta) {
+        std::vector<vm::segment3> MapDocumentCommandFacade::performMoveEdges(const std::map<Model::BrushNode*, std::vector<vm::segment3>>& edges, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries) {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
@@ -814,7 +838,8 @@ namespace TrenchBroom {
                 Model::BrushNode* brushNode = entry.first;
                 Model::Brush brush = brushNode->brush();
                 const std::vector<vm::segment3>& oldPositions = entry.second;
-                const std::vector<vm::segment3> newPositions = brush.moveEdges(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock));
+                const Model::BrushGeometry& newGeometry = *newGeometries.at(brushNode);
+                const std::vector<vm::segment3> newPositions = brush.moveEdges(m_worldBounds, oldPositions, delta, newGeometry, pref(Preferences::UVLock));
                 brushNode->setBrush(brush);
                 kdl::vec_append(newEdgePositions, newPositions);
             }
@@ -825,7 +850,7 @@ namespace TrenchBroom {
             return newEdgePositions;
         }
 
-        std::vector<vm::polygon3> MapDocumentCommandFacade::performMoveFaces(const std::map<Model::BrushNode*, std::vector<vm::polygon3>>& faces, const vm::vec3& delta) {
+        std::vector<vm::polygon3> MapDocumentCommandFacade::performMoveFaces(const std::map<Model::BrushNode*, std::vector<vm::polygon3>>& faces, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries) {
             const std::vector<Model::Node*>& nodes = m_selectedNodes.nodes();
             const std::vector<Model::Node*> parents = collectParents(nodes);
 
@@ -837,7 +862,8 @@ namespace TrenchBroom {
                 Model::BrushNode* brushNode = entry.first;
                 Model::Brush brush = brushNode->brush();
                 const std::vector<vm::polygon3>& oldPositions = entry.second;
-                const std::vector<vm::polygon3> newPositions = brush.moveFaces(m_worldBounds, oldPositions, delta, pref(Preferences::UVLock));
+                const Model::BrushGeometry& newGeometry = *newGeometries.at(brushNode);
+                const std::vector<vm::polygon3> newPositions = brush.moveFaces(m_worldBounds, oldPositions, delta, newGeometry, pref(Preferences::UVLock));
                 brushNode->setBrush(std::move(brush));
                 kdl::vec_append(newFacePositions, newPositions);
             }
@@ -21,6 +21,7 @@
 #define TrenchBroom_MapDocumentCommandFacade
 
 #include "FloatType.h"
+#include "Model/BrushGeometry.h"
 #include "View/MapDocument.h"
 
 #include <vecmath/forward.h>
@@ -118,9 +119,10 @@ namespace TrenchBroom {
         public: // vertices
             bool performFindPlanePoints();
             bool performSnapVertices(FloatType snapTo);
-            std::vector<vm::vec3> performMoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices, const vm::vec3& delta);
-            std::vector<vm::segment3> performMoveEdges(const std::map<Model::BrushNode*, std::vector<vm::segment3>>& edges, const vm::vec3& delta);
-            std::vector<vm::polygon3> performMoveFaces(const std::map<Model::BrushNode*, std::vector<vm::polygon3>>& faces, const vm::vec3& delta);
+            // the move functions take the geometry of each brush after the move, as computed when checking the move
+            std::vector<vm::vec3> performMoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries);
+            std::vector<vm::segment3> performMoveEdges(const std::map<Model::BrushNode*, std::vector<vm::segment3>>& edges, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries);
+            std::vector<vm::polygon3> performMoveFaces(const std::map<Model::BrushNode*, std::vector<vm::polygon3>>& faces, const vm::vec3& delta, const std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>& newGeometries);
             void performAddVertices(const std::map<vm::vec3, std::vector<Model::BrushNode*>>& vertices);
             void performRemoveVertices(const std::map<Model::BrushNode*, std::vector<vm::vec3>>& vertices);
         public: // snapshots and restoration
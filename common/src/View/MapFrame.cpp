@@ -25,6 +25,7 @@
 #include "Preferences.h"
 #include "PreferenceManager.h"
 #include "TrenchBroomApp.h"
+#include "Assets/EntityModelManager.h"
 #include "IO/PathQt.h"
 #include "Model/AttributableNode.h"
 #include "Model/BrushNode.h"
@@ -141,6 +142,11 @@ namespace TrenchBroom {
             m_document->setParentLogger(m_console);
             m_document->setViewEffectsService(m_mapView);
 
+            // entity models are loaded when the views are rendered, so don't block the UI while loading them
+            m_document->entityModelManager().setLoadInBackground(true);
+
+            m_autosaver->setSaveInBackground(true);
+
             m_autosaveTimer = new QTimer(this);
             m_autosaveTimer->start(1000);
 
@@ -24,8 +24,8 @@
 #include "Assets/EntityDefinitionManager.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushBuilder.h"
-#include "Model/CollectContainedNodesVisitor.h"
 #include "Model/HitAdapter.h"
+#include "Model/ModelUtils.h"
 #include "Model/PickResult.h"
 #include "Model/PointFile.h"
 #include "Renderer/Compass2D.h"
@@ -224,9 +224,7 @@ namespace TrenchBroom {
             Transaction transaction(document, "Select Tall");
             document->deleteObjects();
 
-            Model::CollectContainedNodesVisitor<std::vector<Model::BrushNode*>::const_iterator> visitor(std::begin(tallBrushes), std::end(tallBrushes), document->editorContext());
-            document->world()->acceptAndRecurse(visitor);
-            document->select(visitor.nodes());
+            document->select(Model::collectContainedNodes(*document->world(), tallBrushes, document->editorContext()));
 
             kdl::vec_clear_and_delete(tallBrushes);
         }
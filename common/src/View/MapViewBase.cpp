@@ -889,6 +889,11 @@ namespace TrenchBroom {
             renderFPS(renderContext, renderBatch);
 
             renderBatch.render(renderContext);
+
+            if (document->hasPendingAssets()) {
+                // keep rendering until all textures are uploaded
+                update();
+            }
         }
 
         void MapViewBase::setupGL(Renderer::RenderContext& context) {
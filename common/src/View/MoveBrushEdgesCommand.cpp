@@ -20,7 +20,9 @@
 #include "MoveBrushEdgesCommand.h"
 
 #include "FloatType.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
+#include "Model/Polyhedron.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
 #include "View/VertexHandleManager.h"
@@ -53,21 +55,17 @@ namespace TrenchBroom {
 
         MoveBrushEdgesCommand::~MoveBrushEdgesCommand() = default;
 
-        bool MoveBrushEdgesCommand::doCanDoVertexOperation(const MapDocument* document) const {
+        bool MoveBrushEdgesCommand::doCanDoVertexOperation(const MapDocument* document) {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_edges) {
-                const Model::BrushNode* brushNode = entry.first;
-                const std::vector<vm::segment3>& edges = entry.second;
-                const Model::Brush& brush = brushNode->brush();
-                if (!brush.canMoveEdges(worldBounds, edges, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            m_newGeometries.clear();
+            return checkMoves(m_edges, [&](const Model::Brush& brush, const std::vector<vm::segment3>& edges) {
+                return brush.checkMoveEdges(worldBounds, edges, m_delta);
+            }, m_newGeometries);
         }
 
         bool MoveBrushEdgesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
-            m_newEdgePositions = document->performMoveEdges(m_edges, m_delta);
+            m_newEdgePositions = document->performMoveEdges(m_edges, m_delta, m_newGeometries);
+            m_newGeometries.clear();
             return true;
         }
 
@@ -38,13 +38,18 @@ namespace TrenchBroom {
             std::vector<vm::segment3> m_oldEdgePositions;
             std::vector<vm::segment3> m_newEdgePositions;
             vm::vec3 m_delta;
+            /**
+             * The geometries of the brushes after the move, computed when checking the move and consumed when
+             * performing it.
+             */
+            BrushGeometryMap m_newGeometries;
         public:
             static std::unique_ptr<MoveBrushEdgesCommand> move(const EdgeToBrushesMap& edges, const vm::vec3& delta);
 
             MoveBrushEdgesCommand(const std::vector<Model::BrushNode*>& brushes, const BrushEdgesMap& edges, const std::vector<vm::segment3>& edgePositions, const vm::vec3& delta);
             ~MoveBrushEdgesCommand() override;
         private:
-            bool doCanDoVertexOperation(const MapDocument* document) const override;
+            bool doCanDoVertexOperation(const MapDocument* document) override;
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
@@ -21,7 +21,9 @@
 #include "MoveBrushFacesCommand.h"
 
 #include "FloatType.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
+#include "Model/Polyhedron.h"
 #include "Model/Snapshot.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
@@ -52,21 +54,19 @@ namespace TrenchBroom {
             assert(!vm::is_zero(m_delta, vm::C::almost_zero()));
         }
 
-        bool MoveBrushFacesCommand::doCanDoVertexOperation(const MapDocument* document) const {
+        MoveBrushFacesCommand::~MoveBrushFacesCommand() = default;
+
+        bool MoveBrushFacesCommand::doCanDoVertexOperation(const MapDocument* document) {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_faces) {
-                const Model::BrushNode* brushNode = entry.first;
-                const Model::Brush& brush = brushNode->brush();
-                const std::vector<vm::polygon3>& faces = entry.second;
-                if (!brush.canMoveFaces(worldBounds, faces, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            m_newGeometries.clear();
+            return checkMoves(m_faces, [&](const Model::Brush& brush, const std::vector<vm::polygon3>& faces) {
+                return brush.checkMoveFaces(worldBounds, faces, m_delta);
+            }, m_newGeometries);
         }
 
         bool MoveBrushFacesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
-            m_newFacePositions = document->performMoveFaces(m_faces, m_delta);
+            m_newFacePositions = document->performMoveFaces(m_faces, m_delta, m_newGeometries);
+            m_newGeometries.clear();
             return true;
         }
 
@@ -37,12 +37,18 @@ namespace TrenchBroom {
             std::vector<vm::polygon3> m_oldFacePositions;
             std::vector<vm::polygon3> m_newFacePositions;
             vm::vec3 m_delta;
+            /**
+             * The geometries of the brushes after the move, computed when checking the move and consumed when
+             * performing it.
+             */
+            BrushGeometryMap m_newGeometries;
         public:
             static std::unique_ptr<MoveBrushFacesCommand> move(const FaceToBrushesMap& faces, const vm::vec3& delta);
 
             MoveBrushFacesCommand(const std::vector<Model::BrushNode*>& brushes, const BrushFacesMap& faces, const std::vector<vm::polygon3>& facePositions, const vm::vec3& delta);
+            ~MoveBrushFacesCommand() override;
         private:
-            bool doCanDoVertexOperation(const MapDocument* document) const override;
+            bool doCanDoVertexOperation(const MapDocument* document) override;
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
@@ -20,7 +20,9 @@
 #include "MoveBrushVerticesCommand.h"
 
 #include "FloatType.h"
+#include "Model/Brush.h"
 #include "Model/BrushNode.h"
+#include "Model/Polyhedron.h"
 #include "View/MapDocument.h"
 #include "View/MapDocumentCommandFacade.h"
 #include "View/VertexHandleManager.h"
@@ -59,21 +61,19 @@ namespace TrenchBroom {
             assert(!vm::is_zero(m_delta, vm::C::almost_zero()));
         }
 
-        bool MoveBrushVerticesCommand::doCanDoVertexOperation(const MapDocument* document) const {
+        MoveBrushVerticesCommand::~MoveBrushVerticesCommand() = default;
+
+        bool MoveBrushVerticesCommand::doCanDoVertexOperation(const MapDocument* document) {
             const vm::bbox3& worldBounds = document->worldBounds();
-            for (const auto& entry : m_vertices) {
-                const Model::BrushNode* brushNode = entry.first;
-                const Model::Brush& brush = brushNode->brush();
-                const std::vector<vm::vec3>& vertices = entry.second;
-                if (!brush.canMoveVertices(worldBounds, vertices, m_delta)) {
-                    return false;
-                }
-            }
-            return true;
+            m_newGeometries.clear();
+            return checkMoves(m_vertices, [&](const Model::Brush& brush, const std::vector<vm::vec3>& vertices) {
+                return brush.checkMoveVertices(worldBounds, vertices, m_delta);
+            }, m_newGeometries);
         }
 
         bool MoveBrushVerticesCommand::doVertexOperation(MapDocumentCommandFacade* document) {
-            m_newVertexPositions = document->performMoveVertices(m_vertices, m_delta);
+            m_newVertexPositions = document->performMoveVertices(m_vertices, m_delta, m_newGeometries);
+            m_newGeometries.clear();
             return true;
         }
 
@@ -45,12 +45,18 @@ namespace TrenchBroom {
             std::vector<vm::vec3> m_oldVertexPositions;
             std::vector<vm::vec3> m_newVertexPositions;
             vm::vec3 m_delta;
+            /**
+             * The geometries of the brushes after the move, computed when checking the move and consumed when
+             * performing it.
+             */
+            BrushGeometryMap m_newGeometries;
         public:
             static std::unique_ptr<MoveBrushVerticesCommand> move(const VertexToBrushesMap& vertices, const vm::vec3& delta);
 
             MoveBrushVerticesCommand(const std::vector<Model::BrushNode*>& brushes, const BrushVerticesMap& vertices, const std::vector<vm::vec3>& vertexPositions, const vm::vec3& delta);
+            ~MoveBrushVerticesCommand() override;
         private:
-            bool doCanDoVertexOperation(const MapDocument* document) const override;
+            bool doCanDoVertexOperation(const MapDocument* document) override;
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
             std::unique_ptr<CommandResult> doCreateCommandResult(bool success) override;
 
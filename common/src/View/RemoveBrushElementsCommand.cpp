@@ -32,7 +32,7 @@ namespace TrenchBroom {
         VertexCommand(type, name, brushes),
         m_vertices(vertices) {}
 
-        bool RemoveBrushElementsCommand::doCanDoVertexOperation(const MapDocument* document) const {
+        bool RemoveBrushElementsCommand::doCanDoVertexOperation(const MapDocument* document) {
             const vm::bbox3& worldBounds = document->worldBounds();
             for (const auto& entry : m_vertices) {
                 const Model::BrushNode* brushNode = entry.first;
@@ -35,7 +35,7 @@ namespace TrenchBroom {
         protected:
             RemoveBrushElementsCommand(CommandType type, const std::string& name, const std::vector<Model::BrushNode*>& brushes, const BrushVerticesMap& vertices);
         private:
-            bool doCanDoVertexOperation(const MapDocument* document) const override;
+            bool doCanDoVertexOperation(const MapDocument* document) override;
             bool doVertexOperation(MapDocumentCommandFacade* document) override;
 
             bool doCollateWith(UndoableCommand* command) override;
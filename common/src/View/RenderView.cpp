@@ -107,7 +107,11 @@ namespace TrenchBroom {
                     std::to_string(maxFrameTime) + "ms. " +
                     std::to_string(m_glContext->vboManager().currentVboCount()) + " current VBOs (" +
                     std::to_string(m_glContext->vboManager().peakVboCount()) + " peak) totalling " +
-                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB";
+                    std::to_string(m_glContext->vboManager().currentVboSize() / 1024u) + " KiB, " +
+                    std::to_string(m_glContext->vboManager().bytesUploadedLastFrame() / 1024u) + " KiB uploaded last frame, " +
+                    std::to_string(m_glContext->vboManager().compactionCount()) + " compactions, " +
+                    std::to_string(static_cast<int>(m_glContext->vboManager().freeRatio() * 100.0)) + "% free (" +
+                    std::to_string(static_cast<int>(m_glContext->vboManager().fragmentationRatio() * 100.0)) + "% fragmented)";
 
 
             });
@@ -158,6 +162,7 @@ namespace TrenchBroom {
         void RenderView::paintGL() {
             if (TrenchBroom::View::isReportingCrash()) return;
 
+            m_glContext->vboManager().beginFrame();
             render();
 
             // Update stats
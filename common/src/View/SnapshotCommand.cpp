@@ -45,6 +45,10 @@ namespace TrenchBroom {
             return restoreSnapshot(document);
         }
 
+        size_t SnapshotCommand::doGetMemorySize() const {
+            return m_snapshot != nullptr ? m_snapshot->memorySize() : 0u;
+        }
+
         void SnapshotCommand::takeSnapshot(MapDocumentCommandFacade *document) {
             assert(m_snapshot == nullptr);
             m_snapshot = doTakeSnapshot(document);
@@ -42,6 +42,8 @@ namespace TrenchBroom {
             std::unique_ptr<CommandResult> performDo(MapDocumentCommandFacade* document) override;
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
         private:
+            size_t doGetMemorySize() const override;
+
             void takeSnapshot(MapDocumentCommandFacade* document);
             std::unique_ptr<CommandResult> restoreSnapshot(MapDocumentCommandFacade* document);
             void deleteSnapshot();
@@ -45,6 +45,7 @@
 #include <vecmath/mat_ext.h>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <QTextStream>
@@ -154,33 +155,40 @@ namespace TrenchBroom {
             assert(fontSize > 0);
 
             const Renderer::FontDescriptor font(fontPath, static_cast<size_t>(fontSize));
+            const auto textHeight = fontManager().font(font).measure("").y();
+            m_labelCache.reset(font, layout.maxCellWidth(), 6);
+
+            updateTextureIndex();
+            const auto textures = getTextures();
 
             if (m_group) {
+                std::unordered_map<const Assets::TextureCollection*, std::vector<size_t>> texturesByCollection;
+                for (const size_t item : textures) {
+                    texturesByCollection[m_textures[item]->collection()].push_back(item);
+                }
+
                 for (const Assets::TextureCollection* collection : getCollections()) {
                     layout.addGroup(collection->name(), static_cast<float>(fontSize) + 2.0f);
-                    for (Assets::Texture* texture : getTextures(collection))
-                        addTextureToLayout(layout, texture, font);
+                    for (const size_t item : texturesByCollection[collection])
+                        addTextureToLayout(layout, item, textHeight);
                 }
             } else {
-                for (Assets::Texture* texture : getTextures())
-                    addTextureToLayout(layout, texture, font);
+                for (const size_t item : textures)
+                    addTextureToLayout(layout, item, textHeight);
             }
         }
 
-        void TextureBrowserView::addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font) {
+        void TextureBrowserView::addTextureToLayout(Layout& layout, const size_t item, const float textHeight) {
             const float maxCellWidth = layout.maxCellWidth();
 
+            Assets::Texture* texture = m_textures[item];
             const auto& groupName   = texture->collection()->name();
-            const auto  textureName = IO::Path(texture->name()).lastComponent().asString();
+            const auto& textureName = m_textureLabels[item];
 
-            const auto textureFont = fontManager().selectFontSize(font, textureName, maxCellWidth, 6);
-            const auto groupFont   = fontManager().selectFontSize(font, groupName, maxCellWidth, 6);
+            const auto& textureLabel = m_labelCache.label(fontManager(), textureName);
+            const auto& groupLabel   = m_labelCache.label(fontManager(), groupName);
 
-            const auto defaultTextHeight = fontManager().font(font).measure(groupName + textureName).y();
-            const auto textureNameSize   = fontManager().font(textureFont).measure(textureName);
-            const auto groupNameSize     = fontManager().font(groupFont).measure(groupName);
-
-            const auto totalSize = vm::vec2f(vm::max(groupNameSize.x(), textureNameSize.x()), 2.0f * defaultTextHeight + 4.0f);
+            const auto totalSize = vm::vec2f(vm::max(groupLabel.size.x(), textureLabel.size.x()), 2.0f * textHeight + 4.0f);
 
             const float scaleFactor = pref(Preferences::TextureBrowserIconSize);
             const float scaledTextureWidth = vm::round(scaleFactor * static_cast<float>(texture->width()));
@@ -190,10 +198,10 @@ namespace TrenchBroom {
                 texture,
                 textureName,
                 groupName,
-                vm::vec2f((maxCellWidth - textureNameSize.x()) / 2.0f, defaultTextHeight + 3.0f),
-                vm::vec2f((maxCellWidth - groupNameSize.x()) / 2.0f, 1.0f),
-                textureFont,
-                groupFont
+                vm::vec2f((maxCellWidth - textureLabel.size.x()) / 2.0f, textHeight + 3.0f),
+                vm::vec2f((maxCellWidth - groupLabel.size.x()) / 2.0f, 1.0f),
+                textureLabel.font,
+                groupLabel.font
             });
 
             layout.addItem(QVariant::fromValue(cellData),
@@ -217,15 +225,6 @@ namespace TrenchBroom {
             }
         };
 
-        struct TextureBrowserView::CompareByName {
-            kdl::ci::string_less m_less;
-
-            template <typename T>
-            bool operator()(const T* lhs, const T* rhs) const {
-                return m_less(lhs->name(), rhs->name());
-            }
-        };
-
         struct TextureBrowserView::MatchUsageCount {
             template <typename T>
             bool operator()(const T* t) const {
@@ -233,15 +232,42 @@ namespace TrenchBroom {
             }
         };
 
-        struct TextureBrowserView::MatchName {
-            std::string pattern;
+        /**
+         * Rebuilds the texture index if the textures of the loaded collections have changed. The index contains the
+         * textures of all collections, including overridden textures, which are only shown when the textures are
+         * grouped by collection.
+         */
+        void TextureBrowserView::updateTextureIndex() {
+            auto doc = kdl::mem_lock(m_document);
 
-            explicit MatchName(const std::string& i_pattern) : pattern(i_pattern) {}
+            std::vector<Assets::Texture*> textures;
+            textures.reserve(m_textures.size());
+            for (const Assets::TextureCollection* collection : doc->textureManager().collections()) {
+                const auto& collectionTextures = collection->textures();
+                textures.insert(std::end(textures), std::begin(collectionTextures), std::end(collectionTextures));
+            }
 
-            bool operator()(const Assets::Texture* texture) const {
-                return !kdl::ci::str_contains(texture->name(), pattern);
+            // a texture may have been reloaded at the address of a texture with a different name
+            bool unchanged = textures.size() == m_textures.size();
+            for (size_t i = 0u; i < textures.size() && unchanged; ++i) {
+                unchanged = textures[i] == m_textures[i] && textures[i]->name() == m_textureNames[i];
+            }
+            if (unchanged) {
+                return;
             }
-        };
+
+            m_textureNames.clear();
+            m_textureNames.reserve(textures.size());
+            m_textureLabels.clear();
+            m_textureLabels.reserve(textures.size());
+            for (const Assets::Texture* texture : textures) {
+                m_textureNames.push_back(texture->name());
+                m_textureLabels.push_back(IO::Path(texture->name()).lastComponent().asString());
+            }
+
+            m_textures = std::move(textures);
+            m_textureIndex = CellItemIndex(m_textureNames);
+        }
 
         std::vector<Assets::TextureCollection*> TextureBrowserView::getCollections() const {
             auto doc = kdl::mem_lock(m_document);
@@ -255,37 +281,31 @@ namespace TrenchBroom {
             return collections;
         }
 
-        std::vector<Assets::Texture*> TextureBrowserView::getTextures(const Assets::TextureCollection* collection) const {
-            std::vector<Assets::Texture*> textures = collection->textures();
-            filterTextures(textures);
-            sortTextures(textures);
-            return textures;
-        }
-
-        std::vector<Assets::Texture*> TextureBrowserView::getTextures() const {
-            auto doc = kdl::mem_lock(m_document);
-            std::vector<Assets::Texture*> textures = doc->textureManager().textures();
-            filterTextures(textures);
-            sortTextures(textures);
-            return textures;
-        }
-
-        void TextureBrowserView::filterTextures(std::vector<Assets::Texture*>& textures) const {
-            if (m_hideUnused)
-                kdl::vec_erase_if(textures, MatchUsageCount());
-            if (!m_filterText.empty())
-                kdl::vec_erase_if(textures, MatchName(m_filterText));
-        }
+        /**
+         * Returns the indexed textures that match the current filter, in the current sort order.
+         */
+        std::vector<size_t> TextureBrowserView::getTextures() {
+            auto textures = m_textureIndex.match(m_filterText);
+            kdl::vec_erase_if(textures, [&](const size_t item) {
+                const Assets::Texture* texture = m_textures[item];
+                return (!m_group && texture->overridden()) || (m_hideUnused && texture->usageCount() == 0);
+            });
 
-        void TextureBrowserView::sortTextures(std::vector<Assets::Texture*>& textures) const {
             switch (m_sortOrder) {
                 case TextureSortOrder::Name:
-                    kdl::vec_sort(textures, CompareByName());
+                    // the index returns the textures sorted by name
                     break;
                 case TextureSortOrder::Usage:
-                    kdl::vec_sort(textures, CompareByUsageCount());
+                    kdl::vec_sort(textures, [&](const size_t lhs, const size_t rhs) {
+                        const auto lhsUsageCount = m_textures[lhs]->usageCount();
+                        const auto rhsUsageCount = m_textures[rhs]->usageCount();
+                        if (lhsUsageCount != rhsUsageCount)
+                            return lhsUsageCount > rhsUsageCount;
+                        return m_textureIndex.nameRank(lhs) < m_textureIndex.nameRank(rhs);
+                    });
                     break;
             }
+            return textures;
         }
 
         void TextureBrowserView::doClear() {}
@@ -293,6 +313,10 @@ namespace TrenchBroom {
         void TextureBrowserView::doRender(Layout& layout, const float y, const float height) {
             auto doc = kdl::mem_lock(m_document);
             doc->textureManager().commitChanges();
+            if (doc->textureManager().hasPendingChanges()) {
+                // render again to show the remaining textures once they are uploaded
+                update();
+            }
 
             const float viewLeft      = static_cast<float>(0);
             const float viewTop       = static_cast<float>(size().height());
@@ -375,6 +399,10 @@ namespace TrenchBroom {
                                 const Cell& cell = row[k];
                                 const LayoutBounds& bounds = cell.itemBounds();
                                 const Assets::Texture* texture = cellData(cell).texture;
+                                if (!texture->isPrepared()) {
+                                    // only the cell border is rendered until the texture is uploaded
+                                    continue;
+                                }
 
                                 Renderer::VertexArray vertexArray = Renderer::VertexArray::move(std::vector<TextureVertex>({
                                     TextureVertex(vm::vec2f(bounds.left(),  height - (bounds.top() - y)),    vm::vec2f(0.0f, 0.0f)),
@@ -22,6 +22,8 @@
 
 #include "Renderer/FontDescriptor.h"
 #include "Renderer/GLVertexType.h"
+#include "View/CellItemIndex.h"
+#include "View/CellLabelCache.h"
 #include "View/CellView.h"
 
 #include <map>
@@ -69,6 +71,12 @@ namespace TrenchBroom {
             TextureSortOrder m_sortOrder;
             std::string m_filterText;
 
+            std::vector<Assets::Texture*> m_textures;
+            std::vector<std::string> m_textureNames;
+            std::vector<std::string> m_textureLabels;
+            CellItemIndex m_textureIndex;
+            CellLabelCache m_labelCache;
+
             Assets::Texture* m_selectedTexture;
         public:
             TextureBrowserView(QScrollBar* scrollBar,
@@ -90,19 +98,15 @@ namespace TrenchBroom {
 
             void doInitLayout(Layout& layout) override;
             void doReloadLayout(Layout& layout) override;
-            void addTextureToLayout(Layout& layout, Assets::Texture* texture, const Renderer::FontDescriptor& font);
+            void addTextureToLayout(Layout& layout, size_t item, float textHeight);
 
             struct CompareByUsageCount;
-            struct CompareByName;
             struct MatchUsageCount;
-            struct MatchName;
 
-            std::vector<Assets::TextureCollection*> getCollections() const;
-            std::vector<Assets::Texture*> getTextures(const Assets::TextureCollection* collection) const;
-            std::vector<Assets::Texture*> getTextures() const;
+            void updateTextureIndex();
 
-            void filterTextures(std::vector<Assets::Texture*>& textures) const;
-            void sortTextures(std::vector<Assets::Texture*>& textures) const;
+            std::vector<Assets::TextureCollection*> getCollections() const;
+            std::vector<size_t> getTextures();
 
             void doClear() override;
             void doRender(Layout& layout, float y, float height) override;
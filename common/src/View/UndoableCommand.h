@@ -43,6 +43,12 @@ namespace TrenchBroom {
             std::unique_ptr<UndoableCommand> repeat(MapDocumentCommandFacade* document) const;
 
             virtual bool collateWith(UndoableCommand* command);
+
+            /**
+             * Returns an estimate of the number of bytes of memory that this command holds to be able to undo or redo
+             * it, e.g. in snapshots. Commands that only hold a few values return 0.
+             */
+            size_t memorySize() const;
         private:
             virtual std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) = 0;
 
@@ -51,6 +57,8 @@ namespace TrenchBroom {
             virtual std::unique_ptr<UndoableCommand> doRepeat(MapDocumentCommandFacade* document) const;
 
             virtual bool doCollateWith(UndoableCommand* command) = 0;
+
+            virtual size_t doGetMemorySize() const;
         public: // this method is just a service for DocumentCommand and should never be called from anywhere else
             virtual size_t documentModificationCount() const;
 
@@ -25,9 +25,12 @@
 #include "Model/BrushGeometry.h"
 #include "View/DocumentCommand.h"
 
+#include <kdl/parallel.h>
+
 #include <vecmath/forward.h>
 #include <vecmath/vec.h>
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -54,6 +57,7 @@ namespace TrenchBroom {
             using BrushVerticesMap = std::map<Model::BrushNode*, std::vector<vm::vec3>>;
             using BrushEdgesMap = std::map<Model::BrushNode*, std::vector<vm::segment3>>;
             using BrushFacesMap = std::map<Model::BrushNode*, std::vector<vm::polygon3>>;
+            using BrushGeometryMap = std::map<Model::BrushNode*, std::unique_ptr<Model::BrushGeometry>>;
         private:
             std::vector<Model::BrushNode*> m_brushes;
             std::unique_ptr<Model::Snapshot> m_snapshot;
@@ -84,18 +88,65 @@ namespace TrenchBroom {
 
             static BrushVerticesMap brushVertexMap(const BrushEdgesMap& edges);
             static BrushVerticesMap brushVertexMap(const BrushFacesMap& faces);
+
+            /**
+             * Checks whether the given handles of each brush can be moved. The brushes are checked concurrently, and
+             * the remaining checks are skipped as soon as one of them fails. If all checks succeed, the geometries that
+             * result from the moves are returned so that the moves do not need to compute them again.
+             *
+             * @tparam H the handle type
+             * @tparam C the type of the check, a function of type `Model::Brush::CanMoveVerticesResult(const Model::Brush&, const std::vector<H>&)`
+             * @param brushHandles maps each brush to the handles to move
+             * @param check the check to perform for each brush, must be safe to call concurrently
+             * @param newGeometries receives the geometry of each brush after its move if all checks succeed
+             * @return true if all checks succeed and false otherwise
+             */
+            template <typename H, typename C>
+            static bool checkMoves(const std::map<Model::BrushNode*, std::vector<H>>& brushHandles, const C& check, BrushGeometryMap& newGeometries) {
+                std::vector<typename std::map<Model::BrushNode*, std::vector<H>>::const_iterator> entries;
+                entries.reserve(brushHandles.size());
+                for (auto it = std::begin(brushHandles); it != std::end(brushHandles); ++it) {
+                    entries.push_back(it);
+                }
+
+                std::vector<std::unique_ptr<Model::BrushGeometry>> geometries(entries.size());
+                std::atomic<bool> failed(false);
+                kdl::parallel_for(entries.size(), [&](const size_t i) {
+                    if (failed) {
+                        return;
+                    }
+
+                    const auto& [brushNode, handles] = *entries[i];
+                    auto result = check(brushNode->brush(), handles);
+                    if (result.success) {
+                        geometries[i] = std::move(result.geometry);
+                    } else {
+                        failed = true;
+                    }
+                });
+
+                if (failed) {
+                    return false;
+                }
+
+                for (size_t i = 0u; i < entries.size(); ++i) {
+                    newGeometries.emplace(entries[i]->first, std::move(geometries[i]));
+                }
+                return true;
+            }
         private:
             std::unique_ptr<CommandResult> doPerformDo(MapDocumentCommandFacade* document) override;
             std::unique_ptr<CommandResult> doPerformUndo(MapDocumentCommandFacade* document) override;
             void restoreAndTakeNewSnapshot(MapDocumentCommandFacade* document);
             bool doIsRepeatable(MapDocumentCommandFacade* document) const override;
+            size_t doGetMemorySize() const override;
         private:
             void takeSnapshot();
             void deleteSnapshot();
         protected:
             bool canCollateWith(const VertexCommand& other) const;
         private:
-            virtual bool doCanDoVertexOperation(const MapDocument* document) const = 0;
+            virtual bool doCanDoVertexOperation(const MapDocument* document) = 0;
             virtual bool doVertexOperation(MapDocumentCommandFacade* document) = 0;
             virtual std::unique_ptr<CommandResult> doCreateCommandResult(bool success);
         public:
@@ -38,9 +38,10 @@ namespace TrenchBroom {
         const Model::HitType::Type VertexHandleManager::HandleHitType = Model::HitType::freeType();
 
         void VertexHandleManager::pick(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
-                const auto distance = camera.pickPointHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            for (const HandleEntry* entry : findPickableHandles(pickRay, camera, handleRadius)) {
+                const auto& position = entry->first;
+                const auto distance = camera.pickPointHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(distance)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, distance);
                     const auto error = vm::squared_distance(pickRay, position).distance;
@@ -75,12 +76,14 @@ namespace TrenchBroom {
         const Model::HitType::Type EdgeHandleManager::HandleHitType = Model::HitType::freeType();
 
         void EdgeHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
-                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+            // the picked points always lie on the edges, so only edges near the ray need to be tested
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            for (const HandleEntry* entry : findPickableHandles(pickRay, camera, handleRadius)) {
+                const vm::segment3& position = entry->first;
+                const FloatType edgeDist = camera.pickLineSegmentHandle(pickRay, position, handleRadius);
                 if (!vm::is_nan(edgeDist)) {
                     const vm::vec3 pointHandle = grid.snap(vm::point_at_distance(pickRay, edgeDist), position);
-                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
@@ -90,11 +93,12 @@ namespace TrenchBroom {
         }
 
         void EdgeHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const vm::segment3& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            for (const HandleEntry* entry : findPickableHandles(pickRay, camera, handleRadius)) {
+                const vm::segment3& position = entry->first;
                 const vm::vec3 pointHandle = position.center();
 
-                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const FloatType pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const vm::vec3 hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
@@ -128,8 +132,10 @@ namespace TrenchBroom {
         const Model::HitType::Type FaceHandleManager::HandleHitType = Model::HitType::freeType();
 
         void FaceHandleManager::pickGridHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, const Grid& grid, Model::PickResult& pickResult) const {
-            for (const auto& entry : m_handles) {
-                const auto& position = entry.first;
+            // only faces which are hit by the ray can yield a grid handle
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            for (const HandleEntry* entry : findHandlesHitBy(pickRay)) {
+                const auto& position = entry->first;
 
                 const auto [valid, plane] = vm::from_points(std::begin(position), std::end(position));
                 if (!valid) {
@@ -140,7 +146,7 @@ namespace TrenchBroom {
                 if (!vm::is_nan(distance)) {
                     const auto pointHandle = grid.snap(vm::point_at_distance(pickRay, distance), plane);
 
-                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                    const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                     if (!vm::is_nan(pointDist)) {
                         const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                         pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, HitType(position, pointHandle)));
@@ -150,11 +156,12 @@ namespace TrenchBroom {
         }
 
         void FaceHandleManager::pickCenterHandle(const vm::ray3& pickRay, const Renderer::Camera& camera, Model::PickResult& pickResult) const {
-            for (const HandleEntry& entry : m_handles) {
-                const auto& position = entry.first;
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+            for (const HandleEntry* entry : findPickableHandles(pickRay, camera, handleRadius)) {
+                const auto& position = entry->first;
                 const auto pointHandle = position.center();
 
-                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, static_cast<FloatType>(pref(Preferences::HandleRadius)));
+                const auto pointDist = camera.pickPointHandle(pickRay, pointHandle, handleRadius);
                 if (!vm::is_nan(pointDist)) {
                     const auto hitPoint = vm::point_at_distance(pickRay, pointDist);
                     pickResult.addHit(Model::Hit::hit(HandleHitType, pointDist, hitPoint, position));
@@ -20,7 +20,9 @@
 #ifndef VertexHandleManager_h
 #define VertexHandleManager_h
 
+#include "AABBTree.h"
 #include "FloatType.h"
+#include "Macros.h"
 #include "Model/BrushNode.h"
 #include "Model/BrushFace.h"
 #include "Model/HitType.h"
@@ -29,8 +31,15 @@
 
 #include <kdl/vector_set.h>
 
+#include <vecmath/bbox.h>
+#include <vecmath/intersection.h>
+#include <vecmath/plane.h>
+#include <vecmath/polygon.h>
+#include <vecmath/ray.h>
 #include <vecmath/segment.h>
 
+#include <algorithm>
+#include <cmath>
 #include <iterator>
 #include <map>
 #include <vector>
@@ -161,11 +170,19 @@ namespace TrenchBroom {
             using HandleMap = std::map<H, HandleInfo>;
             using HandleEntry = typename HandleMap::value_type;
 
+            using HandleTree = AABBTree<FloatType, 3, HandleEntry*>;
+
             /**
              * Maps a handle position to its info.
              */
             HandleMap m_handles;
 
+            /**
+             * Spatial index of the entries of m_handles, keyed by the bounds of their handles. Since the entries of a
+             * std::map are stable, the tree stores pointers to them.
+             */
+            HandleTree m_handleTree;
+
             /**
              * The total number of selected handles, not counting duplicates.
              */
@@ -175,6 +192,8 @@ namespace TrenchBroom {
             m_selectedHandleCount(0) {}
 
             virtual ~VertexHandleManagerBaseT() {}
+
+            deleteCopyAndMove(VertexHandleManagerBaseT)
         public:
             /**
              * Returns the hit type value of the picking hits reported by this manager.
@@ -303,7 +322,11 @@ namespace TrenchBroom {
              * @param handle the handle to add
              */
             void add(const Handle& handle) {
-                m_handles[handle].inc(); // unknown value gets value constructed, which for HandleInfo means its default constructor is called
+                const auto [it, inserted] = m_handles.try_emplace(handle);
+                if (inserted) {
+                    m_handleTree.insert(handleBounds(it->first), &*it);
+                }
+                it->second.inc();
             }
 
             /**
@@ -320,6 +343,7 @@ namespace TrenchBroom {
 
                     if (info.count == 0) {
                         deselect(info);
+                        m_handleTree.remove(&*it);
                         m_handles.erase(it);
                     }
                     return true;
@@ -332,6 +356,7 @@ namespace TrenchBroom {
              * Removes all handles from this manager.
              */
             void clear() {
+                m_handleTree.clear();
                 m_handles.clear();
                 m_selectedHandleCount = 0;
             }
@@ -423,9 +448,13 @@ namespace TrenchBroom {
             template <typename F>
             void forEachCloseHandle(const H& handle, F fun) {
                 static const auto epsilon = 0.001 * 0.001;
-                for (auto& entry : m_handles) {
-                    if (compare(handle, entry.first, epsilon) == 0) {
-                        fun(entry.second);
+
+                std::vector<HandleEntry*> candidates;
+                m_handleTree.findIntersectors(handleBounds(handle).expand(epsilon), std::back_inserter(candidates));
+
+                for (HandleEntry* entry : candidates) {
+                    if (compare(handle, entry->first, epsilon) == 0) {
+                        fun(entry->second);
                     }
                 }
             }
@@ -471,6 +500,85 @@ namespace TrenchBroom {
                     }
                 }
             }
+
+            /**
+             * Returns every handle whose bounds intersect with the convex volume bounded by the given planes. The
+             * normals of the planes must point out of the volume. The test is conservative, so the result may contain
+             * some handles near the boundary of the volume which do not intersect it.
+             *
+             * @param planes the planes bounding the volume
+             * @return a list containing the handles found
+             */
+            HandleList findHandles(const std::vector<vm::plane3>& planes) const {
+                std::vector<HandleEntry*> entries;
+                m_handleTree.findIntersectors(planes, std::back_inserter(entries));
+
+                HandleList result;
+                result.reserve(entries.size());
+                for (const HandleEntry* entry : entries) {
+                    result.push_back(entry->first);
+                }
+                return result;
+            }
+        protected:
+            /**
+             * Returns the entries of every handle which might be hit by a point handle picking test with the given ray,
+             * camera and handle radius, provided that the tested point lies within the bounds of the handle. The test is
+             * conservative: the bounds of each handle are expanded by the largest pick radius that the camera yields
+             * anywhere within them before they are intersected with the ray.
+             *
+             * @param pickRay the picking ray
+             * @param camera the camera
+             * @param handleRadius the handle radius
+             * @return the candidate handle entries
+             */
+            std::vector<const HandleEntry*> findPickableHandles(const vm::ray3& pickRay, const Renderer::Camera& camera, const FloatType handleRadius) const {
+                std::vector<const HandleEntry*> result;
+                m_handleTree.findMatching([&](const vm::bbox3& bounds) {
+                    // the scaling factor is an affine function of the position, so its extremes are found at the corners
+                    auto maxScaling = FloatType(0);
+                    for (size_t i = 0u; i < 8u; ++i) {
+                        const auto corner = vm::vec3(
+                            (i & 1u) ? bounds.max.x() : bounds.min.x(),
+                            (i & 2u) ? bounds.max.y() : bounds.min.y(),
+                            (i & 4u) ? bounds.max.z() : bounds.min.z());
+                        const auto scaling = static_cast<FloatType>(camera.perspectiveScalingFactor(vm::vec3f(corner)));
+                        maxScaling = std::max(maxScaling, std::abs(scaling));
+                    }
+
+                    const auto pickBounds = bounds.expand(FloatType(2.0) * handleRadius * maxScaling);
+                    return pickBounds.contains(pickRay.origin) || !vm::is_nan(vm::intersect_ray_bbox(pickRay, pickBounds));
+                }, std::back_inserter(result));
+                return result;
+            }
+
+            /**
+             * Returns the entries of every handle whose bounds are hit by the given ray.
+             *
+             * @param pickRay the picking ray
+             * @return the candidate handle entries
+             */
+            std::vector<const HandleEntry*> findHandlesHitBy(const vm::ray3& pickRay) const {
+                std::vector<const HandleEntry*> result;
+                m_handleTree.findIntersectors(pickRay, std::back_inserter(result));
+                return result;
+            }
+        private:
+            static vm::bbox3 handleBounds(const vm::vec3& handle) {
+                return vm::bbox3(handle, handle);
+            }
+
+            static vm::bbox3 handleBounds(const vm::segment3& handle) {
+                return vm::bbox3(vm::min(handle.start(), handle.end()), vm::max(handle.start(), handle.end()));
+            }
+
+            static vm::bbox3 handleBounds(const vm::polygon3& handle) {
+                vm::bbox3::builder builder;
+                for (const vm::vec3& vertex : handle) {
+                    builder.add(vertex);
+                }
+                return builder.bounds();
+            }
         public:
             /**
              * Finds and returns all brushes in the given range which are incident to the given handle.
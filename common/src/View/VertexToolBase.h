@@ -182,10 +182,10 @@ namespace TrenchBroom {
             void select(const Lasso& lasso, const bool modifySelection) {
                 using HandleList = std::vector<H>;
 
-                const HandleList allHandles = handleManager().allHandles();
+                const HandleList candidates = handleManager().findHandles(lasso.boundingPlanes());
                 HandleList selectedHandles;
 
-                lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(selectedHandles));
+                lasso.selected(std::begin(candidates), std::end(candidates), std::back_inserter(selectedHandles));
                 if (!modifySelection) {
                     handleManager().deselectAll();
                 }
@@ -22,20 +22,26 @@
 #include "GTestCompat.h"
 
 #include <vecmath/vec.h>
+#include <vecmath/plane.h>
 #include <vecmath/ray.h>
 #include "AABBTree.h"
 
+#include <algorithm>
 #include <set>
 #include <sstream>
+#include <vector>
 
 namespace TrenchBroom {
     using AABB = AABBTree<double, 3, size_t>;
     using BOX = AABB::Box;
     using RAY = vm::ray<AABB::FloatType, AABB::Components>;
     using VEC = vm::vec<AABB::FloatType, AABB::Components>;
+    using PLANE = vm::plane<AABB::FloatType, AABB::Components>;
 
     void assertTree(const std::string& exp, const AABB& actual);
     void assertIntersectors(const AABB& tree, const RAY& ray, std::initializer_list<AABB::DataType> items);
+    void assertIntersectors(const AABB& tree, const std::vector<PLANE>& planes, std::initializer_list<AABB::DataType> items);
+    void assertIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items);
     void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data);
     void assertTreeDoesNotContain(const AABB& tree, const BOX& box, AABB::DataType data);
 
@@ -489,6 +495,254 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         assertIntersectors(tree, RAY(VEC(0.0,  0.0,  0.0), VEC::pos_x()), { 2u });
     }
 
+    TEST_CASE("AABBTreeTest.findIntersectorsOfPlanes", "[AABBTreeTest]") {
+        const auto box1 = BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0));
+        const auto box2 = BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0));
+
+        AABB inserted;
+        assertIntersectors(inserted, { PLANE(VEC::zero(), VEC::pos_x()) }, {});
+
+        inserted.insert(box1, 1u);
+        inserted.insert(box2, 2u);
+
+        AABB built;
+        built.clearAndBuild(std::vector<size_t>{ 1u, 2u }, [&](const size_t i) { return i == 1u ? box1 : box2; });
+
+        for (const auto* tree : { &inserted, &built }) {
+            assertIntersectors(*tree, std::vector<PLANE>{}, { 1u, 2u });
+            assertIntersectors(*tree, { PLANE(VEC::zero(), VEC::pos_x()) }, { 1u });
+            assertIntersectors(*tree, { PLANE(VEC::zero(), VEC::neg_x()) }, { 2u });
+            assertIntersectors(*tree, { PLANE(VEC(1.5, 0.0, 0.0), VEC::neg_x()) }, { 2u });
+            assertIntersectors(*tree, { PLANE(VEC(3.0, 0.0, 0.0), VEC::neg_x()) }, {});
+            assertIntersectors(*tree, { PLANE(VEC(0.0, 0.0, 2.0), VEC::pos_z()) }, { 1u, 2u });
+            assertIntersectors(*tree, { PLANE(VEC(0.0, 0.0, -2.0), VEC::pos_z()) }, {});
+
+            assertIntersectors(*tree, { PLANE(VEC::zero(), VEC::pos_x()), PLANE(VEC(1.5, 0.0, 0.0), VEC::neg_x()) }, {});
+            assertIntersectors(*tree, { PLANE(VEC(-1.5, 0.0, 0.0), VEC::neg_x()), PLANE(VEC(1.5, 0.0, 0.0), VEC::pos_x()) }, { 1u, 2u });
+
+            // box2 lies outside of the wedge x <= -|y|, but it is not entirely above either of its planes
+            const auto wedge = std::vector<PLANE>{
+                PLANE(VEC::zero(), normalize(VEC(1.0, +1.0, 0.0))),
+                PLANE(VEC::zero(), normalize(VEC(1.0, -1.0, 0.0)))
+            };
+            assertIntersectors(*tree, wedge, { 1u, 2u });
+        }
+    }
+
+    TEST_CASE("AABBTreeTest.findIntersectorsOfBox", "[AABBTreeTest]") {
+        const auto box1 = BOX(VEC(-2.0, -1.0, -1.0), VEC(-1.0, +1.0, +1.0));
+        const auto box2 = BOX(VEC(+1.0, -1.0, -1.0), VEC(+2.0, +1.0, +1.0));
+
+        AABB inserted;
+        assertIntersectors(inserted, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), {});
+
+        inserted.insert(box1, 1u);
+        inserted.insert(box2, 2u);
+
+        AABB built;
+        built.clearAndBuild(std::vector<size_t>{ 1u, 2u }, [&](const size_t i) { return i == 1u ? box1 : box2; });
+
+        for (const auto* tree : { &inserted, &built }) {
+            assertIntersectors(*tree, BOX(VEC(-0.5, -0.5, -0.5), VEC(+0.5, +0.5, +0.5)), {});
+            assertIntersectors(*tree, BOX(VEC(-1.5, -0.5, -0.5), VEC(-0.5, +0.5, +0.5)), { 1u });
+            assertIntersectors(*tree, BOX(VEC(+1.5, +0.5, +0.5), VEC(+3.0, +3.0, +3.0)), { 2u });
+            assertIntersectors(*tree, BOX(VEC(-3.0, -3.0, -3.0), VEC(+3.0, +3.0, +3.0)), { 1u, 2u });
+
+            // touching boxes intersect
+            assertIntersectors(*tree, BOX(VEC(-1.0, -1.0, -1.0), VEC(+1.0, +1.0, +1.0)), { 1u, 2u });
+            assertIntersectors(*tree, BOX(VEC(-1.0, 1.0, -1.0), VEC(+1.0, +2.0, +1.0)), { 1u, 2u });
+            assertIntersectors(*tree, BOX(VEC(-1.0, 1.5, -1.0), VEC(+1.0, +2.0, +1.0)), {});
+        }
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildEmpty", "[AABBTreeTest]") {
+        AABB tree;
+        tree.insert(makeBounds(0, 1), 1u);
+
+        tree.clearAndBuild(std::vector<size_t>{}, [](const size_t i) { return makeBounds(i, i + 1u); });
+        ASSERT_TRUE(tree.empty());
+        ASSERT_FALSE(tree.contains(1u));
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildSingleNode", "[AABBTreeTest]") {
+        AABB tree;
+        tree.clearAndBuild(std::vector<size_t>{ 1u }, [](const size_t i) { return makeBounds(i, i + 1u); });
+
+        assertTree(R"(
+L [ ( 1 -1 -1 ) ( 2 1 1 ) ]: 1
+)" , tree);
+        assertTreeContains(tree, makeBounds(1, 2), 1u);
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildDuplicateNode", "[AABBTreeTest]") {
+        AABB tree;
+        ASSERT_THROW(tree.clearAndBuild(std::vector<size_t>{ 1u, 2u, 1u }, [](const size_t i) { return makeBounds(i, i + 1u); }), NodeTreeException);
+        ASSERT_TRUE(tree.empty());
+        ASSERT_FALSE(tree.contains(1u));
+        ASSERT_FALSE(tree.contains(2u));
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildManyNodes", "[AABBTreeTest]") {
+        std::vector<size_t> data;
+        for (size_t i = 0u; i < 10000u; ++i) {
+            data.push_back(i);
+        }
+
+        const auto getBounds = [](const size_t i) { return makeBounds(2u * i, 2u * i + 1u); };
+
+        AABB tree;
+        tree.clearAndBuild(data, getBounds);
+
+        // building a second time must replace the existing contents
+        tree.clearAndBuild(data, getBounds);
+
+        ASSERT_EQ(BOX(VEC(0.0, -1.0, -1.0), VEC(19999.0, 1.0, 1.0)), tree.bounds());
+
+        // a balanced tree over 10000 leafs has a height of 15
+        ASSERT_LE(tree.height(), 20u);
+
+        for (const auto i : { 0u, 1u, 4999u, 9998u, 9999u }) {
+            assertTreeContains(tree, getBounds(i), i);
+        }
+
+        assertIntersectors(tree, RAY(VEC(2.5, -2.0, 0.0), VEC::pos_y()), { 1u });
+        assertIntersectors(tree, RAY(VEC(1.5, -2.0, 0.0), VEC::pos_y()), {});
+
+        ASSERT_TRUE(tree.remove(4999u));
+        ASSERT_FALSE(tree.contains(4999u));
+        assertTreeDoesNotContain(tree, getBounds(4999u), 4999u);
+
+        tree.insert(getBounds(4999u), 4999u);
+        assertTreeContains(tree, getBounds(4999u), 4999u);
+        ASSERT_EQ(data.size(), tree.findIntersectors(RAY(VEC(-1.0, 0.0, 0.0), VEC::pos_x())).size());
+    }
+
+    TEST_CASE("AABBTreeTest.clearAndBuildQueriesMatchInsertedTree", "[AABBTreeTest]") {
+        std::vector<size_t> data;
+        for (size_t i = 0u; i < 512u; ++i) {
+            data.push_back(i);
+        }
+
+        // overlapping boxes of varying sizes on an 8x8x8 grid
+        const auto getBounds = [](const size_t i) {
+            const auto min = VEC(static_cast<double>(i % 8u), static_cast<double>((i / 8u) % 8u), static_cast<double>(i / 64u)) * 4.0;
+            return BOX(min, min + VEC(2.0, 3.0, 5.0) * static_cast<double>(1u + i % 3u));
+        };
+
+        AABB built;
+        built.clearAndBuild(data, getBounds);
+
+        AABB inserted;
+        for (const auto i : data) {
+            inserted.insert(getBounds(i), i);
+        }
+
+        const auto assertSameResults = [&]() {
+            for (const auto& origin : { VEC(-1.0, -1.0, -1.0), VEC(5.0, 7.0, 9.0), VEC(17.0, 3.0, 40.0), VEC(4.0, 4.0, 4.0) }) {
+                for (const auto& direction : { VEC::pos_x(), VEC::neg_y(), VEC::pos_z(), normalize(VEC(1.0, 1.0, 1.0)), normalize(VEC(-1.0, 2.0, 0.5)) }) {
+                    const auto ray = RAY(origin, direction);
+
+                    auto expected = inserted.findIntersectors(ray);
+                    auto actual = built.findIntersectors(ray);
+                    std::sort(std::begin(expected), std::end(expected));
+                    std::sort(std::begin(actual), std::end(actual));
+                    ASSERT_EQ(expected, actual);
+                }
+
+                auto expected = inserted.findContainers(origin);
+                auto actual = built.findContainers(origin);
+                std::sort(std::begin(expected), std::end(expected));
+                std::sort(std::begin(actual), std::end(actual));
+                ASSERT_EQ(expected, actual);
+
+                const auto box = BOX(origin, origin + VEC(3.0, 5.0, 2.0));
+                expected = inserted.findIntersectors(box);
+                actual = built.findIntersectors(box);
+                std::sort(std::begin(expected), std::end(expected));
+                std::sort(std::begin(actual), std::end(actual));
+                ASSERT_EQ(expected, actual);
+
+                // a predicate that matches the box query
+                std::vector<AABB::DataType> matching;
+                built.findMatching([&](const BOX& bounds) { return bounds.intersects(box); }, std::back_inserter(matching));
+                std::sort(std::begin(matching), std::end(matching));
+                ASSERT_EQ(expected, matching);
+
+                matching.clear();
+                inserted.findMatching([&](const BOX& bounds) { return bounds.intersects(box); }, std::back_inserter(matching));
+                std::sort(std::begin(matching), std::end(matching));
+                ASSERT_EQ(expected, matching);
+            }
+        };
+
+        assertSameResults();
+
+        // modifying the tree must not return stale results
+        built.update(getBounds(0u).translate(VEC(0.0, 0.0, 100.0)), 0u);
+        inserted.update(getBounds(0u).translate(VEC(0.0, 0.0, 100.0)), 0u);
+        assertSameResults();
+
+        built.remove(100u);
+        inserted.remove(100u);
+        assertSameResults();
+    }
+
+    TEST_CASE("AABBTreeTest.insertAll", "[AABBTreeTest]") {
+        const auto getBounds = [](const size_t i) { return makeBounds(2u * i, 2u * i + 1u); };
+
+        std::vector<size_t> first;
+        for (size_t i = 0u; i < 10000u; ++i) {
+            first.push_back(i);
+        }
+
+        AABB tree;
+        tree.insertAll(first, getBounds);
+        ASSERT_LE(tree.height(), 20u);
+
+        std::vector<size_t> second;
+        for (size_t i = 10000u; i < 10100u; ++i) {
+            second.push_back(i);
+        }
+        tree.insertAll(second, getBounds);
+
+        // inserting the smaller batch must keep the tree balanced
+        ASSERT_LE(tree.height(), 21u);
+        ASSERT_EQ(BOX(VEC(0.0, -1.0, -1.0), VEC(20199.0, 1.0, 1.0)), tree.bounds());
+
+        for (const auto i : { 0u, 4999u, 9999u, 10000u, 10050u, 10099u }) {
+            assertTreeContains(tree, getBounds(i), i);
+        }
+        ASSERT_EQ(first.size() + second.size(), tree.findIntersectors(RAY(VEC(-1.0, 0.0, 0.0), VEC::pos_x())).size());
+
+        // inserting a larger batch into a smaller tree
+        AABB small;
+        small.insert(getBounds(20000u), 20000u);
+        small.insertAll(first, getBounds);
+        ASSERT_LE(small.height(), 21u);
+        assertTreeContains(small, getBounds(20000u), 20000u);
+        assertTreeContains(small, getBounds(5000u), 5000u);
+    }
+
+    TEST_CASE("AABBTreeTest.insertAllWithDuplicate", "[AABBTreeTest]") {
+        const auto getBounds = [](const size_t i) { return makeBounds(i, i + 1u); };
+
+        AABB tree;
+        tree.insert(getBounds(1u), 1u);
+
+        ASSERT_THROW(tree.insertAll(std::vector<size_t>{ 2u, 3u, 1u }, getBounds), NodeTreeException);
+        ASSERT_TRUE(tree.contains(1u));
+        ASSERT_FALSE(tree.contains(2u));
+        ASSERT_FALSE(tree.contains(3u));
+
+        ASSERT_THROW(tree.insertAll(std::vector<size_t>{ 2u, 3u, 2u }, getBounds), NodeTreeException);
+        ASSERT_FALSE(tree.contains(2u));
+        ASSERT_FALSE(tree.contains(3u));
+
+        assertTree(R"(
+L [ ( 1 -1 -1 ) ( 2 1 1 ) ]: 1
+)" , tree);
+    }
+
     void assertTree(const std::string& exp, const AABB& actual) {
         std::stringstream str;
         actual.print(str);
@@ -504,6 +758,24 @@ L [ ( -1 -1 -1 ) ( 1 1 1 ) ]: 1
         ASSERT_EQ(expected, actual);
     }
 
+    void assertIntersectors(const AABB& tree, const std::vector<PLANE>& planes, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(planes, std::inserter(actual, std::end(actual)));
+
+        ASSERT_EQ(expected, actual);
+    }
+
+    void assertIntersectors(const AABB& tree, const BOX& box, std::initializer_list<AABB::DataType> items) {
+        const std::set<AABB::DataType> expected(items);
+        std::set<AABB::DataType> actual;
+
+        tree.findIntersectors(box, std::inserter(actual, std::end(actual)));
+
+        ASSERT_EQ(expected, actual);
+    }
+
     void assertTreeContains(const AABB& tree, const BOX& box, AABB::DataType data) {
         ASSERT_TRUE(tree.contains(data));
 
@@ -0,0 +1,188 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "TestLogger.h"
+
+#include "Exceptions.h"
+#include "Assets/EntityModel.h"
+#include "Assets/EntityModelManager.h"
+#include "Assets/ModelDefinition.h"
+#include "IO/EntityModelLoader.h"
+#include "IO/Path.h"
+
+#include <vecmath/bbox.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace Assets {
+        class TestEntityModelLoader : public IO::EntityModelLoader {
+        private:
+            std::shared_future<void> m_canLoad;
+        public:
+            mutable std::atomic<size_t> initializeCount;
+            mutable std::atomic<std::thread::id> loadingThread;
+
+            explicit TestEntityModelLoader(std::shared_future<void> canLoad) :
+            m_canLoad(std::move(canLoad)),
+            initializeCount(0u) {}
+        private:
+            std::unique_ptr<EntityModel> doInitializeModel(const IO::Path& path, Logger& /* logger */) const override {
+                m_canLoad.wait();
+                ++initializeCount;
+                loadingThread = std::this_thread::get_id();
+
+                if (path == IO::Path("missing.mdl")) {
+                    throw AssetException("Model not found");
+                }
+
+                auto model = std::make_unique<EntityModel>(path.asString(), PitchType::Normal);
+                model->addFrames(2);
+                return model;
+            }
+
+            void doLoadFrame(const IO::Path& /* path */, const size_t frameIndex, EntityModel& model, Logger& /* logger */) const override {
+                model.loadFrame(frameIndex, "frame", vm::bbox3f(8.0f));
+            }
+        };
+
+        class LoadedModelsObserver {
+        public:
+            std::vector<IO::Path> loadedPaths;
+            std::vector<std::thread::id> notifyingThreads;
+
+            void modelsWereLoaded(const std::vector<IO::Path>& paths) {
+                loadedPaths.insert(std::end(loadedPaths), std::begin(paths), std::end(paths));
+                notifyingThreads.push_back(std::this_thread::get_id());
+            }
+        };
+
+        static void loadPendingModels(EntityModelManager& manager) {
+            const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            while (manager.hasPendingModels() && std::chrono::steady_clock::now() < timeout) {
+                manager.loadPendingModels();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+
+        TEST_CASE("EntityModelManagerTest.loadQueuedModelsInBackground", "[EntityModelManagerTest]") {
+            std::promise<void> canLoad;
+            canLoad.set_value();
+            const TestEntityModelLoader loader(canLoad.get_future().share());
+
+            TestLogger logger;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadInBackground(true);
+
+            const auto spec = ModelSpecification(IO::Path("model.mdl"), 0u, 1u);
+            const auto missingSpec = ModelSpecification(IO::Path("missing.mdl"), 0u, 0u);
+
+            // models that are not loaded yet are queued
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_EQ(nullptr, manager.frame(missingSpec));
+            ASSERT_TRUE(manager.hasPendingModels());
+
+            LoadedModelsObserver observer;
+            manager.modelsWereLoadedNotifier.addObserver(&observer, &LoadedModelsObserver::modelsWereLoaded);
+
+            loadPendingModels(manager);
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_EQ(2u, loader.initializeCount.load());
+
+            // the paths of failed loads are reported, too
+            ASSERT_EQ(2u, observer.loadedPaths.size());
+            ASSERT_TRUE(std::find(std::begin(observer.loadedPaths), std::end(observer.loadedPaths), spec.path) != std::end(observer.loadedPaths));
+            ASSERT_TRUE(std::find(std::begin(observer.loadedPaths), std::end(observer.loadedPaths), missingSpec.path) != std::end(observer.loadedPaths));
+
+            // the requested frame was loaded in the background as well
+            const auto* frame = manager.frame(spec);
+            ASSERT_NE(nullptr, frame);
+            ASSERT_TRUE(frame->loaded());
+
+            // failed loads are not queued again
+            ASSERT_EQ(nullptr, manager.frame(missingSpec));
+            ASSERT_FALSE(manager.hasPendingModels());
+        }
+
+        TEST_CASE("EntityModelManagerTest.notifyLoadedModelsOnMainThread", "[EntityModelManagerTest]") {
+            std::promise<void> canLoad;
+            canLoad.set_value();
+            const TestEntityModelLoader loader(canLoad.get_future().share());
+
+            TestLogger logger;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadInBackground(true);
+
+            LoadedModelsObserver observer;
+            manager.modelsWereLoadedNotifier.addObserver(&observer, &LoadedModelsObserver::modelsWereLoaded);
+
+            ASSERT_EQ(nullptr, manager.frame(ModelSpecification(IO::Path("model.mdl"), 0u, 0u)));
+            loadPendingModels(manager);
+
+            ASSERT_EQ(1u, loader.initializeCount.load());
+            ASSERT_NE(std::this_thread::get_id(), loader.loadingThread.load());
+
+            ASSERT_FALSE(observer.notifyingThreads.empty());
+            for (const auto& threadId : observer.notifyingThreads) {
+                ASSERT_EQ(std::this_thread::get_id(), threadId);
+            }
+        }
+
+        TEST_CASE("EntityModelManagerTest.doNotQueueModelsWhileLoading", "[EntityModelManagerTest]") {
+            std::promise<void> canLoad;
+            const TestEntityModelLoader loader(canLoad.get_future().share());
+
+            TestLogger logger;
+            EntityModelManager manager(0, 0, logger);
+            manager.setLoader(&loader);
+            manager.setLoadInBackground(true);
+
+            const auto spec = ModelSpecification(IO::Path("model.mdl"), 0u, 0u);
+
+            // start loading the model, the loader blocks until canLoad is set
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            manager.loadPendingModels();
+            ASSERT_TRUE(manager.hasPendingModels());
+
+            // requesting the model while it is being loaded must not queue it again
+            ASSERT_EQ(nullptr, manager.frame(spec));
+            ASSERT_EQ(nullptr, manager.frame(ModelSpecification(IO::Path("model.mdl"), 0u, 1u)));
+            manager.loadPendingModels();
+
+            canLoad.set_value();
+            loadPendingModels(manager);
+
+            ASSERT_FALSE(manager.hasPendingModels());
+            ASSERT_EQ(1u, loader.initializeCount.load());
+            ASSERT_NE(nullptr, manager.frame(spec));
+        }
+    }
+}
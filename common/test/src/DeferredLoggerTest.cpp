@@ -0,0 +1,60 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "DeferredLogger.h"
+#include "TestLogger.h"
+
+#include <kdl/parallel.h>
+
+#include <string>
+
+namespace TrenchBroom {
+    TEST_CASE("DeferredLoggerTest.flushForwardsMessages", "[DeferredLoggerTest]") {
+        DeferredLogger deferredLogger;
+        deferredLogger.info("info");
+        deferredLogger.error() << "error " << 1;
+
+        TestLogger testLogger;
+        ASSERT_EQ(0u, testLogger.countMessages());
+
+        deferredLogger.flush(testLogger);
+        ASSERT_EQ(2u, testLogger.countMessages());
+        ASSERT_EQ(1u, testLogger.countMessages(LogLevel::Info));
+        ASSERT_EQ(1u, testLogger.countMessages(LogLevel::Error));
+
+        // the messages are only forwarded once
+        deferredLogger.flush(testLogger);
+        ASSERT_EQ(2u, testLogger.countMessages());
+    }
+
+    TEST_CASE("DeferredLoggerTest.logFromSeveralThreads", "[DeferredLoggerTest]") {
+        DeferredLogger deferredLogger;
+        kdl::parallel_for(1000u, [&](const std::size_t i) {
+            deferredLogger.warn() << "message " << i;
+        }, 4u);
+
+        TestLogger testLogger;
+        deferredLogger.flush(testLogger);
+        ASSERT_EQ(1000u, testLogger.countMessages(LogLevel::Warn));
+    }
+}
@@ -23,6 +23,7 @@
 
 #include <cmath>
 
+#include "EL/CompiledExpression.h"
 #include "EL/ELExceptions.h"
 #include "EL/EvaluationContext.h"
 #include "EL/Expression.h"
@@ -326,6 +327,45 @@ namespace TrenchBroom {
             evaluateAndAssert("2 + 3 < 2 + 4 -> 6 % 5", 1);
         }
 
+        void compileAndAssert(const std::string& expression, const Value& result, const VariableStore& store) {
+            const Expression parsed = IO::ELParser::parseStrict(expression);
+            ASSERT_EQ(result, parsed.evaluate(EvaluationContext(store)));
+            ASSERT_EQ(result, CompiledExpression(parsed).evaluate(store));
+        }
+
+        TEST_CASE("ExpressionTest.testCompiledExpression", "[ExpressionTest]") {
+            const std::string longString = "a string that is too long to be stored inline";
+
+            VariableTable store;
+            store.declare("x", Value(1));
+            store.declare("s", Value(longString));
+            store.declare("a", Value(ArrayType({ Value(1), Value(2), Value(3) })));
+
+            compileAndAssert("1 + 2 * 3", Value(7), store);
+            compileAndAssert("x + x * 2", Value(3), store);
+            compileAndAssert("-x", Value(-1), store);
+            compileAndAssert("s", Value(longString), store);
+            compileAndAssert("s + \"!\"", Value(longString + "!"), store);
+            compileAndAssert("y", Value::Undefined, store);
+            compileAndAssert("[ 0..1, x ]", Value(ArrayType({ Value(0), Value(1), Value(1) })), store);
+            compileAndAssert("{ \"path\": s, \"skin\": x + 1 }", Value(MapType({ { "path", Value(longString) }, { "skin", Value(2) } })), store);
+
+            // auto ranges refer to the innermost subscript
+            compileAndAssert("a[1..]", Value(ArrayType({ Value(2), Value(3) })), store);
+            compileAndAssert("a[..1]", Value(ArrayType({ Value(3), Value(2) })), store);
+            compileAndAssert("a[[ 1, 2, 0 ][1..][0]..]", Value(ArrayType({ Value(3) })), store);
+
+            // the right operand is not evaluated if the left operand decides the result
+            compileAndAssert("x == 2 && a[3] == 1", Value(false), store);
+            compileAndAssert("x == 1 || a[3] == 1", Value(true), store);
+
+            compileAndAssert("x == 2 -> \"two\"", Value::Undefined, store);
+            compileAndAssert("{{ x == 2 -> \"two\", x == 1 -> \"one\", \"other\" }}", Value("one"), store);
+            compileAndAssert("{{ x == 2 -> \"two\", \"other\" }}", Value("other"), store);
+
+            ASSERT_THROW(CompiledExpression(IO::ELParser::parseStrict("a[x + 5]")).evaluate(store), IndexOutOfBoundsError);
+        }
+
         void evalutateComparisonAndAssert(const std::string& op, bool result) {
             const std::string expression = "4 " + op + " 5";
             evaluateAndAssert(expression, result);
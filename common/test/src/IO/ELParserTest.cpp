@@ -324,5 +324,15 @@ namespace TrenchBroom {
             ASSERT_EL_EQ(9.0, "(2+1)*(2+1)");
             ASSERT_EL_EQ(12.0, "(2+1)*((1+1)*2)");
         }
+
+        TEST_CASE("ELParserTest.subscriptStringValueOutlivesTemporary", "[ELParserTest]") {
+            const EL::Value value = ELParser::parseStrict(R"({ "name": "abc", "path": "textures/base" })").evaluate(EL::EvaluationContext());
+
+            // the values returned by the subscript operator are temporaries, but they share the strings of the map
+            const std::string& name = value["name"].stringValue();
+            const std::string& path = value["path"].stringValue();
+            ASSERT_EQ("abc", name);
+            ASSERT_EQ("textures/base", path);
+        }
     }
 }
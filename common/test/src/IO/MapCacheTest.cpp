@@ -0,0 +1,217 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "Logger.h"
+#include "TestLogger.h"
+#include "IO/DiskIO.h"
+#include "IO/MapCache.h"
+#include "IO/NodeWriter.h"
+#include "IO/Path.h"
+#include "IO/TestEnvironment.h"
+#include "IO/TestParserStatus.h"
+#include "IO/WorldReader.h"
+#include "Model/BrushNode.h"
+#include "Model/LayerNode.h"
+#include "Model/WorldNode.h"
+
+#include <vecmath/bbox.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace TrenchBroom {
+    namespace IO {
+        static const std::string CachedMap(R"(// entity 0
+{
+"classname" "worldspawn"
+"message" "cached"
+"mapversion" "220"
+{
+( -32 -32 -16 ) ( -32 -31 -16 ) ( -32 -32 -15 ) rtz/c_mf_v3c [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( -32 -32 -16 ) ( -32 -32 -15 ) ( -31 -32 -16 ) rtz/b_rc_v16w [ 1 0 0 8 ] [ 0 0 -1 0 ] 0 0.5 1
+( -32 -32 -16 ) ( -31 -32 -16 ) ( -32 -31 -16 ) rtz/c_mf_v3c [ -1 0 0 0 ] [ 0 -1 0 0 ] 90 1 1
+( 32 32 16 ) ( 32 33 16 ) ( 33 32 16 ) rtz/c_mf_v3c [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 32 32 16 ) ( 33 32 16 ) ( 32 32 17 ) rtz/c_mf_v3c [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 32 32 16 ) ( 32 32 17 ) ( 32 33 16 ) rtz/c_mf_v3c [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+}
+}
+// entity 1
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_name" "My Layer"
+"_tb_id" "1"
+"_tb_layer_sort_index" "0"
+}
+// entity 2
+{
+"classname" "func_group"
+"_tb_type" "_tb_group"
+"_tb_name" "My Group"
+"_tb_id" "2"
+"_tb_layer" "1"
+{
+( 64 64 0 ) ( 64 65 0 ) ( 64 64 1 ) __TB_empty [ 0 -1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 64 64 0 ) ( 64 64 1 ) ( 65 64 0 ) __TB_empty [ 1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 64 64 0 ) ( 65 64 0 ) ( 64 65 0 ) __TB_empty [ -1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 128 128 64 ) ( 128 129 64 ) ( 129 128 64 ) __TB_empty [ 1 0 0 0 ] [ 0 -1 0 0 ] 0 1 1
+( 128 128 64 ) ( 129 128 64 ) ( 128 128 65 ) __TB_empty [ -1 0 0 0 ] [ 0 0 -1 0 ] 0 1 1
+( 128 128 64 ) ( 128 128 65 ) ( 128 129 64 ) __TB_empty [ 0 1 0 0 ] [ 0 0 -1 0 ] 0 1 1
+}
+}
+// entity 3
+{
+"classname" "light"
+"origin" "0 0 64"
+"_tb_group" "2"
+}
+)");
+
+        static std::string writeWorld(const Model::WorldNode& world) {
+            std::stringstream str;
+            NodeWriter writer(world, str);
+            writer.writeMap();
+            return str.str();
+        }
+
+        TEST_CASE("MapCacheTest.replayCachedMap", "[MapCacheTest]") {
+            TestEnvironment env("mapcachetest");
+            const auto cachePath = mapCachePath(env.dir() + Path("test.map"));
+            ASSERT_EQ(env.dir() + Path("test.map.tbcache"), cachePath);
+
+            const auto* begin = CachedMap.data();
+            const auto* end = begin + CachedMap.size();
+            const vm::bbox3 worldBounds(8192.0);
+
+            TestParserStatus status;
+
+            MapCacheWriter cacheWriter;
+            WorldReader parsedReader(begin, end);
+            parsedReader.setCacheWriter(&cacheWriter);
+            auto parsedWorld = parsedReader.read(Model::MapFormat::Valve, worldBounds, status);
+            cacheWriter.write(cachePath, begin, end);
+
+            const auto cache = MapCacheReader::open(cachePath, begin, end, Model::MapFormat::Valve);
+            ASSERT_NE(nullptr, cache);
+
+            WorldReader cachedReader(begin, end);
+            auto cachedWorld = cachedReader.read(*cache, worldBounds, status);
+
+            ASSERT_EQ(writeWorld(*parsedWorld), writeWorld(*cachedWorld));
+            ASSERT_EQ(parsedWorld->customLayers().size(), cachedWorld->customLayers().size());
+
+            const auto* parsedBrush = static_cast<Model::BrushNode*>(parsedWorld->defaultLayer()->children().front());
+            const auto* cachedBrush = static_cast<Model::BrushNode*>(cachedWorld->defaultLayer()->children().front());
+            ASSERT_EQ(parsedBrush->lineNumber(), cachedBrush->lineNumber());
+            ASSERT_EQ(parsedBrush->logicalBounds(), cachedBrush->logicalBounds());
+        }
+
+        TEST_CASE("MapCacheTest.readWorldWithCacheLogsRecordedMessages", "[MapCacheTest]") {
+            TestEnvironment env("mapcachetest");
+            const auto mapPath = env.dir() + Path("test.map");
+
+            // the parser warns about the duplicate attribute, which is not reported when replaying the cache
+            auto map = CachedMap;
+            map.replace(map.find("\"message\" \"cached\""), 0u, "\"message\" \"duplicate\"\n");
+            const auto* begin = map.data();
+            const auto* end = begin + map.size();
+            const vm::bbox3 worldBounds(8192.0);
+
+            TestLogger parseLogger;
+            auto parsedWorld = readWorldWithCache(mapPath, begin, end, Model::MapFormat::Valve, worldBounds, parseLogger);
+            ASSERT_TRUE(Disk::fileExists(mapCachePath(mapPath)));
+            ASSERT_LT(0u, parseLogger.countMessages());
+
+            TestLogger cacheLogger;
+            auto cachedWorld = readWorldWithCache(mapPath, begin, end, Model::MapFormat::Valve, worldBounds, cacheLogger);
+            ASSERT_EQ(writeWorld(*parsedWorld), writeWorld(*cachedWorld));
+
+            // the recorded messages plus the notice that the cache was used
+            ASSERT_EQ(parseLogger.countMessages() + 1u, cacheLogger.countMessages());
+            ASSERT_EQ(parseLogger.countMessages(LogLevel::Info) + 1u, cacheLogger.countMessages(LogLevel::Info));
+        }
+
+        TEST_CASE("MapCacheTest.ignoreStaleCache", "[MapCacheTest]") {
+            TestEnvironment env("mapcachetest");
+            const auto cachePath = mapCachePath(env.dir() + Path("test.map"));
+
+            const auto* begin = CachedMap.data();
+            const auto* end = begin + CachedMap.size();
+
+            ASSERT_EQ(nullptr, MapCacheReader::open(cachePath, begin, end, Model::MapFormat::Valve));
+
+            TestParserStatus status;
+            MapCacheWriter cacheWriter;
+            WorldReader reader(begin, end);
+            reader.setCacheWriter(&cacheWriter);
+            reader.read(Model::MapFormat::Valve, vm::bbox3(8192.0), status);
+            cacheWriter.write(cachePath, begin, end);
+
+            auto changedMap = CachedMap;
+            changedMap.replace(changedMap.find("cached"), 6u, "change");
+            const auto* changedBegin = changedMap.data();
+            const auto* changedEnd = changedBegin + changedMap.size();
+
+            ASSERT_NE(nullptr, MapCacheReader::open(cachePath, begin, end, Model::MapFormat::Valve));
+            ASSERT_EQ(nullptr, MapCacheReader::open(cachePath, changedBegin, changedEnd, Model::MapFormat::Valve));
+            ASSERT_EQ(nullptr, MapCacheReader::open(cachePath, begin, end, Model::MapFormat::Standard));
+        }
+
+        TEST_CASE("MapCacheTest.ignoreCorruptCache", "[MapCacheTest]") {
+            TestEnvironment env("mapcachetest");
+            const auto mapPath = env.dir() + Path("test.map");
+            const auto cachePath = mapCachePath(mapPath);
+
+            const auto* begin = CachedMap.data();
+            const auto* end = begin + CachedMap.size();
+            const vm::bbox3 worldBounds(8192.0);
+
+            TestLogger parseLogger;
+            auto parsedWorld = readWorldWithCache(mapPath, begin, end, Model::MapFormat::Valve, worldBounds, parseLogger);
+
+            // overwrite the length prefix of the first attribute name with a huge value
+            std::string cache;
+            {
+                std::ifstream stream(cachePath.asString(), std::ios::in | std::ios::binary);
+                cache.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            }
+            const auto namePos = cache.find("classname");
+            ASSERT_NE(std::string::npos, namePos);
+            cache.replace(namePos - sizeof(std::uint64_t), sizeof(std::uint64_t), sizeof(std::uint64_t), '\xff');
+            {
+                std::ofstream stream(cachePath.asString(), std::ios::out | std::ios::binary | std::ios::trunc);
+                stream.write(cache.data(), static_cast<std::streamsize>(cache.size()));
+            }
+
+            TestLogger cacheLogger;
+            auto cachedWorld = readWorldWithCache(mapPath, begin, end, Model::MapFormat::Valve, worldBounds, cacheLogger);
+            ASSERT_EQ(writeWorld(*parsedWorld), writeWorld(*cachedWorld));
+
+            // the map is parsed again and the corrupt cache is reported
+            ASSERT_EQ(parseLogger.countMessages(LogLevel::Warn) + 1u, cacheLogger.countMessages(LogLevel::Warn));
+        }
+    }
+}
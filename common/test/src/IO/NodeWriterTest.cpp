@@ -33,8 +33,11 @@
 
 #include <kdl/string_compare.h>
 
+#include <cstdio>
 #include <iostream>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 namespace TrenchBroom {
@@ -492,6 +495,36 @@ R"(// entity 0
             ASSERT_TRUE(kdl::cs::str_matches_glob(actual, expected));
         }
 
+        TEST_CASE("NodeWriterTest.writeClonedWorld", "[NodeWriterTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::WorldNode map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+            map.addOrUpdateAttribute("message", "holy damn");
+            map.defaultLayer()->setLayerColor(Color(0.25f, 0.75f, 1.0f));
+
+            Model::BrushBuilder builder(&map, worldBounds);
+
+            Model::GroupNode* group = map.createGroup("Group");
+            map.defaultLayer()->addChild(group);
+            group->addChild(map.createBrush(builder.createCube(64.0, "none")));
+
+            Model::LayerNode* layer = map.createLayer("Custom Layer");
+            layer->setSortIndex(1);
+            map.addChild(layer);
+            layer->addChild(map.createBrush(builder.createCube(32.0, "none")));
+
+            std::stringstream expected;
+            NodeWriter(map, expected).writeMap();
+
+            auto clone = std::unique_ptr<Model::WorldNode>(static_cast<Model::WorldNode*>(map.cloneRecursively(worldBounds)));
+
+            std::stringstream actual;
+            NodeWriter(*clone, actual).writeMap();
+
+            CHECK(actual.str() == expected.str());
+        }
+
         TEST_CASE("NodeWriterTest.writeNodesWithNestedGroup", "[NodeWriterTest]") {
             const vm::bbox3 worldBounds(8192.0);
 
@@ -580,6 +613,61 @@ R"(( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
             delete brushNode;
         }
 
+        TEST_CASE("NodeWriterTest.writeManyBrushesToFile", "[NodeWriterTest]") {
+            const vm::bbox3 worldBounds(8192.0);
+
+            Model::WorldNode map(Model::MapFormat::Standard);
+            map.addOrUpdateAttribute("classname", "worldspawn");
+
+            // enough faces to be formatted on multiple threads
+            const size_t brushCount = 200u;
+            Model::BrushBuilder builder(&map, worldBounds);
+            std::vector<Model::BrushNode*> brushNodes;
+            for (size_t i = 0u; i < brushCount; ++i) {
+                brushNodes.push_back(map.createBrush(builder.createCube(64.0, "none")));
+                map.defaultLayer()->addChild(brushNodes.back());
+            }
+
+            FILE* file = std::tmpfile();
+            REQUIRE(file != nullptr);
+            {
+                NodeWriter writer(map, file);
+                writer.writeMap();
+            }
+
+            std::rewind(file);
+            std::string actual;
+            char buffer[4096];
+            for (size_t read = std::fread(buffer, 1u, sizeof(buffer), file); read > 0u; read = std::fread(buffer, 1u, sizeof(buffer), file)) {
+                actual.append(buffer, read);
+            }
+            std::fclose(file);
+
+            std::string expected = "// entity 0\n{\n\"classname\" \"worldspawn\"\n";
+            for (size_t i = 0u; i < brushCount; ++i) {
+                expected += "// brush " + std::to_string(i) + "\n";
+                expected +=
+R"({
+( -32 -32 -32 ) ( -32 -31 -32 ) ( -32 -32 -31 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -32 -32 -31 ) ( -31 -32 -32 ) none 0 0 0 1 1
+( -32 -32 -32 ) ( -31 -32 -32 ) ( -32 -31 -32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 33 32 ) ( 33 32 32 ) none 0 0 0 1 1
+( 32 32 32 ) ( 33 32 32 ) ( 32 32 33 ) none 0 0 0 1 1
+( 32 32 32 ) ( 32 32 33 ) ( 32 33 32 ) none 0 0 0 1 1
+}
+)";
+            }
+            expected += "}\n";
+
+            ASSERT_EQ(expected, actual);
+
+            // the brush starts at its opening brace, and its faces follow on separate lines
+            const auto* lastBrushNode = brushNodes.back();
+            const auto lastBrushLine = 5u + 9u * (brushCount - 1u);
+            ASSERT_EQ(lastBrushLine, lastBrushNode->lineNumber());
+            ASSERT_EQ(lastBrushLine + 6u, lastBrushNode->brush().faces().back().lineNumber());
+        }
+
         TEST_CASE("NodeWriterTest.writePropertiesWithQuotationMarks", "[NodeWriterTest]") {
             Model::WorldNode map(Model::MapFormat::Standard);
             map.addOrUpdateAttribute("classname", "worldspawn");
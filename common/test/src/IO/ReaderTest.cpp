@@ -21,10 +21,12 @@
 
 #include "GTestCompat.h"
 
+#include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
 #include "IO/Reader.h"
 #include "IO/ReaderException.h"
+#include "IO/TestEnvironment.h"
 
 #include <memory>
 #include <string>
@@ -193,5 +195,51 @@ namespace TrenchBroom {
         TEST_CASE("FileReaderTest.testSubReader", "[FileReaderTest]") {
             subReader(file()->reader());
         }
+
+        TEST_CASE("CFileReaderTest.createEmpty", "[CFileReaderTest]") {
+            const auto emptyFile = CFile(Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Reader/empty"));
+            createEmpty(emptyFile.reader());
+        }
+
+        TEST_CASE("CFileReaderTest.read", "[CFileReaderTest]") {
+            const auto cFile = CFile(Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Reader/10byte"));
+            createNonEmpty(cFile.reader());
+            seekFromBegin(cFile.reader());
+            seekFromEnd(cFile.reader());
+            seekForward(cFile.reader());
+            subReader(cFile.reader());
+        }
+
+        TEST_CASE("MappedFileReaderTest.bufferDoesNotCopy", "[MappedFileReaderTest]") {
+            const auto mappedFile = MappedFile(Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Reader/10byte"));
+            ASSERT_EQ(10U, mappedFile.size());
+
+            const auto bufferedReader = mappedFile.reader().buffer();
+            ASSERT_EQ(mappedFile.begin(), bufferedReader.begin());
+            ASSERT_EQ(mappedFile.end(), bufferedReader.end());
+            ASSERT_EQ(std::string("abcdefghij"), std::string(bufferedReader.begin(), bufferedReader.end()));
+        }
+
+        TEST_CASE("MappedFileReaderTest.readerOutlivesFile", "[MappedFileReaderTest]") {
+            auto mappedFile = std::make_unique<MappedFile>(Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Reader/10byte"));
+            auto reader = mappedFile->reader().subReaderFromBegin(2u, 4u);
+            const auto bufferedReader = mappedFile->reader().buffer();
+            mappedFile.reset();
+
+            ASSERT_EQ(std::string("cdef"), reader.readString(4u));
+            ASSERT_EQ(std::string("abcdefghij"), std::string(bufferedReader.begin(), bufferedReader.end()));
+        }
+
+        TEST_CASE("MappedFileReaderTest.changedFileThrows", "[MappedFileReaderTest]") {
+            TestEnvironment env("MappedFileReaderTest");
+            env.createFile(Path("file"), "abcdefghij");
+
+            const auto mappedFile = MappedFile(env.dir() + Path("file"));
+            ASSERT_NO_THROW(mappedFile.reader());
+
+            env.createFile(Path("file"), "abcdefghijklmnop");
+            ASSERT_THROW(mappedFile.ensureUnchanged(), FileSystemException);
+            ASSERT_THROW(mappedFile.reader(), FileSystemException);
+        }
     }
 }
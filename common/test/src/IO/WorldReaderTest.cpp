@@ -21,6 +21,7 @@
 
 #include "GTestCompat.h"
 
+#include "Logger.h"
 #include "IO/DiskIO.h"
 #include "IO/File.h"
 #include "IO/TestParserStatus.h"
@@ -35,7 +36,9 @@
 
 #include <vecmath/vec.h>
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -1374,5 +1377,112 @@ common/caulk
                 CHECK(face.attributes().textureName() == Model::BrushFaceAttributes::NoTextureName);
             }
         }
+
+        TEST_CASE("WorldReaderTest.parseManyBrushesKeepsFileOrder", "[WorldReaderTest]") {
+            std::string data = R"(
+{
+"classname" "worldspawn"
+)";
+            // each brush spans 8 lines, the first brush starts at line 4
+            const size_t brushCount = 64u;
+            for (size_t i = 0u; i < brushCount; ++i) {
+                const auto x = std::to_string(i * 64u);
+                const auto x1 = std::to_string(i * 64u + 1u);
+                const auto x2 = std::to_string(i * 64u + 64u);
+                const auto x3 = std::to_string(i * 64u + 65u);
+                data += "{\n";
+                data += "( " + x + " 0 0 ) ( " + x + " 1 0 ) ( " + x + " 0 1 ) tex1 0 0 0 1 1\n";
+                data += "( " + x + " 0 0 ) ( " + x + " 0 1 ) ( " + x1 + " 0 0 ) tex1 0 0 0 1 1\n";
+                data += "( " + x + " 0 0 ) ( " + x1 + " 0 0 ) ( " + x + " 1 0 ) tex1 0 0 0 1 1\n";
+                data += "( " + x2 + " 64 64 ) ( " + x2 + " 65 64 ) ( " + x3 + " 64 64 ) tex1 0 0 0 1 1\n";
+                data += "( " + x2 + " 64 64 ) ( " + x3 + " 64 64 ) ( " + x2 + " 64 65 ) tex1 0 0 0 1 1\n";
+                data += "( " + x2 + " 64 64 ) ( " + x2 + " 64 65 ) ( " + x2 + " 65 64 ) tex1 0 0 0 1 1\n";
+                data += "}\n";
+            }
+            // an empty brush, followed by a point entity
+            data += R"({
+( 64 0 0 ) ( 64 1 0 ) ( 64 0 1 ) tex1 0 0 0 1 1
+( 0 64 64 ) ( 0 64 65 ) ( 0 65 64 ) tex1 0 0 0 1 1
+}
+}
+{
+"classname" "info_player_deathmatch"
+"origin" "1 22 -3"
+}
+)";
+
+            const vm::bbox3 worldBounds(8192.0);
+
+            IO::TestParserStatus status;
+            WorldReader reader(data);
+
+            auto world = reader.read(Model::MapFormat::Standard, worldBounds, status);
+            CHECK(status.countStatus(LogLevel::Error) == 1u);
+
+            Model::LayerNode* defaultLayer = world->defaultLayer();
+            REQUIRE(defaultLayer->childCount() == brushCount + 1u);
+
+            const auto& children = defaultLayer->children();
+            for (size_t i = 0u; i < brushCount; ++i) {
+                const auto* brushNode = dynamic_cast<Model::BrushNode*>(children[i]);
+                REQUIRE(brushNode != nullptr);
+                CHECK(brushNode->lineNumber() == 4u + i * 8u);
+                CHECK(brushNode->logicalBounds().min.x() == static_cast<FloatType>(i * 64u));
+            }
+
+            CHECK(dynamic_cast<Model::EntityNode*>(children.back()) != nullptr);
+        }
+
+        namespace {
+            class MessageRecordingParserStatus : public ParserStatus {
+            private:
+                NullLogger m_logger;
+            public:
+                std::vector<std::string> messages;
+
+                MessageRecordingParserStatus() :
+                ParserStatus(m_logger, "") {}
+            private:
+                void doProgress(const double /* progress */) override {}
+
+                void doLog(const LogLevel /* level */, const std::string& str) override {
+                    messages.push_back(str);
+                }
+            };
+        }
+
+        TEST_CASE("WorldReaderTest.reportBrushErrorsInFileOrder", "[WorldReaderTest]") {
+            // an empty brush, followed by a layer without a name
+            const std::string data(R"(
+{
+"classname" "worldspawn"
+{
+( 64 0 0 ) ( 64 1 0 ) ( 64 0 1 ) tex1 0 0 0 1 1
+( 0 64 64 ) ( 0 64 65 ) ( 0 65 64 ) tex1 0 0 0 1 1
+}
+}
+{
+"classname" "func_group"
+"_tb_type" "_tb_layer"
+"_tb_id" "1"
+}
+)");
+
+            MessageRecordingParserStatus status;
+            WorldReader reader(data);
+            reader.read(Model::MapFormat::Standard, vm::bbox3(8192.0), status);
+
+            const auto findMessage = [&](const std::string& prefix) {
+                return std::find_if(std::begin(status.messages), std::end(status.messages), [&](const std::string& message) {
+                    return message.compare(0u, prefix.size(), prefix) == 0;
+                });
+            };
+
+            const auto brushError = findMessage("Skipping brush");
+            const auto layerError = findMessage("Skipping layer entity");
+            REQUIRE(brushError != std::end(status.messages));
+            REQUIRE(layerError != std::end(status.messages));
+            CHECK(brushError < layerError);
+        }
     }
 }
@@ -24,11 +24,18 @@
 #include "Exceptions.h"
 #include "IO/DiskIO.h"
 #include "IO/DiskFileSystem.h"
+#include "IO/File.h"
 #include "IO/FileMatcher.h"
+#include "IO/Reader.h"
+#include "IO/TestEnvironment.h"
 #include "IO/ZipFileSystem.h"
+#include "IO/ZipIndexCache.h"
 
 #include <algorithm>
 #include <cassert>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace TrenchBroom {
     namespace IO {
@@ -140,7 +147,67 @@ namespace TrenchBroom {
             ASSERT_THROW(fs.openFile(Path("/amnet.cfg")), FileSystemException);
             ASSERT_THROW(fs.openFile(Path("/textures")), FileSystemException);
 
-            ASSERT_TRUE(fs.openFile(Path("amnet.cfg")) != nullptr);
+            const auto file = fs.openFile(Path("amnet.cfg"));
+            ASSERT_TRUE(file != nullptr);
+            ASSERT_EQ(Path("amnet.cfg"), file->path());
+            ASSERT_EQ(447u, file->size());
+        }
+
+        TEST_CASE("ZipFileSystemTest.openFiles", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+
+            const ZipFileSystem fs(zipPath);
+            const auto paths = std::vector<Path>{
+                Path("textures/e1u1/box1_3.wal"),
+                Path("does_not_exist.cfg"),
+                Path("bear.cfg"),
+                Path("/amnet.cfg")
+            };
+
+            std::vector<std::string> errors;
+            const auto files = fs.openFiles(paths, errors);
+            ASSERT_EQ(2u, files.size());
+            ASSERT_EQ(Path("textures/e1u1/box1_3.wal"), files[0]->path());
+            ASSERT_EQ(4180u, files[0]->size());
+            ASSERT_EQ(Path("bear.cfg"), files[1]->path());
+            ASSERT_EQ(1489u, files[1]->size());
+            ASSERT_EQ(2u, errors.size());
+        }
+
+        TEST_CASE("ZipFileSystemTest.indexCache", "[ZipFileSystemTest]") {
+            const Path zipPath = Disk::getCurrentWorkingDir() + Path("fixture/test/IO/Zip/zip_test.zip");
+            const auto archiveSize = static_cast<std::uint64_t>(Disk::openFile(zipPath)->size());
+            const auto modificationTime = Disk::modificationTime(zipPath);
+
+            TestEnvironment env("zipindexcachetest");
+            const auto cache = std::make_shared<ZipIndexCache>(env.dir() + Path("cache"));
+            ASSERT_FALSE(cache->load(zipPath, archiveSize, modificationTime).has_value());
+
+            // reading the archive populates the cache
+            const ZipFileSystem uncachedFS(nullptr, zipPath, cache);
+            ASSERT_TRUE(Disk::fileExists(cache->cacheFilePath(zipPath)));
+
+            const auto entries = cache->load(zipPath, archiveSize, modificationTime);
+            ASSERT_TRUE(entries.has_value());
+            ASSERT_EQ(11u, entries->size());
+
+            // a changed archive does not match the cache
+            ASSERT_FALSE(cache->load(zipPath, archiveSize + 1u, modificationTime).has_value());
+            ASSERT_FALSE(cache->load(zipPath, archiveSize, modificationTime + 1).has_value());
+            ASSERT_FALSE(cache->load(zipPath.deleteLastComponent() + Path("other.zip"), archiveSize, modificationTime).has_value());
+
+            // the cached entries give the same files
+            const ZipFileSystem cachedFS(nullptr, zipPath, cache);
+            ASSERT_EQ(uncachedFS.findItemsRecursively(Path("")), cachedFS.findItemsRecursively(Path("")));
+
+            for (const auto& path : cachedFS.findItemsRecursively(Path(""), FileExtensionMatcher("wal"))) {
+                const auto expectedFile = uncachedFS.openFile(path);
+                const auto actualFile = cachedFS.openFile(path);
+
+                auto expectedReader = expectedFile->reader().buffer();
+                auto actualReader = actualFile->reader().buffer();
+                ASSERT_EQ(std::string(expectedReader.begin(), expectedReader.end()), std::string(actualReader.begin(), actualReader.end()));
+            }
         }
     }
 }
@@ -434,6 +434,31 @@ namespace TrenchBroom {
             CHECK(brush.bounds().size().z() == 7.0);
         }
 
+        TEST_CASE("BrushTest.copySharesGeometry", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            WorldNode world(MapFormat::Standard);
+            const BrushBuilder builder(&world, worldBounds);
+            const Brush original = builder.createCube(64.0, "texture");
+
+            Brush copy = original;
+            CHECK(copy.sharesGeometryWith(original));
+            for (size_t i = 0u; i < copy.faceCount(); ++i) {
+                CHECK(copy.face(i).polygon() == original.face(i).polygon());
+            }
+
+            // the shared geometry is not counted
+            CHECK(copy.memorySize() < Brush(worldBounds, copy.faces()).memorySize());
+
+            const auto topFaceIndex = copy.findFace(vm::vec3::pos_z());
+            REQUIRE(topFaceIndex);
+
+            // changing the copy replaces its geometry and leaves the original unchanged
+            copy.moveBoundary(worldBounds, *topFaceIndex, vm::vec3(0.0, 0.0, 16.0), false);
+            CHECK_FALSE(copy.sharesGeometryWith(original));
+            CHECK(copy.bounds().size().z() == 80.0);
+            CHECK(original.bounds().size().z() == 64.0);
+        }
+
         TEST_CASE("BrushTest.resizePastWorldBounds", "[BrushTest]") {
             const vm::bbox3 worldBounds(8192.0);
             WorldNode world(MapFormat::Standard);
@@ -530,6 +555,38 @@ namespace TrenchBroom {
             assertTexture("bottom", brush, p1, p3, p7, p5);
         }
 
+        TEST_CASE("BrushTest.moveVertexWithCheckedGeometry", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            WorldNode world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            const Brush brush = builder.createCube(64.0, "left", "right", "front", "back", "top", "bottom");
+
+            const vm::vec3 p8(+32.0, +32.0, +32.0);
+            const vm::vec3 p9(+16.0, +16.0, +32.0);
+            const std::vector<vm::vec3> vertexPositions(1, p8);
+
+            const auto result = brush.checkMoveVertices(worldBounds, vertexPositions, p9 - p8);
+            ASSERT_TRUE(result.success);
+            ASSERT_NE(nullptr, result.geometry);
+
+            Brush expected = brush;
+            const std::vector<vm::vec3> expectedPositions = expected.moveVertices(worldBounds, vertexPositions, p9 - p8);
+
+            Brush actual = brush;
+            const std::vector<vm::vec3> actualPositions = actual.moveVertices(worldBounds, vertexPositions, p9 - p8, *result.geometry);
+
+            ASSERT_EQ(expectedPositions, actualPositions);
+            ASSERT_EQ(expected.vertexPositions(), actual.vertexPositions());
+            for (const BrushFace& face : expected.faces()) {
+                const auto faceIndex = actual.findFace(face.polygon());
+                ASSERT_TRUE(faceIndex.has_value());
+                ASSERT_EQ(face.attributes().textureName(), actual.face(*faceIndex).attributes().textureName());
+            }
+
+            ASSERT_FALSE(brush.checkMoveVertices(worldBounds, vertexPositions, vm::vec3(0, 0, 0)).success);
+        }
+
         TEST_CASE("BrushTest.moveTetrahedronVertexToOpposideSide", "[BrushTest]") {
             const vm::bbox3 worldBounds(4096.0);
             WorldNode world(MapFormat::Standard);
@@ -3144,6 +3201,56 @@ namespace TrenchBroom {
             ASSERT_EQ(0u, result.size());
         }
 
+        TEST_CASE("BrushTest.subtractAll", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            WorldNode world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            const Brush minuend1 = builder.createCuboid(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(64.0, 64.0, 64.0)), "minuend");
+            const Brush minuend2 = builder.createCuboid(vm::bbox3(vm::vec3(256.0, 0.0, 0.0), vm::vec3(320.0, 64.0, 64.0)), "minuend");
+
+            // together, the subtrahends cut off the top of minuend1 and do not touch minuend2
+            const Brush subtrahend1 = builder.createCuboid(vm::bbox3(vm::vec3(-16.0, -16.0, 48.0), vm::vec3(32.0, 80.0, 80.0)), "subtrahend");
+            const Brush subtrahend2 = builder.createCuboid(vm::bbox3(vm::vec3(32.0, -16.0, 48.0), vm::vec3(80.0, 80.0, 80.0)), "subtrahend");
+
+            const auto result = Brush::subtractAll(world, worldBounds, "default", { &minuend1, &minuend2 }, { &subtrahend1, &subtrahend2 });
+            ASSERT_EQ(2u, result.size());
+
+            // the fragments of minuend1 are merged into a single brush
+            ASSERT_EQ(1u, result[0].size());
+            ASSERT_EQ(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(64.0, 64.0, 48.0)), result[0][0].bounds());
+            ASSERT_EQ(6u, result[0][0].faceCount());
+            ASSERT_EQ("subtrahend", result[0][0].face(*result[0][0].findFace(vm::vec3::pos_z())).attributes().textureName());
+            ASSERT_EQ("minuend", result[0][0].face(*result[0][0].findFace(vm::vec3::neg_z())).attributes().textureName());
+
+            ASSERT_EQ(1u, result[1].size());
+            ASSERT_COLLECTIONS_EQUIVALENT(minuend2.vertexPositions(), result[1][0].vertexPositions());
+        }
+
+        TEST_CASE("BrushTest.subtractAllKeepsNonConvexUnionsApart", "[BrushTest]") {
+            const vm::bbox3 worldBounds(4096.0);
+            WorldNode world(MapFormat::Standard);
+
+            BrushBuilder builder(&world, worldBounds);
+            const Brush minuend = builder.createCuboid(vm::bbox3(vm::vec3(0.0, 0.0, 0.0), vm::vec3(64.0, 64.0, 64.0)), "minuend");
+
+            // cuts a notch out of one edge of the minuend, so the remainder is not convex
+            const Brush subtrahend = builder.createCuboid(vm::bbox3(vm::vec3(32.0, 32.0, -16.0), vm::vec3(80.0, 80.0, 80.0)), "subtrahend");
+
+            const auto result = Brush::subtractAll(world, worldBounds, "default", { &minuend }, { &subtrahend });
+            ASSERT_EQ(1u, result.size());
+            ASSERT_EQ(2u, result[0].size());
+
+            // the fragments are cuboids that fill the remainder without overlapping the notch
+            FloatType volume = 0.0;
+            for (const auto& fragment : result[0]) {
+                ASSERT_EQ(6u, fragment.faceCount());
+                const auto size = fragment.bounds().size();
+                volume += size.x() * size.y() * size.z();
+            }
+            ASSERT_DOUBLE_EQ(64.0 * 64.0 * 64.0 - 32.0 * 32.0 * 64.0, volume);
+        }
+
         TEST_CASE("BrushTest.subtractTruncatedCones", "[BrushTest]") {
             // https://github.com/kduske/TrenchBroom/issues/1469
 
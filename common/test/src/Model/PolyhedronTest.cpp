@@ -35,6 +35,7 @@
 #include <vecmath/vec_io.h>
 
 #include <iterator>
+#include <memory>
 #include <tuple>
 #include <set>
 
@@ -134,6 +135,129 @@ namespace TrenchBroom {
             ASSERT_EQ(original.bounds(), rhs.bounds());
         }
 
+        TEST_CASE("PolyhedronTest.allocationPolicies", "[PolyhedronTest]") {
+            using PoolPolyhedron3d = Polyhedron<double, DefaultPolyhedronPayload, DefaultPolyhedronPayload, Polyhedron_PoolAllocator>;
+
+            const vm::bbox3d bounds(vm::vec3d(-16.0, -16.0, -16.0), vm::vec3d(16.0, 16.0, 16.0));
+            const vm::plane3d plane(vm::vec3d::zero(), vm::normalize(vm::vec3d(1.0, 1.0, 1.0)));
+
+            auto arenaPolyhedron = Polyhedron3d(bounds);
+            auto poolPolyhedron = PoolPolyhedron3d(bounds);
+            CHECK(arenaPolyhedron.clip(plane).success());
+            CHECK(poolPolyhedron.clip(plane).success());
+
+            CHECK(arenaPolyhedron.vertexCount() == poolPolyhedron.vertexCount());
+            CHECK(arenaPolyhedron.edgeCount() == poolPolyhedron.edgeCount());
+            CHECK(arenaPolyhedron.faceCount() == poolPolyhedron.faceCount());
+            CHECK(hasVertices(arenaPolyhedron, poolPolyhedron.vertexPositions()));
+
+            // the copy allocates its elements from its own arena and outlives the original
+            auto copy = std::make_unique<Polyhedron3d>(arenaPolyhedron);
+            arenaPolyhedron = Polyhedron3d(vm::bbox3d(8.0));
+            CHECK(hasVertices(*copy, poolPolyhedron.vertexPositions()));
+
+            // moving into a non-empty polyhedron releases its previous elements first
+            arenaPolyhedron = std::move(*copy);
+            copy.reset();
+            CHECK(arenaPolyhedron.clip(vm::plane3d(0.0, vm::vec3d::pos_z())).success());
+            CHECK(arenaPolyhedron.polyhedron());
+        }
+
+        TEST_CASE("PolyhedronTest.arenaMemoryOfCube", "[PolyhedronTest]") {
+            const auto cube = Polyhedron3d(vm::bbox3d(16.0));
+            const auto elementBytes =
+                cube.vertexCount() * sizeof(PVertex) +
+                cube.edgeCount() * (sizeof(PEdge) + 2u * sizeof(PHalfEdge)) +
+                cube.faceCount() * sizeof(PFace);
+
+            // a small polyhedron must not take much more memory than its elements need
+            CHECK(cube.allocator().allocatedBytes() >= elementBytes);
+            CHECK(cube.allocator().allocatedBytes() < elementBytes + Polyhedron_Arena::PageSize);
+
+            const auto copy = Polyhedron3d(cube);
+            CHECK(copy.allocator().allocatedBytes() < elementBytes + Polyhedron_Arena::PageSize);
+        }
+
+        TEST_CASE("PolyhedronTest.fromPlanes", "[PolyhedronTest]") {
+            const auto box = std::vector<vm::plane3d>({
+                vm::plane3d(16.0, vm::vec3d::pos_x()),
+                vm::plane3d(16.0, vm::vec3d::neg_x()),
+                vm::plane3d(16.0, vm::vec3d::pos_y()),
+                vm::plane3d(16.0, vm::vec3d::neg_y()),
+                vm::plane3d(32.0, vm::vec3d::pos_z()),
+                vm::plane3d(0.0,  vm::vec3d::neg_z()),
+            });
+
+            SECTION("axis aligned box") {
+                auto result = Polyhedron3d::fromPlanes(box);
+                REQUIRE(result.has_value());
+
+                const auto& [polyhedron, faces] = *result;
+                CHECK(polyhedron.polyhedron());
+                CHECK(polyhedron.bounds() == vm::bbox3d(vm::vec3d(-16.0, -16.0, 0.0), vm::vec3d(16.0, 16.0, 32.0)));
+                REQUIRE(faces.size() == box.size());
+                for (size_t i = 0u; i < box.size(); ++i) {
+                    REQUIRE(faces[i] != nullptr);
+                    CHECK(faces[i]->plane() == box[i]);
+                }
+            }
+
+            SECTION("pyramid") {
+                const auto apex = vm::vec3d(0.0, 0.0, 32.0);
+                auto planes = std::vector<vm::plane3d>({
+                    vm::plane3d(0.0, vm::vec3d::neg_z()),
+                    vm::plane3d(apex, vm::normalize(vm::vec3d( 2.0,  0.0, 1.0))),
+                    vm::plane3d(apex, vm::normalize(vm::vec3d(-2.0,  0.0, 1.0))),
+                    vm::plane3d(apex, vm::normalize(vm::vec3d( 0.0,  2.0, 1.0))),
+                    vm::plane3d(apex, vm::normalize(vm::vec3d( 0.0, -2.0, 1.0))),
+                });
+
+                auto result = Polyhedron3d::fromPlanes(planes);
+                REQUIRE(result.has_value());
+
+                const auto& [polyhedron, faces] = *result;
+                CHECK(polyhedron.polyhedron());
+                CHECK(polyhedron.vertexCount() == 5u);
+                CHECK(polyhedron.edgeCount() == 8u);
+                CHECK(polyhedron.faceCount() == 5u);
+                CHECK(hasVertex(polyhedron, apex, vm::constants<double>::almost_zero()));
+                CHECK(hasQuadOf(polyhedron,
+                                vm::vec3d(-16.0, -16.0, 0.0),
+                                vm::vec3d(-16.0,  16.0, 0.0),
+                                vm::vec3d( 16.0,  16.0, 0.0),
+                                vm::vec3d( 16.0, -16.0, 0.0),
+                                vm::constants<double>::almost_zero()));
+
+                REQUIRE(faces.size() == planes.size());
+                for (size_t i = 0u; i < planes.size(); ++i) {
+                    REQUIRE(faces[i] != nullptr);
+                    CHECK(faces[i]->plane() == planes[i]);
+                }
+            }
+
+            SECTION("redundant plane") {
+                auto planes = box;
+                planes.push_back(vm::plane3d(64.0, vm::vec3d::pos_z()));
+
+                auto result = Polyhedron3d::fromPlanes(planes);
+                REQUIRE(result.has_value());
+
+                const auto& [polyhedron, faces] = *result;
+                CHECK(polyhedron.faceCount() == 6u);
+                REQUIRE(faces.size() == planes.size());
+                CHECK(faces.back() == nullptr);
+            }
+
+            SECTION("planes that do not bound a polyhedron") {
+                auto planes = box;
+                planes.pop_back();
+                CHECK_FALSE(Polyhedron3d::fromPlanes(planes).has_value());
+
+                planes.push_back(vm::plane3d(8.0, vm::vec3d::pos_z()));
+                CHECK_FALSE(Polyhedron3d::fromPlanes(planes).has_value());
+            }
+        }
+
         TEST_CASE("PolyhedronTest.convexHullWithFailingPoints", "[PolyhedronTest]") {
             const auto vertices = std::vector<vm::vec3>({
                 vm::vec3d(-64.0,    -45.5049, -34.4752),
@@ -246,6 +246,75 @@ namespace TrenchBroom {
             }
         }
 
+        TEST_CASE("AllocationTrackerTest.freeSize", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+            EXPECT_EQ(100u, t.freeSize());
+
+            AllocationTracker::Block* a = t.allocate(30);
+            AllocationTracker::Block* b = t.allocate(20);
+            EXPECT_EQ(50u, t.freeSize());
+
+            t.free(a);
+            EXPECT_EQ(80u, t.freeSize());
+
+            t.expand(200);
+            EXPECT_EQ(180u, t.freeSize());
+
+            t.free(b);
+            EXPECT_EQ(200u, t.freeSize());
+        }
+
+        TEST_CASE("AllocationTrackerTest.compact", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+
+            AllocationTracker::Block* blocks[5];
+            for (size_t i = 0; i < 5; ++i) {
+                blocks[i] = t.allocate(20);
+                ASSERT_NE(nullptr, blocks[i]);
+            }
+
+            t.free(blocks[0]);
+            t.free(blocks[2]);
+            EXPECT_EQ(20u, t.largestPossibleAllocation());
+
+            const auto relocations = t.compact();
+            EXPECT_EQ(3u, relocations.size());
+            EXPECT_EQ(20u, relocations[0].oldPos);
+            EXPECT_EQ(0u, relocations[0].newPos);
+            EXPECT_EQ(20u, relocations[0].size);
+            EXPECT_EQ(60u, relocations[1].oldPos);
+            EXPECT_EQ(20u, relocations[1].newPos);
+            EXPECT_EQ(80u, relocations[2].oldPos);
+            EXPECT_EQ(40u, relocations[2].newPos);
+
+            // the remaining blocks keep their identity
+            EXPECT_EQ(0u, blocks[1]->pos);
+            EXPECT_EQ(20u, blocks[3]->pos);
+            EXPECT_EQ(40u, blocks[4]->pos);
+
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{60, 40}}), t.freeBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 20}, {20, 20}, {40, 20}}), t.usedBlocks());
+            EXPECT_EQ(40u, t.freeSize());
+            EXPECT_EQ(40u, t.largestPossibleAllocation());
+
+            t.free(blocks[3]);
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{20, 20}, {60, 40}}), t.freeBlocks());
+
+            AllocationTracker::Block* large = t.allocate(40);
+            ASSERT_NE(nullptr, large);
+            EXPECT_EQ(60u, large->pos);
+        }
+
+        TEST_CASE("AllocationTrackerTest.compactWithoutFreeBlocks", "[AllocationTrackerTest]") {
+            AllocationTracker t(100);
+            t.allocate(60);
+            t.allocate(40);
+
+            EXPECT_TRUE(t.compact().empty());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{}), t.freeBlocks());
+            EXPECT_EQ((std::vector<AllocationTracker::Range>{{0, 60}, {60, 40}}), t.usedBlocks());
+        }
+
         static constexpr size_t NumBrushes = 64'000;
 
         // between 12 and 140, inclusive.
@@ -0,0 +1,154 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "SimdIntersection.h"
+
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <array>
+#include <vector>
+
+namespace TrenchBroom {
+    template <typename T>
+    static void testRayBoxTest() {
+        using V = vm::vec<T,3>;
+
+        // eight unit boxes along the x axis, every other one shifted up by 2
+        std::array<std::vector<T>, 3> min;
+        std::array<std::vector<T>, 3> max;
+        for (size_t i = 0u; i < RayBatchSize; ++i) {
+            const auto y = static_cast<T>(i % 2u == 0u ? 0 : 2);
+            const auto lower = V(static_cast<T>(2u * i), y, 0);
+            for (size_t j = 0u; j < 3u; ++j) {
+                min[j].push_back(lower[j]);
+                max[j].push_back(lower[j] + static_cast<T>(1));
+            }
+        }
+
+        const auto minPtr = std::array<const T*, 3>{ min[0].data(), min[1].data(), min[2].data() };
+        const auto maxPtr = std::array<const T*, 3>{ max[0].data(), max[1].data(), max[2].data() };
+
+        const auto hits = [&](const vm::ray<T,3>& ray, const size_t count) {
+            const RayBoxTest<T,3> test(ray);
+            const auto result = test(minPtr, maxPtr, count);
+
+            // the vectorized and the scalar code must agree
+            for (size_t i = 0u; i < count; ++i) {
+                ASSERT_EQ(test.test(minPtr, maxPtr, i), ((result & (1u << i)) != 0u));
+            }
+            return result;
+        };
+
+        // along the x axis, hitting every other box
+        ASSERT_EQ(0x55u, hits(vm::ray<T,3>(V(-1, T(0.5), T(0.5)), V::pos_x()), RayBatchSize));
+        ASSERT_EQ(0x15u, hits(vm::ray<T,3>(V(-1, T(0.5), T(0.5)), V::pos_x()), 5u));
+        ASSERT_EQ(0x54u, hits(vm::ray<T,3>(V(3, T(0.5), T(0.5)), V::pos_x()), RayBatchSize));
+        ASSERT_EQ(0x01u, hits(vm::ray<T,3>(V(3, T(0.5), T(0.5)), V::neg_x()), RayBatchSize));
+
+        // starting inside a box
+        ASSERT_EQ(0x02u, hits(vm::ray<T,3>(V(T(2.5), T(2.5), T(0.5)), V::neg_z()), RayBatchSize));
+
+        // diagonal through boxes 0 and 1
+        ASSERT_EQ(0x03u, hits(vm::ray<T,3>(V(-1, -1, T(0.5)), vm::normalize(V(1, 1, 0))), RayBatchSize));
+
+        // missing everything
+        ASSERT_EQ(0x00u, hits(vm::ray<T,3>(V(-1, T(0.5), T(0.5)), V::neg_x()), RayBatchSize));
+        ASSERT_EQ(0x00u, hits(vm::ray<T,3>(V(-1, T(1.5), T(0.5)), V::pos_x()), RayBatchSize));
+    }
+
+    TEST_CASE("SimdIntersectionTest.rayBoxTestDouble", "[SimdIntersectionTest]") {
+        testRayBoxTest<double>();
+    }
+
+    TEST_CASE("SimdIntersectionTest.rayBoxTestFloat", "[SimdIntersectionTest]") {
+        testRayBoxTest<float>();
+    }
+
+    static PlaneList<double> makeCube() {
+        // a cube from (-1 -1 -1) to (1 1 1), with more than RayBatchSize planes by repeating some
+        PlaneList<double> planes;
+        for (size_t i = 0u; i < 2u; ++i) {
+            planes.push_back(vm::plane3(1.0, vm::vec3::pos_x()));
+            planes.push_back(vm::plane3(1.0, vm::vec3::neg_x()));
+            planes.push_back(vm::plane3(1.0, vm::vec3::pos_y()));
+            planes.push_back(vm::plane3(1.0, vm::vec3::neg_y()));
+            planes.push_back(vm::plane3(1.0, vm::vec3::pos_z()));
+        }
+        planes.push_back(vm::plane3(1.0, vm::vec3::neg_z()));
+        return planes;
+    }
+
+    TEST_CASE("SimdIntersectionTest.intersectRayPlanes", "[SimdIntersectionTest]") {
+        const auto planes = makeCube();
+        const auto ray = vm::ray3(vm::vec3(-3.0, 0.0, 0.0), vm::vec3::pos_x());
+
+        std::array<double, RayBatchSize> cosines;
+        std::array<double, RayBatchSize> distances;
+        intersectRayPlanes(ray, planes, 0u, 5u, cosines.data(), distances.data());
+
+        ASSERT_DOUBLE_EQ(+1.0, cosines[0]);
+        ASSERT_DOUBLE_EQ(4.0, distances[0]);
+        ASSERT_DOUBLE_EQ(-1.0, cosines[1]);
+        ASSERT_DOUBLE_EQ(2.0, distances[1]);
+        ASSERT_DOUBLE_EQ(0.0, cosines[2]);
+        ASSERT_DOUBLE_EQ(0.0, cosines[3]);
+        ASSERT_DOUBLE_EQ(0.0, cosines[4]);
+    }
+
+    TEST_CASE("SimdIntersectionTest.findRayEntryPlane", "[SimdIntersectionTest]") {
+        const auto planes = makeCube();
+        const auto epsilon = 0.0001;
+
+        ASSERT_EQ(std::optional<size_t>(1u), findRayEntryPlane(vm::ray3(vm::vec3(-3.0, 0.0, 0.0), vm::vec3::pos_x()), planes, epsilon));
+        ASSERT_EQ(std::optional<size_t>(4u), findRayEntryPlane(vm::ray3(vm::vec3(0.5, 0.5, 3.0), vm::vec3::neg_z()), planes, epsilon));
+        ASSERT_EQ(std::optional<size_t>(0u), findRayEntryPlane(vm::ray3(vm::vec3(3.0, 0.5, 0.5), vm::normalize(vm::vec3(-1.0, 0.1, 0.1))), planes, epsilon));
+
+        // parallel to a plane and outside
+        ASSERT_EQ(std::nullopt, findRayEntryPlane(vm::ray3(vm::vec3(-3.0, 2.0, 0.0), vm::vec3::pos_x()), planes, epsilon));
+
+        // missing diagonally
+        ASSERT_EQ(std::nullopt, findRayEntryPlane(vm::ray3(vm::vec3(-3.0, 0.0, 0.0), vm::normalize(vm::vec3(1.0, 2.0, 0.0))), planes, epsilon));
+
+        // pointing away
+        ASSERT_EQ(std::nullopt, findRayEntryPlane(vm::ray3(vm::vec3(-3.0, 0.0, 0.0), vm::vec3::neg_x()), planes, epsilon));
+    }
+
+    TEST_CASE("SimdIntersectionTest.pointInHalfspaces", "[SimdIntersectionTest]") {
+        auto planes = makeCube();
+        const auto epsilon = 0.0001;
+
+        ASSERT_TRUE(pointInHalfspaces(vm::vec3(0.0, 0.0, 0.0), planes, epsilon));
+        ASSERT_TRUE(pointInHalfspaces(vm::vec3(1.0, 1.0, 1.0), planes, epsilon));
+        ASSERT_TRUE(pointInHalfspaces(vm::vec3(1.00001, -1.0, 0.0), planes, epsilon));
+        ASSERT_FALSE(pointInHalfspaces(vm::vec3(1.001, 0.0, 0.0), planes, epsilon));
+        ASSERT_FALSE(pointInHalfspaces(vm::vec3(0.0, 0.0, -2.0), planes, epsilon));
+
+        // more planes than fit into a register, the last one cutting off a corner
+        planes.push_back(vm::plane3(vm::vec3(0.5, 0.5, 0.5), vm::normalize(vm::vec3(1.0, 1.0, 1.0))));
+        ASSERT_TRUE(pointInHalfspaces(vm::vec3(0.5, 0.5, 0.5), planes, epsilon));
+        ASSERT_FALSE(pointInHalfspaces(vm::vec3(1.0, 1.0, 1.0), planes, epsilon));
+        ASSERT_TRUE(pointInHalfspaces(vm::vec3(1.0, 1.0, -1.0), planes, epsilon));
+    }
+}
@@ -106,6 +106,37 @@ namespace TrenchBroom {
             ASSERT_TRUE(env.directoryExists(IO::Path("autosave")));
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesInBackground") {
+            using namespace std::literals::chrono_literals;
+
+            IO::TestEnvironment env("autosaver_test");
+            NullLogger logger;
+
+            document->saveDocumentAs(env.dir() + IO::Path("test.map"));
+            assert(env.fileExists(IO::Path("test.map")));
+
+            Autosaver autosaver(document, 100ms);
+            autosaver.setSaveInBackground(true);
+
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            std::this_thread::sleep_for(100ms);
+
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForBackgroundSave(logger);
+
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.1.map")));
+            ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.autosave")));
+
+            document->addNode(createBrushNode("some_texture"), document->currentLayer());
+            std::this_thread::sleep_for(100ms);
+
+            autosaver.triggerAutosave(logger);
+            autosaver.waitForBackgroundSave(logger);
+
+            ASSERT_TRUE(env.fileExists(IO::Path("autosave/test.2.map")));
+            ASSERT_FALSE(env.fileExists(IO::Path("autosave/test.autosave")));
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.autosaverSavesAgainAfterSaveInterval") {
             using namespace std::literals::chrono_literals;
 
@@ -0,0 +1,85 @@
+/*
+ Copyright (C) 2010-2017 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "View/CellItemIndex.h"
+
+#include <string>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        static std::vector<std::string> namesOf(const std::vector<std::string>& names, const std::vector<size_t>& items) {
+            std::vector<std::string> result;
+            for (const auto item : items) {
+                result.push_back(names[item]);
+            }
+            return result;
+        }
+
+        TEST_CASE("CellItemIndexTest.matchSortsByName", "[CellItemIndexTest]") {
+            const auto names = std::vector<std::string>({ "metal1_2", "Base_Wall", "city/METAL2_1", "sky1", "base_floor" });
+            auto index = CellItemIndex(names);
+
+            CHECK(index.size() == 5u);
+            CHECK(namesOf(names, index.match("")) == std::vector<std::string>({ "base_floor", "Base_Wall", "city/METAL2_1", "metal1_2", "sky1" }));
+            CHECK(index.nameRank(0u) == 3u);
+            CHECK(index.nameRank(4u) == 0u);
+        }
+
+        TEST_CASE("CellItemIndexTest.matchIgnoresCase", "[CellItemIndexTest]") {
+            const auto names = std::vector<std::string>({ "metal1_2", "Base_Wall", "city/METAL2_1", "sky1", "base_floor" });
+            auto index = CellItemIndex(names);
+
+            CHECK(namesOf(names, index.match("metal")) == std::vector<std::string>({ "city/METAL2_1", "metal1_2" }));
+            CHECK(namesOf(names, index.match("BASE")) == std::vector<std::string>({ "base_floor", "Base_Wall" }));
+            CHECK(namesOf(names, index.match("1")) == std::vector<std::string>({ "city/METAL2_1", "metal1_2", "sky1" }));
+            CHECK(index.match("brick").empty());
+        }
+
+        TEST_CASE("CellItemIndexTest.matchWhileTyping", "[CellItemIndexTest]") {
+            const auto names = std::vector<std::string>({ "metal1_2", "Base_Wall", "city/METAL2_1", "sky1", "base_floor", "metal_base" });
+            auto index = CellItemIndex(names);
+
+            CHECK(namesOf(names, index.match("m")) == std::vector<std::string>({ "city/METAL2_1", "metal1_2", "metal_base" }));
+            CHECK(namesOf(names, index.match("me")) == std::vector<std::string>({ "city/METAL2_1", "metal1_2", "metal_base" }));
+            CHECK(namesOf(names, index.match("metal1")) == std::vector<std::string>({ "metal1_2" }));
+            CHECK(namesOf(names, index.match("meta")) == std::vector<std::string>({ "city/METAL2_1", "metal1_2", "metal_base" }));
+            CHECK(namesOf(names, index.match("_base")) == std::vector<std::string>({ "metal_base" }));
+            CHECK(namesOf(names, index.match("_")) == std::vector<std::string>({ "base_floor", "Base_Wall", "city/METAL2_1", "metal1_2", "metal_base" }));
+        }
+
+        TEST_CASE("CellItemIndexTest.matchManyItems", "[CellItemIndexTest]") {
+            std::vector<std::string> names;
+            for (size_t i = 0u; i < 20000u; ++i) {
+                names.push_back("texture_" + std::to_string(i));
+            }
+            auto index = CellItemIndex(names);
+
+            CHECK(index.match("texture").size() == 20000u);
+            CHECK(index.match("texture_1").size() == 11111u);
+            CHECK(index.match("99").size() == 560u);
+
+            const auto& matches = index.match("ure_1999");
+            REQUIRE(matches.size() == 11u);
+            CHECK(names[matches.front()] == "texture_1999");
+        }
+    }
+}
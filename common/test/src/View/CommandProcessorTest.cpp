@@ -109,18 +109,20 @@ namespace TrenchBroom {
         class TestCommand : public UndoableCommand {
         private:
             bool m_isRepeatDelimiter;
+            size_t m_memorySize;
 
             mutable std::vector<TestCommandCall> m_expectedCalls;
         public:
             static const CommandType Type;
 
-            static std::unique_ptr<TestCommand> create(const std::string& name, const bool isRepeatDelimiter) {
-                return std::make_unique<TestCommand>(name, isRepeatDelimiter);
+            static std::unique_ptr<TestCommand> create(const std::string& name, const bool isRepeatDelimiter, const size_t memorySize = 0u) {
+                return std::make_unique<TestCommand>(name, isRepeatDelimiter, memorySize);
             }
 
-            explicit TestCommand(const std::string& name, const bool isRepeatDelimiter) :
+            explicit TestCommand(const std::string& name, const bool isRepeatDelimiter, const size_t memorySize = 0u) :
             UndoableCommand(Type, name),
-            m_isRepeatDelimiter(isRepeatDelimiter) {}
+            m_isRepeatDelimiter(isRepeatDelimiter),
+            m_memorySize(memorySize) {}
 
             ~TestCommand() {
                 ASSERT_TRUE(m_expectedCalls.empty());
@@ -171,6 +173,10 @@ namespace TrenchBroom {
                 return expectedCall.returnCanCollate;
             }
 
+            size_t doGetMemorySize() const override {
+                return m_memorySize;
+            }
+
         public:
             /**
              * Sets an expectation that doPerformDo() should be called.
@@ -833,5 +839,49 @@ namespace TrenchBroom {
             ASSERT_EQ(commandName1, commandProcessor.undoCommandName());
             ASSERT_EQ(commandName2, commandProcessor.redoCommandName());
         }
+
+        TEST_CASE("CommandProcessorTest.undoMemoryBudget", "[CommandProcessorTest]") {
+            /*
+             * Execute three commands which exceed the undo memory budget, then lower the budget and undo.
+             */
+
+            CommandProcessor commandProcessor(nullptr);
+            commandProcessor.setUndoMemoryBudget(500u);
+
+            const auto commandName1 = "test command 1";
+            auto command1 = TestCommand::create(commandName1, false, 200u);
+
+            const auto commandName2 = "test command 2";
+            auto command2 = TestCommand::create(commandName2, false, 200u);
+
+            const auto commandName3 = "test command 3";
+            auto command3 = TestCommand::create(commandName3, false, 300u);
+
+            command1->expectDo(true);
+            command1->expectCollate(command2.get(), false);
+            command2->expectDo(true);
+            command2->expectCollate(command3.get(), false);
+            command3->expectDo(true);
+            command3->expectUndo(true);
+
+            commandProcessor.executeAndStore(std::move(command1));
+            commandProcessor.executeAndStore(std::move(command2));
+            ASSERT_EQ(400u, commandProcessor.undoMemorySize());
+
+            // the oldest command is removed to fit the budget
+            commandProcessor.executeAndStore(std::move(command3));
+            ASSERT_EQ(500u, commandProcessor.undoMemorySize());
+            ASSERT_EQ(commandName3, commandProcessor.undoCommandName());
+
+            // the topmost command is kept even if it exceeds the budget
+            commandProcessor.setUndoMemoryBudget(100u);
+            ASSERT_EQ(300u, commandProcessor.undoMemorySize());
+            ASSERT_EQ(commandName3, commandProcessor.undoCommandName());
+            ASSERT_TRUE(commandProcessor.canRepeat());
+
+            ASSERT_TRUE(commandProcessor.undo()->success());
+            ASSERT_FALSE(commandProcessor.canUndo());
+            ASSERT_EQ(0u, commandProcessor.undoMemorySize());
+        }
     }
 }
@@ -36,6 +36,7 @@
 #include "Model/HitQuery.h"
 #include "Model/Issue.h"
 #include "Model/IssueQuickFix.h"
+#include "Model/IssueValidator.h"
 #include "Model/LayerNode.h"
 #include "Model/LockState.h"
 #include "Model/MapFormat.h"
@@ -1116,6 +1117,58 @@ namespace TrenchBroom {
             kdl::vec_clear_and_delete(issueGenerators);
         }
 
+        TEST_CASE_METHOD(MapDocumentTest, "IssueValidator.validateInBatches") {
+            std::vector<Model::EntityNode*> entities;
+            for (size_t i = 0u; i < 5u; ++i) {
+                Model::EntityNode* entity = document->createPointEntity(m_pointEntityDef, vm::vec3::zero());
+                entity->addOrUpdateAttribute("", "");
+                entities.push_back(entity);
+            }
+
+            auto issueGenerators = std::vector<Model::IssueGenerator*>{
+                new Model::EmptyAttributeNameIssueGenerator(),
+                new Model::EmptyAttributeValueIssueGenerator()
+            };
+
+            // the entities were modified after they were added to the document
+            auto nodes = kdl::vec_element_cast<Model::Node*>(entities);
+            for (Model::Node* node : nodes) {
+                CHECK_FALSE(node->issuesValid());
+            }
+
+            Model::IssueValidator validator(issueGenerators, 2u);
+            validator.start(nodes);
+            CHECK(validator.pendingNodeCount() == 5u);
+
+            std::vector<Model::Issue*> issues;
+            while (!validator.finished()) {
+                const auto batch = validator.validateNext(2u);
+                CHECK(batch.size() <= 4u);
+                kdl::vec_append(issues, batch);
+            }
+
+            CHECK(issues.size() == 10u);
+            CHECK(validator.pendingNodeCount() == 0u);
+
+            for (Model::EntityNode* entity : entities) {
+                CHECK(entity->issuesValid());
+                CHECK(entity->issues(issueGenerators).size() == 2u);
+            }
+
+            const auto& stats = validator.stats();
+            REQUIRE(stats.size() == 2u);
+            CHECK(stats[0].generator == issueGenerators[0]);
+            CHECK(stats[0].issueCount == 5u);
+            CHECK(stats[1].generator == issueGenerators[1]);
+            CHECK(stats[1].issueCount == 5u);
+
+            // nodes whose issues are valid are skipped
+            validator.start(nodes);
+            CHECK(validator.finished());
+
+            kdl::vec_clear_and_delete(issueGenerators);
+        }
+
         TEST_CASE_METHOD(MapDocumentTest, "MapDocumentTest.defaultLayerSortIndexImmutable", "[LayerTest]") {
             Model::LayerNode* defaultLayer = document->world()->defaultLayer();
 
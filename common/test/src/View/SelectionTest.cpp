@@ -23,14 +23,19 @@
 
 #include "Model/BrushNode.h"
 #include "Model/BrushBuilder.h"
+#include "Model/CollectContainedNodesVisitor.h"
+#include "Model/CollectTouchingNodesVisitor.h"
 #include "Model/EntityNode.h"
 #include "Model/GroupNode.h"
 #include "Model/LayerNode.h"
+#include "Model/ModelUtils.h"
 #include "Model/NodeCollection.h"
 #include "Model/WorldNode.h"
 #include "View/MapDocumentTest.h"
 #include "View/MapDocument.h"
 
+#include <vector>
+
 namespace TrenchBroom {
     namespace View {
         class SelectionTest : public MapDocumentTest {};
@@ -95,6 +100,44 @@ namespace TrenchBroom {
             ASSERT_EQ(1u, document->selectedNodes().nodeCount());
         }
         
+        TEST_CASE_METHOD(SelectionTest, "SelectionTest.collectTouchingAndContainedNodesMatchVisitors") {
+            Model::BrushBuilder builder(document->world(), document->worldBounds());
+
+            // a grid of small brushes, every other row of which is grouped, and a point entity
+            auto* group = new Model::GroupNode("Unnamed");
+            document->addNode(group, document->parentForNodes());
+            for (int x = 0; x < 12; ++x) {
+                for (int y = 0; y < 12; ++y) {
+                    const auto min = vm::vec3(x * 32.0, y * 32.0, 0.0);
+                    auto* brush = new Model::BrushNode(builder.createCuboid(vm::bbox3(min, min + vm::vec3(16.0, 16.0, 16.0)), "texture"));
+                    document->addNode(brush, y % 2 == 0 ? document->parentForNodes() : group);
+                }
+            }
+
+            auto* entity = new Model::EntityNode();
+            entity->addOrUpdateAttribute("classname", "point_entity");
+            document->addNode(entity, document->parentForNodes());
+
+            // the first query brush touches many brushes, the second one contains the whole grid
+            auto* touchingBrush = new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(-8.0, -8.0, -8.0), vm::vec3(280.0, 280.0, 8.0)), "texture"));
+            auto* containingBrush = new Model::BrushNode(builder.createCuboid(vm::bbox3(vm::vec3(100.0, -64.0, -64.0), vm::vec3(512.0, 512.0, 64.0)), "texture"));
+            document->addNode(touchingBrush, document->parentForNodes());
+            document->addNode(containingBrush, document->parentForNodes());
+
+            for (const auto& brushes : std::vector<std::vector<Model::BrushNode*>>{ { touchingBrush }, { containingBrush }, { touchingBrush, containingBrush } }) {
+                Model::CollectTouchingNodesVisitor<std::vector<Model::BrushNode*>::const_iterator> touchingVisitor(std::begin(brushes), std::end(brushes), document->editorContext());
+                document->world()->acceptAndRecurse(touchingVisitor);
+                const auto touching = Model::collectTouchingNodes(*document->world(), brushes, document->editorContext());
+                CHECK_FALSE(touching.empty());
+                CHECK_THAT(touching, Catch::UnorderedEquals(touchingVisitor.nodes()));
+
+                Model::CollectContainedNodesVisitor<std::vector<Model::BrushNode*>::const_iterator> containedVisitor(std::begin(brushes), std::end(brushes), document->editorContext());
+                document->world()->acceptAndRecurse(containedVisitor);
+                const auto contained = Model::collectContainedNodes(*document->world(), brushes, document->editorContext());
+                CHECK_THAT(contained, Catch::UnorderedEquals(containedVisitor.nodes()));
+            }
+        }
+
         TEST_CASE_METHOD(SelectionTest, "SelectionTest.updateLastSelectionBounds") {
             auto* entityNode = new Model::EntityNode();
             entityNode->addOrUpdateAttribute("classname", "point_entity");
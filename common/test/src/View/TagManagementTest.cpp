@@ -601,5 +601,49 @@ namespace TrenchBroom {
                 CHECK(!faces[i].hasTag(tag));
             }
         }
+
+        TEST_CASE_METHOD(TagManagementTest, "TagManagementTest.tagUpdateBrushFaceTagsAfterChangingTextures", "[TagManagementTest]") {
+            auto* brushNode = createBrushNode(m_textureB->name());
+            document->addNode(brushNode, document->parentForNodes());
+            document->select(brushNode);
+
+            const auto updateFaceTags = [&]() {
+                Model::ChangeBrushFaceAttributesRequest request;
+                request.addXOffset(1.0f);
+                document->setFaceAttributes(request);
+            };
+
+            for (const auto& face : brushNode->brush().faces()) {
+                REQUIRE(face.texture() == m_textureB);
+                CHECK(face.hasTag(document->smartTag("texturePattern")));
+                CHECK(face.hasTag(document->smartTag("surfaceparm_multi")));
+                CHECK(!face.hasTag(document->smartTag("texture")));
+            }
+
+            SECTION("Changing the surface parameters of the texture") {
+                m_textureB->setSurfaceParms({"parm2"});
+                updateFaceTags();
+
+                for (const auto& face : brushNode->brush().faces()) {
+                    CHECK(face.hasTag(document->smartTag("texturePattern")));
+                    CHECK(face.hasTag(document->smartTag("surfaceparm_single")));
+                    CHECK(!face.hasTag(document->smartTag("surfaceparm_multi")));
+                }
+            }
+
+            SECTION("Changing the texture of the faces") {
+                Model::ChangeBrushFaceAttributesRequest request;
+                request.setTextureName(m_textureA->name());
+                document->setFaceAttributes(request);
+
+                for (const auto& face : brushNode->brush().faces()) {
+                    REQUIRE(face.texture() == m_textureA);
+                    CHECK(face.hasTag(document->smartTag("texture")));
+                    CHECK(!face.hasTag(document->smartTag("texturePattern")));
+                    CHECK(face.hasTag(document->smartTag("surfaceparm_multi")));
+                    CHECK(!face.hasTag(document->smartTag("surfaceparm_single")));
+                }
+            }
+        }
     }
 }
@@ -0,0 +1,191 @@
+/*
+ Copyright (C) 2020 Kristian Duske
+
+ This file is part of TrenchBroom.
+
+ TrenchBroom is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ TrenchBroom is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with TrenchBroom. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "FloatType.h"
+#include "PreferenceManager.h"
+#include "Preferences.h"
+#include "Model/PickResult.h"
+#include "Renderer/OrthographicCamera.h"
+#include "Renderer/PerspectiveCamera.h"
+#include "View/Lasso.h"
+#include "View/VertexHandleManager.h"
+
+#include <vecmath/intersection.h>
+#include <vecmath/plane.h>
+#include <vecmath/ray.h>
+#include <vecmath/vec.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace TrenchBroom {
+    namespace View {
+        static std::vector<vm::vec3> makeVertexHandles() {
+            std::vector<vm::vec3> result;
+            for (int x = -4; x <= 4; ++x) {
+                for (int y = -4; y <= 4; ++y) {
+                    for (int z = -4; z <= 4; ++z) {
+                        result.emplace_back(x * 16.0 + 0.5 * y, y * 16.0, z * 16.0 - 0.25 * x);
+                    }
+                }
+            }
+            return result;
+        }
+
+        static std::vector<vm::vec3> pickedHandles(const VertexHandleManager& manager, const vm::ray3& pickRay, const Renderer::Camera& camera) {
+            Model::PickResult pickResult;
+            manager.pick(pickRay, camera, pickResult);
+
+            std::vector<vm::vec3> result;
+            for (const auto& hit : pickResult.all()) {
+                result.push_back(hit.target<vm::vec3>());
+            }
+            std::sort(std::begin(result), std::end(result));
+            return result;
+        }
+
+        static std::vector<vm::vec3> expectedPickedHandles(const VertexHandleManager& manager, const vm::ray3& pickRay, const Renderer::Camera& camera) {
+            const auto handleRadius = static_cast<FloatType>(pref(Preferences::HandleRadius));
+
+            std::vector<vm::vec3> result;
+            for (const auto& handle : manager.allHandles()) {
+                if (!vm::is_nan(camera.pickPointHandle(pickRay, handle, handleRadius))) {
+                    result.push_back(handle);
+                }
+            }
+            std::sort(std::begin(result), std::end(result));
+            return result;
+        }
+
+        static void checkPicking(const VertexHandleManager& manager, const Renderer::Camera& camera) {
+            const auto& viewport = camera.viewport();
+            for (int x = 0; x < viewport.width; x += 7) {
+                for (int y = 0; y < viewport.height; y += 7) {
+                    const auto pickRay = vm::ray3(camera.pickRay(x, y));
+                    ASSERT_EQ(expectedPickedHandles(manager, pickRay, camera), pickedHandles(manager, pickRay, camera));
+                }
+            }
+        }
+
+        TEST_CASE("VertexHandleManagerTest.addAndRemoveHandles", "[VertexHandleManagerTest]") {
+            VertexHandleManager manager;
+
+            const auto handle = vm::vec3(16, 32, 64);
+            manager.add(handle);
+            manager.add(handle);
+            manager.add(vm::vec3(0, 0, 0));
+            ASSERT_EQ(2u, manager.totalHandleCount());
+
+            manager.select(handle + vm::vec3(0.0000001, 0, 0));
+            ASSERT_TRUE(manager.selected(handle));
+            ASSERT_EQ(1u, manager.selectedHandleCount());
+
+            ASSERT_TRUE(manager.remove(handle));
+            ASSERT_TRUE(manager.contains(handle));
+            ASSERT_TRUE(manager.selected(handle));
+
+            ASSERT_TRUE(manager.remove(handle));
+            ASSERT_FALSE(manager.contains(handle));
+            ASSERT_EQ(0u, manager.selectedHandleCount());
+
+            manager.select(handle);
+            ASSERT_EQ(0u, manager.selectedHandleCount());
+
+            manager.add(handle);
+            manager.select(handle);
+            ASSERT_EQ(1u, manager.selectedHandleCount());
+
+            manager.clear();
+            ASSERT_EQ(0u, manager.totalHandleCount());
+
+            manager.add(handle);
+            manager.select(handle);
+            ASSERT_EQ(1u, manager.selectedHandleCount());
+        }
+
+        TEST_CASE("VertexHandleManagerTest.pickFindsSameHandlesAsLinearSearch", "[VertexHandleManagerTest]") {
+            const auto handles = makeVertexHandles();
+
+            VertexHandleManager manager;
+            for (const auto& handle : handles) {
+                manager.add(handle);
+            }
+
+            // remove some handles to check that the spatial index is updated
+            for (size_t i = 0u; i < handles.size(); i += 3u) {
+                manager.remove(handles[i]);
+            }
+
+            const Renderer::Camera::Viewport viewport(0, 0, 64, 48);
+
+            SECTION("Perspective camera") {
+                const Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(-100.0f, -120.0f, 40.0f), vm::normalize(vm::vec3f(1.0f, 1.2f, -0.4f)), vm::vec3f::pos_z());
+                checkPicking(manager, camera);
+            }
+
+            SECTION("Orthographic camera") {
+                Renderer::OrthographicCamera camera(1.0f, 8000.0f, viewport, vm::vec3f(0.0f, 0.0f, 256.0f), vm::vec3f::neg_z(), vm::vec3f::pos_y());
+                camera.setZoom(0.5f);
+                checkPicking(manager, camera);
+            }
+        }
+
+        TEST_CASE("VertexHandleManagerTest.lassoCandidatesContainSelectedHandles", "[VertexHandleManagerTest]") {
+            const auto handles = makeVertexHandles();
+
+            VertexHandleManager manager;
+            for (const auto& handle : handles) {
+                manager.add(handle);
+            }
+
+            const Renderer::Camera::Viewport viewport(0, 0, 640, 480);
+            const Renderer::PerspectiveCamera camera(90.0f, 1.0f, 8000.0f, viewport, vm::vec3f(-100.0f, -120.0f, 40.0f), vm::normalize(vm::vec3f(1.0f, 1.2f, -0.4f)), vm::vec3f::pos_z());
+
+            const auto distance = 64.0f;
+            const auto plane = vm::orthogonal_plane(vm::vec3(camera.defaultPoint(distance)), vm::vec3(camera.direction()));
+            const auto pointOnPlane = [&](const int x, const int y) {
+                const auto pickRay = vm::ray3(camera.pickRay(x, y));
+                return vm::point_at_distance(pickRay, vm::intersect_ray_plane(pickRay, plane));
+            };
+
+            Lasso lasso(camera, static_cast<FloatType>(distance), pointOnPlane(200, 150));
+            lasso.update(pointOnPlane(420, 330));
+
+            const auto allHandles = manager.allHandles();
+            std::vector<vm::vec3> expected;
+            lasso.selected(std::begin(allHandles), std::end(allHandles), std::back_inserter(expected));
+            ASSERT_FALSE(expected.empty());
+            ASSERT_LT(expected.size(), allHandles.size());
+
+            const auto candidates = manager.findHandles(lasso.boundingPlanes());
+            ASSERT_LT(candidates.size(), allHandles.size());
+
+            std::vector<vm::vec3> actual;
+            lasso.selected(std::begin(candidates), std::end(candidates), std::back_inserter(actual));
+
+            std::sort(std::begin(expected), std::end(expected));
+            std::sort(std::begin(actual), std::end(actual));
+            ASSERT_EQ(expected, actual);
+        }
+    }
+}
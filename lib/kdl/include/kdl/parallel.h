@@ -0,0 +1,288 @@
+/*
+ Copyright 2020 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#ifndef KDL_PARALLEL_H
+#define KDL_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace kdl {
+    /**
+     * Returns the number of worker threads to use by default. This is the number of hardware threads, but at least 1.
+     */
+    inline std::size_t default_thread_count() {
+        return std::max(static_cast<std::size_t>(std::thread::hardware_concurrency()), std::size_t(1));
+    }
+
+    /**
+     * A fixed set of worker threads that run the tasks submitted to it in submission order. The threads are started
+     * when the pool is created and joined when it is destroyed, after the remaining tasks have run.
+     */
+    class thread_pool {
+    private:
+        std::vector<std::thread> m_threads;
+        std::deque<std::function<void()>> m_tasks;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopped;
+    public:
+        /**
+         * Creates a pool with the given number of worker threads.
+         */
+        explicit thread_pool(const std::size_t threadCount) :
+        m_stopped(false) {
+            m_threads.reserve(threadCount);
+            for (std::size_t i = 0u; i < threadCount; ++i) {
+                m_threads.emplace_back([this]() { run(); });
+            }
+        }
+
+        ~thread_pool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopped = true;
+            }
+            m_condition.notify_all();
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+
+        /**
+         * Returns the number of worker threads of this pool.
+         */
+        std::size_t thread_count() const {
+            return m_threads.size();
+        }
+
+        /**
+         * Adds the given task to the queue. The task must not throw.
+         */
+        void submit(std::function<void()> task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_tasks.push_back(std::move(task));
+            }
+            m_condition.notify_one();
+        }
+    private:
+        void run() {
+            while (true) {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_condition.wait(lock, [&]() { return m_stopped || !m_tasks.empty(); });
+                    if (m_tasks.empty()) {
+                        return;
+                    }
+                    task = std::move(m_tasks.front());
+                    m_tasks.pop_front();
+                }
+                task();
+            }
+        }
+    };
+
+    /**
+     * Returns the pool shared by the parallel algorithms. It has one thread less than default_thread_count() because
+     * the calling thread always participates in the work.
+     */
+    inline thread_pool& default_thread_pool() {
+        static thread_pool pool(default_thread_count() - 1u);
+        return pool;
+    }
+
+    /**
+     * Calls the given lambda for each index in [0, count) using up to the given number of threads. The indices are
+     * handed out to the threads dynamically, so the order in which the lambda is called is unspecified, but every index
+     * is passed to the lambda exactly once.
+     *
+     * The work is shared by the calling thread and the threads of the default_thread_pool(), so no threads are started
+     * by this function. Helpers that only get to run after the calling thread has run out of indices do nothing, so
+     * calling this function from a task that runs on the pool cannot deadlock.
+     *
+     * The lambda must be safe to call concurrently from different threads. If the lambda throws an exception, the
+     * exception is rethrown on the calling thread once all threads have finished. If more than one invocation throws,
+     * only the first exception is rethrown.
+     *
+     * If the given count or number of threads is at most 1, the lambda is called on the calling thread.
+     *
+     * @tparam L the type of the lambda, must be of type `void(std::size_t)`
+     * @param count the number of indices
+     * @param lambda the lambda to call
+     * @param numThreads the maximum number of threads to use
+     */
+    template <typename L>
+    void parallel_for(const std::size_t count, L&& lambda, const std::size_t numThreads = default_thread_count()) {
+        const auto threadCount = std::min(count, numThreads);
+        if (threadCount <= 1u) {
+            for (std::size_t i = 0u; i < count; ++i) {
+                lambda(i);
+            }
+            return;
+        }
+
+        // The state is shared with the helper tasks since they may only be dequeued after this function has returned.
+        struct state {
+            std::atomic<std::size_t> nextIndex{0u};
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::size_t activeHelpers{0u};
+            bool closed{false};
+            std::exception_ptr exception;
+        };
+        const auto sharedState = std::make_shared<state>();
+
+        const auto work = [&lambda, count](state& s) {
+            try {
+                for (auto i = s.nextIndex++; i < count; i = s.nextIndex++) {
+                    lambda(i);
+                }
+            } catch (...) {
+                // stop handing out indices
+                s.nextIndex = count;
+
+                std::lock_guard<std::mutex> lock(s.mutex);
+                if (!s.exception) {
+                    s.exception = std::current_exception();
+                }
+            }
+        };
+
+        for (std::size_t i = 0u; i < threadCount - 1u; ++i) {
+            default_thread_pool().submit([sharedState, work]() {
+                auto& s = *sharedState;
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    if (s.closed) {
+                        return;
+                    }
+                    ++s.activeHelpers;
+                }
+
+                work(s);
+
+                {
+                    std::lock_guard<std::mutex> lock(s.mutex);
+                    --s.activeHelpers;
+                }
+                s.condition.notify_all();
+            });
+        }
+
+        // the calling thread participates, too
+        auto& s = *sharedState;
+        work(s);
+
+        std::unique_lock<std::mutex> lock(s.mutex);
+        s.closed = true;
+        s.condition.wait(lock, [&]() { return s.activeHelpers == 0u; });
+
+        if (s.exception) {
+            std::rethrow_exception(s.exception);
+        }
+    }
+
+    /**
+     * Applies the given lambda to each element of the given vector using up to the given number of threads and returns
+     * a vector containing the resulting values, in the order in which their original elements appeared in v.
+     *
+     * The elements are passed to the given lambda as const lvalue references. The lambda must be safe to call
+     * concurrently from different threads.
+     *
+     * @tparam T the type of the vector elements
+     * @tparam A the vector's allocator type
+     * @tparam L the type of the lambda to apply
+     * @param v the vector
+     * @param transform the lambda to apply, must be of type `auto(const T&)`
+     * @param numThreads the maximum number of threads to use
+     * @return a vector containing the transformed values
+     */
+    template<typename T, typename A, typename L,
+        typename std::enable_if_t<
+            std::is_invocable_v<L, const T&>
+        >* = nullptr>
+    auto vec_parallel_transform(const std::vector<T, A>& v, L&& transform, const std::size_t numThreads = default_thread_count()) {
+        using ResultType = decltype(transform(std::declval<const T&>()));
+
+        std::vector<std::optional<ResultType>> partialResult(v.size());
+        parallel_for(v.size(), [&](const std::size_t i) {
+            partialResult[i] = transform(v[i]);
+        }, numThreads);
+
+        std::vector<ResultType> result;
+        result.reserve(v.size());
+        for (auto& element : partialResult) {
+            result.push_back(std::move(*element));
+        }
+
+        return result;
+    }
+
+    /**
+     * Applies the given lambda to each element of the given vector using up to the given number of threads and returns
+     * a vector containing the resulting values, in the order in which their original elements appeared in v.
+     *
+     * The elements are passed to the given lambda as rvalue references. The lambda must be safe to call concurrently
+     * from different threads.
+     *
+     * @tparam T the type of the vector elements
+     * @tparam A the vector's allocator type
+     * @tparam L the type of the lambda to apply
+     * @param v the vector
+     * @param transform the lambda to apply, must be of type `auto(T&&)`
+     * @param numThreads the maximum number of threads to use
+     * @return a vector containing the transformed values
+     */
+    template<typename T, typename A, typename L,
+        typename std::enable_if_t<
+            std::is_invocable_v<L, T&&> && !std::is_invocable_v<L, const T&>
+        >* = nullptr>
+    auto vec_parallel_transform(std::vector<T, A>&& v, L&& transform, const std::size_t numThreads = default_thread_count()) {
+        using ResultType = decltype(transform(std::declval<T&&>()));
+
+        std::vector<std::optional<ResultType>> partialResult(v.size());
+        parallel_for(v.size(), [&](const std::size_t i) {
+            partialResult[i] = transform(std::move(v[i]));
+        }, numThreads);
+
+        std::vector<ResultType> result;
+        result.reserve(v.size());
+        for (auto& element : partialResult) {
+            result.push_back(std::move(*element));
+        }
+
+        return result;
+    }
+}
+
+#endif //KDL_PARALLEL_H
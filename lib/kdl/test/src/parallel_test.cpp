@@ -0,0 +1,121 @@
+/*
+ Copyright 2020 Kristian Duske
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated
+ documentation files (the "Software"), to deal in the Software without restriction, including without limitation the
+ rights to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of the Software, and to permit
+ persons to whom the Software is furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the
+ Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE
+ WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR
+ OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include <catch2/catch.hpp>
+
+#include "GTestCompat.h"
+
+#include "kdl/parallel.h"
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace kdl {
+    TEST_CASE("parallel_test.parallel_for", "[parallel_test]") {
+        for (const std::size_t numThreads : { 1u, 2u, 8u }) {
+            std::vector<int> visited(1000u, 0);
+            parallel_for(visited.size(), [&](const std::size_t i) {
+                ++visited[i];
+            }, numThreads);
+
+            for (const auto count : visited) {
+                ASSERT_EQ(1, count);
+            }
+        }
+    }
+
+    TEST_CASE("parallel_test.parallel_for_empty", "[parallel_test]") {
+        std::atomic<int> calls(0);
+        parallel_for(0u, [&](const std::size_t) { ++calls; }, 4u);
+        ASSERT_EQ(0, calls.load());
+    }
+
+    TEST_CASE("parallel_test.parallel_for_rethrows", "[parallel_test]") {
+        ASSERT_THROW(parallel_for(100u, [](const std::size_t i) {
+            if (i == 50u) {
+                throw std::runtime_error("fail");
+            }
+        }, 4u), std::runtime_error);
+    }
+
+    TEST_CASE("parallel_test.parallel_for_nested", "[parallel_test]") {
+        std::vector<std::vector<int>> visited(16u, std::vector<int>(100u, 0));
+        parallel_for(visited.size(), [&](const std::size_t i) {
+            parallel_for(visited[i].size(), [&](const std::size_t j) {
+                ++visited[i][j];
+            }, 4u);
+        }, 8u);
+
+        for (const auto& inner : visited) {
+            for (const auto count : inner) {
+                ASSERT_EQ(1, count);
+            }
+        }
+    }
+
+    TEST_CASE("parallel_test.parallel_for_repeated", "[parallel_test]") {
+        // helpers that are dequeued late must not interfere with later calls
+        for (std::size_t n = 0u; n < 1000u; ++n) {
+            std::atomic<std::size_t> sum(0u);
+            parallel_for(n % 7u, [&](const std::size_t i) { sum += i + 1u; }, 8u);
+
+            const auto count = n % 7u;
+            ASSERT_EQ(count * (count + 1u) / 2u, sum.load());
+        }
+    }
+
+    TEST_CASE("parallel_test.thread_pool", "[parallel_test]") {
+        std::atomic<int> calls(0);
+        {
+            thread_pool pool(2u);
+            ASSERT_EQ(2u, pool.thread_count());
+            for (int i = 0; i < 100; ++i) {
+                pool.submit([&]() { ++calls; });
+            }
+        }
+        // destroying the pool runs the remaining tasks
+        ASSERT_EQ(100, calls.load());
+    }
+
+    TEST_CASE("parallel_test.vec_parallel_transform", "[parallel_test]") {
+        std::vector<int> v;
+        for (int i = 0; i < 1000; ++i) {
+            v.push_back(i);
+        }
+
+        const auto result = vec_parallel_transform(v, [](const int i) { return i * 2; }, 4u);
+        ASSERT_EQ(v.size(), result.size());
+        for (std::size_t i = 0u; i < v.size(); ++i) {
+            ASSERT_EQ(v[i] * 2, result[i]);
+        }
+    }
+
+    TEST_CASE("parallel_test.vec_parallel_transform_rvalue", "[parallel_test]") {
+        std::vector<std::unique_ptr<int>> v;
+        for (int i = 0; i < 100; ++i) {
+            v.push_back(std::make_unique<int>(i));
+        }
+
+        const auto result = vec_parallel_transform(std::move(v), [](std::unique_ptr<int>&& i) { return std::move(i); }, 4u);
+        ASSERT_EQ(100u, result.size());
+        for (std::size_t i = 0u; i < result.size(); ++i) {
+            ASSERT_EQ(static_cast<int>(i), *result[i]);
+        }
+    }
+}